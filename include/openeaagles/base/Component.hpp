@@ -224,11 +224,18 @@ class String;
 //
 //    Send() locates the receiving component, 'id', from our components list,
 //    and it uses the SendData structure to save the pointer to the receiving
-//    component.
+//    component, so the component's name is only searched for (findByName())
+//    until it's found.  Use SendData::empty() if the components change.
 //
 //    For 'int', 'float', 'double', 'bool' and 'char*' type arguments, send()
 //    will create the proper type Object to pass to the event() function.
-//    The SendData structure is used to save the previous argument value.
+//    The SendData structure is used to save the previous argument value, and
+//    it reuses its value objects, so there are no allocations after the first
+//    send() of each type (a 'char*' value's object only grows to hold longer
+//    strings).  Only the sending side is allocation-free: the receiving
+//    component's event() still finds its handler with its event table, so
+//    each ON_EVENT_OBJ() for the event token does a dynamic_cast<> of the
+//    value object until the handler for its type is found.
 //    With all subsequent send()'s, the previous argument value is compared to
 //    the current argument value, and the event() is sent only if the values
 //    have changed.
@@ -276,8 +283,10 @@ public:
       public:  Object* getValue(const double value);
       public:  Object* getValue(const char* const value);
       public:  Object* getValue(const bool value);
-      private: Component* obj {};   // Object to send to
-      private: Object* past {};     // Old value
+      private: enum ValueType : unsigned char { NONE, INTEGER, FLOAT, STRING, BOOLEAN, NUM_VALUE_TYPES };
+      private: Component* obj {};                      // Object to send to
+      private: Object* values[NUM_VALUE_TYPES] {};     // Old values, by type (reused)
+      private: ValueType type {NONE};                  // Type of the old value
    };
 
 public:
@@ -334,9 +343,11 @@ public:
    // Send the 'event' message to our component named 'id' with an optional
    // argument, 'value',  The SendData structure maintains the n-1 value
    // and the pointer to our component.  Send() returns true if the 'event'
-   // has been received and used.
+   // has been received and used.  Without a SendData structure, the component
+   // is found by name, findByName(), with each call.
    // ---
    bool send(const char* const id, const int event);
+   bool send(const char* const id, const int event, SendData& sd);
    bool send(const char* const id, const int event, const int value, SendData& sd);
    bool send(const char* const id, const int event, const float value, SendData& sd);
    bool send(const char* const id, const int event, const double value, SendData& sd);
@@ -0,0 +1,73 @@
+
+#ifndef __oe_base_FactoryTable_H__
+#define __oe_base_FactoryTable_H__
+
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+
+namespace oe {
+namespace base {
+class Object;
+
+//------------------------------------------------------------------------------
+// Class: FactoryTable
+// Description: Hash table of the factory names of a module's classes and the
+//              functions that construct them, which is used by the module's
+//              factory() function to find the class with one hashed lookup,
+//              instead of comparing the name with each class's factory name.
+//
+// Example:
+//
+//    Object* factory(const std::string& name)
+//    {
+//       static const FactoryTable table = {
+//          FACTORY_ENTRY(Integer),
+//          FACTORY_ENTRY(Float)
+//       };
+//       return table.create(name);
+//    }
+//
+// Notes:
+//    1) Use a function static table, which is built on the first call, so the
+//       classes' factory names have been initialized (see IMPLEMENT_SUBCLASS).
+//
+//    2) With duplicate factory names, the first entry is used.
+//------------------------------------------------------------------------------
+class FactoryTable
+{
+public:
+   using CreateFunc = Object* (*)();
+
+   struct Entry {
+      const char* name;          // Factory name
+      CreateFunc create;         // Constructs a new object
+   };
+
+public:
+   FactoryTable(std::initializer_list<Entry> entries);
+   FactoryTable(const FactoryTable&) = delete;
+   FactoryTable& operator=(const FactoryTable&) = delete;
+
+   // Returns a new object of the class named 'name', or zero if not found
+   Object* create(const std::string& name) const;
+
+   unsigned int getNumEntries() const        { return static_cast<unsigned int>(table.size()); }
+
+   // Constructs an object of class T (see FACTORY_ENTRY)
+   template <class T>
+   static Object* construct()                { return new T(); }
+
+private:
+   std::unordered_map<std::string, CreateFunc> table;
+};
+
+}
+}
+
+//------------------------------------------------------------------------------
+// FACTORY_ENTRY(ThisType) -- FactoryTable entry for class 'ThisType'
+//------------------------------------------------------------------------------
+#define FACTORY_ENTRY(ThisType)  { ThisType::getFactoryName(), &oe::base::FactoryTable::construct<ThisType> }
+
+#endif
@@ -216,6 +216,10 @@ namespace base {
 //    relative to our class (i.e. a local slot one), and these local number are
 //    used by the ON_SLOT() macro.
 //
+//    Slots are set by name, setSlotByName(), or by their SlotTable index
+//    number, setSlotByNumber(), which skips the slot name search (e.g., the
+//    compiled EDL files; see edl_parser.hpp).
+//
 //
 // Object Serializer:
 //
@@ -317,6 +321,7 @@ class Object : public Referenced
    public: static const SlotTable& getSlotTable();
    protected: virtual bool setSlotByIndex(const int slotindex, Object* const obj);
    public: bool setSlotByName(const char* const slotname, Object* const obj);
+   public: bool setSlotByNumber(const int slotnumber, Object* const obj);
    public: const char* slotIndex2Name(const int slotindex) const;
    public: int slotName2Index(const char* const slotname) const;
 
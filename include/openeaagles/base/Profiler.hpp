@@ -0,0 +1,170 @@
+
+#ifndef __oe_base_Profiler_H__
+#define __oe_base_Profiler_H__
+
+#include "openeaagles/base/Component.hpp"
+
+#include <atomic>
+#include <iostream>
+
+namespace oe {
+namespace base {
+class Number;
+class String;
+
+//------------------------------------------------------------------------------
+// Class: Profiler
+//
+// Description: Low overhead, hierarchical frame profiler.  Timed scopes (see
+//              ProfileScope below) record one event each into a per-thread
+//              ring buffer; the events are exported as a Chrome trace
+//              (JSON) file, which can be viewed with chrome://tracing or
+//              Perfetto (ui.perfetto.dev).
+//
+// Factory name: Profiler
+// Slots:
+//    enable         <Boolean>   ! Enable the profiler (default: true)
+//    bufferSize     <Number>    ! Max number of events kept per thread
+//                               ! (default: DEFAULT_BUFFER_SIZE)
+//    filename       <String>    ! Trace file written at shutdown (default: none)
+//    printSummary   <Boolean>   ! Print the event summary at shutdown (default: false)
+//
+// Events:
+//    SHUTDOWN_EVENT    Stops the profiler and writes the trace file and the
+//                      summary (if enabled)
+//
+// Example:
+//
+//    ( Station
+//       profiler: ( Profiler filename: "frames.json" printSummary: true )
+//       ...
+//    )
+//
+// Notes:
+//    1) The event buffers are global: there's only one active profiler, which
+//       is enabled by the last Profiler to be enabled.  When it's disabled,
+//       each timed scope costs one flag check.
+//
+//    2) Each thread records to its own ring buffer, which is created with the
+//       thread's first event and is kept until the program exits; when full,
+//       the oldest events are overwritten.  The buffer size is used for the
+//       buffers created after it's set.
+//
+//    3) Event names and types must be static strings.  The object types are
+//       from typeid(), and are demangled when the events are exported.
+//
+//    4) Exports are meant to be done with the profiler stopped (e.g., at
+//       shutdown); events that are being written while exporting may be
+//       missing or incomplete.
+//
+//    5) Instrumented scopes: Component::tcFrame() and the subcomponents'
+//       updateData(), the players' updateData() and the four phases of the
+//       Simulation, the NetIO input and output frames, and the Tdb scans.
+//------------------------------------------------------------------------------
+class Profiler : public Component
+{
+   DECLARE_SUBCLASS(Profiler, Component)
+
+public:
+   static const unsigned int DEFAULT_BUFFER_SIZE = 64 * 1024;   // events per thread
+   static const unsigned int MIN_BUFFER_SIZE = 256;
+
+   // Recorded event
+   struct Event {
+      const char* name;       // Event name
+      const char* type;       // Object type (mangled type_info name), or zero
+      const void* object;     // Object, or zero
+      long long start;        // Start time (nanoseconds)
+      long long duration;     // Duration (nanoseconds)
+   };
+
+public:
+   Profiler();
+
+   bool isProfilerEnabled() const                     { return enableFlg; }
+   unsigned int getBufferSize() const                 { return bufferSize; }
+   const String* getFilename() const                  { return filename; }
+   bool isSummaryEnabled() const                      { return summaryFlg; }
+
+   virtual bool setProfilerEnabled(const bool flg);
+   virtual bool setBufferSize(const unsigned int n);
+   virtual bool setFilename(const String* const name);
+   virtual bool setSummaryEnabled(const bool flg);
+
+   // Writes the events as a Chrome trace (JSON) file; returns true if successful
+   static bool writeTrace(const char* const filename);
+   static void writeTrace(std::ostream& sout);
+
+   // Prints the count, mean, max and total times (ms) of each event type
+   static void printSummary(std::ostream& sout);
+
+   // Clears the events
+   static void clear();
+
+   // ---
+   // Event recording (see ProfileScope)
+   // ---
+   static bool isEnabled()                            { return enabled.load(std::memory_order_relaxed); }
+   static long long getTime();      // Profiler time (nanoseconds)
+   static void record(const char* const name, const char* const type, const void* const object,
+                      const long long start, const long long end);
+
+protected:
+   // Slot functions
+   bool setSlotEnable(const Number* const msg);
+   bool setSlotBufferSize(const Number* const msg);
+   bool setSlotFilename(const String* const msg);
+   bool setSlotPrintSummary(const Number* const msg);
+
+   virtual bool shutdownNotification() override;
+
+private:
+   static std::atomic<bool> enabled;          // Recording events
+
+   bool enableFlg {true};                     // Enable flag
+   unsigned int bufferSize {DEFAULT_BUFFER_SIZE};  // Events per thread
+   const String* filename {};                 // Trace file name
+   bool summaryFlg {};                        // Print summary at shutdown
+   bool active {};                            // We've enabled the recording
+};
+
+//------------------------------------------------------------------------------
+// Class: ProfileScope
+//
+// Description: Records a Profiler event for the lifetime of the object, if
+//              the profiler is enabled.
+//
+// Example:
+//
+//    {
+//       ProfileScope ps("updateData", this);
+//       ...
+//    }
+//------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+   explicit ProfileScope(const char* const name, const Object* const obj = nullptr)
+      : eventName(name), object(obj), start(Profiler::isEnabled() ? Profiler::getTime() : -1)
+   {}
+
+   ~ProfileScope() {
+      if (start >= 0) {
+         const char* type = (object != nullptr ? typeid(*object).name() : nullptr);
+         Profiler::record(eventName, type, object, start, Profiler::getTime());
+      }
+   }
+
+   ProfileScope(const ProfileScope&) = delete;
+   ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+   const char* eventName {};
+   const Object* object {};
+   long long start {-1};
+};
+
+}
+}
+
+#endif
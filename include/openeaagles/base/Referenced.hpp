@@ -4,15 +4,28 @@
 
 // framework configuration file
 #include "openeaagles/config.hpp"
-// lock/unlock, etc - reference system needs it
+// lock/unlock, etc
 #include "openeaagles/base/util/atomics.hpp"
 
+#include <atomic>
+
 namespace oe {
 namespace base {
 
 //------------------------------------------------------------------------------
 // Class: Referenced
 // Description: Base class to enable reference counting mechanism for objects
+//
+//    The reference count is a lock-free std::atomic.  ref() is a relaxed
+//    increment; unref() is a release decrement, and the thread that drops
+//    the count to zero synchronizes (acquire) with the other threads'
+//    decrements before deleting the object.
+//
+//    The ExpInvalidRefCount checks are made only when
+//    OE_CONFIG_CHECK_REF_COUNTS is non-zero (default: debug builds, see
+//    config.hpp).  With the checks, ref() and unref() use compare-and-swap
+//    loops, so the count is checked before it's changed, and an invalid
+//    count is left as it was when the exception is thrown.
 //------------------------------------------------------------------------------
 class Referenced
 {
@@ -22,7 +35,7 @@ public:
    Referenced& operator=(const Referenced&) = delete;
    virtual ~Referenced() =0;
 
-   unsigned int getRefCount() const { return refCount; }
+   unsigned int getRefCount() const { return refCount.load(std::memory_order_relaxed); }
 
    // ---
    // ref() --
@@ -30,7 +43,8 @@ public:
    //    is pre-referenced at creation and therefore does not need to be
    //    referenced by the creator (i.e., the reference count is
    //    initialized to one (1) by the constructor).  ExpInvalidRefCount
-   //    is thrown if the reference count is invalid.
+   //    is thrown if the reference count is invalid (reference count checks
+   //    only, see OE_CONFIG_CHECK_REF_COUNTS).
    // ---
    void ref() const;
 
@@ -38,6 +52,8 @@ public:
    // unref() --
    //    Decrements the number of references to this object.
    //    And, when the number of references becomes zero, deletes this object.
+   //    ExpInvalidRefCount is thrown if the object had no references
+   //    (reference count checks only).
    // ---
    void unref() const;
 
@@ -68,31 +84,49 @@ public:
    };
 
 private:
-   mutable long semaphore {};           // ref(), unref() semaphore
-   mutable unsigned int refCount {1};   // reference count
+   mutable std::atomic<unsigned int> refCount {1};   // reference count
 };
 
 inline Referenced::~Referenced() {}
 
 inline void Referenced::ref() const
 {
-   lock(semaphore);
-   if (++(refCount) <= 1) throw new ExpInvalidRefCount();
-   else unlock(semaphore);
+   // Only the new reference needs to be counted; the caller already holds
+   // a reference, so no ordering is required.
+   #if OE_CONFIG_CHECK_REF_COUNTS
+   unsigned int prev = refCount.load(std::memory_order_relaxed);
+   do {
+      if (prev < 1) throw new ExpInvalidRefCount();
+   } while (!refCount.compare_exchange_weak(prev, prev + 1, std::memory_order_relaxed));
+   #else
+   const unsigned int prev = refCount.fetch_add(1, std::memory_order_relaxed);
+   (void) prev;
+   #endif
 
    #ifdef MAX_REF_COUNT_ERROR
-   static int maxRefCount = MAX_REF_COUNT_ERROR;
-   if (which->refCount > maxRefCount) {
-      std::cout << "ref(" << this << "): refCount(" << which->refCount << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
+   static unsigned int maxRefCount = MAX_REF_COUNT_ERROR;
+   if ((prev + 1) > maxRefCount) {
+      std::cout << "ref(" << this << "): refCount(" << (prev + 1) << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
    }
    #endif
 }
 
 inline void Referenced::unref() const
 {
-   lock(semaphore);
-   if (--refCount == 0) delete this;
-   else unlock(semaphore);
+   // Release our writes to the object; the thread that drops the last
+   // reference acquires everyone else's before deleting it.
+   #if OE_CONFIG_CHECK_REF_COUNTS
+   unsigned int prev = refCount.load(std::memory_order_relaxed);
+   do {
+      if (prev < 1) throw new ExpInvalidRefCount();
+   } while (!refCount.compare_exchange_weak(prev, prev - 1, std::memory_order_release, std::memory_order_relaxed));
+   #else
+   const unsigned int prev = refCount.fetch_sub(1, std::memory_order_release);
+   #endif
+   if (prev == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      delete this;
+   }
 }
 
 }
@@ -21,6 +21,12 @@ namespace base {
 // Slot tables are usually defined using the macros BEGIN_SLOTTABLE and
 // END_SLOTTABLE (see macros.hpp).
 //
+// Each table keeps a small hash table of its own slot names, which is built
+// by the constructor, so index() hashes the slot name once and then probes
+// this table and each base class table, instead of comparing the name with
+// each slot name.  Only our own names are hashed, because the base class
+// tables may not have been constructed yet (static initialization order).
+//
 //------------------------------------------------------------------------------
 class SlotTable
 {
@@ -43,9 +49,17 @@ public:
    const char* name(const unsigned int slotindex) const;
 
 private:
+   static unsigned int hash(const char* const slotname);
+   unsigned int index(const char* const slotname, const unsigned int h) const;
+   void buildHashTable();
+
    SlotTable* baseTable {};   // Pointer to base class's slot table
    char** slots1 {};          // Array of slot names
    unsigned int nslots1 {};   // Number of slots in table
+
+   unsigned int* hashes1 {};  // Hash of each slot name
+   unsigned int* buckets {};  // Open addressed hash table of our slot numbers, [ 1 .. nslots1 ]; zero if empty
+   unsigned int mask {};      // Hash table size minus one (power of two)
 };
 
 }
@@ -18,11 +18,52 @@ class Component;
 //    work function, userFunc(), which is called at fixed rate of 'rate' Hz
 //    until the parent component is shutdown.  A value of 1.0/rate is passed
 //    to userFunc() as the delta time parameter.
+//
+// Frame overruns:
+//
+//    A frame has overrun when userFunc() returns after the start time of the
+//    next frame.  What happens next is set by the overrun policy:
+//
+//       CATCH_UP -- (default) the late frames are run back to back, without
+//                   waiting, until we're back on the schedule.  If the max
+//                   number of catch-up frames is set (greater than zero) and
+//                   reached, we skip to the next frame start time.
+//
+//       SKIP     -- skip the missed frames; wait for the next frame start time.
+//
+//       DEGRADE  -- same as SKIP, but degradedModeChanged(true) is also called;
+//                   after 'recovery frames' frames without an overrun,
+//                   degradedModeChanged(false) is called.  Derived classes
+//                   use this to tell their parent to shed optional work.
+//
+//    If the variable delta time flag is set, the delta time passed to userFunc()
+//    after skipped frames includes the skipped frames' time.
+//
+// Frame statistics:
+//
+//    The start time jitter (how late userFunc() was called) and the overrun
+//    time of each frame are collected as statistics and as histograms of
+//    NUM_HIST_BINS bins, where bin zero is less than 10 microseconds, bin 'i'
+//    is [ 10 * 2^(i-1), 10 * 2^i ) microseconds, and the last bin is
+//    everything above (see getHistogramBinLimit()).  These are updated by the
+//    thread without locks, so other threads may see slightly stale values.
+//
+// Linux: the thread sleeps until the start of each frame using
+//    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME).  The thread can be pinned
+//    to a CPU, and its SCHED_FIFO priority (see Thread) can be set by the
+//    thread itself, which fails without the realtime privilege (warning only).
 //------------------------------------------------------------------------------
 class PeriodicTask : public Thread
 {
    DECLARE_SUBCLASS(PeriodicTask, Thread)
 
+public:
+   // Frame overrun policies
+   enum OverrunPolicy { CATCH_UP, SKIP, DEGRADE };
+
+   static const unsigned int NUM_HIST_BINS = 16;
+   static const unsigned int DEFAULT_RECOVERY_FRAMES = 50;
+
 public:
    PeriodicTask(Component* const parent, const double priority, const double rate);
 
@@ -30,29 +71,82 @@ public:
    unsigned int getTotalFrameCount() const;        // Total frame count
 
    // Busted (overrun) frames statistics; overrun frames time (seconds)
-   // (Windows only)
    const Statistic& getBustedFrameStats() const;
 
-   // Variable delta time flag (windows only).
+   // Frame start jitter statistics (seconds)
+   const Statistic& getJitterStats() const;
+
+   // Jitter and overrun histograms; returns the number of bins copied to 'bins'
+   unsigned int getJitterHistogram(unsigned int* const bins, const unsigned int n) const;
+   unsigned int getOverrunHistogram(unsigned int* const bins, const unsigned int n) const;
+   static double getHistogramBinLimit(const unsigned int bin);  // Upper limit of the bin (seconds)
+
+   unsigned int getSkippedFrameCount() const;      // Total number of skipped frames
+   void clearFrameStats();                         // Clears the statistics and histograms
+
+   // Variable delta time flag.
    // If false (default), delta time is always passed as one over the update rate;
    // If true and there's a frame overrun then a delta time adjusted for the overrun
    // is used.
    bool isVariableDeltaTimeEnabled() const;
    bool setVariableDeltaTimeFlag(const bool enable);
 
+   // Frame overrun policy (set before creating the thread)
+   OverrunPolicy getOverrunPolicy() const;
+   bool setOverrunPolicy(const OverrunPolicy p);
+
+   // Max number of back-to-back catch-up frames (CATCH_UP policy), or zero for no limit
+   unsigned int getMaxCatchUpFrames() const;
+   bool setMaxCatchUpFrames(const unsigned int n);
+
+   // Number of frames without an overrun to leave the degraded mode (DEGRADE policy)
+   unsigned int getRecoveryFrames() const;
+   bool setRecoveryFrames(const unsigned int n);
+   bool isDegraded() const;
+
+   // CPU that the thread is pinned to, or -1 for none (set before creating the thread)
+   int getCpuAffinity() const;
+   bool setCpuAffinity(const int cpu);
+
+   // Realtime (SCHED_FIFO) scheduling set by the thread (set before creating the thread)
+   bool isRealtimeEnabled() const;
+   bool setRealtimeEnabled(const bool enable);
+
    // User defined work function
    private: virtual unsigned long userFunc(const double dt) =0;
 
 protected:
    PeriodicTask();
 
+   // Called when entering and leaving the degraded mode (DEGRADE policy)
+   virtual void degradedModeChanged(const bool degraded);
+
 private:
    virtual unsigned long mainThreadFunc() override;
 
+   void configTiming();                                // Sets the CPU affinity and scheduling (platform)
+   void startOfFrame(const double jitter);             // Frame start time jitter (seconds)
+   unsigned int endOfFrame(const double late, const double period);  // Returns the number of frames to skip
+
    double rate {};         // Loop rate (hz); until our parent shuts down
-   Statistic bfStats {};   // Busted (overrun) frame statistics (windows only)
+   Statistic bfStats {};   // Busted (overrun) frame statistics
+   Statistic jitStats {};  // Frame start jitter statistics
    unsigned int tcnt {};   // total frame count
    bool vdtFlg {};         // Variable delta time flag
+
+   OverrunPolicy policy {CATCH_UP};                 // Frame overrun policy
+   unsigned int maxCatchUp {};                      // Max catch-up frames (zero for no limit)
+   unsigned int recoveryFrames {DEFAULT_RECOVERY_FRAMES};
+   int cpu {-1};                                    // CPU affinity (or -1)
+   bool rtFlg {};                                   // Realtime scheduling
+
+   unsigned int catchUpCnt {};                      // Current number of catch-up frames
+   unsigned int onTimeCnt {};                       // Number of frames since the last overrun
+   unsigned int skipCnt {};                         // Total number of skipped frames
+   bool degraded {};                                // In degraded mode
+
+   unsigned int jitHist[NUM_HIST_BINS] {};          // Jitter histogram
+   unsigned int ovrHist[NUM_HIST_BINS] {};          // Overrun histogram
 };
 
 }
@@ -0,0 +1,92 @@
+
+#ifndef __oe_base_WorkStealingScheduler_H__
+#define __oe_base_WorkStealingScheduler_H__
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace oe {
+namespace base {
+
+//------------------------------------------------------------------------------
+// Class: WorkStealingScheduler
+//
+// Description: Cost weighted, work-stealing scheduler used to split a set of
+//              'n' work items (e.g., players) across a group of sync task
+//              worker threads.
+//
+//    1) The parent thread calls partition() with the estimated cost of each
+//       item.  The items are cut into contiguous chunks of roughly equal cost,
+//       and each worker is given a contiguous range of chunks of roughly
+//       equal total cost.
+//
+//    2) Each worker then calls getNextChunk() until it returns false.  A
+//       worker first pops chunks from the front of its own range and, once
+//       its range is empty, steals chunks from the back of the other workers'
+//       ranges.  All operations are lock-free.
+//
+//    3) partition() must not be called while any worker is still inside
+//       getNextChunk() (i.e., call it only between the sync task barriers).
+//
+// Example:
+//    // parent thread
+//    scheduler.partition(costs, n, numWorkers);
+//    ... start the workers ...
+//
+//    // worker 'w'
+//    unsigned int b = 0, e = 0;
+//    while (scheduler.getNextChunk(w, &b, &e)) {
+//       for (unsigned int i = b; i < e; i++) process(i);
+//    }
+//------------------------------------------------------------------------------
+class WorkStealingScheduler
+{
+public:
+   static const unsigned int MAX_WORKERS = 32;       // Max number of workers
+   static const unsigned int CHUNKS_PER_WORKER = 8;  // Target number of chunks per worker
+
+public:
+   WorkStealingScheduler() = default;
+   WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+   WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+   unsigned int getNumWorkers() const       { return numWorkers; }
+   unsigned int getNumChunks() const        { return numChunks; }
+   unsigned int getNumSteals() const        { return steals.load(std::memory_order_relaxed); }
+
+   // Splits items [ 0 .. n-1 ] into cost-weighted chunks for 'nw' workers.
+   // The 'costs' array holds the estimated cost of each item (any units),
+   // or nullptr to use equal costs.
+   void partition(const double* const costs, const unsigned int n, const unsigned int nw);
+
+   // Gets the next chunk of items, [ begin .. end ), for worker 'w' [ 0 .. nw-1 ];
+   // returns false when there are no more chunks to process.
+   bool getNextChunk(const unsigned int w, unsigned int* const begin, unsigned int* const end);
+
+private:
+   // Packed [ head, tail ) range of chunk indexes; head in the low 32 bits
+   static unsigned long long pack(const unsigned int h, const unsigned int t) {
+      return (static_cast<unsigned long long>(t) << 32) | h;
+   }
+
+   bool popOwn(const unsigned int w, unsigned int* const c);
+   bool steal(const unsigned int v, unsigned int* const c);
+
+   // Worker's range of chunks; padded to a cache line to avoid false sharing
+   struct Range {
+      std::atomic<unsigned long long> ht {};
+      char pad[64 - sizeof(std::atomic<unsigned long long>)];
+   };
+
+   std::array<Range, MAX_WORKERS> ranges;     // Worker chunk ranges
+   std::vector<unsigned int> chunkStart;      // Chunk 'c' is items [ chunkStart[c] .. chunkStart[c+1] )
+   unsigned int numChunks {};                 // Number of chunks
+   unsigned int numWorkers {};                // Number of workers
+   std::atomic<unsigned int> steals {};       // Number of chunks stolen since the last partition()
+};
+
+}
+}
+
+#endif
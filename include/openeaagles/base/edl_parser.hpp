@@ -21,6 +21,20 @@ typedef Object* (*factory_func)(const std::string& name);
 //
 extern Object* edl_parser(const std::string& filename, factory_func f, unsigned int* num_errors = nullptr);
 
+//
+// edl_parser( text filename to parse, user supplied factory function to create objects,
+//             compiled EDL filename, pointer to variable for num of errors found )
+//
+// Same as above, but with a compiled (binary) EDL file, 'cache_filename', which
+// holds the parsed EDL with the slot names resolved to slot numbers.  If the
+// compiled file is from the same EDL text (same size and hash) then the objects
+// are built from it, which skips the scanning, parsing and slot name searches;
+// otherwise the EDL file is parsed and, if there were no errors, the compiled
+// file is (re)written.
+//
+extern Object* edl_parser(const std::string& filename, factory_func f, const std::string& cache_filename,
+                          unsigned int* num_errors = nullptr);
+
 }
 }
 
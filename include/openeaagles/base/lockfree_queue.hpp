@@ -0,0 +1,135 @@
+
+#ifndef __oe_base_lockfree_queue_H__
+#define __oe_base_lockfree_queue_H__
+
+#include <atomic>
+
+namespace oe {
+namespace base {
+
+//------------------------------------------------------------------------------
+// Template: lockfree_queue<T>
+//
+// Description: Bounded, lock-free, multiple producer/multiple consumer queue
+//              of items of type T (a ring buffer of sequenced cells).
+//
+// Notes:
+//    1) Use the constructor's 'qsize' parameter to set the max size of the
+//       queue, which is rounded up to a power of two.
+//    2) Use put() to add items and get() to remove items; put() returns false
+//       if the queue is full, and get() returns zero if the queue is empty.
+//    3) No locks are used, so a producer or consumer thread is never blocked
+//       by another thread.
+//    4) entries() is only a snapshot while other threads are using the queue.
+//
+// Examples:
+//    base::lockfree_queue<Foo*>* q1 = new base::lockfree_queue<Foo*>(1024);
+//    q1->put(p1);          // puts p1 on the queue
+//    Foo* p = q1->get();   // p is equal to p1
+//------------------------------------------------------------------------------
+template <class T> class lockfree_queue
+{
+public:
+   lockfree_queue(const unsigned int qsize) {
+      SIZE = 2;
+      while (SIZE < qsize) SIZE *= 2;
+      cells = new Cell[SIZE];
+      for (unsigned int i = 0; i < SIZE; i++) {
+         cells[i].seq.store(i, std::memory_order_relaxed);
+      }
+   }
+   lockfree_queue(const lockfree_queue<T>&) = delete;
+   lockfree_queue<T>& operator=(const lockfree_queue<T>&) = delete;
+   ~lockfree_queue()                 { delete[] cells; }
+
+   unsigned int getSize() const      { return SIZE; }
+   bool isEmpty() const              { return (entries() == 0); }
+   bool isFull() const               { return (entries() >= SIZE); }
+
+   unsigned int entries() const {
+      const unsigned int d = deqPos.load(std::memory_order_relaxed);
+      const unsigned int e = enqPos.load(std::memory_order_relaxed);
+      const int n = static_cast<int>(e - d);
+      return (n > 0 ? static_cast<unsigned int>(n) : 0);
+   }
+
+   // Puts an item at the back of the queue; returns false if the queue is full
+   bool put(T item) {
+      bool ok = false;
+      bool finished = false;
+      unsigned int pos = enqPos.load(std::memory_order_relaxed);
+      while (!finished) {
+         Cell& cell = cells[pos & (SIZE - 1)];
+         const unsigned int seq = cell.seq.load(std::memory_order_acquire);
+         const int dif = static_cast<int>(seq - pos);
+         if (dif == 0) {
+            // Cell is free; claim it
+            if (enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               cell.data = item;
+               cell.seq.store(pos + 1, std::memory_order_release);
+               ok = true;
+               finished = true;
+            }
+         }
+         else if (dif < 0) {
+            // Queue is full
+            finished = true;
+         }
+         else {
+            // Another producer claimed the cell
+            pos = enqPos.load(std::memory_order_relaxed);
+         }
+      }
+      return ok;
+   }
+
+   // Gets an item from the front of the queue; returns zero if the queue is empty
+   T get() {
+      T p = 0;
+      bool finished = false;
+      unsigned int pos = deqPos.load(std::memory_order_relaxed);
+      while (!finished) {
+         Cell& cell = cells[pos & (SIZE - 1)];
+         const unsigned int seq = cell.seq.load(std::memory_order_acquire);
+         const int dif = static_cast<int>(seq - (pos + 1));
+         if (dif == 0) {
+            // Cell is full; take it
+            if (deqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               p = cell.data;
+               cell.seq.store(pos + SIZE, std::memory_order_release);
+               finished = true;
+            }
+         }
+         else if (dif < 0) {
+            // Queue is empty
+            finished = true;
+         }
+         else {
+            // Another consumer took the cell
+            pos = deqPos.load(std::memory_order_relaxed);
+         }
+      }
+      return p;
+   }
+
+private:
+   struct Cell {
+      std::atomic<unsigned int> seq {};
+      T data {};
+   };
+
+   Cell* cells {};                          // The ring buffer
+   unsigned int SIZE {};                    // Max size of the queue (power of two)
+
+   // Put and get positions (on separate cache lines)
+   char pad0[64] {};
+   std::atomic<unsigned int> enqPos {};
+   char pad1[64 - sizeof(std::atomic<unsigned int>)] {};
+   std::atomic<unsigned int> deqPos {};
+   char pad2[64 - sizeof(std::atomic<unsigned int>)] {};
+};
+
+}
+}
+
+#endif
@@ -340,9 +340,9 @@
 
 
 #define ON_SLOT(idx,setFunc,ObjType)                                                   \
-    if ( !_ok ) {                                                                      \
+    if ( !_ok && idx == _n1 ) {                                                        \
         const auto _msg = dynamic_cast<ObjType*>(obj);                                 \
-        if (idx == _n1 && _msg != nullptr) {                                           \
+        if (_msg != nullptr) {                                                         \
             _ok = setFunc(_msg);                                                       \
         }                                                                              \
     }
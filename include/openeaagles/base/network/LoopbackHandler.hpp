@@ -0,0 +1,96 @@
+
+#ifndef __oe_base_LoopbackHandler_H__
+#define __oe_base_LoopbackHandler_H__
+
+#include "openeaagles/base/network/NetHandler.hpp"
+
+namespace oe {
+namespace base {
+
+class Number;
+
+//------------------------------------------------------------------------------
+// Class: LoopbackHandler
+//
+// Description: In-process (loopback) network handler.  The packets that are
+//              sent by a handler are received by the handlers of the same
+//              channel, within the same process, without using any sockets
+//              (e.g., to feed a NetIO from a traffic generator for load testing).
+//
+//    Each channel is a bounded queue of packets, which is shared by all of the
+//    channel's handlers, and each packet is received by only one handler.  A
+//    packet that is sent while the channel's queue is full is dropped.
+//
+// Factory name: LoopbackHandler
+//
+// Slots:
+//    channel     <Number>    ! Channel number [ 0 .. MAX_CHANNELS-1 ] (default: 0)
+//    maxPackets  <Number>    ! Max number of queued packets (default: 65536)
+//                            ! (set by the first of the channel's handlers to be initialized)
+//
+// Input File Example:
+//
+//        ( LoopbackHandler
+//           channel: 1
+//           maxPackets: 20000
+//        )
+//
+// Notes:
+//    1) The I/O is always unblocked (no wait): recvData() returns zero
+//       when the channel's queue is empty.  Use waitForData() to wait for
+//       a packet.
+//
+//    2) The channel's queue is locked, so the handlers of a channel can
+//       be used by different threads (e.g., one sender and one receiver).
+//------------------------------------------------------------------------------
+class LoopbackHandler : public NetHandler
+{
+   DECLARE_SUBCLASS(LoopbackHandler, NetHandler)
+
+public:
+   static const unsigned int MAX_CHANNELS = 16;
+   static const unsigned int DEFAULT_MAX_PACKETS = 65536;
+
+public:
+   LoopbackHandler();
+
+   unsigned int getChannel() const                    { return channel; }
+
+   unsigned int getNumQueued() const;                 // Number of packets on our channel's queue
+   unsigned long long getNumSent() const;             // Number of packets queued on our channel
+   unsigned long long getNumDropped() const;          // Number of packets dropped by our channel (queue full)
+
+   virtual bool isConnected() const override;
+   virtual bool closeConnection() override;
+   virtual bool sendData(const char* const packet, const int size) override;
+   virtual unsigned int recvData(char* const packet, const int maxSize) override;
+   virtual unsigned int sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n) override;
+   virtual unsigned int recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes = nullptr) override;
+   virtual bool waitForData(const double timeout) override;
+   virtual bool setBlocked() override;
+   virtual bool setNoWait() override;
+
+   // Slot functions
+   virtual bool setSlotChannel(const Number* const msg);
+   virtual bool setSlotMaxPackets(const Number* const msg);
+
+protected:
+   virtual bool init() override;
+
+private:
+   struct Channel;
+   static Channel channels[MAX_CHANNELS];
+
+   bool put(Channel* const ch, const char* const packet, const int size);
+   unsigned int get(Channel* const ch, char* const packet, const int maxSize);
+   static void notify(Channel* const ch);
+
+   unsigned int channel {};                        // Channel number
+   unsigned int maxPackets {DEFAULT_MAX_PACKETS};  // Max number of queued packets
+   bool connected {};                              // Initialized
+};
+
+}
+}
+
+#endif
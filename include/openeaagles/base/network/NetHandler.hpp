@@ -54,6 +54,24 @@ public:
    // the actual number of bytes received.
    virtual unsigned int recvData(char* const packet, const int maxSize) =0;
 
+   // Sends 'n' packets: packet 'i' is 'sizes[i]' bytes from 'packets[i]'.
+   // Returns the number of packets sent.  The default sends the packets
+   // one at a time using sendData().
+   virtual unsigned int sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n);
+
+   // Receives up to 'n' packets: packet 'i' is received into 'buffer' at
+   // offset 'i * maxSize' (a maximum of 'maxSize' bytes each), and its size
+   // is returned in 'sizes[i]' (optional).  Returns the number of packets
+   // received.  The default receives the packets one at a time using
+   // recvData() until there are no more packets (or 'n' packets).
+   virtual unsigned int recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes = nullptr);
+
+   // Waits up to 'timeout' seconds for a packet to receive, and returns true
+   // if one may be waiting (e.g., for a receiver thread, which needs to check
+   // for a stop request now and then).  The default, for handlers that can't
+   // wait, sleeps for up to a millisecond and returns true.
+   virtual bool waitForData(const double timeout);
+
    // Set our socket for blocked (wait) I/O
    virtual bool setBlocked() =0;
 
@@ -56,6 +56,11 @@ class String;
 //
 // Notes:
 //
+// On Linux, sendDataBatch() and recvDataBatch() use sendmmsg() and recvmmsg()
+// to send or receive up to MAX_BATCH packets with a single system call;
+// other platforms use the NetHandler defaults (one packet at a time).
+// waitForData() uses select() on the socket.
+//
 // M$ WinSock has slightly different return types, some different calling, and
 // is missing some of the calls that are standard in Berkeley and POSIX socket
 // implementation.  These slight differences will be handled in setting basic
@@ -68,6 +73,9 @@ class PosixHandler : public NetHandler
 {
    DECLARE_SUBCLASS(PosixHandler, NetHandler)
 
+public:
+   static const unsigned int MAX_BATCH = 64;    // Max packets per sendmmsg()/recvmmsg() call
+
 public:
    PosixHandler();
 
@@ -86,10 +94,13 @@ public:
    virtual bool closeConnection() override;
    virtual bool sendData(const char* const packet, const int size) override;
    virtual unsigned int recvData(char* const packet, const int maxSize) override;
+   virtual unsigned int sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n) override;
+   virtual unsigned int recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes = nullptr) override;
+   virtual bool waitForData(const double timeout) override;
    virtual bool setBlocked() override;
    virtual bool setNoWait() override;
 
-   // Last recvData() origin IP and port
+   // Last recvData() (or last packet of recvDataBatch()) origin IP and port
    uint32_t getLastFromAddr() const;     // IP address of last valid recvData()
    uint16_t getLastFromPort() const;     // Port address of last valid recvData()
 
@@ -25,6 +25,8 @@ public:
 
    virtual bool sendData(const char* const packet, const int size) override;
    virtual unsigned int recvData(char* const packet, const int maxSize) override;
+   virtual unsigned int sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n) override;
+   virtual unsigned int recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes = nullptr) override;
    virtual bool isConnected() const override;
    virtual bool closeConnection() override;
 
@@ -171,6 +171,23 @@ void pow10Array(const float*  const src, float*  const dst, const unsigned int n
 void multArrayConst(const double* const src, const double c, double* const dst, const unsigned int n);
 void multArrayConst(const float* const src, const float c, double* const dst, const unsigned int n);
 
+// Computes the lengths of 'n' 3D vectors, which are stored as component arrays
+void lengthArray(const double* const x, const double* const y, const double* const z, double* const lengths, const unsigned int n);
+
+// Normalizes, in place, 'n' 3D vectors, which are stored as component arrays,
+// and returns their lengths (same as Vec3d::normalize())
+void normalizeArray(double* const x, double* const y, double* const z, double* const lengths, const unsigned int n);
+
+// Computes the dot products of two arrays of 'n' 3D vectors, which are stored as component arrays
+void dotArray(
+      const double* const ax, const double* const ay, const double* const az,
+      const double* const bx, const double* const by, const double* const bz,
+      double* const dst, const unsigned int n);
+
+// Note: sqrtArray(), multArrayConst(), lengthArray(), normalizeArray() and
+// dotArray() use SSE2/AVX (selected at run time) on x86 processors; their
+// results are identical to the scalar code.
+
 }
 }
 
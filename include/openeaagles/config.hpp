@@ -55,4 +55,13 @@
 #define OE_CONFIG_MAX_NETIO_NEW_OUTGOING   150
 #endif
 
+// Reference count checking (see Referenced.hpp); on by default for debug builds
+#ifndef OE_CONFIG_CHECK_REF_COUNTS
+  #ifdef NDEBUG
+    #define OE_CONFIG_CHECK_REF_COUNTS     0
+  #else
+    #define OE_CONFIG_CHECK_REF_COUNTS     1
+  #endif
+#endif
+
 #endif
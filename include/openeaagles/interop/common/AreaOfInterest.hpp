@@ -0,0 +1,112 @@
+
+#ifndef __oe_interop_AreaOfInterest_H__
+#define __oe_interop_AreaOfInterest_H__
+
+#include "openeaagles/base/osg/Vec3d"
+
+#include <unordered_map>
+#include <vector>
+
+namespace oe {
+namespace base { class PairStream; }
+namespace interop {
+
+//------------------------------------------------------------------------------
+// Class: AreaOfInterest
+//
+// Description: Interest management of the incoming entities.  Keeps a coarse
+//              uniform grid of the geocentric (ECEF) positions of our active
+//              local players, which is used to filter the state updates of new
+//              remote entities, before their NIBs and IPlayers are created.
+//
+//    The grid is rebuilt from the simulation's player list by rebuild(), once
+//    per network input frame, and isInterested() checks if an entity is within
+//    range of any of our local players.  The cell size should be about the max
+//    entity range, so a check looks up only a few cells.
+//
+//    The entities that were filtered are remembered (filtered()) until they're
+//    admitted (admitted()) or until they've timed out (expire()), which is used
+//    to count the filtered, admitted and promoted (i.e., admitted after being
+//    filtered) entities.
+//
+// Notes:
+//    1) If there are no active local players then all entities are of interest.
+//
+//    2) Only new entities are filtered.  A filtered entity is not deferred; it's
+//       promoted by its next state update that's within range, so the caller
+//       should pad the range by how far the entity could move before its next
+//       update (e.g., its speed times the max DR time).
+//
+//    3) Used only by the network input thread; it's not locked.
+//------------------------------------------------------------------------------
+class AreaOfInterest
+{
+public:
+   static const double DEFAULT_CELL_SIZE;    // Default grid cell size (meters)
+   static const double MIN_CELL_SIZE;        // Minimum grid cell size (meters)
+
+public:
+   AreaOfInterest() = default;
+   AreaOfInterest(const AreaOfInterest&) = delete;
+   AreaOfInterest& operator=(const AreaOfInterest&) = delete;
+
+   double getCellSize() const                      { return cellSize; }
+   bool setCellSize(const double meters);
+
+   // Rebuilds the grid from the active local players of the player list
+   void rebuild(const base::PairStream* const players);
+
+   // Number of local players in the grid
+   unsigned int getNumLocalPlayers() const         { return static_cast<unsigned int>(items.size()); }
+
+   // True if position 'p' (ECEF) is within 'range' meters of one of
+   // our local players, or if there are no local players
+   bool isInterested(const base::Vec3d& p, const double range) const;
+
+   // Entity 'id' was filtered at 'time' (seconds); it's forgotten
+   // if it's not filtered again within 'timeout' seconds
+   void filtered(const unsigned long long id, const double time, const double timeout);
+
+   // Entity 'id' was admitted (i.e., its NIB was created)
+   void admitted(const unsigned long long id);
+
+   // Forgets the filtered entities that have timed out at 'time' (seconds)
+   void expire(const double time);
+
+   // Forgets all filtered entities and clears the counters
+   void reset();
+
+   unsigned int getNumFilteredEntities() const     { return static_cast<unsigned int>(filteredTable.size()); }
+   unsigned long long getFilteredCount() const     { return nFilteredUpdates; }   // Number of filtered updates
+   unsigned long long getAdmittedCount() const     { return nAdmitted; }          // Number of admitted entities
+   unsigned long long getPromotedCount() const     { return nPromoted; }          // Number of admitted entities that were filtered
+
+private:
+   static unsigned long long cellKey(const int ix, const int iy, const int iz);
+   int cellCoord(const double v) const;
+
+   double cellSize {DEFAULT_CELL_SIZE};   // Grid cell size (meters)
+
+   // Grid of cells; each cell holds its local players' positions
+   std::unordered_map<unsigned long long, unsigned int> cells;  // Cell key to cell index
+   std::vector<int> cx, cy, cz;                                 // Cell coordinates
+   std::vector<unsigned int> start;                             // Cell 'c' items are [ start[c] .. start[c+1] )
+   std::vector<base::Vec3d> items;                              // Positions (ECEF)
+
+   // rebuild() work arrays
+   std::vector<base::Vec3d> pos;
+   std::vector<unsigned int> cellOf;
+
+   // Filtered entities: entity ID to the time that it's forgotten (seconds)
+   std::unordered_map<unsigned long long, double> filteredTable;
+   double nextExpire {};                  // Time of the next expire() check (seconds)
+
+   unsigned long long nFilteredUpdates {};   // Number of filtered updates
+   unsigned long long nAdmitted {};          // Number of admitted entities
+   unsigned long long nPromoted {};          // Number of admitted entities that were filtered
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,140 @@
+
+#ifndef __oe_interop_DrEngine_H__
+#define __oe_interop_DrEngine_H__
+
+#include "openeaagles/base/osg/Vec3d"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace oe {
+namespace interop {
+
+//------------------------------------------------------------------------------
+// Class: DrEngine
+//
+// Description: Batched dead reckoning (DR) of the incoming entities' positions.
+//              The DR positions of all of the input NIBs of a NetIO are computed
+//              in one pass, once per time-critical frame, before the IPlayers'
+//              dynamics.  Each NIB then takes its position from the engine,
+//              instead of computing it in Nib::updateDeadReckoning().
+//
+//    The entities' DR data are kept in component arrays (one array per vector
+//    component), in fixed size blocks, and each block is updated by a single
+//    branch free loop, which is vectorized.  The blocks are grouped by the DR
+//    algorithm's position kernel:
+//
+//       FIRST_ORDER    P0 + V0*T                   (FPW_DRM and RPW_DRM)
+//       SECOND_ORDER   P0 + V0*T + A0*(0.5*T*T)    (FVW_DRM and RVW_DRM)
+//
+//    The operations and their order are the same as Nib::mainDeadReckoning(),
+//    so the positions are bit for bit the same.  The other (body axis, static
+//    and user defined) algorithms are not batched.
+//
+//    The NIB's slot handle is from allocate() and is freed by release().  Use
+//    set() when the NIB's DR is reset and update() when the NIB updates its DR
+//    time.  A position is used by update() only if it was computed by advance()
+//    for the NIB's new DR time, and the slot hasn't changed since.
+//
+// Notes:
+//    1) Slots are allocated, released and set by the network thread (new and
+//       updated entities) and by the thread that deletes the NIB, while
+//       advance() and update() are called by the time-critical thread(s),
+//       with advance() before the frame's update()s.  The blocks are never
+//       moved or freed until the engine is deleted.
+//
+//       Each slot has a sequence number, which is odd while the slot is being
+//       changed by set(), update() or release() (they also use it to exclude
+//       each other), and is incremented by each change.  advance() doesn't
+//       lock; it saves the slots' sequence numbers before it reads their data,
+//       and update() only uses a position if its slot's sequence number is
+//       still the same (i.e., the data weren't changed during or after the
+//       advance()).  Only allocate() and release() lock the free slot lists.
+//
+//    2) Each kernel has a max of MAX_BLOCKS * BLOCK_SIZE slots.  A NIB without
+//       a slot (e.g., allocate() returns -1) uses Nib::mainDeadReckoning().
+//------------------------------------------------------------------------------
+class DrEngine
+{
+public:
+   // Position kernels
+   enum Kernel { FIRST_ORDER, SECOND_ORDER, NUM_KERNELS };
+
+   static const unsigned int BLOCK_SIZE = 64;   // Slots per block
+   static const unsigned int MAX_BLOCKS = 1024; // Max blocks per kernel
+
+public:
+   DrEngine() = default;
+   DrEngine(const DrEngine&) = delete;
+   DrEngine& operator=(const DrEngine&) = delete;
+   ~DrEngine();
+
+   // Allocates a slot for the kernel; returns the slot handle, or -1
+   int allocate(const Kernel k);
+
+   // Releases a slot
+   void release(const int h);
+
+   // Kernel of a slot handle
+   static Kernel getKernel(const int h)         { return static_cast<Kernel>(h / (MAX_BLOCKS * BLOCK_SIZE)); }
+
+   // Sets the DR data @ T0 and the DR time of a slot
+   void set(
+      const int h,                  // Slot handle
+      const base::Vec3d& p,         // Position vector @ T0 (meters) (ECEF)
+      const base::Vec3d& v,         // Velocity vector @ T0 (m/sec) (ECEF)
+      const base::Vec3d& a,         // Acceleration vector @ T0 ((m/sec)/sec) (ECEF)
+      const double time             // DR time (sec)
+   );
+
+   // Sets the slot's DR time to 'time', which is its previous DR time plus the
+   // players' delta time, and returns the position at 'time', if it was computed
+   // by advance(); returns false if the position wasn't computed.
+   bool update(
+      const int h,                  // Slot handle
+      const double time,            // New DR time (sec)
+      base::Vec3d* const pNewPos    // New DR position (meters) (ECEF)
+   );
+
+   // Computes the positions of all slots at their DR time plus 'dt', which
+   // should be the delta time that the players will dead reckon with
+   void advance(const double dt);
+
+   // Number of allocated slots
+   unsigned int getNumSlots() const             { return nSlots; }
+
+private:
+   // Block of slots: component arrays
+   struct Block {
+      std::array<double, BLOCK_SIZE> p0x {}, p0y {}, p0z {};   // Position vectors @ T0 (meters)
+      std::array<double, BLOCK_SIZE> v0x {}, v0y {}, v0z {};   // Velocity vectors @ T0 (m/sec)
+      std::array<double, BLOCK_SIZE> a0x {}, a0y {}, a0z {};   // Acceleration vectors @ T0 ((m/sec)/sec)
+      std::array<double, BLOCK_SIZE> t {};                     // DR times (sec)
+      std::array<double, BLOCK_SIZE> px {}, py {}, pz {};      // Computed DR positions (meters)
+      std::array<double, BLOCK_SIZE> pt {};                    // DR times of the computed positions (sec)
+      std::array<unsigned int, BLOCK_SIZE> pseq {};            // Sequence numbers used by the computed positions
+      std::array<std::atomic<unsigned int>, BLOCK_SIZE> seq {}; // Sequence numbers (odd while changing)
+
+      void firstOrder(const double dt);
+      void secondOrder(const double dt);
+      void saveSequence();
+   };
+
+   Block* getBlock(const int h, unsigned int* const idx) const;
+
+   static unsigned int lockSlot(Block* const blk, const unsigned int i);
+   static void unlockSlot(Block* const blk, const unsigned int i, const unsigned int s);
+
+   std::array<std::array<Block*, MAX_BLOCKS>, NUM_KERNELS> blocks {};   // Blocks by kernel
+   std::array<std::atomic<unsigned int>, NUM_KERNELS> nBlocks {};      // Number of blocks by kernel
+   std::array<std::vector<int>, NUM_KERNELS> freeSlots;                // Free slots by kernel
+   std::atomic<unsigned int> nSlots {};  // Number of allocated slots
+
+   long slotLock {};                   // Semaphore for the free slot lists (allocate() and release())
+};
+
+}
+}
+
+#endif
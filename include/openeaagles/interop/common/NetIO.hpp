@@ -3,9 +3,13 @@
 #define __oe_interop_common_NetIO_H__
 
 #include "openeaagles/simulation/AbstractNetIO.hpp"
+#include "openeaagles/interop/common/NibTable.hpp"
+#include "openeaagles/interop/common/DrEngine.hpp"
+#include "openeaagles/simulation/PlayerEvents.hpp"
 
 #include "openeaagles/base/String.hpp"
 #include <array>
+#include <vector>
 
 namespace oe {
 namespace base { class Angle; class Distance; class Identifier; class String; class Time; }
@@ -91,6 +95,11 @@ class Ntm;
 //    slot, which defaults to zero or no range filtering.  Currently, this
 //    applies only to new entities; existing IPlayers are not filtered.
 //
+//    The positions of the incoming entities that use the world coordinate
+//    DR algorithms are dead reckoned in one pass by our DR engine (DrEngine),
+//    which is advanced by deadReckoningFrame() (see Station::updateTC()) using
+//    the IPlayers' delta time.
+//
 // Outgoing entities:
 //
 //    Use the 'enableOutput' slot to enable or disable the sending of our
@@ -108,6 +117,13 @@ class Ntm;
 //    manage the flow of data from the oe player to the network entity.
 //    The outgoing Nib objects are managed using the "output Nib" list.
 //
+//    The output list is kept up to date using the simulation's player events
+//    (see simulation::PlayerEvents), so only the players that were added,
+//    removed or changed are checked each frame.  The whole player list is
+//    scanned on the first frame, and again whenever any of the player events
+//    have been lost.  No more than MAX_NEW_OUTGOING output NIBs are created
+//    per frame; the other players wait for the following frames.
+//
 //    The oe player objects do not contain any state data related to the
 //    interoperability networks that their being sent to.  As a result, an
 //    oe player can be sent to more than one interoperability network,
@@ -168,6 +184,9 @@ public:
    // Updates the 'output' side of the network
    virtual void outputFrame(const double dt) override;
 
+   // Dead reckons the incoming entities (see DrEngine)
+   virtual void deadReckoningFrame(const double dt) override;
+
    // Network ID number
    unsigned short getNetworkID() const override { return netID; }
 
@@ -284,7 +303,7 @@ public:
    virtual Nib* findNib(const unsigned short playerID, const base::String* const federateName, const IoType ioType);
    virtual Nib* findNib(const models::Player* const player, const IoType ioType);
    virtual bool addNibToList(Nib* const nib, const IoType ioType);
-   virtual void removeNibFromList(Nib* const nib, const IoType ioType);
+   virtual void removeNibFromList(Nib* const nib, const IoType ioType);   // (the list is compacted by the next input or output frame)
 
    // More NIB support
    virtual Nib* createNewInputNib();
@@ -293,8 +312,11 @@ public:
    virtual void destroyOutputNib(Nib* const nib);
    virtual bool addNib2InputList(Nib* const nib);
 
+   // Dead reckoning engine of the input NIBs
+   DrEngine* getDrEngine()                                { return &drEngine; }
+
 protected:
-   // Maximum number of active objects
+   // Maximum number of active objects (the NIB input and output lists are not limited)
    static const int MAX_OBJECTS = OE_CONFIG_MAX_NETIO_ENTITIES;
 
    // Create NIB unique to protocol (pure functions!)
@@ -306,42 +328,44 @@ protected:
 
    // Number of NIBs on the input list
    unsigned int getInputListSize() const {
-      return nInNibs;
+      return inputTable.size();
    }
 
-   // Returns the idx'th NIB from the input list
+   // Returns the idx'th NIB from the input list, or null for an entry
+   // removed by removeNibFromList() (until the next input frame)
    Nib* getInputNib(const unsigned int idx) {
-      return (idx < nInNibs) ? inputList[idx] : 0;
+      return inputTable.get(idx);
    }
 
-   // Returns the idx'th NIB from the input list (const version)
+   // Returns the idx'th NIB from the input list, or null (const version)
    const Nib* getInputNib(const unsigned int idx) const  {
-      return (idx < nInNibs) ? inputList[idx] : 0;
+      return inputTable.get(idx);
    }
 
    // Returns the input list
    Nib** getInputList() {
-      return inputList.data();
+      return inputTable.data();
    }
 
    // Number of NIBs on the output list
    unsigned int getOutputListSize() const {
-      return nOutNibs;
+      return outputTable.size();
    }
 
    // Returns the input list
    Nib** getOutputList() {
-      return outputList.data();
+      return outputTable.data();
    }
 
-   // Returns the idx'th NIB from the output list
+   // Returns the idx'th NIB from the output list, or null for an entry
+   // removed by removeNibFromList() (until the next output frame)
    Nib* getOutputNib(const unsigned int idx) {
-      return (idx < nOutNibs) ? outputList[idx] : 0;
+      return outputTable.get(idx);
    }
 
-   // Returns the idx'th NIB from the output list (const version)
+   // Returns the idx'th NIB from the output list, or null (const version)
    const Nib* getOutputNib(const unsigned int idx) const {
-      return (idx < nOutNibs) ? outputList[idx] : 0;
+      return outputTable.get(idx);
    }
 
 
@@ -410,6 +434,11 @@ protected:
 //------------------------------------------------------------------------------
 private:
    void updateOutputList();                             // Update the Output-List from the simulation player list (Background thread)
+   void scanOutputList();                               // Update the Output-List by scanning the player list
+   bool processPlayerEvents();                          // Update the Output-List from the player events; false if events were lost
+   void checkOutputPlayer(models::Player* const player);      // Check a player's output NIB
+   bool isOutputPlayer(const models::Player* const player) const;  // Should the player have an output NIB?
+   void clearNewOutputPlayers();                        // Clear the players waiting for an output NIB
    void cleanupInputList();                             // Clean-up the Input-List (remove out of date items)
 
    // Network Model IDs
@@ -441,25 +470,19 @@ private:
    double maxAge {};             // Maximum age of networked players (seconds)
 
 private: // Nib related private
-   // input tables
-   std::array<Nib*, MAX_OBJECTS> inputList {};  // Table of input objects in name order
-   unsigned int nInNibs {};                    // Number of input objects in both tables
-
-   // output tables
-   std::array<Nib*, MAX_OBJECTS> outputList {}; // Table of output objects in name order
-   unsigned int nOutNibs {};                   // Number of output objects in both tables
-
-   // NIB quick lookup key
-   struct NibKey {
-      NibKey(const unsigned short playerId, const base::String* const federateName): id(playerId), fName(federateName) {}
-      // NIB IDs  -- Comparisons in this order --
-      unsigned short id {};                        // Player id
-      base::safe_ptr<const base::String> fName;    // Federate name
-   };
-
-   // Search callbacks: object name compare function --
-   //   True types are (const NibKey* key, const Nib** nib)
-   static int compareKey2Nib(const void* key, const void* nib);
+   // Input and output lists: NIBs in the order added, hashed by player ID and federate name
+   NibTable inputTable;
+   NibTable outputTable;
+
+   // Output list updates from the simulation's player events
+   unsigned long long playerEventSeq {};                         // Sequence number of our next player event
+   std::vector<simulation::PlayerEvents::Event> playerEvents;    // Player events being processed
+   std::vector<models::Player*> newOutputPlayers;                // Players waiting for an output NIB (ref()'d)
+   bool outputScanReq {true};                                    // Scan the player list
+   std::vector<Nib*> outputDeletes;                              // Output NIBs set to DELETE_REQUEST (not ref()'d)
+
+   // Batched dead reckoning of the input NIBs
+   DrEngine drEngine;
 
 private:  // Ntm related private
    static const unsigned int MAX_ENTITY_TYPES = OE_CONFIG_MAX_NETIO_ENTITY_TYPES;
@@ -35,6 +35,11 @@ namespace interop {
 //    is common data used by most interoperability network entities.  Additional
 //    entity data is added by the network specific classes derived from Nib.
 //
+//    The DR positions of the input NIBs that use the world coordinate DR
+//    algorithms (FPW, RPW, RVW and FVW) are computed in one pass by the NetIO's
+//    DR engine (see DrEngine), and their DR angles are fixed when there's no
+//    rotation; the other input NIBs use mainDeadReckoning().
+//
 // Factory name: Nib
 //
 //------------------------------------------------------------------------------
@@ -274,6 +279,8 @@ private:
 
 private:
    void initData();
+   void updateDrSlot();                // Updates our DR engine slot (input NIBs)
+   void releaseDrSlot();               // Releases our DR engine slot
 
    NetIO::IoType ioType;               // Input/Output direction of this NIB
 
@@ -319,6 +326,11 @@ private:
    base::Vec3d drPos;                  // Current DR position vector (meters) (ECEF)
    base::Vec3d drAngles;               // Current DR angles (rad) [ roll pitch yaw ] (Body/ECEF)
 
+   // Batched DR (incoming only; see DrEngine)
+   int drSlot {-1};                    // DR engine slot handle (or -1)
+   bool drFixedAnglesFlg {};           // DR angles are fixed (no rotation)
+   base::Vec3d drFixedAngles;          // Fixed DR angles (rad) [ roll pitch yaw ] (Body/ECEF)
+
    // DR smoothing data
    base::Vec3d smoothVel;              // Smoothing Velocity (meters/second) (ECEF)
    double smoothTime {};               // Smoothing Time
@@ -0,0 +1,96 @@
+
+#ifndef __oe_interop_NibTable_H__
+#define __oe_interop_NibTable_H__
+
+#include <vector>
+
+namespace oe {
+namespace base { class String; }
+namespace interop {
+class Nib;
+
+//------------------------------------------------------------------------------
+// Class: NibTable
+//
+// Description: Table of Network Interface Blocks (NIBs) used by NetIO for its
+//              input and output lists.  The NIBs are kept in a contiguous
+//              array, in the order they were added, and are indexed by an
+//              open-addressing hash table keyed on the NIB's player ID and
+//              federate name (e.g., DIS site and application IDs).
+//
+// Notes:
+//    1) The table holds a reference (ref()) to each of its NIBs.
+//
+//    2) The table grows as needed; there is no fixed limit on its size.
+//
+//    3) The iteration order is stable: removing NIBs does not change the
+//       order of the remaining NIBs.
+//
+//    4) detach() and remove() leave an empty (null) entry on the list, which
+//       get() returns as a null NIB, until the next compact().  To remove
+//       several NIBs in one pass, detach() or remove() each NIB, then
+//       compact() the list once.
+//
+//    5) A NIB's player ID and federate name must not change while the NIB
+//       is in the table.
+//------------------------------------------------------------------------------
+class NibTable
+{
+public:
+   NibTable() = default;
+   NibTable(const NibTable&) = delete;
+   NibTable& operator=(const NibTable&) = delete;
+   ~NibTable();
+
+   unsigned int size() const                    { return static_cast<unsigned int>(list.size()); }
+   Nib* get(const unsigned int idx) const       { return (idx < list.size()) ? list[idx] : nullptr; }
+   Nib** data()                                 { return list.data(); }
+
+   // Finds the first NIB (in list order) with the player ID and federate name
+   Nib* find(const unsigned short playerID, const base::String* const federateName) const;
+
+   // Adds a NIB to the end of the list (ref()'s the NIB)
+   bool add(Nib* const nib);
+
+   // Removes a NIB, which is found by its hash slot, leaving an empty
+   // entry on the list until the next compact() (unref()'s the NIB)
+   bool remove(Nib* const nib);
+
+   // Detaches the idx'th NIB, leaving an empty entry on the list until the
+   // next compact(); returns the NIB with the table's reference.
+   Nib* detach(const unsigned int idx);
+
+   // Removes the empty entries left by detach()
+   void compact();
+
+   // Removes (unref()'s) all NIBs
+   void clear();
+
+private:
+   // Hash table slot
+   struct Slot {
+      Nib* nib {};            // NIB, or null if empty or deleted
+      unsigned int hash {};   // NIB's key hash
+      unsigned int index {};  // NIB's index on the list
+      bool used {};           // Slot has been used (a null 'nib' is a deleted slot)
+   };
+
+   static unsigned int hashKey(const unsigned short playerID, const base::String* const federateName);
+   static bool isMatch(const Nib* const nib, const unsigned short playerID, const base::String* const federateName);
+
+   void insertSlot(Nib* const nib, const unsigned int hash, const unsigned int index);
+   Slot* findSlot(const Nib* const nib, const unsigned int hash);
+   void rehash(const unsigned int minCount);
+
+   std::vector<Nib*> list;             // NIBs, in the order added
+   std::vector<unsigned int> hashes;   // Key hashes of the NIBs on the list
+
+   std::vector<Slot> slots;            // Hash table (the size is a power of two)
+   unsigned int nUsed {};              // Number of used slots (including deleted slots)
+   unsigned int nDetached {};          // Number of detached (null) entries on the list
+};
+
+}
+}
+
+#endif
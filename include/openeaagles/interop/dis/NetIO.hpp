@@ -3,16 +3,19 @@
 #define __oe_interop_dis_NetIO_H__
 
 #include "openeaagles/interop/common/NetIO.hpp"
+#include "openeaagles/interop/common/AreaOfInterest.hpp"
 #include <array>
+#include <atomic>
 
 namespace oe {
-namespace base { class Angle; class NetHandler; }
+namespace base { class Angle; class NetHandler; class Thread; }
 namespace models { class Iff; class RfSensor; }
 namespace interop { class Nib; }
 namespace dis {
 class Nib;
 class Ntm;
 class EmissionPduHandler;
+class PduQueue;
 
 struct EeFundamentalParameterData;
 struct EmitterBeamData;
@@ -77,6 +80,12 @@ struct ActionResponsePDU_R;
 //
 //    EmissionPduHandlers <base::PairStream> ! List of Electromagnetic-Emission PDU handlers
 //
+//    areaOfInterest <base::Number>      ! Area-of-interest filtering of new incoming entities (see note #7)
+//                                       ! (default: false)
+//
+//    inputThread    <base::Number>      ! Two stage (pipelined) network input (see note #8) (default: false)
+//    inputQueueSize <base::Number>      ! Max number of PDUs in the pipelined input queue (default: 4096)
+//
 //
 // Notes:
 //    1) NetIO creates its own federate name based on the site and application numbers
@@ -110,6 +119,28 @@ struct ActionResponsePDU_R;
 //       type id.  For incoming emission PDUs, the "emitter name" from the PDU
 //       is matched with the EmissionPduHandler's "emitterName" value.
 //
+//    7) With 'areaOfInterest' enabled, the entity state PDUs of new incoming
+//       entities that are not within range of any of our active local players
+//       are dropped before their NIBs are created (see interop::AreaOfInterest).
+//       The range is the entity's 'maxEntityRange' plus its speed times its
+//       'maxTimeDR', so a filtered entity is admitted (promoted) by one of its
+//       next updates before it can be within 'maxEntityRange'.  Entity types
+//       without a max entity range are not filtered, nor are entities that
+//       already have NIBs.  Use getAreaOfInterest() for the counts of the
+//       filtered and admitted entities.
+//
+//    8) With 'inputThread' enabled, the network input is split into two stages.
+//       A receiver thread receives the PDUs, checks their exercise, site and
+//       application IDs, byte swaps them and puts them on a lock-free queue
+//       (see PduQueue), where an entity state PDU replaces any older queued
+//       entity state PDU of the same entity.  The network input handler,
+//       netInputHander(), then processes the queued PDUs at frame time, before
+//       processInputList().  Use getInputQueue() for the queue depth,
+//       coalescing ratio and latency statistics.  The receiver thread is
+//       started by the first netInputHander() and stopped at shutdown; while
+//       there's no input, it waits on the network input handler (see
+//       base::NetHandler::waitForData()).
+//
 //------------------------------------------------------------------------------
 class NetIO : public interop::NetIO
 {
@@ -230,6 +261,11 @@ public:
    // Receives a packet (PDU) from the network
    int recvData(char* const packet, const int maxSize);
 
+   // Receives up to 'n' packets (PDUs) from the network; packet 'i' is
+   // received at offset 'i * maxSize' of 'buffer', and its size is returned
+   // in the optional 'sizes[i]'.  Returns the number of packets received.
+   unsigned int recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes = nullptr);
+
    unsigned int timeStamp();                                                  // Gets the current timestamp
    unsigned int makeTimeStamp(const double ctime, const bool absolute);       // Make a PDU time stamp
 
@@ -279,6 +315,15 @@ public:
    virtual double getMaxAge(const interop::Nib* const nib) const override;
    virtual interop::Nib* createNewOutputNib(models::Player* const player) override;
 
+   // Area-of-interest filter of new incoming entities, or zero if not enabled
+   const interop::AreaOfInterest* getAreaOfInterest() const  { return (aoiEnabled ? &aoi : nullptr); }
+
+   // Pipelined input queue, or zero if there's no receiver thread
+   const PduQueue* getInputQueue() const                      { return inputQueue; }
+
+   // Receiver thread's main loop (called by the receiver thread)
+   void inputThreadLoop();
+
    // DIS v7 additions
    virtual double getHbtPduEe() const;
    virtual double getHbtTimeoutMplier() const;
@@ -338,6 +383,9 @@ protected:
    virtual bool setSlotSiteID(const base::Number* const num);                             // Sets Site ID
    virtual bool setSlotApplicationID(const base::Number* const num);                      // Sets Application ID
    virtual bool setSlotExerciseID(const base::Number* const num);                         // Sets Exercise ID
+   virtual bool setSlotAreaOfInterest(const base::Number* const num);                     // Sets the area-of-interest filter enabled flag
+   virtual bool setSlotInputThread(const base::Number* const num);                        // Sets the pipelined input enabled flag
+   virtual bool setSlotInputQueueSize(const base::Number* const num);                     // Sets the pipelined input queue size
 
    virtual bool slot2KD(const char* const slotname, unsigned char* const k, unsigned char* const d);
    virtual bool setMaxTimeDR(const double v, const unsigned char kind, const unsigned char domain);
@@ -358,12 +406,15 @@ protected:
    // NetIO Interface
    virtual bool initNetwork() override;                                                   // Initialize the network
    virtual void netInputHander() override;                                                // Network input handler
+   virtual void processOutputList() override;                                             // Create output packets from Output-List
    virtual void processInputList() override;                                              // Update players/systems from the Input-list
    virtual interop::Nib* nibFactory(const interop::NetIO::IoType ioType) override;        // Create a new Nib
    virtual interop::NetIO::NtmInputNode* rootNtmInputNodeFactory() const override;
    virtual void testOutputEntityTypes(const unsigned int) override;                       // Test quick lookup of outgoing entity types
    virtual void testInputEntityTypes(const unsigned int) override;                        // Test quick lookup of incoming entity types
 
+   virtual bool shutdownNotification() override;
+
 private:
     void initData();
 
@@ -379,10 +430,44 @@ private:
    static const unsigned int MAX_PDUs = 500;               // Max PDUs in input buffer
    unsigned int inputBuffer[MAX_PDUs][MAX_PDU_SIZE/4] {};  // Input buffer
 
+   // Input PDUs: checks, byte swaps (stage one) and processes (stage two)
+   bool decodeInputPdu(PDUHeader* const header);
+   void processInputPdu(PDUHeader* const header);
+
+   // Pipelined input: the receiver thread receives into the input buffer
+   // and puts the decoded PDUs on the input queue
+   static const unsigned int DEFAULT_INPUT_QUEUE_SIZE = 4096;
+   bool createInputThread();
+   void stopInputThread();
+   bool inputThreadFlg {};                                 // Use the receiver thread
+   unsigned int inputQueueSize {DEFAULT_INPUT_QUEUE_SIZE}; // Input queue size (PDUs)
+   PduQueue* inputQueue {};                                // Input queue (decoded PDUs)
+   base::safe_ptr<base::Thread> inputThread;               // Receiver thread
+   bool inputThreadStarted {};                             // Receiver thread has been started (or failed)
+   std::atomic<bool> stopInput {};                         // Stop request to the receiver thread
+   unsigned int inputSizes[MAX_PDUs] {};                   // Receiver thread's PDU sizes (bytes)
+   unsigned int queuedPdu[MAX_PDU_SIZE/4] {};              // PDU from the input queue
+
+   // Output PDUs sent by processOutputList() are collected in the output
+   // buffer and sent in batches (see base::NetHandler::sendDataBatch())
+   void flushOutputBuffer();
+   static const unsigned int MAX_OUTPUT_PDUs = 64;                  // Max PDUs in output buffer
+   unsigned int outputBuffer[MAX_OUTPUT_PDUs][MAX_PDU_SIZE/4] {};   // Output buffer
+   int outputSizes[MAX_OUTPUT_PDUs] {};                             // Output PDU sizes (bytes)
+   unsigned int nOutputPdus {};                                     // Number of PDUs in the output buffer
+   bool batchOutput {};                                             // Collecting output PDUs
+   mutable long outputLock {};                                      // Semaphore to protect the output buffer
+
    // Distance filter by entity kind/domain
    double  maxEntityRange[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS] {};     // Max range from ownship           (meters)
    double  maxEntityRange2[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS] {};    // Max range squared from ownship   (meters^2)
 
+   // Area-of-interest filter of new incoming entities
+   void updateAreaOfInterest();
+   bool isInAreaOfInterest(const EntityStatePDU* const pdu);
+   interop::AreaOfInterest aoi;                   // Grid of our local players
+   bool aoiEnabled {};                            // Area-of-interest filter is enabled
+
    // Dead Reckoning (DR) parameters by entity kind/domain
    double  maxTimeDR[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS] {};          // Maximum DR time                  (seconds)
    double  maxPositionErr[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS] {};     // Maximum position error           (meters)
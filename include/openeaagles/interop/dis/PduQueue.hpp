@@ -0,0 +1,131 @@
+
+#ifndef __oe_interop_dis_PduQueue_H__
+#define __oe_interop_dis_PduQueue_H__
+
+#include "openeaagles/base/lockfree_queue.hpp"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace oe {
+namespace dis {
+struct PDUHeader;
+
+//------------------------------------------------------------------------------
+// Class: PduQueue
+//
+// Description: Bounded queue of decoded (validated and byte swapped) PDUs
+//              between NetIO's receiver thread, the producer, and the network
+//              input handler, the consumer (see NetIO's 'inputThread' slot).
+//
+//    The PDUs are copied into a fixed pool of PDU buffers; the queue itself
+//    is a lock-free ring of pointers to these buffers, and the free buffers
+//    are on a second lock-free ring.
+//
+//    Entity state PDUs are coalesced: if an entity state PDU for the same
+//    entity is still waiting on the queue, put() overwrites it with the newer
+//    PDU, which keeps its place in the queue.
+//
+// Statistics:
+//    getDepth()           Number of PDUs on the queue
+//    getMaxDepth()        Max number of PDUs on the queue
+//    getNumReceived()     Number of PDUs given to put()
+//    getNumCoalesced()    Number of PDUs that replaced a queued PDU
+//    getNumDropped()      Number of PDUs dropped because the queue was full
+//    getCoalescingRatio() Ratio of coalesced to received PDUs
+//    getMeanLatency()     Mean and max time (seconds) from put() to get()
+//    getMaxLatency()        of the (newest) PDUs
+//    getLatencyPercentile() Latency percentiles (seconds), from a histogram with
+//                           four bins per octave, so within about 19 percent
+//
+// Notes:
+//    1) Single producer, single consumer: put() is called only by the receiver
+//       thread, and get() only by the network input thread.
+//
+//    2) Each buffer has a state (free, queued, writing or taken), which lets
+//       the producer overwrite a queued PDU only while the consumer hasn't
+//       taken it.
+//------------------------------------------------------------------------------
+class PduQueue
+{
+public:
+   static const unsigned int PDU_SIZE = 1536;     // Max PDU size (bytes), same as NetIO::MAX_PDU_SIZE
+
+public:
+   explicit PduQueue(const unsigned int qsize);
+   PduQueue(const PduQueue&) = delete;
+   PduQueue& operator=(const PduQueue&) = delete;
+   ~PduQueue();
+
+   unsigned int getSize() const                    { return nItems; }
+
+   // Producer: queues a copy of the decoded PDU, which was received at
+   // 'time' (seconds); returns false if it was dropped.
+   bool put(const PDUHeader* const pdu, const unsigned int size, const double time);
+
+   // Consumer: copies the next PDU into 'pdu', which must be at least PDU_SIZE
+   // bytes; returns false if the queue is empty.
+   bool get(PDUHeader* const pdu, const double time);
+
+   unsigned int getDepth() const                   { return ring.entries(); }
+   unsigned int getMaxDepth() const                { return maxDepth; }
+   unsigned long long getNumReceived() const       { return nReceived; }
+   unsigned long long getNumCoalesced() const      { return nCoalesced; }
+   unsigned long long getNumDropped() const        { return nDropped; }
+   double getCoalescingRatio() const;
+   double getMeanLatency() const;
+   double getMaxLatency() const                    { return maxLatency; }
+   double getLatencyPercentile(const double pct) const;  // 'pct' is [ 0 .. 100 ]
+
+   // Clears the statistics (not the queue); may be called by any thread.
+   // Each counter is written only by its owner, so the producer's counters
+   // are cleared by its next put(), and the consumer's by its next get().
+   void clearStatistics();
+
+private:
+   enum { FREE, QUEUED, WRITING, TAKEN };
+   static const unsigned long long NO_KEY = ~0ull;
+   static const unsigned int NUM_BINS = 100;    // Latency histogram bins: bin zero is less than 1 usec,
+                                                // and bin 'b' is [ 2^((b-1)/4) .. 2^(b/4) ) usec
+
+   struct Item {
+      std::atomic<unsigned int> state {FREE};
+      unsigned long long key {NO_KEY};          // Entity key of an entity state PDU
+      unsigned int size {};                     // PDU size (bytes)
+      double time {};                           // Receive time (seconds)
+      unsigned int data[PDU_SIZE/4] {};         // The PDU
+   };
+
+   static unsigned long long entityKey(const PDUHeader* const pdu);
+   void fill(Item* const item, const PDUHeader* const pdu, const unsigned int size, const double time);
+
+   unsigned int nItems {};                      // Number of PDU buffers
+   Item* items {};                              // Pool of PDU buffers
+   base::lockfree_queue<Item*> ring;            // Queued buffers (in order)
+   base::lockfree_queue<Item*> freeItems;       // Free buffers
+
+   // Producer's queued entity state PDUs (hints; an entry is used only if
+   // its buffer is still queued with the same key)
+   std::unordered_map<unsigned long long, Item*> queuedEntities;
+
+   std::atomic<unsigned int> maxDepth {};
+   std::atomic<unsigned long long> nReceived {};
+   std::atomic<unsigned long long> nCoalesced {};
+   std::atomic<unsigned long long> nDropped {};
+
+   // Consumer's latency statistics
+   std::atomic<unsigned long long> nLatency {};
+   std::atomic<double> sumLatency {};
+   std::atomic<double> maxLatency {};
+   std::atomic<unsigned long long> latencyBins[NUM_BINS] {};
+
+   // Clear statistics requests (see clearStatistics())
+   std::atomic<bool> clearProducerStats {};
+   std::atomic<bool> clearConsumerStats {};
+};
+
+}
+}
+
+#endif
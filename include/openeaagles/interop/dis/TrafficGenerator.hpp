@@ -0,0 +1,177 @@
+
+#ifndef __oe_interop_dis_TrafficGenerator_H__
+#define __oe_interop_dis_TrafficGenerator_H__
+
+#include "openeaagles/base/Component.hpp"
+#include "openeaagles/base/safe_ptr.hpp"
+
+#include <array>
+#include <vector>
+
+namespace oe {
+namespace base { class Distance; class List; class NetHandler; class Number; class Rng; }
+namespace dis {
+
+//------------------------------------------------------------------------------
+// Class: TrafficGenerator
+//
+// Description: Synthetic DIS traffic generator, which is used to load test a
+//              DIS NetIO without a live exercise.  It sends the entity state PDUs
+//              of 'numEntities' air vehicles that fly random tracks around a
+//              center point, and a mix of Fire, Detonation, Electromagnetic
+//              Emission and Signal PDUs from random entities, to its network
+//              output handler (e.g., a base::LoopbackHandler for an in-process
+//              test, or a UDP handler for a loopback or a networked test).
+//
+//    The PDUs are made and sent by updateData(), so the generator can be run
+//    as a component of a Station (i.e., at the background rate), or by
+//    calling updateData() directly.  The entity state PDUs of each entity are
+//    sent at 'entityStateRate', with the entities' send times spread over
+//    the update period; the other PDUs are sent at their total rates.
+//
+// Factory name: DisTrafficGenerator
+// Slots:
+//    netOutput       <base::NetHandler>  ! Network output handler
+//    numEntities     <base::Number>      ! Number of entities [ 1 .. 30000 ] (default: 100)
+//    siteID          <base::Number>      ! Site Identification (default: 100)
+//    applicationID   <base::Number>      ! Application Identification (default: 1)
+//    exerciseID      <base::Number>      ! Exercise Identification (default: 1)
+//    latitude        <base::Number>      ! Center latitude (degrees) (default: 0)
+//    longitude       <base::Number>      ! Center longitude (degrees) (default: 0)
+//    radius          <base::Distance>    ! Radius of the entities' area (default: 100 km)
+//    entityType      <base::List>        ! Entities' DIS entity type vector
+//                                        !  [ kind domain country category subcategory specific extra ]
+//                                        !  (default: [ 1 2 225 1 0 0 0 ])
+//    munitionType    <base::List>        ! Fire and detonation PDUs' munition type vector
+//                                        !  (default: [ 2 1 225 1 0 0 0 ])
+//    emitterName     <base::Number>      ! Emission PDUs' emitter name (default: 0)
+//    entityStateRate <base::Number>      ! Entity state PDUs per second of each entity (default: 5)
+//    fireRate        <base::Number>      ! Fire PDUs per second (default: 0)
+//    detonationRate  <base::Number>      ! Detonation PDUs per second (default: 0)
+//    emissionRate    <base::Number>      ! Electromagnetic emission PDUs per second (default: 0)
+//    signalRate      <base::Number>      ! Signal PDUs per second (default: 0)
+//    seed            <base::Number>      ! Random number seed (default: 1)
+//
+// Notes:
+//    1) The entities' site ID must not be the site ID of the NetIO under test,
+//       or the NetIO will reject the PDUs as its own.
+//
+//    2) The entities are created (or re-created) by the first updateData() after
+//       reset(), and the entity state PDUs use the DIS relative time stamps of the
+//       generator's own time, which starts at zero.
+//
+//    3) Use getNumSent() and getNumFailed() for the counts of the PDUs that were
+//       sent or that the network handler failed to send, by PDU kind.
+//------------------------------------------------------------------------------
+class TrafficGenerator : public base::Component
+{
+   DECLARE_SUBCLASS(TrafficGenerator, base::Component)
+
+public:
+   // Kinds of generated PDUs
+   enum PduKind { ENTITY_STATE, FIRE, DETONATION, EMISSION, SIGNAL, NUM_PDU_KINDS };
+
+   static const unsigned int MAX_ENTITIES = 30000;
+
+public:
+   TrafficGenerator();
+
+   unsigned int getNumEntities() const                   { return numEntities; }
+   double getTime() const                                { return time; }          // Generator's time (seconds)
+
+   unsigned long long getNumSent(const PduKind k) const   { return nSent[k]; }
+   unsigned long long getNumFailed(const PduKind k) const { return nFailed[k]; }
+   unsigned long long getTotalSent() const;
+   double getSendRate() const;                           // Mean PDUs per second (generator's time)
+
+   virtual void updateData(const double dt = 0.0) override;
+   virtual void reset() override;
+
+   // Slot functions
+   virtual bool setSlotNetOutput(base::NetHandler* const msg);
+   virtual bool setSlotNumEntities(const base::Number* const msg);
+   virtual bool setSlotSiteID(const base::Number* const msg);
+   virtual bool setSlotApplicationID(const base::Number* const msg);
+   virtual bool setSlotExerciseID(const base::Number* const msg);
+   virtual bool setSlotLatitude(const base::Number* const msg);
+   virtual bool setSlotLongitude(const base::Number* const msg);
+   virtual bool setSlotRadius(const base::Distance* const msg);
+   virtual bool setSlotEntityType(const base::List* const msg);
+   virtual bool setSlotMunitionType(const base::List* const msg);
+   virtual bool setSlotEmitterName(const base::Number* const msg);
+   virtual bool setSlotEntityStateRate(const base::Number* const msg);
+   virtual bool setSlotFireRate(const base::Number* const msg);
+   virtual bool setSlotDetonationRate(const base::Number* const msg);
+   virtual bool setSlotEmissionRate(const base::Number* const msg);
+   virtual bool setSlotSignalRate(const base::Number* const msg);
+   virtual bool setSlotSeed(const base::Number* const msg);
+
+private:
+   static const unsigned int MAX_BATCH = 64;          // Max PDUs per sendDataBatch()
+   static const unsigned int MAX_PDU_SIZE = 1536;     // Same as NetIO::MAX_PDU_SIZE
+
+   // Entity type codes: [ kind domain country category subcategory specific extra ]
+   typedef std::array<unsigned short, 7> TypeCodes;
+
+   void createEntities();
+   void moveEntities(const double dt);
+   void entityState(const unsigned int i, double pos[3], double vel[3], double angles[3]) const;
+   unsigned int randomEntity();
+
+   char* nextPdu();
+   void queuePdu(const PduKind k, const unsigned int length);
+   void flush();
+
+   unsigned int makeEntityState(const unsigned int i, char* const buffer) const;
+   unsigned int makeFire(const unsigned int i, const unsigned int tgt, char* const buffer);
+   unsigned int makeDetonation(const unsigned int i, const unsigned int tgt, char* const buffer);
+   unsigned int makeEmission(const unsigned int i, char* const buffer);
+   unsigned int makeSignal(const unsigned int i, char* const buffer) const;
+
+   unsigned int timeStamp() const;
+
+   base::safe_ptr<base::NetHandler> netOutput;     // Network output handler
+   bool netInitialized {};            // Network output handler has been initialized
+
+   unsigned int numEntities {100};    // Number of entities
+   unsigned short siteID {100};       // Site ID
+   unsigned short appID {1};          // Application ID
+   unsigned char exerciseID {1};      // Exercise ID
+   double refLat {};                  // Center latitude (degrees)
+   double refLon {};                  // Center longitude (degrees)
+   double radius {100000.0};          // Radius of the entities' area (meters)
+   TypeCodes entityType {{1, 2, 225, 1, 0, 0, 0}};
+   TypeCodes munitionType {{2, 1, 225, 1, 0, 0, 0}};
+   unsigned short emitterName {};     // Emission PDUs' emitter name
+   double esRate {5.0};               // Entity state PDUs per second per entity
+   std::array<double, NUM_PDU_KINDS> rates {};     // PDUs per second by kind (not entity state)
+   unsigned int seed {1};             // Random number seed
+
+   // Entities (component arrays)
+   std::vector<double> lat, lon, alt; // Position (degrees, degrees, meters)
+   std::vector<double> hdg;           // Heading (radians)
+   std::vector<double> spd;           // Ground speed (m/sec)
+   std::vector<double> turn;          // Turn rate (radians/sec)
+   std::vector<double> nextEs;        // Time of the next entity state PDU (seconds)
+   bool entitiesCreated {};
+
+   base::Rng* rng {};                 // Random number generator
+   double time {};                    // Generator's time (seconds)
+   std::array<double, NUM_PDU_KINDS> due {};       // PDUs due by kind (fractional)
+   unsigned short eventNumber {};     // Fire and detonation event numbers
+
+   // Batch of PDUs to send (network byte order)
+   std::vector<char> batch;
+   std::array<const char*, MAX_BATCH> batchPdus {};
+   std::array<int, MAX_BATCH> batchSizes {};
+   std::array<PduKind, MAX_BATCH> batchKinds {};
+   unsigned int nBatch {};
+
+   std::array<unsigned long long, NUM_PDU_KINDS> nSent {};     // PDUs sent by kind
+   std::array<unsigned long long, NUM_PDU_KINDS> nFailed {};   // PDUs failed by kind
+};
+
+}
+}
+
+#endif
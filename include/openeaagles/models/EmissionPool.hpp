@@ -0,0 +1,79 @@
+
+#ifndef __oe_models_EmissionPool_H__
+#define __oe_models_EmissionPool_H__
+
+#include <vector>
+
+namespace oe {
+namespace models {
+class Emission;
+
+//------------------------------------------------------------------------------
+// Class: EmissionPool
+//
+// Description: Arena of reusable Emission objects, which is used by an antenna
+//              to send its emission packets without creating and deleting an
+//              Emission per target per transmit (see Antenna::rfTransmit()).
+//
+//    1) The pool holds one reference to each of its emissions.  An emission
+//       is free once every receiver has unref()'d it (i.e., its reference
+//       count is back to one).
+//
+//    2) The pool is owned by a single antenna, and only the thread updating
+//       the antenna's ownship calls alloc() and sweep(), so no locks are
+//       needed.  Receivers on other threads only unref() the emissions.
+//
+//    3) sweep() is called once per frame to clear (release the player
+//       references of) the emissions that have been returned, and to
+//       build the free list used by alloc().  Emissions returned after
+//       the sweep are reused after the next sweep.
+//
+//    4) In steady state, alloc() does not touch the heap; the number of
+//       emissions created by the pool is available from getNumCreated().
+//       Only exact Emission objects are pooled; templates of Emission
+//       subclasses are always cloned.
+//------------------------------------------------------------------------------
+class EmissionPool
+{
+public:
+   static const unsigned int DEFAULT_MAX_SIZE = 10000;  // Default max number of pooled emissions
+
+public:
+   EmissionPool() = default;
+   EmissionPool(const EmissionPool&) = delete;
+   EmissionPool& operator=(const EmissionPool&) = delete;
+   ~EmissionPool();
+
+   unsigned int getSize() const                       { return static_cast<unsigned int>(pool.size()); }
+   unsigned int getNumFree() const                    { return static_cast<unsigned int>(freeList.size()); }
+   unsigned int getMaxSize() const                    { return maxSize; }
+   unsigned long long getNumCreated() const           { return numCreated; }
+
+   // Sets the max number of pooled emissions; extra emissions are cloned and not pooled
+   void setMaxSize(const unsigned int n)              { maxSize = n; }
+
+   // Returns a pre-ref()'d copy of the template emission, 'tmpl'; unref() when finished.
+   Emission* alloc(const Emission& tmpl);
+
+   // Clears the returned emissions and rebuilds the free list
+   void sweep();
+
+   // Releases all of the pooled emissions
+   void clear();
+
+private:
+   struct Slot {
+      Emission* em;     // Pooled emission (the pool's reference)
+      bool cleared;     // Emission has been cleared since it was last used
+   };
+
+   std::vector<Slot> pool;                // Pooled emissions
+   std::vector<unsigned int> freeList;    // Indexes of the free emissions (as of the last sweep())
+   unsigned int maxSize {DEFAULT_MAX_SIZE};
+   unsigned long long numCreated {};      // Number of emissions created (heap allocations)
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,114 @@
+
+#ifndef __oe_models_PlayerSpatialIndex_H__
+#define __oe_models_PlayerSpatialIndex_H__
+
+#include "openeaagles/base/Referenced.hpp"
+#include "openeaagles/base/safe_ptr.hpp"
+#include "openeaagles/base/osg/Vec3d"
+
+#include <unordered_map>
+#include <vector>
+
+namespace oe {
+namespace base { class PairStream; }
+namespace simulation { class PlayerRegistry; }
+namespace models {
+class Player;
+
+//------------------------------------------------------------------------------
+// Class: PlayerSpatialIndex
+//
+// Description: Uniform grid spatial index of the simulation's players, which
+//              is used to find the candidate players-of-interest that could be
+//              within range of a gimbal (see Tdb::processPlayers()).
+//
+//    1) The index is an immutable snapshot; a new index is built once per
+//       background frame by the WorldModel, after the player list has been
+//       updated, from the player list's registry (see PlayerRegistry), and
+//       then swapped in.  Indexes are reference counted; readers on the T/C
+//       and background threads hold a (pre-ref()'d) index, which holds its
+//       registry, so its players can not be deleted while it's in use.
+//
+//    2) There are two grids: one using the players' geocentric (ECEF)
+//       positions, and one using the players' gaming area (NED) positions,
+//       which only contains the players with valid position vectors.
+//
+//    3) query() returns the registry indexes of all players that could be
+//       within range, in player list order.  The players continue to move
+//       after the index is built, so the query range is padded by the fastest
+//       player's speed times the age of the index plus PAD_TIME.  The caller
+//       must still make its own exact range check.
+//------------------------------------------------------------------------------
+class PlayerSpatialIndex : public base::Referenced
+{
+public:
+   static const double DEFAULT_CELL_SIZE;    // Default grid cell size (meters)
+   static const double MIN_CELL_SIZE;        // Minimum grid cell size (meters)
+   static const double PAD_TIME;             // Extra time (seconds) used to pad the query ranges
+
+public:
+   // Builds the index from the player list's registry at executive time
+   // 'time' (seconds) using grid cells of 'meters' (at least MIN_CELL_SIZE)
+   PlayerSpatialIndex(simulation::PlayerRegistry* const reg, const double meters, const double time);
+   PlayerSpatialIndex(const PlayerSpatialIndex&) = delete;
+   PlayerSpatialIndex& operator=(const PlayerSpatialIndex&) = delete;
+
+   double getCellSize() const                      { return cellSize; }
+
+   // True if the index was built from this player list
+   bool isIndexing(const base::PairStream* const players) const;
+
+   // Player at registry index 'idx'
+   Player* getPlayer(const unsigned int idx) const;
+
+   // Collects, in player list order, the registry indexes of the players that
+   // could be within 'range' meters of position 'p0' (ECEF or gaming area NED)
+   // at executive time 'time' (seconds).  Returns the number of candidates.
+   unsigned int query(
+      const base::Vec3d& p0,
+      const double range,
+      const bool ecef,
+      const double time,
+      std::vector<unsigned int>* const candidates
+   ) const;
+
+   // Same as query(), but in the gaming area (NED) horizontal plane only;
+   // i.e., the players that could be within 'range' meters of 'p0' at any
+   // altitude.
+   unsigned int queryHorizontal(
+      const base::Vec3d& p0,
+      const double range,
+      const double time,
+      std::vector<unsigned int>* const candidates
+   ) const;
+
+private:
+   virtual ~PlayerSpatialIndex() = default;
+
+   // Grid of cells; each cell holds the registry indexes of its players (in list order)
+   struct Grid {
+      std::unordered_map<unsigned long long, unsigned int> cells;   // Cell key to cell index
+      std::vector<int> cx, cy, cz;                                  // Cell coordinates
+      std::vector<unsigned int> start;                              // Cell 'c' items are [ start[c] .. start[c+1] )
+      std::vector<unsigned int> items;                              // Registry indexes
+   };
+
+   static unsigned long long cellKey(const int ix, const int iy, const int iz);
+   int cellCoord(const double v) const;
+   void buildGrid(Grid* const grid, const std::vector<base::Vec3d>& pos, const std::vector<unsigned int>& idx) const;
+   double paddedRange(const double range, const double time) const;
+   void queryGrid(const Grid& grid, const base::Vec3d& p0, const double r, const bool horizontal, std::vector<unsigned int>* const candidates) const;
+
+   base::safe_ptr<simulation::PlayerRegistry> registry;   // Registry used to build the index
+   double cellSize {DEFAULT_CELL_SIZE};                   // Grid cell size (meters)
+   double buildTime {};                                   // Executive time of the build (seconds)
+   double maxSpeed {};                                    // Fastest player's speed at the build (m/s)
+
+   Grid ecefGrid;                                         // Geocentric (ECEF) grid
+   Grid nedGrid;                                          // Gaming area (NED) grid
+};
+
+}
+}
+
+#endif
@@ -4,8 +4,10 @@
 
 #include "openeaagles/models/system/System.hpp"
 #include "openeaagles/base/osg/Vec3d"
+#include "openeaagles/base/osg/Matrixd"
 
 namespace oe {
+namespace terrain { class Terrain; }
 namespace models {
 class Gimbal;
 class Player;
@@ -35,6 +37,24 @@ class Player;
 //
 //       If we're using gaming area position vectors (i.e., not usingECEF()) then
 //       all target's with invalid gaming area position vectors are rejected.
+//
+//       If the gimbal has a max range and the world model's players-of-interest
+//       spatial index (see PlayerSpatialIndex) was built from this player list,
+//       then only the candidate players from the index are checked, in player
+//       list order, which gives the same targets as scanning the whole list.
+//
+//       With terrain occulting (see Gimbal::isTerrainOccultingEnabled()), the
+//       targets that pass the other filters are checked in batches using
+//       terrain::Terrain::targetOccultingMask(), which gives the same targets
+//       as checking them one at a time.  If the gimbal's occulting cache is
+//       enabled (see Gimbal::isTerrainOccultingCacheEnabled()) then the
+//       results are kept by the gimbal, across scans, by target cell (3 arc
+//       seconds and 10 meters) until our ownship moves to another cell (see
+//       Gimbal::getOccultingCache()), so the results are
+//       approximate: all targets in a cell share the result of the first one
+//       checked.  If the gimbal has a viewshed (see Gimbal::getViewshed()),
+//       the targets within it, and outside of its tolerance band, are checked
+//       using its horizon tables instead.
 //       
 // 
 //       (Background task)
@@ -124,6 +144,37 @@ public:
    const double* getBoresightElevationErrors() const        { return aelr; }
 
 protected:
+   // Players-of-interest filter parameters (see processPlayers())
+   struct PoiFilter {
+      const terrain::Terrain* terrain {};   // Terrain for occulting checks, or zero
+      double maxRange {};                   // Max range (m), or zero for no limit
+      double maxAngle {};                   // Max angle off boresight (rad), or zero for no limit
+      double cosMaxFov {};                  // Cosine of 'maxAngle'
+      unsigned int mask {};                 // Player of interest types
+      bool localOnly {};                    // Local players of interest only
+      bool checkHorizon {};                 // Horizon check enabled
+      bool osSpaceVehicle {};               // Ownship is a space vehicle
+      double osLat {};                      // Ownship latitude (deg)
+      double osLon {};                      // Ownship longitude (deg)
+      double osAlt {};                      // Ownship altitude (m)
+      double hDist {};                      // Distance to horizon (m)
+      double hTanAng {};                    // Tangent of the angle to horizon (positive down)
+      base::Vec3d p0;                       // Ownship position (ECEF or gaming area NED)
+      base::Matrixd wm;                     // World (ECEF) to local (NED) matrix
+      base::Matrixd rm;                     // Local (NED) to gimbal matrix
+   };
+
+   static const unsigned int MAX_OCCULTING_CACHE = 65536;   // Max number of cached occulting results
+
+   // True if the target passes the players-of-interest filter (except terrain occulting)
+   bool isPlayerOfInterest(const PoiFilter& f, Player* const target, bool* const finished, double* const tanTgtAngOut) const;
+
+   // Adds the targets that aren't occulted by the terrain to the target list
+   void addVisibleTargets(const PoiFilter& f, Player** const tgts, const double* const tanTgtAngs, const unsigned int n);
+
+   // Terrain occulting cache cell of a position
+   static unsigned long long getOccultingCell(const double lat, const double lon, const double alt);
+
    // Sets our Gimbal
    virtual void setGimbal(const Gimbal* const gimbal); 
 
@@ -161,6 +212,15 @@ protected:
    double* za {};
    double* ra2 {};
    double* ra {};
+
+   // computeBoresightData() target LOS and relative velocity vectors,
+   // stored as component arrays (SoA) for the base::xxxArray() kernels
+   double* losX {};
+   double* losY {};
+   double* losZ {};
+   double* dvX {};
+   double* dvY {};
+   double* dvZ {};
 };
 
 }
@@ -3,6 +3,7 @@
 #define __oe_models_WorldModel_H__
 
 #include "openeaagles/simulation/Simulation.hpp"
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
 
 namespace oe {
 namespace terrain { class Terrain; }
@@ -43,6 +44,9 @@ class AbstractAtmosphere;
 //    terrain        <terrain:Terrain>        ! Terrain elevation database (default: nullptr)
 //    atmosphere     <Atmosphere>             ! Atmosphere
 //
+//    playerIndexCellSize <base::Distance>    ! Cell size of the players-of-interest spatial index,
+//                                            ! or zero to disable the index (default: 20 km)
+//
 
 // Gaming area reference point:
 //
@@ -68,6 +72,14 @@ class AbstractAtmosphere;
 //                   Vecef = Vned * M;
 //
 //
+// Players-of-interest spatial index:
+//
+//    The players are binned into a uniform grid (see PlayerSpatialIndex) once
+//    per background frame, after the player list has been updated, and the
+//    new index is swapped in.  Gimbals use this index, getPlayerSpatialIndex(),
+//    to find the players that could be within their max range (see
+//    Tdb::processPlayers()); it's pre-ref()'d, so unref() it when finished.
+//
 // Environments:
 //
 //    Current simulation environments include terrain elevation posts, getTerrain(),
@@ -105,6 +117,8 @@ public:
 
     bool isGamingAreaUsingEarthModel() const;      // Gaming area using the earth model?
 
+    const PlayerSpatialIndex* getPlayerSpatialIndex() const; // Players-of-interest spatial index, or zero if disabled; pre-ref()'d
+
 
 
     // environmental interface
@@ -125,6 +139,8 @@ protected:
 
    // environmental interface
     terrain::Terrain* getTerrain();                        // returns the terrain elevation database
+
+    virtual void updatePlayerList() override;
     virtual bool shutdownNotification() override;
 
 private:
@@ -139,6 +155,7 @@ private:
    bool setSlotEarthModel(const base::EarthModel* const msg);
    bool setSlotEarthModel(const base::String* const msg);
    bool setSlotGamingAreaEarthModel(const base::Number* const msg);
+   bool setSlotPlayerIndexCellSize(const base::Distance* const msg);
 
    // environmental interface
    bool setSlotTerrain(terrain::Terrain* const msg);
@@ -162,6 +179,10 @@ private:
    AbstractAtmosphere* atmosphere {};
    terrain::Terrain* terrain {};
 
+   base::safe_ptr<PlayerSpatialIndex> playerIndex;                         // Players-of-interest spatial index (latest)
+   double playerIndexCellSize {PlayerSpatialIndex::DEFAULT_CELL_SIZE};    // Spatial index cell size (meters)
+   bool playerIndexEnabled {true};                                         // Players-of-interest spatial index is enabled
+
 };
 
 }
@@ -16,6 +16,22 @@ namespace models {
 //    Provides a description of the bullet.  It is used to create the "flyout"
 //    weapon player.  During flyout, the bullets are grouped into bursts.
 //
+//    The bursts are kept in component arrays (gaming area NED), which are all
+//    updated by a single branch free loop.  Each frame, the segment that each
+//    active burst traveled is checked for hits (i.e., a swept check, so fast
+//    bursts can't pass through a player between frames):
+//
+//    1) With a target player, against the target's HIT_RANGE sphere, using
+//       the target's relative motion during the frame.
+//
+//    2) Without a target, against the CLOSE_RANGE (horizontal) range of the
+//       life form players.  The candidate players come from the world model's
+//       spatial index, PlayerSpatialIndex, when it's enabled (otherwise the
+//       player list), and are first checked against the bounds of all of the
+//       burst segments.
+//
+//    Hits are passed to the player using Player::processDetonation().
+//
 // Factory name: Bullet
 //------------------------------------------------------------------------------
 class Bullet : public AbstractWeapon
@@ -25,6 +41,8 @@ class Bullet : public AbstractWeapon
 public:
    static const double DEFAULT_MUZZLE_VEL;         // Meters / second
    static const double DEFAULT_MAX_TOF;            // Seconds
+   static const double HIT_RANGE;                  // Target player hit range (meters)
+   static const double CLOSE_RANGE;                // Life form detonation range (meters)
 
 public:
    Bullet();
@@ -60,27 +78,29 @@ protected:
 
    virtual bool shutdownNotification() override;
 
-   struct Burst {
-      enum Status { ACTIVE, HIT, MISS };
-      Burst() : bPos(0,0,0), bVel(0,0,0) {}
-      base::Vec3d bPos;         // Burst positions -- world  (m)
-      base::Vec3d bVel;         // Burst velocities -- world (m)
-      double bTof {};           // Burst time of flight      (sec)
-      int    bNum {};           // Number of rounds in burst
-      int    bRate {};          // Round rate for this burst (rds per min)
-      int    bEvent {};         // Release event number for burst
-      Status bStatus {ACTIVE};  // Burst status
-   };
+   // Burst status
+   enum BurstStatus { BURST_ACTIVE, BURST_HIT, BURST_MISS };
 
 private:
    enum { MBT = 100 };         // Max number of burst trajectories
 
+   void burstHit(const int i, Player* const p, const double range);
+
    double muzzleVel {DEFAULT_MUZZLE_VEL}; // Muzzle velocity (m/s)
    base::safe_ptr<Player> hitPlayer;      // Player we hit (if any)
 
-   // Bullet trajectories
-   int nbt {};                     // Number of burst trajectories
-   std::array<Burst, MBT> bursts;  // Bursts
+   // Bullet trajectories (component arrays)
+   int nbt {};                            // Number of burst trajectories
+   double bdt {};                         // Delta time of the last update (sec)
+   std::array<double, MBT> bx {}, by {}, bz {};       // Burst positions -- gaming area NED (m)
+   std::array<double, MBT> bvx {}, bvy {}, bvz {};    // Burst velocities -- NED (m/s)
+   std::array<double, MBT> bx0 {}, by0 {}, bz0 {};    // Burst positions before the last update (m)
+   std::array<double, MBT> bTof {};                   // Burst time of flight (sec)
+   std::array<double, MBT> bActive {};                // One if the burst is active, else zero
+   std::array<int, MBT> bNum {};                      // Number of rounds in burst
+   std::array<int, MBT> bRate {};                     // Round rate for this burst (rds per min)
+   std::array<int, MBT> bEvent {};                    // Release event number for burst
+   std::array<BurstStatus, MBT> bStatus {};           // Burst status
 };
 
 }
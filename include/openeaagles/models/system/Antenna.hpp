@@ -4,8 +4,8 @@
 
 #include "openeaagles/models/system/ScanGimbal.hpp"
 
-#include "openeaagles/base/safe_queue.hpp"
-#include "openeaagles/base/safe_stack.hpp"
+#include "openeaagles/models/EmissionPool.hpp"
+
 #include "openeaagles/base/util/constants.hpp"
 
 namespace oe {
@@ -47,8 +47,9 @@ class RfSystem;
 //          playerOfInterestTypes: { "air" "weapon" }
 //
 //    2) When the Emission 'recycle' flag is enabled (default behavior), the
-//       system will try to reuse Emission objects, which removes the overhead
-//       of creating and deleting them.
+//       system will reuse Emission objects from its emission pool (see
+//       EmissionPool), which removes the overhead of creating and deleting
+//       them.  The pool is swept once per frame by process().
 //
 //------------------------------------------------------------------------------
 class Antenna : public ScanGimbal
@@ -92,6 +93,9 @@ public:
    // Recycle emissions flag (reuse old emission structure instead of creating new ones)
    bool isEmissionRecycleEnabled() const       { return recycle; }
 
+   // Emission pool (statistics only: e.g., getNumCreated())
+   const EmissionPool& getEmissionPool() const { return emPool; }
+
    // Beam width (radians)
    double getBeamWidth() const                 { return beamWidth; }
 
@@ -130,11 +134,7 @@ protected:
 
    virtual bool shutdownNotification() override;
 
-   base::safe_stack<Emission*> freeEmStack {MAX_EMISSIONS};  // Free emission stack
-   mutable long freeEmLock {};                               // Semaphore to protect 'freeEmStack'
-
-   base::safe_queue<Emission*> inUseEmQueue {MAX_EMISSIONS}; // In use emission queue
-   mutable long inUseEmLock {};                              // Semaphore to protect 'inUseEmQueue'
+   EmissionPool emPool;             // Recycled emissions
 
 private:
    static const int MAX_EMISSIONS = 10000;   // Max size of emission queues and arrays
@@ -24,6 +24,9 @@ class Player;
 //    Using the 'maxPlayers', 'playerTypes', 'maxRange2Players', 'maxAngle2Players'
 //    and 'localOnly' slot parameters, this function filters the players list
 //    to create a sublist of players that are checked by the process() function.
+//    With a max range, only the candidate players from the world model's
+//    spatial index (see PlayerSpatialIndex), which is built once per frame
+//    for all players, are filtered; otherwise the whole player list.
 //
 // 2) process() -- time critical thread --
 //    Checks the distance from own ownship to the players in the sublist, which
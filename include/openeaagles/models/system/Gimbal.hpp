@@ -7,8 +7,11 @@
 #include "openeaagles/base/osg/Vec3d"
 #include "openeaagles/base/osg/Matrixd"
 
+#include <unordered_map>
+
 namespace oe {
 namespace base { class Angle; class Distance; class List; class PairStream; }
+namespace terrain { class Viewshed; }
 namespace models {
 class Emission;
 class SensorMsg;
@@ -103,6 +106,15 @@ class Tdb;
 //    useWorldCoordinates  (Number)          ! Using player of interest's world (ECEF) coordinate system (default: true)
 //    useOwnHeadingOnly    (Number)          ! Whether only the ownship heading is used by the target data block (default: true)
 //
+//    terrainOccultingCache (Boolean)        ! Enable the terrain occulting results cache (default: false)
+//                                           ! (results are cached by observer and target cells; see Tdb)
+//
+//    viewshed             (Boolean)         ! Enable the terrain occulting viewshed of a stationary ownship (default: false)
+//                                           ! (see terrain::Viewshed; targets near its horizon angles get the full check,
+//                                           ! but the results can still differ on terrain steeper than its tolerance;
+//                                           ! while the ownship is moving, the targets get the full check)
+//    viewshedThreshold    (Distance)        ! Distance the ownship can move before the viewshed is rebuilt (default: 10 meters)
+//
 //
 // Events:
 //    RF_EMISSION       (Emission)           ! Default handler: Pass emissions to subcomponents.
@@ -215,6 +227,16 @@ public:  // Public section
    unsigned int getMaxPlayersOfInterest() const  { return maxPlayers; }     // Max number of players of interest (i.e., size of the arrays)
    bool isLocalPlayersOfInterestOnly() const { return localOnly; }          // Local only players of interest flag
    bool isTerrainOccultingEnabled() const  { return terrainOcculting; }     // Terrain occulting enabled flag
+   bool isTerrainOccultingCacheEnabled() const { return occultingCache; }   // Terrain occulting cache enabled flag
+   bool isViewshedEnabled() const          { return viewshedEnabled; }      // Terrain occulting viewshed enabled flag
+   double getViewshedThreshold() const     { return viewshedThreshold; }    // Viewshed rebuild threshold (meters)
+   const terrain::Viewshed* getViewshed() const;                            // Terrain occulting viewshed, if enabled and built (or zero)
+
+   // Terrain occulting results cache (visible flags by target cell; see Tdb)
+   // for the observer cell 'osCell' -- the cache is cleared when the observer
+   // cell changes.  Kept by the gimbal so that the results carry across the
+   // scans' TDBs.
+   std::unordered_map<unsigned long long, bool>* getOccultingCache(const unsigned long long osCell) const;
    bool isHorizonCheckEnabled() const      { return checkHorizon; }         // Horizon masking enable flag
    bool isUsingWorldCoordinates() const    { return useWorld; }             // Returns true if using player of interest's world coordinates
    bool isUsingHeadingOnly() const         { return ownHeadingOnly; }       // Returns true if using players heading only
@@ -227,6 +249,9 @@ public:  // Public section
    virtual bool setMaxPlayersOfInterest(const unsigned int n);             // Max number of players of interest (i.e., size of the arrays)
    virtual bool setLocalPlayersOfInterestOnly(const bool flg);             // Sets the local only players of interest flag
    virtual bool setTerrainOccultingEnabled(const bool flg);                // Sets the terrain occulting enabled flag
+   virtual bool setTerrainOccultingCacheEnabled(const bool flg);           // Sets the terrain occulting cache enabled flag
+   virtual bool setViewshedEnabled(const bool flg);                        // Sets the terrain occulting viewshed enabled flag
+   virtual bool setViewshedThreshold(const double meters);                 // Sets the viewshed rebuild threshold (meters)
    virtual bool setHorizonCheckEnabled(const bool flg);                    // Sets the horizon check enabled flag
    virtual bool setUseWorld(const bool flg);                               // Sets the using world coordinates flag
    virtual bool setOwnHeadingOnly(const bool flg);                         // Use only the ownship player's heading to when transforming between body and local NED
@@ -302,6 +327,9 @@ public:  // Public section
    virtual bool setSlotCmdRateRoll(const base::Angle* const msg);               // Commanded roll rate (sets RATE_SERVO)
 
    virtual bool setSlotTerrainOcculting(const base::Number* const msg);         // Enable target terrain occulting (default: false)
+   virtual bool setSlotTerrainOccultingCache(const base::Number* const msg);    // Enable the terrain occulting results cache (default: false)
+   virtual bool setSlotViewshed(const base::Number* const msg);                 // Enable the terrain occulting viewshed (default: false)
+   virtual bool setSlotViewshedThreshold(const base::Distance* const msg);      // Viewshed rebuild threshold (default: 10 meters)
    virtual bool setSlotCheckHorizon(const base::Number* const msg);             // Enable horizon masking check (default: true)
 
    virtual bool setSlotPlayerTypes(const base::PairStream* const msg);          // Player of interest types (default: 0 )
@@ -341,6 +369,10 @@ protected:
    // Set the current TDB
    bool setCurrentTdb(Tdb* const newTdb);
 
+   // Updates the terrain occulting viewshed (rebuilt if our ownship has moved,
+   // and cleared while our ownship is moving)
+   virtual bool updateViewshed();
+
    // System Interface -- Callbacks by phase
    virtual void dynamics(const double dt) override;    // Phase 0
 
@@ -351,6 +383,7 @@ private:
    void initData();
 
    static const double defaultTolerance;
+   static const double viewshedMaxSpeed;   // Max ownship speed for the viewshed (m/s)
 
    Type        type {ELECTRONIC};          // Mechanical or Electronic gimbal (affects maxRates)
    ServoMode   servoMode {FREEZE_SERVO};   // Gimbal's servo mode
@@ -378,11 +411,19 @@ private:
    unsigned int maxPlayers {200};      // Max number of players of interest (i.e., size of the arrays)
    bool     localOnly {};              // Local players of interest only
    bool     terrainOcculting {};       // Target terrain occulting enabled flag
+   bool     occultingCache {};         // Terrain occulting results cache enabled flag
+   bool     viewshedEnabled {};        // Terrain occulting viewshed enabled flag
+   double   viewshedThreshold {10.0};  // Viewshed rebuild threshold (meters)
    bool     checkHorizon {true};       // Horizon masking check enabled flag
    bool     useWorld {true};           // Using player of interest's world coordinates
    bool     ownHeadingOnly {true};     // Whether only the ownship heading is used by the target data block
 
    base::safe_ptr<Tdb> tdb;  // Current Target Data Block
+   terrain::Viewshed* viewshed {};     // Terrain occulting viewshed (built as needed)
+
+   // Terrain occulting results cache for the observer cell, 'occultingCacheCell'
+   mutable std::unordered_map<unsigned long long, bool> occultingResults;
+   mutable unsigned long long occultingCacheCell {};
 };
 
 }
@@ -23,6 +23,9 @@ public:
 
 protected:
    virtual void transmit(const double dt) override;
+
+private:
+   Emission* xmitEm {};    // Transmit template emission (reused each frame)
 };
 
 }
@@ -111,6 +111,8 @@ private:
    int    numberOfJammedEmissions {};
 
    double rfIGain {1.0};              // Integrator gain (default: 1.0) (no units)
+
+   Emission* xmitEm {};               // Transmit template emission (reused each frame)
 };
 
 }
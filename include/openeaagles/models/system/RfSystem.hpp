@@ -144,12 +144,23 @@ protected:
    // Compute receiver thermal noise
    virtual bool computeReceiverNoise();
 
-   // The following are filled by rfReceivedEmission() and consumed (emptied) by receive()
+   // Batch of emission packets (and their signals) passed from rfReceivedEmission() to receive()
+   struct EmissionBatch {
+      unsigned int np {};                               // Number of emission packets
+      std::array<double, MAX_EMISSIONS> signals {};     // Signal values
+      std::array<Emission*, MAX_EMISSIONS> packets {};  // Emission packets (ref()'d)
+   };
+
+   // Moves all of the emission packets received since the last call to the
+   // caller (e.g., receive()) in a single hand-off.  The batch belongs to the
+   // caller until it's passed to releaseEmissionBatch().
+   EmissionBatch* takeReceivedEmissions();
+
+   // Unref()s the batch's emission packets and empties the batch
+   void releaseEmissionBatch(EmissionBatch* const batch);
+
+   // The following is filled by rfReceivedEmission() and consumed (emptied) by receive()
    double jamSignal {};                              // Interference signal (from Jammer)
-   unsigned int np {};                               // Number of emission packets being passed from rfReceivedEmission() to receive()
-   std::array<double, MAX_EMISSIONS> signals {};     // signals values being passed from rfReceivedEmission() to receive()
-   std::array<Emission*, MAX_EMISSIONS> packets {};  // emission packets being passed from rfReceivedEmission() to receive()
-   mutable long packetLock {};                       // Semaphore to protect 'signals' and 'xxpackets
 
    // Process players of interest -- Called by our updateData() -- the background thread --
    // This function will create a filtered list of players that R/F systems will interact with.
@@ -162,6 +173,12 @@ protected:
    virtual bool shutdownNotification() override;
 
 private:
+   void clearReceivedEmissions();
+
+   std::array<EmissionBatch, 2> batches;  // Received emission batches (double buffered)
+   unsigned int inBatch {};               // Index of the batch being filled by rfReceivedEmission()
+   mutable long packetLock {};            // Semaphore to protect 'inBatch' and its batch
+
    Antenna* antenna {};              // Our antenna
    base::String* antennaName {};     // Name of our antenna
 
@@ -44,6 +44,9 @@ public:
    virtual bool setPathName(const base::String* const msg);
 
 protected:
+   std::ifstream* getInputStream()  { return sin; }
+   void setFailed(const bool flg)   { fileFailed = flg; }
+
    virtual const DataRecordHandle* readRecordImp() override;
 
 private:
@@ -7,6 +7,7 @@
 namespace oe {
 namespace base { class String; }
 namespace recorder {
+namespace pb { class DataRecord; }
 
 //------------------------------------------------------------------------------
 // Class: FileWriter
@@ -33,19 +34,27 @@ namespace recorder {
 //    4) File will be closed with an end of data (REID_END_OF_DATA) message.
 //    Calling openFile() or sending any additional data messages will open
 //    a new file with a new version number.
+//
+//    5) Derived classes can write other file formats by overriding
+//    writeHeader(), which is called after the file is opened, writeRecord(),
+//    which writes each data record, and writeTrailer(), which is called
+//    before the file is closed (see IndexedFileWriter).
 //------------------------------------------------------------------------------
 class FileWriter : public OutputHandler
 {
     DECLARE_SUBCLASS(FileWriter, OutputHandler)
 
+public:
+   static const unsigned int OUTPUT_BUFFER_SIZE = 1024 * 1024;   // Output stream buffer size (bytes)
+
 public:
    FileWriter();
 
    bool isOpen() const;                   // Is the data file open?
    bool isFailed() const;                 // Did we have an open or write error?
 
-   bool openFile();                       // Open the data file
-   void closeFile();                      // Close the data file
+   virtual bool openFile();               // Open the data file
+   virtual void closeFile();              // Close the data file
 
    const char* getFilename() const;       // File name as entered
    const char* getPathname() const;       // Path to file
@@ -60,12 +69,20 @@ public:
 protected:
    void setFullFilename(const char* const name);
 
+   std::ofstream* getOutputStream()       { return sout; }
+
+   // File format: header, data record and trailer writers; returns true if successful
+   virtual bool writeHeader();
+   virtual bool writeRecord(const pb::DataRecord* const dataRecord);
+   virtual bool writeTrailer();
+
    virtual void processRecordImp(const DataRecordHandle* const handle) override;
 
    virtual bool shutdownNotification() override;
 
 private:
    std::ofstream* sout {};            // Output stream
+   char* obuf {};                     // Output stream buffer
 
    char* fullFilename {};             // Full file name of the output file
    const base::String* filename {};   // Output file name
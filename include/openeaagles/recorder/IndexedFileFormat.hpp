@@ -0,0 +1,127 @@
+
+#ifndef __oe_recorder_IndexedFileFormat_H__
+#define __oe_recorder_IndexedFileFormat_H__
+
+#include <string>
+#include <vector>
+
+namespace oe {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Class: IndexedFileFormat
+// Description: Layout and encoding functions for the indexed data recorder
+//              file, which is written by IndexedFileWriter and read by
+//              IndexedFileReader.
+//
+// File layout (all fixed size integers and doubles are little-endian):
+//
+//    File header (16 bytes)
+//       char[8]  "OERECIDX"         ! File magic
+//       uint32   version            ! FORMAT_VERSION
+//       uint32   codec              ! Block codec (CODEC_NONE or CODEC_LZ4)
+//
+//    Blocks, each:
+//       char[4]  "OEBK"             ! Block marker
+//       uint32   n                  ! Size of the block info (bytes)
+//       byte[n]  block info         ! See BlockInfo below
+//       byte[]   block data         ! 'packedSize' bytes of compressed data, or
+//                                   ! 'rawSize' bytes if 'packedSize' is zero
+//
+//    Index
+//       char[4]  "OEIX"             ! Index marker
+//       varint   number of blocks
+//       block info, for each block  ! (with the block's file offset)
+//
+//    Footer (16 bytes)
+//       uint64   index offset       ! File offset of the index marker
+//       char[8]  "OERECEND"         ! Footer magic
+//
+// Block info:
+//       varint   offset             ! File offset of the block (index only)
+//       varint   rawSize            ! Size of the uncompressed block data
+//       varint   packedSize         ! Size of the compressed block data (zero if stored uncompressed)
+//       varint   numRecords         ! Number of data records in the block
+//       double   minSimTime         ! Min and max simulated time of the records (seconds)
+//       double   maxSimTime
+//       varint   numIds             ! Number of record IDs, followed by the
+//       varint[] ids                ! IDs of the records in the block (sorted)
+//
+// Uncompressed block data, for each data record:
+//       varint   id                 ! Recorder event ID (see dataRecorderTokens.hpp)
+//       double   simTime            ! Simulated time (seconds)
+//       varint   n                  ! Size of the serialized DataRecord (bytes)
+//       byte[n]  DataRecord         ! Serialized protocol buffer DataRecord
+//
+// Notes:
+//    1) Varints are unsigned LEB128 (7 bits per byte, low order first), as
+//       used by protocol buffers.
+//
+//    2) The index is a copy of the block infos.  If the file wasn't closed
+//       (i.e., there's no footer), the reader rebuilds the index by scanning
+//       the block headers without decompressing the block data.
+//
+//    3) Block data is compressed with the LZ4 library, which is enabled by
+//       defining OE_RECORDER_LZ4 (see makedefs).  Without it, the blocks are
+//       written uncompressed (CODEC_NONE), and only the uncompressed blocks
+//       of an LZ4 file can be read.
+//------------------------------------------------------------------------------
+class IndexedFileFormat
+{
+public:
+   static const unsigned int FORMAT_VERSION = 1;
+
+   // Block codecs
+   static const unsigned int CODEC_NONE = 0;
+   static const unsigned int CODEC_LZ4 = 1;
+
+   static const unsigned int HEADER_SIZE = 16;
+   static const unsigned int FOOTER_SIZE = 16;
+   static const unsigned int MARKER_SIZE = 4;
+
+   static const char FILE_MAGIC[8];
+   static const char FOOTER_MAGIC[8];
+   static const char BLOCK_MARKER[4];
+   static const char INDEX_MARKER[4];
+
+   // Max size of a block's data or info (bytes)
+   static const unsigned int MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+   // Block info (see above)
+   struct BlockInfo {
+      unsigned long long offset {};
+      unsigned int rawSize {};
+      unsigned int packedSize {};
+      unsigned int numRecords {};
+      double minSimTime {};
+      double maxSimTime {};
+      std::vector<unsigned int> ids;
+   };
+
+   // Encoders (append to 'buf')
+   static void putVarint(std::string* const buf, const unsigned long long v);
+   static void putUInt32(std::string* const buf, const unsigned int v);
+   static void putUInt64(std::string* const buf, const unsigned long long v);
+   static void putDouble(std::string* const buf, const double v);
+   static void putBlockInfo(std::string* const buf, const BlockInfo& info, const bool withOffset);
+
+   // Decoders (read from '*p' and advance it; must not read past 'end'); return true if successful
+   static bool getVarint(const char** const p, const char* const end, unsigned long long* const v);
+   static bool getUInt32(const char** const p, const char* const end, unsigned int* const v);
+   static bool getUInt64(const char** const p, const char* const end, unsigned long long* const v);
+   static bool getDouble(const char** const p, const char* const end, double* const v);
+   static bool getBlockInfo(const char** const p, const char* const end, BlockInfo* const info, const bool withOffset);
+
+   // Block data compression; return true if successful
+   static bool isCompressionAvailable();
+   static bool compress(const std::string& in, std::string* const out);
+   static bool decompress(const char* const in, const unsigned int n, const unsigned int rawSize, std::string* const out);
+
+private:
+   IndexedFileFormat() = delete;
+};
+
+}
+}
+
+#endif
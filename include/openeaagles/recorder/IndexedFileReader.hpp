@@ -0,0 +1,79 @@
+
+#ifndef __oe_recorder_IndexedFileReader_H__
+#define __oe_recorder_IndexedFileReader_H__
+
+#include "openeaagles/recorder/FileReader.hpp"
+#include "openeaagles/recorder/IndexedFileFormat.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oe {
+namespace recorder {
+
+//------------------------------------------------------------------------------
+// Class: IndexedFileReader
+// Description: Read and parse data records from an indexed, block compressed
+//              data file (see IndexedFileWriter and IndexedFileFormat)
+//
+// Factory name: IndexedFileReader
+//
+// Notes
+//    1) The block index is read when the file is opened.  If the file doesn't
+//    have an index (i.e., it wasn't closed), the index is rebuilt by scanning
+//    the block headers.
+//
+//    2) Blocks that don't contain any enabled data records (see the
+//    'enabledList' and 'disabledList' slots) are skipped without reading or
+//    decompressing them, and disabled data records are skipped without
+//    parsing them.
+//
+//    3) seekTime() positions the reader at the first data record with a
+//    simulated time at or after the given time.  Blocks that end before the
+//    time are skipped.
+//------------------------------------------------------------------------------
+class IndexedFileReader : public FileReader
+{
+    DECLARE_SUBCLASS(IndexedFileReader, FileReader)
+
+public:
+   IndexedFileReader();
+
+   unsigned int getNumBlocks() const                  { return static_cast<unsigned int>(index.size()); }
+   unsigned int getNumRecords() const;                // Total number of data records in the file
+   double getFirstSimTime() const;                    // First (min) simulated time in the file (seconds)
+   double getLastSimTime() const;                     // Last (max) simulated time in the file (seconds)
+
+   // Positions the reader at the first data record at or after 'simTime' (seconds)
+   bool seekTime(const double simTime);
+
+   virtual bool openFile() override;
+   virtual void closeFile() override;
+
+protected:
+   virtual const DataRecordHandle* readRecordImp() override;
+
+private:
+   void initData();
+   bool readIndex();
+   bool scanBlocks(const unsigned long long fileSize);
+   bool readBlock(const unsigned int idx);
+   bool isBlockEnabled(const IndexedFileFormat::BlockInfo& info) const;
+
+   std::vector<IndexedFileFormat::BlockInfo> index;  // Block index
+   unsigned int codec {};                            // Block codec
+   unsigned int nextBlock {};                        // Index of the next block to read
+
+   std::string blockData;                            // Current block's (uncompressed) data
+   unsigned int blockPos {};                         // Position of the next record in 'blockData'
+   std::string packed;                               // Block read buffer
+
+   double seekSimTime {};                            // Time that we're seeking (seconds)
+   bool seeking {};                                  // Seeking to 'seekSimTime'
+   bool firstPassFlg {true};                         // First pass flag
+};
+
+}
+}
+
+#endif
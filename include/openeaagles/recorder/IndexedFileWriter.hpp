@@ -0,0 +1,93 @@
+
+#ifndef __oe_recorder_IndexedFileWriter_H__
+#define __oe_recorder_IndexedFileWriter_H__
+
+#include "openeaagles/recorder/FileWriter.hpp"
+#include "openeaagles/recorder/IndexedFileFormat.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oe {
+namespace base { class Number; }
+namespace recorder {
+class FileReader;
+
+//------------------------------------------------------------------------------
+// Class: IndexedFileWriter
+// Description: Serialize and write the data from protocol buffer DataRecord
+//              messages to an indexed, block compressed data file
+//              (see IndexedFileFormat).
+//
+// Factory name: IndexedFileWriter
+// Slots:
+//     compress       <Boolean>    ! Compress the data blocks (default: true, if
+//                                 ! LZ4 is enabled; see IndexedFileFormat)
+//     blockSize      <Number>     ! Uncompressed size of the data blocks (bytes)
+//                                 ! [ 4096 .. 16777216 ] (default: 262144)
+//
+// Notes:
+//    1) The data records are collected into blocks, which are compressed and
+//    written to the file when full.  The block index is written at the end of
+//    the file, when the file is closed.  Files that weren't closed can still
+//    be read, but the last (partial) block is lost.
+//
+//    2) Use an IndexedFileReader to read the file; it can seek to a
+//    simulation time and it skips the blocks that don't contain any of its
+//    enabled data records.
+//
+//    3) convertFile() converts a data file from the original (FileWriter)
+//    format by copying all of the data records from a FileReader.
+//------------------------------------------------------------------------------
+class IndexedFileWriter : public FileWriter
+{
+    DECLARE_SUBCLASS(IndexedFileWriter, FileWriter)
+
+public:
+   static const unsigned int DEFAULT_BLOCK_SIZE = 256 * 1024;
+   static const unsigned int MIN_BLOCK_SIZE = 4 * 1024;
+   static const unsigned int MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+public:
+   IndexedFileWriter();
+
+   bool isCompressionEnabled() const                  { return compressFlg; }
+   unsigned int getBlockSize() const                  { return blockSize; }
+   unsigned int getNumBlocks() const                  { return static_cast<unsigned int>(index.size()); }
+
+   virtual bool setCompressionEnabled(const bool flg);
+   virtual bool setBlockSize(const unsigned int bytes);
+
+   // Copies all of the data records from the reader to this file and closes
+   // the file; returns true if successful.
+   bool convertFile(FileReader* const reader);
+
+protected:
+   // Slot functions
+   bool setSlotCompress(const base::Number* const msg);
+   bool setSlotBlockSize(const base::Number* const msg);
+
+   virtual bool writeHeader() override;
+   virtual bool writeRecord(const pb::DataRecord* const dataRecord) override;
+   virtual bool writeTrailer() override;
+
+private:
+   bool writeBlock();
+
+   bool compressFlg {IndexedFileFormat::isCompressionAvailable()};                         // Compress the data blocks
+   unsigned int blockSize {DEFAULT_BLOCK_SIZE};     // Uncompressed block size (bytes)
+
+   std::string block;                               // Current block's (uncompressed) data
+   IndexedFileFormat::BlockInfo blockInfo;          // Current block's info
+   std::vector<IndexedFileFormat::BlockInfo> index; // Infos of the blocks written to the file
+   unsigned long long offset {};                    // Current file offset (bytes)
+
+   std::string wireFormat;                          // Serialized data record buffer
+   std::string packed;                              // Compressed block buffer
+   std::string header;                              // Block info/index buffer
+};
+
+}
+}
+
+#endif
@@ -4,9 +4,15 @@
 
 #include "openeaagles/simulation/AbstractRecorderComponent.hpp"
 #include "openeaagles/base/List.hpp"
+#include "openeaagles/base/lockfree_queue.hpp"
+#include "openeaagles/base/safe_ptr.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace oe {
-namespace base { class List; }
+namespace base { class Identifier; class List; class Number; class Thread; }
 namespace recorder {
 class DataRecordHandle;
 
@@ -27,8 +33,30 @@ class DataRecordHandle;
 //    of subcomponent OutputHandlers.  The prcessRecord() function for each
 //    subcomponent OutputHandler is called from our processRecord() function.
 //
+//    4) With the 'asyncWriter' slot set, the queued records are processed by
+//    a dedicated writer thread instead of by processQueue(), so serializing
+//    and writing the records never runs on the simulation threads.  The
+//    queue is a bounded, lock-free ring buffer of 'queueSize' records, and
+//    'overflowPolicy' selects what addToQueue() does when it's full:
+//       block       -- wait for the writer thread (no records are lost)
+//       dropOldest  -- drop the oldest queued record
+//       dropNewest  -- drop the new record
+//    The writer thread is started with the first queued record, and at
+//    shutdown it's stopped and the remaining records are processed; the
+//    records that are queued after that are dropped, since the output is
+//    being closed.  The queue is drained by only one thread at a time (the
+//    writer thread, or stopWriterThread()), and the writer thread and any
+//    blocked producers wait on condition variables, not by polling.
+//    getQueueDepth() and getNumDropped() return the queue statistics.
+//
 // Factory name: OutputHandler
 //
+// Slots:
+//    asyncWriter    <Boolean>     ! Use a dedicated writer thread (default: false)
+//    queueSize      <Number>      ! Writer thread's queue size (records) (default: 10000)
+//    overflowPolicy <Identifier>  ! Writer thread's queue overflow policy:
+//                                 !   block, dropOldest or dropNewest (default: block)
+//
 // Overriding the Component class slot:
 //    components     ! Must contain only 'OutputHandler' type objects
 //
@@ -37,6 +65,12 @@ class OutputHandler : public simulation::AbstractRecorderComponent
 {
    DECLARE_SUBCLASS(OutputHandler, simulation::AbstractRecorderComponent)
 
+public:
+   // Writer thread's queue overflow policies
+   enum OverflowPolicy { BLOCK, DROP_OLDEST, DROP_NEWEST };
+
+   static const unsigned int DEFAULT_QUEUE_SIZE = 10000;
+
 public:
    OutputHandler();
 
@@ -47,9 +81,29 @@ public:
    void addToQueue(const DataRecordHandle* const handle);
 
    // Process all data records from the queue
+   // (does nothing when the writer thread is processing the queue)
    void processQueue();
 
+   bool isAsyncWriterEnabled() const                  { return asyncFlg; }
+   unsigned int getQueueSize() const                  { return queueSize; }
+   OverflowPolicy getOverflowPolicy() const           { return policy; }
+   unsigned int getQueueDepth() const;                // Number of records in the queue
+   unsigned long long getNumDropped() const           { return numDropped; }
+
+   // Set before the first record is queued
+   virtual bool setAsyncWriterEnabled(const bool flg);
+   virtual bool setQueueSize(const unsigned int n);
+   virtual bool setOverflowPolicy(const OverflowPolicy p);
+
+   // Writer thread's main loop (called by the writer thread)
+   void writerLoop();
+
 protected:
+   // Slot functions
+   bool setSlotAsyncWriter(const base::Number* const msg);
+   bool setSlotQueueSize(const base::Number* const msg);
+   bool setSlotOverflowPolicy(const base::Identifier* const msg);
+
    // Process record implementations by derived classes
    virtual void processRecordImp(const DataRecordHandle* const handle);
 
@@ -63,11 +117,38 @@ protected:
       base::Component* const remove = nullptr   // Optional subcomponent to remove
    ) override;
 
+   // Stops the writer thread, if any, and processes the records remaining
+   // in its queue (derived classes call this before closing their output)
+   void stopWriterThread();
+
    virtual bool shutdownNotification() override;
 
 private:
+   static const unsigned int WRITER_BATCH_SIZE = 256;
+
+   bool createWriterThread();
+   unsigned int processRing(const unsigned int max);
+   void notifyWriter();
+
    base::List queue;            // Data Record Queue
    mutable long semaphore {};
+
+   // Writer thread
+   bool asyncFlg {};                                     // Use the writer thread
+   unsigned int queueSize {DEFAULT_QUEUE_SIZE};          // Writer thread's queue size (records)
+   OverflowPolicy policy {BLOCK};                        // Writer thread's queue overflow policy
+   base::lockfree_queue<const DataRecordHandle*>* ring {}; // Writer thread's queue
+   base::safe_ptr<base::Thread> writerThread;            // The writer thread
+   std::atomic<bool> writerStarted {};                   // Writer thread has been started (or failed)
+   std::atomic<bool> stopWriter {};                      // Stop request to the writer thread
+   std::atomic<unsigned long long> numDropped {};        // Number of dropped records
+
+   std::mutex drainMutex;                                // Serializes processRing() (one drainer at a time)
+   std::mutex waitMutex;                                 // Waiters' mutex
+   std::condition_variable recordsQueued;                // Writer thread waits for records
+   std::condition_variable spaceFreed;                   // Blocked producers wait for room in the queue
+   std::atomic<bool> writerWaiting {};                   // Writer thread is waiting (producers notify)
+   std::atomic<unsigned int> blockedProducers {};        // Number of blocked producers (writer notifies)
 };
 
 }
@@ -22,6 +22,10 @@ namespace simulation {
 //    container object (e.g., Station class) to process the incoming and out-
 //    going entities, respectively.  For DIS, these can be called by different
 //    threads, and for HLA they need to be called from the same thread.
+//
+//    The function deadReckoningFrame() is called by our container object from
+//    its time-critical thread, before the simulation's time-critical frame,
+//    to dead reckon the incoming entities in one pass.
 //------------------------------------------------------------------------------
 class AbstractNetIO : public base::Component
 {
@@ -43,6 +47,9 @@ public:
    // Updates the 'output' side of the network
    virtual void outputFrame(const double dt) =0;
 
+   // Dead reckons the incoming entities (default: none)
+   virtual void deadReckoningFrame(const double dt);
+
    // Network ID number
    virtual unsigned short getNetworkID() const =0;
 
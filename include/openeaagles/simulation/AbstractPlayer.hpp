@@ -6,9 +6,13 @@
 
 #include "openeaagles/base/Identifier.hpp"
 
+#include <array>
+#include <atomic>
+
 namespace oe {
 namespace simulation {
 class AbstractNib;
+class PlayerEvents;
 
 //------------------------------------------------------------------------------
 // Class: AbstractPlayer
@@ -93,6 +97,22 @@ public:
    virtual bool setEnableNetOutput(const bool f);                             // Sets the network output enabled flag
    virtual bool setOutgoingNib(AbstractNib* const p, const unsigned int id);  // Sets the outgoing NIB for network 'id'
 
+   // ---
+   // Player list events -- while the player is on a simulation's player list,
+   // changes to its mode, network output flag and NIB are posted to the list's events
+   // ---
+   bool isOnPlayerList() const;                                       // True if the player is on a simulation's player list
+   void setPlayerEvents(PlayerEvents* const p);                       // Sets the player list's events (set by the simulation; nullptr when removed)
+
+   // ---
+   // Frame cost history -- smoothed execution times used by the simulation
+   // executive to balance the player list across its T/C and background threads
+   // ---
+   double getTcFrameCost(const unsigned int phase) const;             // Time-critical frame cost for 'phase' [ 0 .. 3 ] (seconds)
+   double getBgFrameCost() const;                                     // Background frame cost (seconds)
+   void updateTcFrameCost(const unsigned int phase, const double t);  // Adds a new time-critical sample for 'phase' (seconds)
+   void updateBgFrameCost(const double t);                            // Adds a new background sample (seconds)
+
    virtual void reset() override;
 
 protected:
@@ -107,6 +127,7 @@ protected:
 
 private:
    void initData();
+   void postChanged();
 
    // player identity
    unsigned short id {};          // ID
@@ -120,6 +141,14 @@ private:
    // outgoing network support data
    AbstractNib** nibList {};      // Pointer to a list of outgoing NIBs
    bool enableNetOutput {true};   // Allow output to the network
+
+   // player list support
+   std::atomic<PlayerEvents*> events {};  // Player list's events (not ref()'d), while on the list;
+                                          // set by the background thread, read by the T/C thread
+
+   // frame cost history (seconds)
+   std::array<double, 4> tcCost {};   // Time-critical cost per phase
+   double bgCost {};                  // Background cost
 };
 
 #include "openeaagles/simulation/AbstractPlayer.inl"
@@ -131,6 +131,40 @@ inline bool AbstractPlayer::isNetOutputEnabled() const
    return enableNetOutput;
 }
 
+// True if the player is on a simulation's player list
+inline bool AbstractPlayer::isOnPlayerList() const
+{
+   return (events.load() != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+
+// Time-critical frame cost for 'phase' (seconds)
+inline double AbstractPlayer::getTcFrameCost(const unsigned int phase) const
+{
+   return (phase < tcCost.size()) ? tcCost[phase] : 0.0;
+}
+
+// Background frame cost (seconds)
+inline double AbstractPlayer::getBgFrameCost() const
+{
+   return bgCost;
+}
+
+// Adds a new time-critical sample for 'phase'; smoothed with the previous cost
+inline void AbstractPlayer::updateTcFrameCost(const unsigned int phase, const double t)
+{
+   if (phase < tcCost.size()) {
+      tcCost[phase] = (tcCost[phase] > 0.0) ? (0.75 * tcCost[phase] + 0.25 * t) : t;
+   }
+}
+
+// Adds a new background sample; smoothed with the previous cost
+inline void AbstractPlayer::updateBgFrameCost(const double t)
+{
+   bgCost = (bgCost > 0.0) ? (0.75 * bgCost + 0.25 * t) : t;
+}
+
 
 
 
@@ -0,0 +1,83 @@
+
+#ifndef __oe_simulation_PlayerEvents_H__
+#define __oe_simulation_PlayerEvents_H__
+
+#include <array>
+#include <vector>
+
+namespace oe {
+namespace simulation {
+class AbstractPlayer;
+
+//------------------------------------------------------------------------------
+// Class: PlayerEvents
+//
+// Description: Log of the changes to a simulation's player list, which is
+//              published by the Simulation so that its consumers (e.g., the
+//              interoperability NetIOs) can track the player list
+//              incrementally, instead of scanning the whole list each frame.
+//
+//    The events are:
+//       ADDED     -- the player was added to the player list
+//       REMOVED   -- the player was removed from the player list
+//       CHANGED   -- the player's mode or network output enabled flag changed
+//
+//    The events are numbered by sequence number, and each consumer keeps the
+//    sequence number of its next event.  The log holds the last MAX_EVENTS
+//    events; getEvents() returns false when any of a consumer's events have
+//    been lost (i.e., the log overflowed, or the whole player list was
+//    replaced; see resync()), and the consumer must then rescan the player list.
+//
+// Notes:
+//    1) The log holds a reference (ref()) to each of its events' players, so
+//       a player is not deleted while its events are on the log, and
+//       getEvents() ref()'s the returned players for the consumer.
+//
+//    2) The events are posted by the background thread (player list updates)
+//       and by any thread that changes a player's mode, so the log is locked.
+//
+//    3) An event only says that something changed; the consumer should check
+//       the player's current state.
+//------------------------------------------------------------------------------
+class PlayerEvents
+{
+public:
+   enum Type { ADDED, REMOVED, CHANGED };
+
+   struct Event {
+      AbstractPlayer* player {};
+      Type type {CHANGED};
+   };
+
+   static const unsigned int MAX_EVENTS = 1024;
+
+public:
+   PlayerEvents() = default;
+   PlayerEvents(const PlayerEvents&) = delete;
+   PlayerEvents& operator=(const PlayerEvents&) = delete;
+   ~PlayerEvents();
+
+   unsigned long long getSequence() const;             // Sequence number of the next event
+
+   // Posts an event for the player
+   void post(AbstractPlayer* const player, const Type type);
+
+   // Drops all events; the consumers must rescan the player list
+   void resync();
+
+   // Appends the events from sequence number 'seq' to 'events' (pre-ref()'d
+   // players) and advances 'seq' to the next event.  Returns false if any of
+   // these events have been lost.
+   bool getEvents(unsigned long long* const seq, std::vector<Event>* const events) const;
+
+private:
+   std::array<Event, MAX_EVENTS> ring {};     // Last MAX_EVENTS events; event 'n' is at [n % MAX_EVENTS]
+   unsigned long long nextSeq {};             // Sequence number of the next event
+   unsigned long long firstSeq {};            // Sequence number of the oldest event on the log
+   mutable long semaphore {};                 // Locks the log
+};
+
+}
+}
+
+#endif
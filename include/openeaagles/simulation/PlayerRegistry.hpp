@@ -0,0 +1,98 @@
+
+#ifndef __oe_simulation_PlayerRegistry_H__
+#define __oe_simulation_PlayerRegistry_H__
+
+#include "openeaagles/base/Referenced.hpp"
+#include "openeaagles/base/safe_ptr.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oe {
+namespace base { class PairStream; }
+namespace simulation {
+class AbstractPlayer;
+
+//------------------------------------------------------------------------------
+// Class: PlayerRegistry
+//
+// Description: Immutable snapshot of a simulation player list that provides
+//              a contiguous array of the players (in list order) with hashed
+//              lookup by player ID (plus network ID) and by player name.
+//
+// Notes:
+//    1) A new registry is created by the Simulation each time its player list
+//       is swapped; the registry holds (ref()'s) its player list, so its
+//       players can not be deleted while the registry is in use.
+//
+//    2) Registries are reference counted; readers on the T/C and background
+//       threads hold a (pre-ref()'d) registry for a consistent snapshot.
+//
+//    3) Lookups match the player list searches: with a network ID of zero,
+//       findPlayer() returns the first player, in list order, with the ID
+//       (i.e., local players first), and findPlayerByName() returns the first
+//       player with the name.
+//
+//    4) Player IDs, network IDs and names are set before the players are
+//       added to the player list and must not change while on the list.
+//
+//    5) When Simulation::updatePlayerList() adds and removes players, the
+//       new registry's indexes are updated from the previous registry's
+//       indexes, instead of being rebuilt from all of the players.
+//------------------------------------------------------------------------------
+class PlayerRegistry : public base::Referenced
+{
+public:
+   PlayerRegistry(base::PairStream* const playerList);
+
+   // Registry of 'playerList', which is the previous registry's player list
+   // less the 'removed' players plus the 'added' players
+   PlayerRegistry(
+      base::PairStream* const playerList,
+      const PlayerRegistry* const prev,
+      const std::vector<AbstractPlayer*>& removed,
+      const std::vector<AbstractPlayer*>& added
+   );
+
+   PlayerRegistry(const PlayerRegistry&) = delete;
+   PlayerRegistry& operator=(const PlayerRegistry&) = delete;
+
+   base::PairStream* getPlayerList();                                     // The player list (not ref()'d)
+   const base::PairStream* getPlayerList() const;                         // The player list (not ref()'d) (const version)
+
+   unsigned int getNumPlayers() const;                                    // Number of players
+   AbstractPlayer* getPlayer(const unsigned int idx) const;               // Player at 'idx' [ 0 .. getNumPlayers()-1 ], in list order
+
+   AbstractPlayer* findPlayer(const short id, const int netID = 0) const; // Find a player by player (and network) ID
+   AbstractPlayer* findPlayerByName(const char* const playerName) const;  // Find a player by name
+
+private:
+   virtual ~PlayerRegistry();
+
+   static unsigned long long idKey(const unsigned short id, const int netID) {
+      return (static_cast<unsigned long long>(static_cast<unsigned int>(netID)) << 16) | id;
+   }
+
+   void loadPlayers();
+   void indexPlayer(AbstractPlayer* const ip);
+
+   base::safe_ptr<base::PairStream> list;                                  // Player list
+   std::vector<AbstractPlayer*> players;                                   // Players in list order
+   std::unordered_map<unsigned long long, AbstractPlayer*> idNetIndex;     // Players by (network ID, player ID)
+   std::unordered_map<unsigned short, AbstractPlayer*> idIndex;            // First player by player ID
+   std::unordered_map<std::string, AbstractPlayer*> nameIndex;             // First player by name
+};
+
+inline base::PairStream* PlayerRegistry::getPlayerList()                    { return list; }
+inline const base::PairStream* PlayerRegistry::getPlayerList() const        { return list; }
+inline unsigned int PlayerRegistry::getNumPlayers() const                   { return static_cast<unsigned int>(players.size()); }
+inline AbstractPlayer* PlayerRegistry::getPlayer(const unsigned int idx) const
+{
+   return (idx < players.size()) ? players[idx] : nullptr;
+}
+
+}
+}
+
+#endif
@@ -5,8 +5,9 @@
 #include "openeaagles/base/concurrent/SyncTask.hpp"
 
 namespace oe {
-namespace base { class Component; class PairStream; }
+namespace base { class Component; }
 namespace simulation {
+class PlayerRegistry;
 
 //------------------------------------------------------------------------------
 // Class: SimTcThread
@@ -21,7 +22,7 @@ public:
 
    // Parent thread signals start to this child thread with these parameters.
    void start(
-      base::PairStream* const pl0,
+      PlayerRegistry* const pl0,
       const double dt0,
       const unsigned int idx0,
       const unsigned int n0
@@ -32,7 +33,7 @@ private:
    virtual unsigned long userFunc() override;
 
 private:
-   base::PairStream* pl0 {};
+   PlayerRegistry* pl0 {};
    double dt0 {};
    unsigned int idx0 {};
    unsigned int n0 {};
@@ -4,8 +4,11 @@
 
 #include "openeaagles/base/Component.hpp"
 #include "openeaagles/base/safe_queue.hpp"
+#include "openeaagles/base/concurrent/WorkStealingScheduler.hpp"
 #include "openeaagles/base/osg/Matrixd"
+#include "openeaagles/simulation/PlayerEvents.hpp"
 #include <array>
+#include <vector>
 
 namespace oe {
 namespace base { class Distance; class EarthModel; class LatLon; class Pair; class Time; }
@@ -15,6 +18,7 @@ class SimBgThread;
 class SimTcThread;
 class Station;
 class AbstractPlayer;
+class PlayerRegistry;
 
 //------------------------------------------------------------------------------
 // Class: Simulation
@@ -79,6 +83,17 @@ class AbstractPlayer;
 //    g) You can find players on the list by Player ID [plus Net ID], findPlayer(),
 //       or by name using findPlayerByName().
 //
+//    h) Each time the player list is swapped, a new PlayerRegistry is created
+//       for it, which holds an array of the players, in list order, and the
+//       hashed indexes used by findPlayer() and findPlayerByName().  Use
+//       getPlayerRegistry() for a consistent snapshot of the player list.
+//
+//    i) The changes to the player list (players added and removed) and to its
+//       players (mode and network output changes) are posted to the player
+//       list's events, getPlayerEvents(), so that the player list can be
+//       tracked without scanning it each frame.  When the whole player list
+//       is replaced (e.g., reset()), the events are resync()'d.
+//
 //
 // Cycles, frames and phases:
 //
@@ -108,6 +123,13 @@ class AbstractPlayer;
 //    complexity of the players and the speed of your computer system, so you
 //    may need to do a little experimenting on your system.
 //
+//    When more than one thread is used, the players are divided into cost
+//    weighted chunks using a work-stealing scheduler (base::WorkStealingScheduler).
+//    Each player's recent execution times (see AbstractPlayer::getTcFrameCost()
+//    and getBgFrameCost()) are used as its cost, so the split improves over
+//    time, and a thread that finishes its own chunks steals chunks from the
+//    other threads instead of idling at the end of the phase.
+//
 //    These threads will be very CPU bound, so having more threads than CPUs is
 //    very ineffective.  And to be nice, ...
 //
@@ -177,6 +199,12 @@ public:
     base::PairStream* getPlayers();                // Returns the player list; pre-ref()'d
     const base::PairStream* getPlayers() const;    // Returns the player list; pre-ref()'d (const version)
 
+    PlayerRegistry* getPlayerRegistry();             // Returns the player list's registry; pre-ref()'d
+    const PlayerRegistry* getPlayerRegistry() const; // Returns the player list's registry; pre-ref()'d (const version)
+
+    PlayerEvents* getPlayerEvents();                 // Returns the player list's events
+    const PlayerEvents* getPlayerEvents() const;     // Returns the player list's events (const version)
+
     unsigned int cycle() const;                    // Cycle counter; each cycle represents 16 frames.
     unsigned int frame() const;                    // Frame counter [0 .. 15]; each frame represents a call to our updateTC()
     unsigned int phase() const;                    // Phase counter [0 .. 3]; frames are divide into 4 phases to help
@@ -218,6 +246,26 @@ public:
     virtual void reset() override;
 
 public:
+    // Thread processing of the player list, where 'idx' [ 1 .. n ] is the
+    // thread's index and 'n' is the number of threads.  With multiple threads
+    // (n > 1) the players are taken from the current work-stealing schedule.
+    void updateTcPlayerList(
+       PlayerRegistry* const playerList,
+       const double dt,
+       const unsigned int idx,
+       const unsigned int n
+    );
+
+    void updateBgPlayerList(
+       PlayerRegistry* const playerList,
+       const double dt,
+       const unsigned int idx,
+       const unsigned int n
+    );
+
+    // (Deprecated: use the PlayerRegistry versions) Thread processing of the
+    // player list, where thread 'idx' [ 1 .. n ] updates every n'th player,
+    // starting with the idx'th player
     void updateTcPlayerList(
        base::PairStream* const playerList,
        const double dt,
@@ -251,6 +299,10 @@ private:
    Station* getStationImp();
 
    bool insertPlayerSort(base::Pair* const newPlayer, base::PairStream* const newList);
+   void setPlayerList(base::PairStream* const newList);
+   void swapPlayerList(base::PairStream* const newList);
+   void swapPlayerList(base::PairStream* const newList, const std::vector<AbstractPlayer*>& removed, const std::vector<AbstractPlayer*>& added);
+   static void setPlayerEvents(base::PairStream* const list, PlayerEvents* const events);
    AbstractPlayer* findPlayerPrivate(const short id, const int netID) const;
    AbstractPlayer* findPlayerByNamePrivate(const char* const playerName) const;
 
@@ -265,7 +317,9 @@ private:
    bool setSlotNumBgThreads(const base::Number* const msg);
 
    base::safe_ptr<base::PairStream> players;     // Main player list (sorted by network and player IDs)
+   base::safe_ptr<PlayerRegistry> registry;      // Main player list's registry
    base::safe_ptr<base::PairStream> origPlayers; // Original player list
+   PlayerEvents playerEvents;                    // Main player list's events
 
    unsigned int cycleCnt {};     // Real-Time Cycle Counter (Cycles consist of Frames)
    unsigned int frameCnt {};     // Real-Time Frame Counter (Frames consist of Phases)
@@ -308,6 +362,13 @@ private:
    unsigned int reqBgThreads {1};                          // Requested number of threads
    unsigned int numBgThreads {};                           // Number of threads in pool; should be (reqBgThreads - 1)
    bool bgThreadsFailed {};                                // Failed to create threads.
+
+   // Work-stealing schedules for the multi-threaded player list passes
+   static const double MIN_PLAYER_COST;                    // Minimum cost of a player (seconds)
+   base::WorkStealingScheduler tcScheduler;                // T/C schedule (per phase)
+   std::vector<double> tcCosts;                            // T/C player costs (current phase)
+   base::WorkStealingScheduler bgScheduler;                // Background schedule
+   std::vector<double> bgCosts;                            // Background player costs
 };
 
 }
@@ -3,9 +3,12 @@
 #define __oe_simulation_Station_H__
 
 #include "openeaagles/base/Component.hpp"
+#include "openeaagles/base/concurrent/PeriodicTask.hpp"
+
+#include <atomic>
 
 namespace oe {
-namespace base { class IoHandler; class Number; class Thread; class Time; }
+namespace base { class Identifier; class IoHandler; class Number; class Profiler; class Thread; class Time; }
 namespace simulation {
 class AbstractDataRecorder;
 class Simulation;
@@ -38,6 +41,13 @@ class AbstractOtw;
 //    tcPriority         <base::Number>         ! Time-critical thread priority  (default: DEFAULT_TC_THREAD_PRI)
 //    tcStackSize        <base::Number>         ! Time-critical thread stack size (default: <system default size>)
 //
+//    tcOverrunPolicy    <base::Identifier>     ! Time-critical thread frame overrun policy: { catchUp, skip, degrade }
+//                                              ! (default: catchUp; see base::PeriodicTask)
+//    tcMaxCatchUp       <base::Number>         ! Time-critical thread max catch-up frames (default: 0 -- no limit)
+//    tcCpu              <base::Number>         ! Time-critical thread CPU affinity (default: -1 -- none)
+//    tcRealtime         <base::Boolean>        ! Time-critical thread sets its own SCHED_FIFO priority (Linux)
+//                                              ! (default: false)
+//
 //    fastForwardRate    <base::Number>         ! Fast forward rate for time critical functions
 //                                              ! (i.e., the number of times updateTC() is called per frame).
 //                                              ! (default: DEFAULT_FAST_FORWARD_RATE)
@@ -57,6 +67,8 @@ class AbstractOtw;
 //
 //    dataRecorder       <AbstractDataRecorder> ! Our Data Recorder
 //
+//    profiler           <base::Profiler>       ! Frame profiler (default: nullptr -- no profiling)
+//
 //
 // Ownship player:
 //
@@ -101,6 +113,10 @@ class AbstractOtw;
 //          updateTC().  Any slow I/O (e.g., RS-232) or blocked I/O should not be
 //          in these functions.
 //
+//       d: Just before the call to the simulation's updateTC(), the networks'
+//          deadReckoningFrame() functions are called to dead reckon their
+//          incoming entities in one pass (see interop::DrEngine).
+//
 //    4) updateData() -- The main application will need to call updateData()
 //       directly at its required (i.e., as needed) rate.  By default, this
 //       function will call the simulation exec and interoperability network
@@ -125,7 +141,18 @@ class AbstractOtw;
 //       called from the same thread, or threads, as the simulation model's
 //       functions are called from.
 //
-//    6) When subclassing off of this class for your application, the
+//    6) Degraded mode: with the 'degrade' time-critical overrun policy, the
+//       time-critical thread calls setDegradedMode(true) when a frame overruns,
+//       and setDegradedMode(false) once it has been on time for a while.  While
+//       degraded, the OTW models are not updated and, except for the new and
+//       removed player records, no data is recorded (the simulation's
+//       getDataRecorder() returns zero).  Derived stations can override
+//       setDegradedMode() to shed their own optional work.  The player
+//       models, including their background sensors, are not shed, since
+//       that would change the simulation's results rather than just its
+//       outputs.
+//
+//    7) When subclassing off of this class for your application, the
 //       convention is that the updateData() function for any graphic
 //       component (see graphics::Graphic) is called by their display
 //       manager (see graphics::GlutDisplay) and therefore from the
@@ -178,6 +205,10 @@ public:
    const AbstractDataRecorder* getDataRecorder() const;             // Returns the data recorder (const version)
    virtual bool setDataRecorder(AbstractDataRecorder* const p);     // Sets the data recorder
 
+   base::Profiler* getProfiler();                                   // Returns the frame profiler
+   const base::Profiler* getProfiler() const;                       // Returns the frame profiler (const version)
+   virtual bool setProfiler(base::Profiler* const p);               // Sets the frame profiler
+
    // Is Timer::updateTimers() being called from our updateTC()
    bool isUpdateTimersEnabled() const;
    virtual bool setUpdateTimersEnable(const bool enb);
@@ -200,11 +231,29 @@ public:
    unsigned int getTimeCriticalStackSize() const;            // Time-critical thread stack size
    bool setTimeCriticalStackSize(const unsigned int bytes);  // Set Time-critical thread stack size  (bytes or zero for default)
 
+   // Time-critical thread frame overrun handling and timing (see base::PeriodicTask)
+   // -- set before creating the thread --
+   base::PeriodicTask::OverrunPolicy getTimeCriticalOverrunPolicy() const;
+   bool setTimeCriticalOverrunPolicy(const base::PeriodicTask::OverrunPolicy p);
+   unsigned int getTimeCriticalMaxCatchUp() const;           // Max catch-up frames (or zero for no limit)
+   bool setTimeCriticalMaxCatchUp(const unsigned int n);
+   int getTimeCriticalCpu() const;                           // CPU affinity (or -1 for none)
+   bool setTimeCriticalCpu(const int cpu);
+   bool isTimeCriticalRealtime() const;                      // Thread sets its own SCHED_FIFO priority
+   bool setTimeCriticalRealtime(const bool flg);
+
    // Optionally called by the main application  to create a thread
    // that will call 'updateTC()' at 'getTimeCriticalRate()' Hz
    virtual void createTimeCriticalProcess();
    bool doWeHaveTheTcThread() const;                         // Do we have a T/C thread?
 
+   // The time-critical thread's frame statistics (jitter, overruns, etc), or zero
+   const base::PeriodicTask* getTimeCriticalTask() const;
+
+   // Degraded mode (shedding optional work after time-critical frame overruns)
+   bool isDegraded() const;
+   virtual void setDegradedMode(const bool flg);
+
    // Fast forward rates used by processTimeCriticalTasks().
    //   (i.e., number of times Station::tcFrame() is called per frame)
    unsigned int getFastForwardRate() const { return fastForwardRate; } // Hz
@@ -250,6 +299,10 @@ public:
    virtual bool setSlotOwnshipName(const base::String* const);
    virtual bool setSlotFastForwardRate(const base::Number* const);
    virtual bool setSlotEnableUpdateTimers(const base::Number* const);
+   virtual bool setSlotTimeCriticalOverrunPolicy(const base::Identifier* const);
+   virtual bool setSlotTimeCriticalMaxCatchUp(const base::Number* const);
+   virtual bool setSlotTimeCriticalCpu(const base::Number* const);
+   virtual bool setSlotTimeCriticalRealtime(const base::Number* const);
 
    virtual void updateTC(const double dt = 0.0) override;
    virtual void updateData(const double dt = 0.0) override;
@@ -283,12 +336,18 @@ private:
    const base::String* ownshipName {};            // Name of our ownship player
    bool tmrUpdateEnbl {};                         // Enable base::Timers::updateTimers() call from updateTC()
    AbstractDataRecorder* dataRecorder {};         // Data Recorder
+   base::Profiler* profiler {};                   // Frame profiler
 
    double tcRate {50.0};                                     // Time-critical thread Rate (hz)
    double tcPri {DEFAULT_TC_THREAD_PRI};                     // Priority of the time-critical thread (0->lowest, 1->highest)
    unsigned int tcStackSize {};                              // Time-critical thread stack size (bytes or zero for system default size)
    base::safe_ptr<base::Thread> tcThread;                    // The Time-critical thread
    unsigned int fastForwardRate {DEFAULT_FAST_FORWARD_RATE}; // Time-critical thread fast forward rate
+   base::PeriodicTask::OverrunPolicy tcOverrunPolicy {base::PeriodicTask::CATCH_UP};  // Time-critical thread overrun policy
+   unsigned int tcMaxCatchUp {};                             // Time-critical thread max catch-up frames
+   int tcCpu {-1};                                           // Time-critical thread CPU affinity
+   bool tcRealtime {};                                       // Time-critical thread sets SCHED_FIFO
+   std::atomic<bool> degraded {};                            // Degraded mode (set by the T/C thread; read by the others)
 
    double netRate {};                                // Network thread Rate (hz)
    double netPri {DEFAULT_NET_THREAD_PRI};           // Priority of the Network thread (0->lowest, 1->highest)
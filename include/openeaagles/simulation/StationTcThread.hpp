@@ -15,6 +15,7 @@ class TcThread : public base::PeriodicTask
    DECLARE_SUBCLASS(TcThread, base::PeriodicTask)
    public: TcThread(base::Component* const parent, const double priority, const double rate);
    private: virtual unsigned long userFunc(const double dt) override;
+   protected: virtual void degradedModeChanged(const bool degraded) override;
 };
 
 }
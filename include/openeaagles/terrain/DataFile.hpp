@@ -80,6 +80,16 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   // Locates the elevations at an array of points (and sets valid flags if found)
+   virtual unsigned int getElevationsAt(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of the arrays
+         const double* const lats,     // Latitudes of the points (degs)
+         const double* const lons,     // Longitudes of the points (degs)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
 protected:
    short**  columns {};           // Array of data columns (values in meters)
    double   latSpacing {};        // Spacing between latitude points (degs)
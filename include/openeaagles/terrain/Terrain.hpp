@@ -72,6 +72,18 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const = 0;
 
+   // Locates the elevations at an array of points (and sets valid flags if
+   // found); returns the number of points found.  Points with their valid
+   // flags already set are skipped.
+   virtual unsigned int getElevationsAt(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of the arrays
+         const double* const lats,     // Latitudes of the points (degs)
+         const double* const lons,     // Longitudes of the points (degs)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const;
+
    // Returns true if a target point is occulted by the terrain as seen from the ref point
    virtual bool targetOcculting(
          const double refLat,          // Ref latitude (degs)
@@ -93,6 +105,22 @@ public:
       const double tanLookAng          // Tangent of the look angle
    ) const;
 
+   // Batched target occulting: checks 'n' targets as seen from the ref point.
+   // Bit 'i%32' of word 'i/32' of the 'visible' mask is set if target 'i'
+   // isn't occulted (same check as targetOcculting()).  Returns the number
+   // of visible targets.
+   virtual unsigned int targetOccultingMask(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double* const tgtLats,  // Target latitudes (degs)
+         const double* const tgtLons,  // Target longitudes (degs)
+         const double* const tgtAlts,  // Target altitudes (meters)
+         const unsigned int n,         // Number of targets
+         unsigned int* const visible,  // Visibility mask ((n+31)/32 words)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const;
+
    // Returns true if the target at the altitude 'tgtAlt' and range 'range' is
    // occulted by the elevation points as seen from the reference altitude, 'refAlt'.
    static bool occultCheck(
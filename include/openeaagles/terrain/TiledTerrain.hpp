@@ -0,0 +1,202 @@
+
+#ifndef __oe_terrain_TiledTerrain_H__
+#define __oe_terrain_TiledTerrain_H__
+
+#include "openeaagles/terrain/Terrain.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace oe {
+namespace base { class Number; }
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: TiledTerrain
+//
+// Description: Terrain database of a directory of DTED and SRTM cells.  The
+//              cells are indexed when the data is loaded, and their elevation
+//              posts are paged in, as needed, in fixed-size tiles that are
+//              kept in a bounded, least recently used (LRU) cache.
+//
+// Factory name: TiledTerrain
+// Slots:
+//    tileSize    <Number>   ! Size of the tiles (posts per side; min: 16)
+//                           ! (default: DEFAULT_TILE_SIZE)
+//    cacheSize   <Number>   ! Max number of cached tiles (min: 4)
+//                           ! (default: DEFAULT_CACHE_SIZE)
+//
+// Example:
+//
+//    ( TiledTerrain
+//       path: "/data/terrain/srtm3"
+//       tileSize: 256
+//       cacheSize: 512
+//    )
+//
+// Notes:
+//    1) The 'path' slot (see Terrain) is the directory of the cells.  DTED cells
+//       (*.dt0, *.dt1 or *.dt2) are located by their headers, and can be in the
+//       directory or in its (longitude) subdirectories, e.g., "w118/n40.dt1".
+//       SRTM cells are located by their names, e.g., "N40W118.hgt" (see SrtmHgtFile).
+//       The 'file' slot is not used.
+//
+//    2) A tile also includes the first row and column of posts of its northern
+//       and eastern neighbors, so interpolations use only one tile.
+//
+//    3) The cache is shared by all threads, and is locked (spin lock) only
+//       while a tile is looked up and its posts are used.  A missing tile is
+//       read from its cell file with the cache unlocked (the reads are
+//       serialized by a second lock), and then added to the cache.
+//
+//    4) The min and max elevations of the database (see Terrain) are not
+//       computed, which would need all of the cells to be read.
+//
+//    5) SRTM posts are read as two's complement values, as defined by the SRTM
+//       documentation; void posts are returned as is (see DataFile).
+//------------------------------------------------------------------------------
+class TiledTerrain : public Terrain
+{
+   DECLARE_SUBCLASS(TiledTerrain, Terrain)
+
+public:
+   static const unsigned int DEFAULT_TILE_SIZE = 256;   // posts per side
+   static const unsigned int DEFAULT_CACHE_SIZE = 256;  // tiles
+
+public:
+   TiledTerrain();
+
+   unsigned int getTileSize() const                   { return tileSize; }
+   unsigned int getCacheSize() const                  { return cacheSize; }
+   virtual bool setTileSize(const unsigned int n);    // Clears the cache
+   virtual bool setCacheSize(const unsigned int n);   // Clears the cache
+
+   unsigned int getNumCells() const                   { return static_cast<unsigned int>(cells.size()); }
+   unsigned int getNumCachedTiles() const;            // Number of tiles in the cache
+
+   // Cache statistics
+   unsigned long long getCacheHits() const            { return cacheHits; }
+   unsigned long long getCacheMisses() const          { return cacheMisses; }
+   unsigned long long getCacheEvictions() const       { return cacheEvictions; }
+   void clearCacheStats();
+
+   // Removes all tiles from the cache
+   void clearCache();
+
+   // ---
+   // Terrain interface
+   // ---
+
+   virtual bool isDataLoaded() const override;
+
+   // Locates an array of (at least two) elevation points (and sets valid flags if found)
+   // returns the number of points found within this database
+   virtual unsigned int getElevations(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of elevation and valdFlags arrays
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const double direction,       // True direction (heading) angle of the data (degs)
+         const double maxRng,          // Range to last elevation point (meters)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates an elevation value (meters) for a given reference point and returns
+   // it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+   virtual bool getElevation(
+         double* const elev,           // The elevation value (meters)
+         const double lat,             // Reference latitude (degs)
+         const double lon,             // Reference longitude (degs)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates the elevations at an array of points (and sets valid flags if found)
+   virtual unsigned int getElevationsAt(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of the arrays
+         const double* const lats,     // Latitudes of the points (degs)
+         const double* const lons,     // Longitudes of the points (degs)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+protected:
+   // Slot functions
+   bool setSlotTileSize(const base::Number* const msg);
+   bool setSlotCacheSize(const base::Number* const msg);
+
+   virtual void clearData() override;
+
+private:
+   enum Format { DTED, SRTM };
+
+   // Indexed cell
+   struct Cell {
+      std::string filename;            // Cell file
+      Format format {DTED};            // File format
+      int swLat {}, swLon {};          // Southwest corner (degs)
+      unsigned int nptlat {};          // Number of points in latitude (rows)
+      unsigned int nptlong {};         // Number of points in longitude (columns)
+      double latSpacing {};            // Spacing between latitude points (degs)
+      double lonSpacing {};            // Spacing between longitude points (degs)
+   };
+
+   // Cached tile
+   struct Tile {
+      std::vector<short> posts;        // Elevation posts [col * nrows + row] (meters)
+      unsigned int row0 {}, col0 {};   // Cell indices of the first post
+      unsigned int nrows {}, ncols {}; // Number of rows and columns
+      int cell {-1};                   // Cell index, or -1 if unused
+      unsigned int index {};           // Tile index within the cell
+      int prev {-1}, next {-1};        // LRU list (most recently used first)
+   };
+
+   virtual bool loadData() override;
+
+   bool indexDirectory(const std::string& dir, const bool subdirs);
+   bool indexDtedCell(const std::string& filename);
+   bool indexSrtmCell(const std::string& filename, const std::string& name);
+   bool addCell(const Cell& cell);
+
+   const Cell* findCell(const double lat, const double lon, int* const idx) const;
+   bool lookup(double* const elev, const double lat, const double lon, const bool interp) const;
+   double tileElevation(const Tile& tile, const unsigned int irow, const unsigned int icol,
+                        const double deltaLat, const double deltaLon, const bool interp) const;
+   unsigned int tileIndex(const Cell& cell, const unsigned int irow, const unsigned int icol,
+                          unsigned int* const tr, unsigned int* const tc, unsigned int* const ntiles) const;
+   void initTile(Tile* const tile, const int icell, const unsigned int irow, const unsigned int icol) const;
+   const Tile* findTile(const int icell, const unsigned int irow, const unsigned int icol) const;
+   const Tile* insertTile(Tile* const tile) const;
+   bool readTile(Tile* const tile, const Cell& cell) const;
+   void touch(const int slot) const;
+   void unlink(const int slot) const;
+
+   unsigned int tileSize {DEFAULT_TILE_SIZE};      // Tile size (posts per side)
+   unsigned int cacheSize {DEFAULT_CACHE_SIZE};    // Max number of tiles
+
+   std::vector<Cell> cells;                        // Indexed cells
+   std::vector<int> cellGrid;                      // Cell index of each 1x1 degree cell, or -1 [lat][lon]
+
+   // Tile cache (protected by 'cacheLock')
+   mutable std::vector<Tile> cache;                // Cache slots
+   mutable int lruHead {-1};                       // Most recently used slot
+   mutable int lruTail {-1};                       // Least recently used slot
+   mutable std::vector< std::vector<int> > tileSlots;  // Cache slot of each tile, or -1 [cell][tile]
+   mutable unsigned long long cacheHits {};        // Tile lookups found in the cache
+   mutable unsigned long long cacheMisses {};      // Tiles read from the cell files
+   mutable unsigned long long cacheEvictions {};   // Tiles removed from a full cache
+   mutable long cacheLock {};                      // Cache spin lock
+
+   // Cell file reads (protected by 'fileLock')
+   mutable std::ifstream cellFile;                 // Last opened cell file
+   mutable int cellFileIdx {-1};                   // Cell index of 'cellFile'
+   mutable std::vector<unsigned char> readBuffer;  // Tile read buffer
+   mutable long fileLock {};                       // Cell file spin lock
+};
+
+}
+}
+
+#endif
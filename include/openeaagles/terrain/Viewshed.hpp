@@ -0,0 +1,116 @@
+
+#ifndef __oe_terrain_Viewshed_H__
+#define __oe_terrain_Viewshed_H__
+
+#include "openeaagles/base/Object.hpp"
+
+#include <vector>
+
+namespace oe {
+namespace terrain {
+class Terrain;
+
+//------------------------------------------------------------------------------
+// Class: Viewshed
+//
+// Description: Precomputed horizon table of a fixed reference point (e.g., a
+//              ground radar or a SAM site), which is used to check the terrain
+//              occulting of targets with a single table lookup.
+//
+//              For each azimuth bin, the tables hold the tangent of the max
+//              angle, from the reference point's local level, to the terrain
+//              between the reference point and each range step, raised (upper)
+//              and lowered (lower) by ELEVATION_TOLERANCE.  A target is occulted
+//              if the angle to the target is on or below the lower horizon
+//              angle, up to its last profile point, and is visible if it's
+//              above the upper horizon angle, which is the same check as
+//              Terrain::targetOcculting().  Targets within the band aren't
+//              checked (see targetOcculting()).
+//
+// Example:
+//
+//    Viewshed* vs = new Viewshed();
+//    vs->build(terrain, lat, lon, alt, 100000.0);
+//    ...
+//    bool occulted = false;
+//    if (!vs->targetOcculting(tgtLat, tgtLon, tgtAlt, &occulted)) {
+//       occulted = terrain->targetOcculting(lat, lon, alt, tgtLat, tgtLon, tgtAlt);
+//    }
+//
+// Notes:
+//    1) The terrain profiles are sampled every RANGE_STEP meters (the point
+//       spacing of Terrain::targetOcculting()) along the centers of the
+//       azimuth bins, and not along the targets' profiles.  The tolerance band
+//       covers the differences between the two when the terrain elevations
+//       of nearby points (i.e., within the azimuth bins and half of a range
+//       step) differ by less than ELEVATION_TOLERANCE, so the results are the
+//       same as Terrain::targetOcculting() except on steeper terrain (e.g.,
+//       cliffs), or with wide azimuth bins.
+//
+//    2) The tables' size is 2 * 'numAzBins' * (maxRange / RANGE_STEP) floats
+//       (e.g., about 13.8MB for 1440 bins out to 120km).
+//
+//    3) Targets beyond the table's max range aren't checked (see
+//       targetOcculting()).
+//------------------------------------------------------------------------------
+class Viewshed : public base::Object
+{
+   DECLARE_SUBCLASS(Viewshed, base::Object)
+
+public:
+   static const unsigned int DEFAULT_AZIMUTH_BINS = 1440;   // 0.25 degree bins
+   static const unsigned int MIN_AZIMUTH_BINS = 4;
+   static const unsigned int MAX_RANGE_STEPS = 1200;        // Max number of range steps
+   static const double RANGE_STEP;                          // Range step (meters)
+   static const double ELEVATION_TOLERANCE;                 // Terrain elevation tolerance of the horizon band (meters)
+
+public:
+   Viewshed();
+
+   // Builds the table for the ref point [ refLat refLon refAlt ] out to 'maxRange'
+   // meters (up to MAX_RANGE_STEPS * RANGE_STEP).  Returns true if successful.
+   virtual bool build(
+         const Terrain* const terrain, // Terrain database
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double maxRange,        // Max range (meters)
+         const unsigned int numAzBins = DEFAULT_AZIMUTH_BINS   // Number of azimuth bins
+      );
+
+   // Clears the table
+   void clear();
+
+   // Terrain occulting check of a target point [ tgtLat tgtLon tgtAlt ].  Returns
+   // true, and sets 'occulted', if the target is within the table and outside of
+   // the tolerance band, otherwise false and 'occulted' is unchanged (i.e., use
+   // Terrain::targetOcculting()).
+   bool targetOcculting(
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const double tgtAlt,          // Target altitude (meters)
+         bool* const occulted          // True if the target is occulted
+      ) const;
+
+   bool isValid() const                               { return (numRngSteps > 0); }
+   double getRefLatitude() const                      { return refLat; }
+   double getRefLongitude() const                     { return refLon; }
+   double getRefAltitude() const                      { return refAlt; }
+   double getMaxRange() const                         { return (numRngSteps * RANGE_STEP); }
+   unsigned int getNumAzimuthBins() const             { return numAzBins; }
+   unsigned int getNumRangeSteps() const              { return numRngSteps; }
+
+private:
+   std::vector<float> upper;        // Tangent of the max terrain angle, raised by ELEVATION_TOLERANCE [azBin * numRngSteps + (step-1)]
+   std::vector<float> lower;        // Tangent of the max terrain angle, lowered by ELEVATION_TOLERANCE [azBin * numRngSteps + (step-1)]
+   double refLat {};                // Ref latitude (degs)
+   double refLon {};                // Ref longitude (degs)
+   double refAlt {};                // Ref altitude (meters)
+   unsigned int numAzBins {};       // Number of azimuth bins
+   unsigned int numRngSteps {};     // Number of range steps (zero if not built)
+};
+
+}
+}
+
+#endif
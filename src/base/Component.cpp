@@ -7,6 +7,7 @@
 #include "openeaagles/base/Number.hpp"
 #include "openeaagles/base/Pair.hpp"
 #include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/Profiler.hpp"
 #include "openeaagles/base/Statistic.hpp"
 #include "openeaagles/base/String.hpp"
 #include "openeaagles/base/util/system_utils.hpp"
@@ -200,7 +201,10 @@ void Component::tcFrame(const double dt)
    // ---
    // Execute one time-critical frame
    // ---
-   this->updateTC(dt);
+   {
+      ProfileScope ps("tcFrame", this);
+      this->updateTC(dt);
+   }
 
    // ---
    // Process timing data
@@ -274,7 +278,10 @@ void Component::updateData(const double dt)
     if (subcomponents != nullptr) {
         if (selection != nullptr) {
             // When we've selected only one
-            if (selected != nullptr) selected->updateData(dt);
+            if (selected != nullptr) {
+                ProfileScope ps("updateData", selected);
+                selected->updateData(dt);
+            }
         }
         else {
             // When we should update them all
@@ -282,6 +289,7 @@ void Component::updateData(const double dt)
             while (item != nullptr) {
                 const auto pair = static_cast<Pair*>(item->getValue());
                 const auto obj = static_cast<Component*>(pair->object());
+                ProfileScope ps("updateData", obj);
                 obj->updateData(dt);
                 item = item->getNext();
             }
@@ -892,6 +900,15 @@ bool Component::send(const char* const id, const int event)
     return val;
 }
 
+// Send an event message to component 'id' (found once; see SendData)
+bool Component::send(const char* const id, const int event, SendData& sd)
+{
+   bool val {};
+   Component* g = sd.getObject(this,id);
+   if (g != nullptr) val = g->event(event);
+   return val;
+}
+
 
 // Send an event message with an int value to component 'id'
 bool Component::send(const char* const id, const int event, const int value, SendData& sd)
@@ -1203,8 +1220,11 @@ std::ostream& Component::serialize(std::ostream& sout, const int i, const bool s
 void Component::SendData::empty()
 {
    obj = nullptr;
-   if (past != nullptr) past->unref();
-   past = nullptr;
+   for (unsigned int i = 0; i < NUM_VALUE_TYPES; i++) {
+      if (values[i] != nullptr) values[i]->unref();
+      values[i] = nullptr;
+   }
+   type = NONE;
 }
 
 
@@ -1245,53 +1265,41 @@ Component* Component::SendData::getObject(Component* gobj, const char* const id,
     return obj;
 }
 
+// ---
+// getValue() functions -- There's one value object for each type of value,
+// which is reused, so there are no allocations after the first value of each
+// type.  A change of the value's type is always sent.
+// ---
+
 // getValue() -- get an object containing the int value to send
 // or null(0) if the value hasn't changed.
 Object* Component::SendData::getValue(const int value)
 {
-    const auto num = dynamic_cast<Integer*>(past);
-    if (num == nullptr) {
-        if (past != nullptr) past->unref();
-        past = new Integer(value);
-        return past;
-    }
-    if (*num != value) {
-        *num = value;
-        return num;
-    }
+    auto num = static_cast<Integer*>(values[INTEGER]);
+    if (num == nullptr) values[INTEGER] = num = new Integer(value);
+    else if (type != INTEGER || *num != value) *num = value;
     else return nullptr;
+
+    type = INTEGER;
+    return num;
 }
 
 // getValue() -- get an object containing the real value to send
 // or null(0) if the value hasn't changed.
 Object* Component::SendData::getValue(const float value)
 {
-    const auto num = dynamic_cast<Float*>(past);
-    if (num == nullptr) {
-        if (past != nullptr) past->unref();
-        past = new Float(value);
-        return past;
-    }
-    if (*num != static_cast<double>(value)) {
-        *num = value;
-        return num;
-    }
-    else return nullptr;
+    return getValue(static_cast<double>(value));
 }
 
 Object* Component::SendData::getValue(const double value)
 {
-    const auto num = dynamic_cast<Number*>(past);
-    if (num == nullptr) {
-        if (past != nullptr) past->unref();
-        past = new Float(value);
-        return past;
-    }
-    if (num != nullptr && num->getDouble() != value) {
-        num->setValue(value);
-        return num;
-    }
+    auto num = static_cast<Float*>(values[FLOAT]);
+    if (num == nullptr) values[FLOAT] = num = new Float(value);
+    else if (type != FLOAT || num->getDouble() != value) num->setValue(value);
     else return nullptr;
+
+    type = FLOAT;
+    return num;
 }
 
 
@@ -1299,48 +1307,36 @@ Object* Component::SendData::getValue(const double value)
 // or null(0) if the value hasn't changed.
 Object* Component::SendData::getValue(const char* const value)
 {
-    // get our past string
-    const auto str = dynamic_cast<String*>(past);
-    if (str == nullptr) {
-        if (past != nullptr) past->unref();
-        past = new String(value);
-        return past;
-    }
+    auto str = static_cast<String*>(values[STRING]);
+    if (str == nullptr) values[STRING] = str = new String(value);
 
     // Compare our new value to our past string.
-    if (value != nullptr) {
-        if (*str != value) {
-            *str = value;
-            return str;
-        }
+    else if (value != nullptr) {
+        if (type != STRING || *str != value) *str = value;
         else return nullptr;
     }
 
     // When our value is a null string, check if the past string was null
     else {
-        if ( !str->isEmpty() ) {
-            str->empty();
-            return str;
-        }
+        if (type != STRING || !str->isEmpty()) str->empty();
         else return nullptr;
     }
+
+    type = STRING;
+    return str;
 }
 
 // getValue() -- get an object containing the boolean value to send
 // or null(0) if the value hasn't changed.
 Object* Component::SendData::getValue(const bool value)
 {
-    const auto num = dynamic_cast<Boolean*>(past);
-    if (num == nullptr) {
-        if (past != nullptr) past->unref();
-        past = new Boolean(value);
-        return past;
-    }
-    if (*num != value) {
-        *num = value;
-        return num;
-    }
+    auto num = static_cast<Boolean*>(values[BOOLEAN]);
+    if (num == nullptr) values[BOOLEAN] = num = new Boolean(value);
+    else if (type != BOOLEAN || *num != value) *num = value;
     else return nullptr;
+
+    type = BOOLEAN;
+    return num;
 }
 
 }
@@ -0,0 +1,28 @@
+#include "openeaagles/base/FactoryTable.hpp"
+
+namespace oe {
+namespace base {
+
+FactoryTable::FactoryTable(std::initializer_list<Entry> entries)
+{
+   table.reserve(entries.size());
+   for (const Entry& e : entries) {
+      if (e.name != nullptr && e.create != nullptr) {
+         table.emplace(e.name, e.create);    // keeps the first of any duplicate names
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// create() -- returns a new object of the class named 'name', or zero
+//------------------------------------------------------------------------------
+Object* FactoryTable::create(const std::string& name) const
+{
+   Object* obj {};
+   const auto it = table.find(name);
+   if (it != table.end()) obj = (it->second)();
+   return obj;
+}
+
+}
+}
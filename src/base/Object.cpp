@@ -157,6 +157,19 @@ bool Object::setSlotByName(const char* const slotname, Object* const obj)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// setSlotByNumber() -- set the value of slot number 'slotnumber', [ 1 .. n() ]
+//                 (see SlotTable), to 'obj'.  Returns true if the slot and
+//                 object were processed; returns false if there was an error.
+//------------------------------------------------------------------------------
+bool Object::setSlotByNumber(const int slotnumber, Object* const obj)
+{
+    bool ok = false;
+    if (obj == nullptr || slotnumber <= 0 || slotnumber > static_cast<int>(slotTable->n())) return ok;
+    ok = setSlotByIndex(slotnumber,obj);
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // slotIndex2Name() -- returns the name of the slot at 'slotindex'
 //------------------------------------------------------------------------------
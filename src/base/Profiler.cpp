@@ -0,0 +1,432 @@
+#include "openeaagles/base/Profiler.hpp"
+
+#include "openeaagles/base/Number.hpp"
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace oe {
+namespace base {
+
+//==============================================================================
+// Per-thread event buffers
+//==============================================================================
+namespace {
+
+struct ThreadBuffer {
+   std::vector<Profiler::Event> events;           // Ring buffer of events (power of two size)
+   std::atomic<unsigned long long> count {};      // Total number of events recorded
+   unsigned int tid {};                           // Thread index (trace 'tid')
+};
+
+std::vector<ThreadBuffer*> buffers;               // All thread buffers
+long buffersLock {};                              // Semaphore for 'buffers'
+unsigned int newBufferSize {Profiler::DEFAULT_BUFFER_SIZE};
+
+thread_local ThreadBuffer* threadBuffer {};       // This thread's buffer
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// Creates and registers this thread's buffer
+ThreadBuffer* createThreadBuffer()
+{
+   const auto p = new ThreadBuffer();
+   lock(buffersLock);
+   unsigned int n = 2;
+   while (n < newBufferSize) n *= 2;
+   p->events.resize(n);
+   buffers.push_back(p);
+   p->tid = static_cast<unsigned int>(buffers.size());
+   unlock(buffersLock);
+   return p;
+}
+
+// Returns the demangled type name
+std::string typeName(const char* const name)
+{
+   std::string str(name);
+   #if defined(__GNUC__)
+      int status = 0;
+      char* p = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+      if (p != nullptr) {
+         if (status == 0) str = p;
+         std::free(p);
+      }
+   #endif
+   return str;
+}
+
+// Returns the event's full name: '<type>.<name>', or '<name>'
+std::string eventName(const Profiler::Event& e, std::map<const char*, std::string>* const types)
+{
+   if (e.type == nullptr) return std::string(e.name);
+   auto it = types->find(e.type);
+   if (it == types->end()) it = types->insert(std::make_pair(e.type, typeName(e.type))).first;
+   return it->second + "." + e.name;
+}
+
+// Writes a JSON string
+void writeString(std::ostream& sout, const std::string& str)
+{
+   sout << '"';
+   for (const char c : str) {
+      if (c == '"' || c == '\\') sout << '\\';
+      sout << c;
+   }
+   sout << '"';
+}
+
+// Copies the thread's most recent events, oldest first
+void copyEvents(const ThreadBuffer* const b, std::vector<Profiler::Event>* const list)
+{
+   const unsigned long long size = b->events.size();
+   const unsigned long long n = b->count.load(std::memory_order_acquire);
+   const unsigned long long first = (n > size ? n - size : 0);
+   list->clear();
+   for (unsigned long long i = first; i < n; i++) {
+      list->push_back(b->events[static_cast<std::size_t>(i & (size - 1))]);
+   }
+}
+
+}
+
+//==============================================================================
+// Class Profiler
+//==============================================================================
+IMPLEMENT_SUBCLASS(Profiler, "Profiler")
+
+BEGIN_SLOTTABLE(Profiler)
+   "enable",         // 1) Enable the profiler (default: true)
+   "bufferSize",     // 2) Max number of events kept per thread
+   "filename",       // 3) Trace file written at shutdown
+   "printSummary",   // 4) Print the event summary at shutdown
+END_SLOTTABLE(Profiler)
+
+BEGIN_SLOT_MAP(Profiler)
+   ON_SLOT( 1, setSlotEnable,       Number)
+   ON_SLOT( 2, setSlotBufferSize,   Number)
+   ON_SLOT( 3, setSlotFilename,     String)
+   ON_SLOT( 4, setSlotPrintSummary, Number)
+END_SLOT_MAP()
+
+std::atomic<bool> Profiler::enabled {};
+
+Profiler::Profiler()
+{
+   STANDARD_CONSTRUCTOR()
+   setProfilerEnabled(true);
+}
+
+void Profiler::copyData(const Profiler& org, const bool cc)
+{
+   BaseClass::copyData(org);
+
+   if (cc) active = false;
+   bufferSize = org.bufferSize;
+   setFilename(org.filename);
+   summaryFlg = org.summaryFlg;
+   setProfilerEnabled(org.enableFlg);
+}
+
+void Profiler::deleteData()
+{
+   setProfilerEnabled(false);
+   setFilename(nullptr);
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- stop recording; write the trace and the summary
+//------------------------------------------------------------------------------
+bool Profiler::shutdownNotification()
+{
+   if (active) {
+      setProfilerEnabled(false);
+
+      if (filename != nullptr && filename->len() > 0) {
+         if (!writeTrace(*filename) && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "Profiler::shutdownNotification(): unable to write trace file: " << *filename << std::endl;
+         }
+      }
+      if (summaryFlg) printSummary(std::cout);
+   }
+
+   return BaseClass::shutdownNotification();
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool Profiler::setProfilerEnabled(const bool flg)
+{
+   enableFlg = flg;
+   if (flg) {
+      lock(buffersLock);
+      newBufferSize = bufferSize;
+      unlock(buffersLock);
+      enabled = true;
+      active = true;
+   }
+   else if (active) {
+      enabled = false;
+      active = false;
+   }
+   return true;
+}
+
+bool Profiler::setBufferSize(const unsigned int n)
+{
+   bool ok = false;
+   if (n >= MIN_BUFFER_SIZE) {
+      bufferSize = n;
+      if (active) {
+         lock(buffersLock);
+         newBufferSize = bufferSize;
+         unlock(buffersLock);
+      }
+      ok = true;
+   }
+   return ok;
+}
+
+bool Profiler::setFilename(const String* const name)
+{
+   if (filename != nullptr) filename->unref();
+   filename = name;
+   if (filename != nullptr) filename->ref();
+   return true;
+}
+
+bool Profiler::setSummaryEnabled(const bool flg)
+{
+   summaryFlg = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Event recording
+//------------------------------------------------------------------------------
+
+// Profiler time (nanoseconds)
+long long Profiler::getTime()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// Records an event in this thread's buffer
+void Profiler::record(const char* const name, const char* const type, const void* const object,
+                      const long long start, const long long end)
+{
+   ThreadBuffer* b = threadBuffer;
+   if (b == nullptr) {
+      b = createThreadBuffer();
+      threadBuffer = b;
+   }
+
+   const unsigned long long n = b->count.load(std::memory_order_relaxed);
+   Event& e = b->events[static_cast<std::size_t>(n & (b->events.size() - 1))];
+   e.name = name;
+   e.type = type;
+   e.object = object;
+   e.start = start;
+   e.duration = end - start;
+   b->count.store(n + 1, std::memory_order_release);
+}
+
+// Clears the events
+void Profiler::clear()
+{
+   lock(buffersLock);
+   for (ThreadBuffer* b : buffers) {
+      b->count = 0;
+   }
+   unlock(buffersLock);
+}
+
+//------------------------------------------------------------------------------
+// Exports
+//------------------------------------------------------------------------------
+
+// Writes the events as a Chrome trace (JSON) file
+bool Profiler::writeTrace(const char* const name)
+{
+   bool ok = false;
+   if (name != nullptr) {
+      std::ofstream sout(name);
+      if (sout.is_open()) {
+         writeTrace(sout);
+         sout.close();
+         ok = !sout.fail();
+      }
+   }
+   return ok;
+}
+
+// Writes the events as a Chrome trace (JSON) stream
+void Profiler::writeTrace(std::ostream& sout)
+{
+   lock(buffersLock);
+   const std::vector<ThreadBuffer*> list = buffers;
+   unlock(buffersLock);
+
+   std::map<const char*, std::string> types;
+   std::vector<Event> events;
+   char buff[64] {};
+   bool first = true;
+
+   sout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+   for (const ThreadBuffer* b : list) {
+      // Thread name
+      sout << (first ? "\n" : ",\n");
+      sout << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid;
+      sout << ",\"args\":{\"name\":\"thread " << b->tid << "\"}}";
+      first = false;
+
+      // Complete ('X') events; times in microseconds
+      copyEvents(b, &events);
+      for (const Event& e : events) {
+         sout << ",\n{\"name\":";
+         writeString(sout, eventName(e, &types));
+         sout << ",\"cat\":";
+         writeString(sout, e.name);
+         std::snprintf(buff, sizeof(buff), "%.3f", static_cast<double>(e.start) / 1000.0);
+         sout << ",\"ph\":\"X\",\"ts\":" << buff;
+         std::snprintf(buff, sizeof(buff), "%.3f", static_cast<double>(e.duration) / 1000.0);
+         sout << ",\"dur\":" << buff;
+         sout << ",\"pid\":1,\"tid\":" << b->tid;
+         if (e.object != nullptr) {
+            std::snprintf(buff, sizeof(buff), "%p", e.object);
+            sout << ",\"args\":{\"object\":\"" << buff << "\"}";
+         }
+         sout << "}";
+      }
+   }
+   sout << "\n]}" << std::endl;
+}
+
+// Prints the count, mean, max and total times (ms) of each event type
+void Profiler::printSummary(std::ostream& sout)
+{
+   struct Totals {
+      unsigned long long n {};
+      long long total {};
+      long long max {};
+   };
+
+   lock(buffersLock);
+   const std::vector<ThreadBuffer*> list = buffers;
+   unlock(buffersLock);
+
+   std::map<const char*, std::string> types;
+   std::map<std::string, Totals> totals;
+   std::vector<Event> events;
+   for (const ThreadBuffer* b : list) {
+      copyEvents(b, &events);
+      for (const Event& e : events) {
+         Totals& t = totals[eventName(e, &types)];
+         t.n++;
+         t.total += e.duration;
+         if (e.duration > t.max) t.max = e.duration;
+      }
+   }
+
+   // Largest total first
+   std::vector<std::pair<std::string, Totals>> sorted(totals.begin(), totals.end());
+   std::sort(sorted.begin(), sorted.end(),
+      [](const std::pair<std::string, Totals>& a, const std::pair<std::string, Totals>& b) { return a.second.total > b.second.total; });
+
+   char buff[128] {};
+   sout << "Profiler summary:        count     mean(ms)      max(ms)    total(ms)   event" << std::endl;
+   for (const auto& item : sorted) {
+      const Totals& t = item.second;
+      std::snprintf(buff, sizeof(buff), "                  %12llu %12.4f %12.4f %12.3f   ",
+                    t.n, (static_cast<double>(t.total) / static_cast<double>(t.n)) / 1.0e6,
+                    static_cast<double>(t.max) / 1.0e6, static_cast<double>(t.total) / 1.0e6);
+      sout << buff << item.first << std::endl;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool Profiler::setSlotEnable(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setProfilerEnabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+bool Profiler::setSlotBufferSize(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) ok = setBufferSize( static_cast<unsigned int>(n) );
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Profiler::setSlotBufferSize(): invalid buffer size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Profiler::setSlotFilename(const String* const msg)
+{
+   return setFilename(msg);
+}
+
+bool Profiler::setSlotPrintSummary(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setSummaryEnabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+std::ostream& Profiler::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+   int j = 0;
+   if ( !slotsOnly ) {
+      sout << "( " << getFactoryName() << std::endl;
+      j = 4;
+   }
+
+   indent(sout,i+j);
+   sout << "enable: " << (enableFlg ? "true" : "false") << std::endl;
+
+   indent(sout,i+j);
+   sout << "bufferSize: " << bufferSize << std::endl;
+
+   if (filename != nullptr) {
+      indent(sout,i+j);
+      sout << "filename: \"" << *filename << "\"" << std::endl;
+   }
+
+   indent(sout,i+j);
+   sout << "printSummary: " << (summaryFlg ? "true" : "false") << std::endl;
+
+   BaseClass::serialize(sout,i+j,true);
+
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << ")" << std::endl;
+   }
+
+   return sout;
+}
+
+}
+}
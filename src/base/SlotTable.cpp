@@ -10,6 +10,7 @@ SlotTable::SlotTable(const char* s[], const unsigned int ns, const SlotTable& ba
    baseTable = const_cast<SlotTable*>(&base);
    slots1 = const_cast<char**>(s);
    nslots1 = ns;
+   buildHashTable();
 }
 
 SlotTable::SlotTable(const char* s[], const unsigned int ns)
@@ -17,6 +18,7 @@ SlotTable::SlotTable(const char* s[], const unsigned int ns)
    baseTable = nullptr;
    slots1 = const_cast<char**>(s);
    nslots1 = ns;
+   buildHashTable();
 }
 
 SlotTable::~SlotTable()
@@ -24,6 +26,50 @@ SlotTable::~SlotTable()
    baseTable = nullptr;
    slots1 = nullptr;
    nslots1 = 0;
+
+   delete[] hashes1;
+   hashes1 = nullptr;
+   delete[] buckets;
+   buckets = nullptr;
+   mask = 0;
+}
+
+//------------------------------------------------------------------------------
+// hash() -- slot name hash (FNV-1a)
+//------------------------------------------------------------------------------
+unsigned int SlotTable::hash(const char* const slotname)
+{
+   unsigned int h = 2166136261u;
+   for (const char* p = slotname; *p != '\0'; p++) {
+      h ^= static_cast<unsigned char>(*p);
+      h *= 16777619u;
+   }
+   return h;
+}
+
+//------------------------------------------------------------------------------
+// buildHashTable() -- builds the hash table of our slot names
+//------------------------------------------------------------------------------
+void SlotTable::buildHashTable()
+{
+   if (slots1 == nullptr || nslots1 == 0) return;
+
+   // table size: a power of two that's at least twice the number of slots
+   unsigned int size = 4;
+   while (size < (2 * nslots1)) size *= 2;
+   mask = size - 1;
+
+   hashes1 = new unsigned int[nslots1];
+   buckets = new unsigned int[size];
+   for (unsigned int k = 0; k < size; k++) buckets[k] = 0;
+
+   // in slot order, so the first of any duplicate names is found first
+   for (unsigned int j = 0; j < nslots1; j++) {
+      hashes1[j] = hash(slots1[j]);
+      unsigned int k = (hashes1[j] & mask);
+      while (buckets[k] != 0) k = ((k + 1) & mask);
+      buckets[k] = (j + 1);
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -65,26 +111,33 @@ const char* SlotTable::name(const unsigned int slotindex) const
 // index() -- returns the index of the slot named 'slotname'
 //------------------------------------------------------------------------------
 unsigned int SlotTable::index(const char* const slotname) const
+{
+   if (slotname == nullptr) return 0;
+   return index(slotname, hash(slotname));
+}
+
+unsigned int SlotTable::index(const char* const slotname, const unsigned int h) const
 {
    unsigned int i = 0;
 
    // First, check our slot names
-   {
-      // search our table
-      unsigned int j;
-      for (j = 0; j < nslots1; j++) {
-         if (std::strcmp(slotname, slots1[j]) == 0) break;
-      }
-      if (j < nslots1) {
-         // if we're here, we found a match
-         i = j;                                    // a) start with j
-         i++;                                      // b) make it one based
-         if (baseTable != nullptr) i += baseTable->n();  // c) add baseTable->n()
+   if (buckets != nullptr) {
+      // probe our hash table
+      unsigned int k = (h & mask);
+      while (buckets[k] != 0 && i == 0) {
+         const unsigned int j = buckets[k] - 1;
+         if (hashes1[j] == h && std::strcmp(slotname, slots1[j]) == 0) {
+            // if we're here, we found a match
+            i = j;                                    // a) start with j
+            i++;                                      // b) make it one based
+            if (baseTable != nullptr) i += baseTable->n();  // c) add baseTable->n()
+         }
+         k = ((k + 1) & mask);
       }
    }
 
    // Second, check our baseTable
-   if (i == 0 && baseTable != nullptr) i = baseTable->index(slotname);
+   if (i == 0 && baseTable != nullptr) i = baseTable->index(slotname, h);
 
    return i;
 }
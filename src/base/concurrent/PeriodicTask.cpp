@@ -3,6 +3,7 @@
 
 #include "openeaagles/base/Component.hpp"
 #include <iostream>
+#include <cmath>
 
 namespace oe {
 namespace base {
@@ -12,6 +13,21 @@ EMPTY_SLOTTABLE(PeriodicTask)
 EMPTY_SERIALIZER(PeriodicTask)
 EMPTY_DELETEDATA(PeriodicTask)
 
+// Upper limit of the first histogram bin (seconds)
+static const double HIST_BIN0 = 10.0e-6;
+
+// Histogram bin of the time 't' (seconds)
+static unsigned int histogramBin(const double t)
+{
+   unsigned int bin = 0;
+   double limit = HIST_BIN0;
+   while (t >= limit && bin < (PeriodicTask::NUM_HIST_BINS-1)) {
+      limit *= 2.0;
+      bin++;
+   }
+   return bin;
+}
+
 PeriodicTask::PeriodicTask(Component* const p, const double pri, const double rt) : Thread(p, pri), rate(rt)
 {
    STANDARD_CONSTRUCTOR()
@@ -60,5 +76,178 @@ bool PeriodicTask::setVariableDeltaTimeFlag(const bool enable)
    return true;
 }
 
+const Statistic& PeriodicTask::getJitterStats() const
+{
+   return jitStats;
+}
+
+unsigned int PeriodicTask::getJitterHistogram(unsigned int* const bins, const unsigned int n) const
+{
+   unsigned int i = 0;
+   if (bins != nullptr) {
+      for (; i < n && i < NUM_HIST_BINS; i++) bins[i] = jitHist[i];
+   }
+   return i;
+}
+
+unsigned int PeriodicTask::getOverrunHistogram(unsigned int* const bins, const unsigned int n) const
+{
+   unsigned int i = 0;
+   if (bins != nullptr) {
+      for (; i < n && i < NUM_HIST_BINS; i++) bins[i] = ovrHist[i];
+   }
+   return i;
+}
+
+double PeriodicTask::getHistogramBinLimit(const unsigned int bin)
+{
+   double limit = HIST_BIN0;
+   if (bin >= (NUM_HIST_BINS-1)) limit = HUGE_VAL;
+   else {
+      for (unsigned int i = 0; i < bin; i++) limit *= 2.0;
+   }
+   return limit;
+}
+
+unsigned int PeriodicTask::getSkippedFrameCount() const
+{
+   return skipCnt;
+}
+
+void PeriodicTask::clearFrameStats()
+{
+   bfStats.clear();
+   jitStats.clear();
+   for (unsigned int i = 0; i < NUM_HIST_BINS; i++) {
+      jitHist[i] = 0;
+      ovrHist[i] = 0;
+   }
+   skipCnt = 0;
+}
+
+PeriodicTask::OverrunPolicy PeriodicTask::getOverrunPolicy() const
+{
+   return policy;
+}
+
+bool PeriodicTask::setOverrunPolicy(const OverrunPolicy p)
+{
+   policy = p;
+   return true;
+}
+
+unsigned int PeriodicTask::getMaxCatchUpFrames() const
+{
+   return maxCatchUp;
+}
+
+bool PeriodicTask::setMaxCatchUpFrames(const unsigned int n)
+{
+   maxCatchUp = n;
+   return true;
+}
+
+unsigned int PeriodicTask::getRecoveryFrames() const
+{
+   return recoveryFrames;
+}
+
+bool PeriodicTask::setRecoveryFrames(const unsigned int n)
+{
+   recoveryFrames = n;
+   return true;
+}
+
+bool PeriodicTask::isDegraded() const
+{
+   return degraded;
+}
+
+int PeriodicTask::getCpuAffinity() const
+{
+   return cpu;
+}
+
+bool PeriodicTask::setCpuAffinity(const int c)
+{
+   cpu = (c >= 0 ? c : -1);
+   return true;
+}
+
+bool PeriodicTask::isRealtimeEnabled() const
+{
+   return rtFlg;
+}
+
+bool PeriodicTask::setRealtimeEnabled(const bool enable)
+{
+   rtFlg = enable;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// degradedModeChanged() -- entering or leaving the degraded mode; derived
+// classes tell their parent (nothing to do here)
+//------------------------------------------------------------------------------
+void PeriodicTask::degradedModeChanged(const bool)
+{
+}
+
+//------------------------------------------------------------------------------
+// startOfFrame() -- collect the frame start time jitter (seconds)
+//------------------------------------------------------------------------------
+void PeriodicTask::startOfFrame(const double jitter)
+{
+   const double t = (jitter > 0.0 ? jitter : 0.0);
+   jitStats.sigma(t);
+   jitHist[histogramBin(t)]++;
+}
+
+//------------------------------------------------------------------------------
+// endOfFrame() -- handles the end of frame timing, where 'late' is how long
+// (seconds) after the start time of the next frame that we've finished; it's
+// zero or less if we're on time.  Returns the number of frames to skip.
+//------------------------------------------------------------------------------
+unsigned int PeriodicTask::endOfFrame(const double late, const double period)
+{
+   unsigned int skip = 0;
+
+   if (late > 0.0) {
+      // Frame overrun
+      bfStats.sigma(late);
+      ovrHist[histogramBin(late)]++;
+      onTimeCnt = 0;
+
+      // Skip to the first frame start time that's still ahead of us
+      const auto missed = static_cast<unsigned int>(std::floor(late / period)) + 1;
+
+      if (policy == CATCH_UP) {
+         catchUpCnt++;
+         if (maxCatchUp > 0 && catchUpCnt > maxCatchUp) {
+            skip = missed;
+            catchUpCnt = 0;
+         }
+      }
+      else {
+         skip = missed;
+         if (policy == DEGRADE && !degraded) {
+            degraded = true;
+            degradedModeChanged(true);
+         }
+      }
+   }
+   else {
+      catchUpCnt = 0;
+      onTimeCnt++;
+      if (degraded && onTimeCnt >= recoveryFrames) {
+         degraded = false;
+         degradedModeChanged(false);
+      }
+   }
+
+   skipCnt += skip;
+   return skip;
+}
+
 }
 }
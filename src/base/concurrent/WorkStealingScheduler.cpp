@@ -0,0 +1,137 @@
+
+#include "openeaagles/base/concurrent/WorkStealingScheduler.hpp"
+
+namespace oe {
+namespace base {
+
+//-----------------------------------------------------------------------------
+// partition() -- splits items [ 0 .. n-1 ] into cost-weighted chunks and
+// assigns contiguous ranges of chunks to the 'nw' workers
+//-----------------------------------------------------------------------------
+void WorkStealingScheduler::partition(const double* const costs, const unsigned int n, const unsigned int nw)
+{
+   numWorkers = nw;
+   if (numWorkers < 1) numWorkers = 1;
+   if (numWorkers > MAX_WORKERS) numWorkers = MAX_WORKERS;
+
+   steals.store(0, std::memory_order_relaxed);
+
+   // Total cost of all items (equal costs if none were given)
+   double total = 0.0;
+   if (costs != nullptr) {
+      for (unsigned int i = 0; i < n; i++) {
+         if (costs[i] > 0.0) total += costs[i];
+      }
+   }
+   const bool equalCosts = (costs == nullptr || total <= 0.0);
+   if (equalCosts) total = static_cast<double>(n);
+
+   // ---
+   // Cut the items into chunks of roughly equal cost; a single item
+   // that costs more than the target ends up in a chunk by itself.
+   // ---
+   chunkStart.clear();
+   chunkStart.push_back(0);
+   if (n > 0) {
+      const double target = total / static_cast<double>(numWorkers * CHUNKS_PER_WORKER);
+      double acc = 0.0;
+      for (unsigned int i = 0; i < n; i++) {
+         acc += (equalCosts ? 1.0 : (costs[i] > 0.0 ? costs[i] : 0.0));
+         if (acc >= target && (i+1) < n) {
+            chunkStart.push_back(i+1);
+            acc = 0.0;
+         }
+      }
+      chunkStart.push_back(n);
+   }
+   numChunks = static_cast<unsigned int>(chunkStart.size() - 1);
+
+   // ---
+   // Assign contiguous ranges of chunks to the workers so that each
+   // worker's share of the total cost is about the same.  A chunk
+   // belongs to the worker whose share contains the chunk's midpoint.
+   // ---
+   const double share = (total > 0.0 ? total / static_cast<double>(numWorkers) : 1.0);
+   unsigned int w = 0;
+   unsigned int first = 0;
+   double acc = 0.0;
+   for (unsigned int c = 0; c < numChunks; c++) {
+      double cc = 0.0;
+      for (unsigned int i = chunkStart[c]; i < chunkStart[c+1]; i++) {
+         cc += (equalCosts ? 1.0 : (costs[i] > 0.0 ? costs[i] : 0.0));
+      }
+      unsigned int cw = static_cast<unsigned int>((acc + cc/2.0) / share);
+      if (cw >= numWorkers) cw = numWorkers - 1;
+      while (w < cw) {
+         ranges[w].ht.store(pack(first, c), std::memory_order_relaxed);
+         first = c;
+         w++;
+      }
+      acc += cc;
+   }
+   while (w < numWorkers) {
+      ranges[w].ht.store(pack(first, numChunks), std::memory_order_relaxed);
+      first = numChunks;
+      w++;
+   }
+
+   // Publish the new partition to the workers
+   std::atomic_thread_fence(std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// getNextChunk() -- next chunk for worker 'w'; our own chunks first, then
+// steal from the other workers.
+//-----------------------------------------------------------------------------
+bool WorkStealingScheduler::getNextChunk(const unsigned int w, unsigned int* const begin, unsigned int* const end)
+{
+   if (w >= numWorkers || begin == nullptr || end == nullptr) return false;
+
+   unsigned int c = 0;
+   bool found = popOwn(w, &c);
+   for (unsigned int k = 1; !found && k < numWorkers; k++) {
+      found = steal( (w + k) % numWorkers, &c );
+      if (found) steals.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   if (found) {
+      *begin = chunkStart[c];
+      *end = chunkStart[c+1];
+   }
+   return found;
+}
+
+// Pops a chunk from the front of worker 'w's own range
+bool WorkStealingScheduler::popOwn(const unsigned int w, unsigned int* const c)
+{
+   std::atomic<unsigned long long>& ht = ranges[w].ht;
+   unsigned long long r = ht.load(std::memory_order_acquire);
+   for (;;) {
+      const auto h = static_cast<unsigned int>(r & 0xffffffff);
+      const auto t = static_cast<unsigned int>(r >> 32);
+      if (h >= t) return false;
+      if (ht.compare_exchange_weak(r, pack(h+1, t), std::memory_order_acq_rel, std::memory_order_acquire)) {
+         *c = h;
+         return true;
+      }
+   }
+}
+
+// Steals a chunk from the back of worker 'v's range
+bool WorkStealingScheduler::steal(const unsigned int v, unsigned int* const c)
+{
+   std::atomic<unsigned long long>& ht = ranges[v].ht;
+   unsigned long long r = ht.load(std::memory_order_acquire);
+   for (;;) {
+      const auto h = static_cast<unsigned int>(r & 0xffffffff);
+      const auto t = static_cast<unsigned int>(r >> 32);
+      if (h >= t) return false;
+      if (ht.compare_exchange_weak(r, pack(h, t-1), std::memory_order_acq_rel, std::memory_order_acquire)) {
+         *c = t - 1;
+         return true;
+      }
+   }
+}
+
+}
+}
@@ -5,6 +5,10 @@
 #include "openeaagles/base/util/math_utils.hpp"
 #include "openeaagles/base/util/system_utils.hpp"
 
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <iostream>
 
@@ -14,6 +18,50 @@ namespace base {
 // max number of processors we'll allow
 static const unsigned int MAX_CPUS = 32;
 
+// Adds 'ns' nanoseconds to the time 'tp'
+static void addTime(struct timespec* const tp, const long long ns)
+{
+   const long long t = static_cast<long long>(tp->tv_nsec) + ns;
+   tp->tv_sec += static_cast<time_t>(t / 1000000000LL);
+   tp->tv_nsec = static_cast<long>(t % 1000000000LL);
+}
+
+// Time from 't0' to 't1' (seconds)
+static double deltaTime(const struct timespec& t0, const struct timespec& t1)
+{
+   return static_cast<double>(t1.tv_sec - t0.tv_sec) + static_cast<double>(t1.tv_nsec - t0.tv_nsec) / 1000000000.0;
+}
+
+//-----------------------------------------------------------------------------
+// Sets the CPU affinity and the realtime scheduling of this thread
+//-----------------------------------------------------------------------------
+void PeriodicTask::configTiming()
+{
+   if (cpu >= 0) {
+      int stat = -1;
+      if (cpu < CPU_SETSIZE) {
+         cpu_set_t mask;
+         CPU_ZERO(&mask);
+         CPU_SET(cpu, &mask);
+         stat = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask);
+      }
+      if (stat != 0 && getParent()->isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "Thread(" << this << ")::configTiming(): unable to set the CPU affinity to " << cpu << std::endl;
+      }
+   }
+
+   if (rtFlg) {
+      const int maxp = sched_get_priority_max(SCHED_FIFO);
+      const int minp = sched_get_priority_min(SCHED_FIFO);
+      struct sched_param param;
+      param.sched_priority = nint(minp + getPriority() * (maxp - minp));
+      const int stat = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+      if (stat != 0 && getParent()->isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "Thread(" << this << ")::configTiming(): unable to set SCHED_FIFO priority " << param.sched_priority << std::endl;
+      }
+   }
+}
+
 //-----------------------------------------------------------------------------
 // Our main thread function
 //-----------------------------------------------------------------------------
@@ -24,52 +72,56 @@ unsigned long PeriodicTask::mainThreadFunc()
       std::cout << "Thread(" << this << ")::mainLoopFunc(): Starting main loop ..." << std::endl;
    }
 
-   // Delta time
-   const double dt = 1.0/static_cast<double>(getRate());
-   int sec0 = static_cast<int>(dt);
-   int nsec0 = static_cast<int>((dt - static_cast<double>(sec0)) * 1000000000.0);
+   configTiming();
 
-   // Reference time
-   struct timespec tp;
-   clock_gettime(CLOCK_REALTIME, &tp);
+   // Delta time and frame period (nanoseconds)
+   const double dt = 1.0/static_cast<double>(getRate());
+   const long long period = static_cast<long long>(dt * 1000000000.0 + 0.5);
 
-   // Mutex
-   pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
-   pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-   pthread_mutex_lock(&mutex);
+   // Start time of the next frame
+   struct timespec next;
+   clock_gettime(CLOCK_MONOTONIC, &next);
 
    // ---
    // Inital wait for one frame --
    // --- Linux seems to need this otherwise the userFunc() call failes.
    // ---
-   tp.tv_nsec += (nsec0);
-   if (tp.tv_nsec >= 1000000000) {
-      tp.tv_sec++;
-      tp.tv_nsec -= 1000000000;
-   }
-   pthread_cond_timedwait(&cond, &mutex, &tp);
+   addTime(&next, period);
+   while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) == EINTR) {}
 
+   double dt0 = dt;
    while (!getParent()->isShutdown()) {
 
+      // ---
+      // Frame start time jitter
+      // ---
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      startOfFrame(deltaTime(next, now));
+
       // ---
       // User defined tasks
       // ---
-      this->userFunc(dt);
+      this->userFunc(dt0);
       tcnt++;
 
       // ---
-      // Wait for the end of frame
+      // Overrun check and the start time of the next frame
       // ---
-      tp.tv_nsec += (nsec0);
-      if (tp.tv_nsec >= 1000000000) {
-         tp.tv_sec++;
-         tp.tv_nsec -= 1000000000;
-      }
-      pthread_cond_timedwait(&cond, &mutex, &tp);
+      addTime(&next, period);
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      const unsigned int skip = endOfFrame(deltaTime(next, now), dt);
+      if (skip > 0) addTime(&next, period * skip);
 
-   }
+      dt0 = dt;
+      if (vdtFlg) dt0 += dt * skip;
 
-   pthread_mutex_unlock(&mutex);
+      // ---
+      // Wait for the start of the next frame
+      // ---
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) == EINTR) {}
+
+   }
 
    if (getParent()->isMessageEnabled(MSG_INFO) ) {
       std::cout << "Thread(" << this << ")::mainLoopFunc(): ... end of main loop." << std::endl;
@@ -18,6 +18,21 @@ namespace base {
 // max number of processors we'll allow
 static const unsigned int MAX_CPUS = 32;
 
+//-----------------------------------------------------------------------------
+// Sets the CPU affinity of this thread (the process priority class sets the
+// realtime scheduling; see Thread)
+//-----------------------------------------------------------------------------
+void PeriodicTask::configTiming()
+{
+   if (cpu >= 0) {
+      DWORD_PTR mask = 0;
+      if (static_cast<unsigned int>(cpu) < MAX_CPUS) mask = (static_cast<DWORD_PTR>(1) << cpu);
+      if ((mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) && getParent()->isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "ThreadPeriodicTask(" << this << ")::configTiming(): unable to set the CPU affinity to " << cpu << std::endl;
+      }
+   }
+}
+
 //-----------------------------------------------------------------------------
 // Our main thread function
 //-----------------------------------------------------------------------------
@@ -27,6 +42,7 @@ unsigned long PeriodicTask::mainThreadFunc()
 
    // Configure this thread
    bool ok = configThread();
+   configTiming();
 
    if ( getParent()->isMessageEnabled(MSG_INFO) ) {
       std::cout << "ThreadPeriodicTask(" << this << ")::mainThreadFunc(): thread handle = " << getThreadHandle() << std::endl;
@@ -36,29 +52,39 @@ unsigned long PeriodicTask::mainThreadFunc()
 
    // All of the real work is done by ...
    if (ok) {
-      double refTime = 0.0;                                  // Reference time
-      const double startTime = getComputerTime();;           // Computer's time of day (sec) run started
-      double dt = 1.0/static_cast<double>(getRate());
+      double refTime = 0.0;                                  // Reference time (start of this frame)
+      const double startTime = getComputerTime();            // Computer's time of day (sec) run started
+      const double period = 1.0/static_cast<double>(getRate());
+      double dt = period;
 
       while (!getParent()->isShutdown()) {
 
+         // ---
+         // Frame start time jitter
+         // ---
+         startOfFrame((getComputerTime() - startTime) - refTime);
+
          // ---
          // User defined tasks
          // ---
          this->userFunc(dt);
+         tcnt++;
 
          // ---
          // Wait for the start of the next frame
          // ---
          {
             // Update reference time at the start of next frame
-            refTime = (refTime + dt);
+            refTime = (refTime + period);
 
-            // Current computer time
-            const double time = getComputerTime();
+            // Actual run time; how late are we?
+            const double t0 = (getComputerTime() - startTime);
+            const unsigned int skip = endOfFrame(t0 - refTime, period);
+            refTime += (period * skip);
 
-            // Actual run time
-            const double t0 = (time - startTime);
+            // Compute next delta time
+            dt = period;
+            if (vdtFlg) dt += (period * skip);
 
             // How long should we sleep for
             const double st = refTime - t0;
@@ -66,19 +92,6 @@ unsigned long PeriodicTask::mainThreadFunc()
 
             // wait for the next frame
             if (sleepFor > 0) Sleep(sleepFor);
-
-            // Compute next delta time and update frame stats
-            dt = 1.0/static_cast<double>(getRate());
-            if (st < 0) {
-               const double overrun = -st;
-               bfStats.sigma(overrun);
-               if (vdtFlg) {
-                  // adjust for overrun
-                  dt += overrun;
-                  refTime += overrun;
-               }
-            }
-            tcnt++;
          }
       }
    }
@@ -0,0 +1,405 @@
+#include "EdlCompiler.hpp"
+
+#include "openeaagles/base/Object.hpp"
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/Identifier.hpp"
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/Float.hpp"
+#include "openeaagles/base/Boolean.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/List.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace oe {
+namespace base {
+
+// File header
+namespace {
+struct Header {
+   char magic[8];
+   unsigned int version;
+   unsigned int unused;
+   unsigned long long srcSize;
+   unsigned long long srcHash;
+   unsigned int numStrings;
+   unsigned int codeSize;
+};
+const char MAGIC[8] = { 'O', 'E', 'E', 'D', 'L', 'C', 0, 0 };
+}
+
+//------------------------------------------------------------------------------
+// Recording
+//------------------------------------------------------------------------------
+
+void EdlCompiler::u32(const unsigned int v)
+{
+   const unsigned char* const p = reinterpret_cast<const unsigned char*>(&v);
+   code.insert(code.end(), p, p + sizeof(v));
+}
+
+unsigned int EdlCompiler::str(const char* const s)
+{
+   const std::string key(s != nullptr ? s : "");
+   const auto it = stringIdx.find(key);
+   if (it != stringIdx.end()) return it->second;
+
+   const unsigned int idx = static_cast<unsigned int>(strings.size());
+   strings.push_back(key);
+   stringIdx.emplace(key, idx);
+   return idx;
+}
+
+void EdlCompiler::integer(const long n)
+{
+   op(OP_INTEGER);
+   const long long v = n;
+   const unsigned char* const p = reinterpret_cast<const unsigned char*>(&v);
+   code.insert(code.end(), p, p + sizeof(v));
+}
+
+void EdlCompiler::floating(const double d)
+{
+   op(OP_FLOAT);
+   const unsigned char* const p = reinterpret_cast<const unsigned char*>(&d);
+   code.insert(code.end(), p, p + sizeof(d));
+}
+
+// Records the factory name and the slot numbers of the arguments, as
+// resolved by the object (zero if not found)
+void EdlCompiler::form(const char* const name, const Object* const obj, const PairStream* const args)
+{
+   op(OP_FORM);
+   u32(str(name));
+   const unsigned int n = (args != nullptr ? args->entries() : 0);
+   u32(n);
+   if (args != nullptr) {
+      const List::Item* item = args->getFirstItem();
+      while (item != nullptr) {
+         const Pair* const p = static_cast<const Pair*>(item->getValue());
+         int num = 0;
+         if (obj != nullptr) num = obj->slotName2Index(*p->slot());
+         u32(static_cast<unsigned int>(num));
+         item = item->getNext();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Writes the compiled file
+//------------------------------------------------------------------------------
+bool EdlCompiler::write(const std::string& filename, const unsigned long long srcSize, const unsigned long long srcHash) const
+{
+   std::ofstream fout(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!fout) return false;
+
+   Header hdr {};
+   std::memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+   hdr.version = VERSION;
+   hdr.srcSize = srcSize;
+   hdr.srcHash = srcHash;
+   hdr.numStrings = static_cast<unsigned int>(strings.size());
+   hdr.codeSize = static_cast<unsigned int>(code.size());
+   fout.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+
+   for (const std::string& s : strings) {
+      const unsigned int len = static_cast<unsigned int>(s.size());
+      fout.write(reinterpret_cast<const char*>(&len), sizeof(len));
+      fout.write(s.c_str(), len + 1);
+   }
+
+   if (!code.empty()) {
+      fout.write(reinterpret_cast<const char*>(code.data()), code.size());
+   }
+
+   const bool ok = fout.good();
+   fout.close();
+   if (!ok) std::remove(filename.c_str());
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Loads a compiled file --- runs the stack machine program
+//------------------------------------------------------------------------------
+bool EdlCompiler::load(const std::string& filename, const unsigned long long srcSize, const unsigned long long srcHash,
+                       factory_func factory, Object** const result)
+{
+   if (factory == nullptr || result == nullptr) return false;
+
+   // Read the file
+   std::ifstream fin(filename, std::ios::in | std::ios::binary);
+   if (!fin) return false;
+   fin.seekg(0, std::ios::end);
+   const std::streamoff fsize = fin.tellg();
+   fin.seekg(0, std::ios::beg);
+   if (fsize < static_cast<std::streamoff>(sizeof(Header))) return false;
+
+   std::vector<char> buff(static_cast<std::size_t>(fsize));
+   fin.read(buff.data(), fsize);
+   if (!fin) return false;
+   fin.close();
+
+   // Check the header
+   Header hdr {};
+   std::memcpy(&hdr, buff.data(), sizeof(hdr));
+   if ( std::memcmp(hdr.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        hdr.version != VERSION ||
+        hdr.srcSize != srcSize ||
+        hdr.srcHash != srcHash ) return false;
+
+   // String table
+   const char* p = buff.data() + sizeof(hdr);
+   const char* const end = buff.data() + buff.size();
+   std::vector<const char*> strs(hdr.numStrings);
+   for (unsigned int i = 0; i < hdr.numStrings; i++) {
+      unsigned int len = 0;
+      if ((end - p) < static_cast<std::ptrdiff_t>(sizeof(len))) return false;
+      std::memcpy(&len, p, sizeof(len));
+      p += sizeof(len);
+      if ((end - p) < static_cast<std::ptrdiff_t>(len) + 1 || p[len] != '\0') return false;
+      strs[i] = p;
+      p += len + 1;
+   }
+
+   // Program
+   if ((end - p) != static_cast<std::ptrdiff_t>(hdr.codeSize)) return false;
+   const unsigned char* pc = reinterpret_cast<const unsigned char*>(p);
+   const unsigned char* const pcEnd = pc + hdr.codeSize;
+
+   // Operand readers
+   auto readU32 = [&pc, pcEnd](unsigned int* const v) -> bool {
+      if ((pcEnd - pc) < static_cast<std::ptrdiff_t>(sizeof(*v))) return false;
+      std::memcpy(v, pc, sizeof(*v));
+      pc += sizeof(*v);
+      return true;
+   };
+   auto readStr = [&readU32, &strs](const char** const s) -> bool {
+      unsigned int idx = 0;
+      if (!readU32(&idx) || idx >= strs.size()) return false;
+      *s = strs[idx];
+      return true;
+   };
+
+   std::vector<Object*> stack;
+   std::vector<unsigned int> slotNums;
+   bool ok = true;
+
+   while (ok && pc < pcEnd) {
+      const unsigned char c = *pc++;
+      switch (c) {
+
+         case OP_STRING: {
+            const char* s = nullptr;
+            ok = readStr(&s);
+            if (ok) stack.push_back(new String(s));
+            break;
+         }
+
+         case OP_IDENT: {
+            const char* s = nullptr;
+            ok = readStr(&s);
+            if (ok) stack.push_back(new Identifier(s));
+            break;
+         }
+
+         case OP_BOOL: {
+            ok = (pc < pcEnd);
+            if (ok) stack.push_back(new Boolean(*pc++ != 0));
+            break;
+         }
+
+         case OP_INTEGER: {
+            long long v = 0;
+            ok = ((pcEnd - pc) >= static_cast<std::ptrdiff_t>(sizeof(v)));
+            if (ok) {
+               std::memcpy(&v, pc, sizeof(v));
+               pc += sizeof(v);
+               stack.push_back(new Integer(static_cast<long>(v)));
+            }
+            break;
+         }
+
+         case OP_FLOAT: {
+            double v = 0;
+            ok = ((pcEnd - pc) >= static_cast<std::ptrdiff_t>(sizeof(v)));
+            if (ok) {
+               std::memcpy(&v, pc, sizeof(v));
+               pc += sizeof(v);
+               stack.push_back(new Float(v));
+            }
+            break;
+         }
+
+         case OP_NUMLIST: {
+            ok = !stack.empty();
+            if (ok) {
+               Object* const num = stack.back();
+               stack.pop_back();
+               List* const list = new List();
+               list->put(num);
+               num->unref();
+               stack.push_back(list);
+            }
+            break;
+         }
+
+         case OP_NUMLIST_ADD: {
+            List* list = nullptr;
+            ok = (stack.size() >= 2 && (list = dynamic_cast<List*>(stack[stack.size() - 2])) != nullptr);
+            if (ok) {
+               Object* const num = stack.back();
+               stack.pop_back();
+               list->put(num);
+               num->unref();
+            }
+            break;
+         }
+
+         case OP_ARGS: {
+            stack.push_back(new PairStream());
+            break;
+         }
+
+         case OP_ARGS_ITEM: {
+            PairStream* args = nullptr;
+            ok = (stack.size() >= 2 && (args = dynamic_cast<PairStream*>(stack[stack.size() - 2])) != nullptr);
+            if (ok) {
+               Object* const obj = stack.back();
+               stack.pop_back();
+               char cbuf[20];
+               std::sprintf(cbuf, "%i", args->entries() + 1);
+               Pair* const pair = new Pair(cbuf, obj);
+               obj->unref();
+               args->put(pair);
+               pair->unref();
+            }
+            break;
+         }
+
+         case OP_ARGS_PAIR: {
+            PairStream* args = nullptr;
+            ok = (stack.size() >= 2 && (args = dynamic_cast<PairStream*>(stack[stack.size() - 2])) != nullptr &&
+                  dynamic_cast<Pair*>(stack.back()) != nullptr);
+            if (ok) {
+               Object* const pair = stack.back();
+               stack.pop_back();
+               args->put(static_cast<Pair*>(pair));
+               pair->unref();
+            }
+            break;
+         }
+
+         case OP_SLOT: {
+            const char* name = nullptr;
+            ok = readStr(&name) && !stack.empty();
+            if (ok) {
+               Object* const obj = stack.back();
+               stack.back() = new Pair(name, obj);
+               obj->unref();
+            }
+            break;
+         }
+
+         case OP_FORM: {
+            const char* name = nullptr;
+            unsigned int n = 0;
+            PairStream* args = nullptr;
+            ok = readStr(&name) && readU32(&n) && !stack.empty() &&
+                 (args = dynamic_cast<PairStream*>(stack.back())) != nullptr &&
+                 args->entries() == n;
+            slotNums.resize(n);
+            for (unsigned int i = 0; ok && i < n; i++) {
+               ok = readU32(&slotNums[i]);
+            }
+            if (!ok) break;
+
+            // call user provided factory() to construct an object
+            Object* const obj = factory(name);
+            ok = (obj != nullptr);
+
+            // set slots in our new object, by slot number if the slot names
+            // still match (or are numbers), otherwise by name
+            const List::Item* item = args->getFirstItem();
+            for (unsigned int i = 0; ok && i < n; i++) {
+               Pair* const pair = const_cast<Pair*>(static_cast<const Pair*>(item->getValue()));
+               const char* const slotname = *pair->slot();
+               const int num = static_cast<int>(slotNums[i]);
+               bool byNumber = false;
+               if (num > 0) {
+                  if (std::isdigit(static_cast<unsigned char>(slotname[0]))) {
+                     byNumber = true;
+                  }
+                  else {
+                     const char* const sname = obj->slotIndex2Name(num);
+                     byNumber = (sname != nullptr && std::strcmp(sname, slotname) == 0);
+                  }
+               }
+               if (byNumber) ok = obj->setSlotByNumber(num, pair->object());
+               else ok = obj->setSlotByName(slotname, pair->object());
+               item = item->getNext();
+            }
+            if (ok) ok = obj->isValid();
+
+            args->unref();
+            if (ok) {
+               stack.back() = obj;
+            }
+            else {
+               stack.pop_back();
+               if (obj != nullptr) obj->unref();
+            }
+            break;
+         }
+
+         default: {
+            ok = false;
+            break;
+         }
+      }
+   }
+
+   // The result is the only object left on the stack
+   if (ok && stack.size() > 1) ok = false;
+   if (ok) {
+      *result = (stack.empty() ? nullptr : stack.back());
+   }
+   else {
+      for (Object* const obj : stack) {
+         if (obj != nullptr) obj->unref();
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Size and hash (64 bit FNV-1a) of a file
+//------------------------------------------------------------------------------
+bool EdlCompiler::hashFile(const std::string& filename, unsigned long long* const size, unsigned long long* const hash)
+{
+   std::ifstream fin(filename, std::ios::in | std::ios::binary);
+   if (!fin) return false;
+
+   unsigned long long h = 14695981039346656037ULL;
+   unsigned long long n = 0;
+   char buff[64 * 1024];
+   while (fin) {
+      fin.read(buff, sizeof(buff));
+      const std::streamsize cnt = fin.gcount();
+      for (std::streamsize i = 0; i < cnt; i++) {
+         h ^= static_cast<unsigned char>(buff[i]);
+         h *= 1099511628211ULL;
+      }
+      n += static_cast<unsigned long long>(cnt);
+   }
+
+   *size = n;
+   *hash = h;
+   return true;
+}
+
+}
+}
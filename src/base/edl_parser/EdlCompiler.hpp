@@ -0,0 +1,111 @@
+
+#ifndef _oe_base_EdlCompiler_H_
+#define _oe_base_EdlCompiler_H_
+
+#include "openeaagles/base/edl_parser.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oe {
+namespace base {
+class PairStream;
+
+//------------------------------------------------------------------------------
+// Class: EdlCompiler
+//
+// Description: Compiled (binary) EDL files.  While an EDL file is parsed, the
+//              parser's actions are recorded, in order, as a simple stack
+//              machine program, with the slot names of the objects already
+//              resolved to their slot numbers.  The program is written to the
+//              compiled file, and load() replays it to build the same object
+//              tree without scanning, parsing or slot name searches.
+//
+// File format (native byte order):
+//
+//    header:  magic "OEEDLC\0\0", version (u32), unused (u32),
+//             EDL source size (u64) and hash (u64; FNV-1a),
+//             number of strings (u32) and size of the code (u32; bytes)
+//    strings: length (u32) and characters, with a terminating zero
+//    code:    op codes (u8) and their operands (see the Op enum)
+//
+// Notes:
+//    1) A compiled file is used only if its source size and hash match the
+//       EDL file (e.g., the preprocessed input file).  Files with errors, or
+//       that fail to load (e.g., an unknown factory name or a slot error),
+//       are parsed instead, which reports the errors.
+//
+//    2) The slot numbers are checked against the slot names when loaded (one
+//       name compare), so a file compiled with other versions of the classes
+//       falls back to the slot name searches.
+//------------------------------------------------------------------------------
+class EdlCompiler
+{
+public:
+   static const unsigned int VERSION = 1;
+
+   // Stack machine op codes
+   enum Op : unsigned char {
+      OP_STRING = 1,       // <u32 str>   push String
+      OP_IDENT,            // <u32 str>   push Identifier
+      OP_BOOL,             // <u8>        push Boolean
+      OP_INTEGER,          // <i64>       push Integer
+      OP_FLOAT,            // <f64>       push Float
+      OP_NUMLIST,          //             pop number; push List of the number
+      OP_NUMLIST_ADD,      //             pop number; add to the List on top
+      OP_ARGS,             //             push empty PairStream (argument list)
+      OP_ARGS_ITEM,        //             pop object; add to the PairStream on top as a numbered Pair
+      OP_ARGS_PAIR,        //             pop Pair; add to the PairStream on top
+      OP_SLOT,             // <u32 str>   pop object; push Pair (slot name, object)
+      OP_FORM              // <u32 str> <u32 n> <u32 slot numbers>[n]
+                           //             pop PairStream; push new object with its slots set
+   };
+
+public:
+   EdlCompiler() = default;
+   EdlCompiler(const EdlCompiler&) = delete;
+   EdlCompiler& operator=(const EdlCompiler&) = delete;
+
+   // ---
+   // Recording (parser actions)
+   // ---
+   void string(const char* const s)          { op(OP_STRING); u32(str(s)); }
+   void ident(const char* const s)           { op(OP_IDENT); u32(str(s)); }
+   void boolean(const bool b)                { op(OP_BOOL); code.push_back(b ? 1 : 0); }
+   void integer(const long n);
+   void floating(const double d);
+   void numList()                            { op(OP_NUMLIST); }
+   void numListAdd()                         { op(OP_NUMLIST_ADD); }
+   void args()                               { op(OP_ARGS); }
+   void argsItem()                           { op(OP_ARGS_ITEM); }
+   void argsPair()                           { op(OP_ARGS_PAIR); }
+   void slot(const char* const name)         { op(OP_SLOT); u32(str(name)); }
+   void form(const char* const name, const Object* const obj, const PairStream* const args);
+
+   // Writes the compiled file; returns true if successful
+   bool write(const std::string& filename, const unsigned long long srcSize, const unsigned long long srcHash) const;
+
+   // Loads a compiled file and returns its object in 'result'.  Returns false
+   // if the file isn't a compiled file of the EDL source (size and hash), or
+   // if there were any errors while building the objects.
+   static bool load(const std::string& filename, const unsigned long long srcSize, const unsigned long long srcHash,
+                    factory_func factory, Object** const result);
+
+   // Size and hash (FNV-1a) of a file; returns false if the file can't be read
+   static bool hashFile(const std::string& filename, unsigned long long* const size, unsigned long long* const hash);
+
+private:
+   void op(const Op c)                       { code.push_back(c); }
+   void u32(const unsigned int v);
+   unsigned int str(const char* const s);
+
+   std::vector<unsigned char> code;                       // Program
+   std::vector<std::string> strings;                      // String table
+   std::unordered_map<std::string, unsigned int> stringIdx;  // String table indexes
+};
+
+}
+}
+
+#endif
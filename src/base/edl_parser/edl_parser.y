@@ -33,11 +33,13 @@
 #include "openeaagles/base/PairStream.hpp"
 #include "openeaagles/base/List.hpp"
 #include "EdlScanner.hpp"
+#include "EdlCompiler.hpp"
 
 static oe::base::Object* result;               // result of all our work (i.e., an Object)
 static oe::base::EdlScanner* scanner;          // edl scanner
 static oe::base::factory_func factory;         // factory function 
 static unsigned int err_count;                 // error count
+static oe::base::EdlCompiler* compiler;        // records the compiled EDL (or zero)
 
 //------------------------------------------------------------------------------
 // yylex() -- user defined; used by the parser to call the lexical generator
@@ -137,12 +139,14 @@ static oe::base::Object* parse(const std::string& name, oe::base::PairStream* ar
 //--------------------------------------------------------------------------
 %%
 file    : form                      { result = $1; }
-        | SLOT_ID form              { if ($2 != 0) { result = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); } }
+        | SLOT_ID form              { if (compiler != nullptr) compiler->slot($1);
+                                      if ($2 != 0) { result = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); } }
         ;
 
-arglist :                           { $$ = new oe::base::PairStream(); }
+arglist :                           { $$ = new oe::base::PairStream(); if (compiler != nullptr) compiler->args(); }
 
-        | arglist form              { if ($2 != 0) {
+        | arglist form              { if (compiler != nullptr) compiler->argsItem();
+                                      if ($2 != 0) {
                                         int i = $1->entries();
                                         char cbuf[20];
                                         std::sprintf(cbuf, "%i", i+1);
@@ -155,6 +159,7 @@ arglist :                           { $$ = new oe::base::PairStream(); }
                                     }
 
         | arglist prim              {
+                                    if (compiler != nullptr) compiler->argsItem();
                                     int i = $1->entries();
                                     char cbuf[20];
                                     std::sprintf(cbuf,"%i", i+1);
@@ -165,33 +170,33 @@ arglist :                           { $$ = new oe::base::PairStream(); }
                                     $$ = $1;
                                     }
 
-        | arglist slot_value        { $1->put($2); $2->unref(); $$ = $1; }
+        | arglist slot_value        { if (compiler != nullptr) compiler->argsPair(); $1->put($2); $2->unref(); $$ = $1; }
         ;
 
 
-form    : '(' IDENT arglist ')'     { $$ = parse($2, $3); delete[] $2; $3->unref(); }
+form    : '(' IDENT arglist ')'     { $$ = parse($2, $3); if (compiler != nullptr) compiler->form($2, $$, $3); delete[] $2; $3->unref(); }
 
         | '{' arglist '}'           { $$ = (oe::base::Object*) $2; }
         ;
 
 
-slot_value  : SLOT_ID prim          { $$ = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); }
-        | SLOT_ID form              { $$ = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); }
+slot_value  : SLOT_ID prim          { if (compiler != nullptr) compiler->slot($1); $$ = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); }
+        | SLOT_ID form              { if (compiler != nullptr) compiler->slot($1); $$ = new oe::base::Pair($1, $2); delete[] $1; $2->unref(); }
         ;
 
-prim    : STRING_LITERAL            { $$ = new oe::base::String($1); delete[] $1; }
-        | IDENT                     { $$ = new oe::base::Identifier($1); delete[] $1; }
-        | BOOLconstant              { $$ = new oe::base::Boolean($1); }
+prim    : STRING_LITERAL            { if (compiler != nullptr) compiler->string($1); $$ = new oe::base::String($1); delete[] $1; }
+        | IDENT                     { if (compiler != nullptr) compiler->ident($1); $$ = new oe::base::Identifier($1); delete[] $1; }
+        | BOOLconstant              { if (compiler != nullptr) compiler->boolean($1); $$ = new oe::base::Boolean($1); }
         | '[' numlist ']'           { $$ = $2; }
         | number                    { $$ = $1; }
         ;
 
-numlist : number                    { $$ = new oe::base::List(); $$->put($1); $1->unref(); }
-        | numlist number            { $$ = $1; $$->put($2); $2->unref(); }
+numlist : number                    { if (compiler != nullptr) compiler->numList(); $$ = new oe::base::List(); $$->put($1); $1->unref(); }
+        | numlist number            { if (compiler != nullptr) compiler->numListAdd(); $$ = $1; $$->put($2); $2->unref(); }
         ;
 
-number  : INTEGERconstant           { $$ = new oe::base::Integer($1); }
-        | FLOATINGconstant          { $$ = new oe::base::Float($1); }
+number  : INTEGERconstant           { if (compiler != nullptr) compiler->integer($1); $$ = new oe::base::Integer($1); }
+        | FLOATINGconstant          { if (compiler != nullptr) compiler->floating($1); $$ = new oe::base::Float($1); }
         ;
 %%
 
@@ -231,6 +236,46 @@ Object* edl_parser(const std::string& filename, factory_func f, unsigned int* nu
     return obj;
 }
 
+//------------------------------------------------------------------------------
+// Returns an Object* that was constructed from a compiled EDL file, if it was
+// compiled from this EDL file; otherwise the EDL file is parsed and compiled.
+//------------------------------------------------------------------------------
+Object* edl_parser(const std::string& filename, factory_func f, const std::string& cache_filename, unsigned int* num_errors)
+{
+    // size and hash of the EDL file
+    unsigned long long size {};
+    unsigned long long hash {};
+    const bool hashed = !cache_filename.empty() && EdlCompiler::hashFile(filename, &size, &hash);
+
+    // load the compiled file, if it's from this EDL file
+    Object* obj {nullptr};
+    if (hashed && EdlCompiler::load(cache_filename, size, hash, f, &obj)) {
+        if (num_errors != nullptr) {
+            *num_errors = 0;
+        }
+        return obj;
+    }
+
+    // parse the EDL file, recording the compiled EDL
+    EdlCompiler comp;
+    if (hashed) compiler = &comp;
+    unsigned int errors {};
+    obj = edl_parser(filename, f, &errors);
+    compiler = nullptr;
+
+    // write the compiled file, if there were no errors
+    if (hashed && obj != nullptr && errors == 0) {
+        if (!comp.write(cache_filename, size, hash)) {
+            std::cerr << "edl_parser(): unable to write the compiled EDL file: " << cache_filename << std::endl;
+        }
+    }
+
+    if (num_errors != nullptr) {
+        *num_errors = errors;
+    }
+    return obj;
+}
+
 }
 }
 
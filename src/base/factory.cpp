@@ -2,9 +2,11 @@
 #include "openeaagles/base/factory.hpp"
 
 #include "openeaagles/base/Object.hpp"
+#include "openeaagles/base/FactoryTable.hpp"
 
 #include "openeaagles/base/FileReader.hpp"
 #include "openeaagles/base/Statistic.hpp"
+#include "openeaagles/base/Profiler.hpp"
 #include "openeaagles/base/Transforms.hpp"
 #include "openeaagles/base/Timers.hpp"
 
@@ -26,6 +28,7 @@
 #include "openeaagles/base/io/IoHandler.hpp"
 
 // Network handlers
+#include "openeaagles/base/network/LoopbackHandler.hpp"
 #include "openeaagles/base/network/TcpHandler.hpp"
 #include "openeaagles/base/network/TcpClient.hpp"
 #include "openeaagles/base/network/TcpServerMultiple.hpp"
@@ -79,377 +82,163 @@ namespace base {
 
 Object* factory(const std::string& name)
 {
-    Object* obj = nullptr;
-
-    // Numbers
-    if ( name == Number::getFactoryName() ) {
-        obj = new Number();
-    }
-    else if ( name == Complex::getFactoryName() ) {
-        obj = new Complex();
-    }
-    else if ( name == Integer::getFactoryName() ) {
-        obj = new Integer();
-    }
-    else if ( name == Float::getFactoryName() ) {
-        obj = new Float();
-    }
-    else if ( name == Boolean::getFactoryName() ) {
-        obj = new Boolean();
-    }
-    else if ( name == Decibel::getFactoryName() ) {
-        obj = new Decibel();
-    }
-    else if ( name == LatLon::getFactoryName() ) {
-        obj = new LatLon();
-    }
-    else if ( name == Add::getFactoryName() ) {
-        obj = new Add();
-    }
-    else if ( name == Subtract::getFactoryName() ) {
-        obj = new Subtract();
-    }
-    else if ( name == Multiply::getFactoryName() ) {
-        obj = new Multiply();
-    }
-    else if ( name == Divide::getFactoryName() ) {
-        obj = new Divide();
-    }
-
-    // Components
-    else if ( name == FileReader::getFactoryName() ) {
-        obj = new FileReader();
-    }
-    else if ( name == Statistic::getFactoryName() ) {
-        obj = new Statistic();
-    }
-
-    // Transformations
-    else if ( name == Translation::getFactoryName() ) {
-        obj = new Translation();
-    }
-    else if ( name == Rotation::getFactoryName() ) {
-        obj = new Rotation();
-    }
-    else if ( name == Scale::getFactoryName() ) {
-        obj = new Scale();
-    }
-
-    // Functors
-    else if ( name == Func1::getFactoryName() ) {
-        obj = new Func1();
-    }
-    else if ( name == Func2::getFactoryName() ) {
-        obj = new Func2();
-    }
-    else if ( name == Func3::getFactoryName() ) {
-        obj = new Func3();
-    }
-    else if ( name == Func4::getFactoryName() ) {
-        obj = new Func4();
-    }
-    else if ( name == Func5::getFactoryName() ) {
-        obj = new Func5();
-    }
-    else if ( name == Polynomial::getFactoryName() ) {
-        obj = new Polynomial();
-    }
-    else if ( name == Table1::getFactoryName() ) {
-        obj = new Table1();
-    }
-    else if ( name == Table2::getFactoryName() ) {
-        obj = new Table2();
-    }
-    else if ( name == Table3::getFactoryName() ) {
-        obj = new Table3();
-    }
-    else if ( name == Table4::getFactoryName() ) {
-        obj = new Table4();
-    }
-    else if ( name == Table5::getFactoryName() ) {
-        obj = new Table5();
-    }
-
-    // Timers
-    else if ( name == UpTimer::getFactoryName() ) {
-        obj = new UpTimer();
-    }
-    else if ( name == DownTimer::getFactoryName() ) {
-        obj = new DownTimer();
-    }
-
-    // Units: Angles
-    else if ( name == Degrees::getFactoryName() ) {
-        obj = new Degrees();
-    }
-    else if ( name == Radians::getFactoryName() ) {
-        obj = new Radians();
-    }
-    else if ( name == Semicircles::getFactoryName() ) {
-        obj = new Semicircles();
-    }
-
-    // Units: Areas
-    else if ( name == SquareMeters::getFactoryName() ) {
-        obj = new SquareMeters();
-    }
-    else if ( name == SquareFeet::getFactoryName() ) {
-        obj = new SquareFeet();
-    }
-    else if ( name == SquareInches::getFactoryName() ) {
-        obj = new SquareInches();
-    }
-    else if ( name == SquareYards::getFactoryName() ) {
-        obj = new SquareYards();
-    }
-    else if ( name == SquareMiles::getFactoryName() ) {
-        obj = new SquareMiles();
-    }
-    else if ( name == SquareCentiMeters::getFactoryName() ) {
-        obj = new SquareCentiMeters();
-    }
-    else if ( name == SquareMilliMeters::getFactoryName() ) {
-        obj = new SquareMilliMeters();
-    }
-    else if ( name == SquareKiloMeters::getFactoryName() ) {
-        obj = new SquareKiloMeters();
-    }
-    else if ( name == DecibelSquareMeters::getFactoryName() ) {
-        obj = new DecibelSquareMeters();
-    }
-
-    // Units: Distances
-    else if ( name == Meters::getFactoryName() ) {
-        obj = new Meters();
-    }
-    else if ( name == CentiMeters::getFactoryName() ) {
-        obj = new CentiMeters();
-    }
-    else if ( name == MicroMeters::getFactoryName() ) {
-        obj = new MicroMeters();
-    }
-    else if ( name == Microns::getFactoryName() ) {
-        obj = new Microns();
-    }
-    else if ( name == KiloMeters::getFactoryName() ) {
-        obj = new KiloMeters();
-    }
-    else if ( name == Inches::getFactoryName() ) {
-        obj = new Inches();
-    }
-    else if ( name == Feet::getFactoryName() ) {
-        obj = new Feet();
-    }
-    else if ( name == NauticalMiles::getFactoryName() ) {
-        obj = new NauticalMiles();
-    }
-    else if ( name == StatuteMiles::getFactoryName() ) {
-        obj = new StatuteMiles();
-    }
-
-    // Units: Energies
-    else if ( name == KiloWattHours::getFactoryName() ) {
-        obj = new KiloWattHours();
-    }
-    else if ( name == BTUs::getFactoryName() ) {
-        obj = new BTUs();
-    }
-    else if ( name == Calories::getFactoryName() ) {
-        obj = new Calories();
-    }
-    else if ( name == FootPounds::getFactoryName() ) {
-        obj = new FootPounds();
-    }
-    else if ( name == Joules::getFactoryName() ) {
-        obj = new Joules();
-    }
-
-    // Units: Forces
-    else if ( name == Newtons::getFactoryName() ) {
-        obj = new Newtons();
-    }
-    else if ( name == KiloNewtons::getFactoryName() ) {
-        obj = new KiloNewtons();
-    }
-    else if ( name == Poundals::getFactoryName() ) {
-        obj = new Poundals();
-    }
-    else if ( name == PoundForces::getFactoryName() ) {
-        obj = new PoundForces();
-    }
-
-    // Units: Frequencies
-    else if ( name == Hertz::getFactoryName() ) {
-        obj = new Hertz();
-    }
-    else if ( name == KiloHertz::getFactoryName() ) {
-        obj = new KiloHertz();
-    }
-    else if ( name == MegaHertz::getFactoryName() ) {
-        obj = new MegaHertz();
-    }
-    else if ( name == GigaHertz::getFactoryName() ) {
-        obj = new GigaHertz();
-    }
-    else if ( name == TeraHertz::getFactoryName() ) {
-        obj = new TeraHertz();
-    }
-
-    // Units: Masses
-    else if ( name == Grams::getFactoryName() ) {
-        obj = new Grams();
-    }
-    else if ( name == KiloGrams::getFactoryName() ) {
-        obj = new KiloGrams();
-    }
-    else if ( name == Slugs::getFactoryName() ) {
-        obj = new Slugs();
-    }
-
-    // Units: Powers
-    else if ( name == KiloWatts::getFactoryName() ) {
-        obj = new KiloWatts();
-    }
-    else if ( name == Watts::getFactoryName() ) {
-        obj = new Watts();
-    }
-    else if ( name == MilliWatts::getFactoryName() ) {
-        obj = new MilliWatts();
-    }
-    else if ( name == Horsepower::getFactoryName() ) {
-        obj = new Horsepower();
-    }
-    else if ( name == DecibelWatts::getFactoryName() ) {
-        obj = new DecibelWatts();
-    }
-    else if ( name == DecibelMilliWatts::getFactoryName() ) {
-        obj = new DecibelMilliWatts();
-    }
-
-    // Units: Time
-    else if ( name == Seconds::getFactoryName() ) {
-        obj = new Seconds();
-    }
-    else if ( name == MilliSeconds::getFactoryName() ) {
-        obj = new MilliSeconds();
-    }
-    else if ( name == MicroSeconds::getFactoryName() ) {
-        obj = new MicroSeconds();
-    }
-    else if ( name == NanoSeconds::getFactoryName() ) {
-        obj = new NanoSeconds();
-    }
-    else if ( name == Minutes::getFactoryName() ) {
-        obj = new Minutes();
-    }
-    else if ( name == Hours::getFactoryName() ) {
-        obj = new Hours();
-    }
-    else if ( name == Days::getFactoryName() ) {
-        obj = new Days();
-    }
-
-    // Units: Velocities
-    else if ( name == AngularVelocity::getFactoryName() ) {
-        obj = new AngularVelocity();
-    }
-    else if ( name == LinearVelocity::getFactoryName() ) {
-        obj = new LinearVelocity();
-    }
-
-    // Colors
-    else if ( name == Color::getFactoryName() ) {
-        obj = new Color();
-    }
-    else if ( name == Cie::getFactoryName() ) {
-        obj = new Cie();
-    }
-    else if ( name == Cmy::getFactoryName() ) {
-        obj = new Cmy();
-    }
-    else if ( name == Hls::getFactoryName() ) {
-        obj = new Hls();
-    }
-    else if ( name == Hsv::getFactoryName() ) {
-        obj = new Hsv();
-    }
-    else if ( name == Hsva::getFactoryName() ) {
-        obj = new Hsva();
-    }
-    else if ( name == Rgb::getFactoryName() ) {
-        obj = new Rgb();
-    }
-    else if ( name == Rgba::getFactoryName() ) {
-        obj = new Rgba();
-    }
-    else if ( name == Yiq::getFactoryName() ) {
-        obj = new Yiq();
-    }
-
-    // Network handlers
-    else if ( name == TcpClient::getFactoryName() ) {
-        obj = new TcpClient();
-    }
-    else if ( name == TcpServerSingle::getFactoryName() ) {
-        obj = new TcpServerSingle();
-    }
-    else if ( name == TcpServerMultiple::getFactoryName() ) {
-        obj = new TcpServerMultiple();
-    }
-    else if ( name == UdpBroadcastHandler::getFactoryName() ) {
-        obj = new UdpBroadcastHandler();
-    }
-    else if ( name == UdpMulticastHandler::getFactoryName() ) {
-        obj = new UdpMulticastHandler();
-    }
-    else if ( name == UdpUnicastHandler::getFactoryName() ) {
-        obj = new UdpUnicastHandler();
-    }
-
-    // Random number generator and distributions
-    else if ( name == Rng::getFactoryName() ) {
-        obj = new Rng();
-    }
-    else if ( name == Exponential::getFactoryName() ) {
-        obj = new Exponential();
-    }
-    else if ( name == Lognormal::getFactoryName() ) {
-        obj = new Lognormal();
-    }
-    else if ( name == Pareto::getFactoryName() ) {
-        obj = new Pareto();
-    }
-    else if ( name == Uniform::getFactoryName() ) {
-        obj = new Uniform();
-    }
-
-    // General I/O Devices
-    else if ( name == IoHandler::getFactoryName() ) {
-        obj = new IoHandler();
-    }
-    else if ( name == IoData::getFactoryName() ) {
-        obj = new IoData();
-    }
-
-    // Earth models
-    else if ( name == EarthModel::getFactoryName() ) {
-        obj = new EarthModel();
-    }
-
-    // Thread pool
-    else if ( name == ThreadPool::getFactoryName() ) {
-       obj = new ThreadPool();
-    }
-
-    // Ubf
-    else if ( name == ubf::Agent::getFactoryName() ) {
-        obj = new ubf::Agent();
-    }
-    else if ( name == ubf::Arbiter::getFactoryName() ) {
-        obj = new ubf::Arbiter();
-    }
-
-    return obj;
+    static const FactoryTable table = {
+        // Numbers
+        FACTORY_ENTRY(Number),
+        FACTORY_ENTRY(Complex),
+        FACTORY_ENTRY(Integer),
+        FACTORY_ENTRY(Float),
+        FACTORY_ENTRY(Boolean),
+        FACTORY_ENTRY(Decibel),
+        FACTORY_ENTRY(LatLon),
+        FACTORY_ENTRY(Add),
+        FACTORY_ENTRY(Subtract),
+        FACTORY_ENTRY(Multiply),
+        FACTORY_ENTRY(Divide),
+
+        // Components
+        FACTORY_ENTRY(FileReader),
+        FACTORY_ENTRY(Statistic),
+        FACTORY_ENTRY(Profiler),
+
+        // Transformations
+        FACTORY_ENTRY(Translation),
+        FACTORY_ENTRY(Rotation),
+        FACTORY_ENTRY(Scale),
+
+        // Functors
+        FACTORY_ENTRY(Func1),
+        FACTORY_ENTRY(Func2),
+        FACTORY_ENTRY(Func3),
+        FACTORY_ENTRY(Func4),
+        FACTORY_ENTRY(Func5),
+        FACTORY_ENTRY(Polynomial),
+        FACTORY_ENTRY(Table1),
+        FACTORY_ENTRY(Table2),
+        FACTORY_ENTRY(Table3),
+        FACTORY_ENTRY(Table4),
+        FACTORY_ENTRY(Table5),
+
+        // Timers
+        FACTORY_ENTRY(UpTimer),
+        FACTORY_ENTRY(DownTimer),
+
+        // Units: Angles
+        FACTORY_ENTRY(Degrees),
+        FACTORY_ENTRY(Radians),
+        FACTORY_ENTRY(Semicircles),
+
+        // Units: Areas
+        FACTORY_ENTRY(SquareMeters),
+        FACTORY_ENTRY(SquareFeet),
+        FACTORY_ENTRY(SquareInches),
+        FACTORY_ENTRY(SquareYards),
+        FACTORY_ENTRY(SquareMiles),
+        FACTORY_ENTRY(SquareCentiMeters),
+        FACTORY_ENTRY(SquareMilliMeters),
+        FACTORY_ENTRY(SquareKiloMeters),
+        FACTORY_ENTRY(DecibelSquareMeters),
+
+        // Units: Distances
+        FACTORY_ENTRY(Meters),
+        FACTORY_ENTRY(CentiMeters),
+        FACTORY_ENTRY(MicroMeters),
+        FACTORY_ENTRY(Microns),
+        FACTORY_ENTRY(KiloMeters),
+        FACTORY_ENTRY(Inches),
+        FACTORY_ENTRY(Feet),
+        FACTORY_ENTRY(NauticalMiles),
+        FACTORY_ENTRY(StatuteMiles),
+
+        // Units: Energies
+        FACTORY_ENTRY(KiloWattHours),
+        FACTORY_ENTRY(BTUs),
+        FACTORY_ENTRY(Calories),
+        FACTORY_ENTRY(FootPounds),
+        FACTORY_ENTRY(Joules),
+
+        // Units: Forces
+        FACTORY_ENTRY(Newtons),
+        FACTORY_ENTRY(KiloNewtons),
+        FACTORY_ENTRY(Poundals),
+        FACTORY_ENTRY(PoundForces),
+
+        // Units: Frequencies
+        FACTORY_ENTRY(Hertz),
+        FACTORY_ENTRY(KiloHertz),
+        FACTORY_ENTRY(MegaHertz),
+        FACTORY_ENTRY(GigaHertz),
+        FACTORY_ENTRY(TeraHertz),
+
+        // Units: Masses
+        FACTORY_ENTRY(Grams),
+        FACTORY_ENTRY(KiloGrams),
+        FACTORY_ENTRY(Slugs),
+
+        // Units: Powers
+        FACTORY_ENTRY(KiloWatts),
+        FACTORY_ENTRY(Watts),
+        FACTORY_ENTRY(MilliWatts),
+        FACTORY_ENTRY(Horsepower),
+        FACTORY_ENTRY(DecibelWatts),
+        FACTORY_ENTRY(DecibelMilliWatts),
+
+        // Units: Time
+        FACTORY_ENTRY(Seconds),
+        FACTORY_ENTRY(MilliSeconds),
+        FACTORY_ENTRY(MicroSeconds),
+        FACTORY_ENTRY(NanoSeconds),
+        FACTORY_ENTRY(Minutes),
+        FACTORY_ENTRY(Hours),
+        FACTORY_ENTRY(Days),
+
+        // Units: Velocities
+        FACTORY_ENTRY(AngularVelocity),
+        FACTORY_ENTRY(LinearVelocity),
+
+        // Colors
+        FACTORY_ENTRY(Color),
+        FACTORY_ENTRY(Cie),
+        FACTORY_ENTRY(Cmy),
+        FACTORY_ENTRY(Hls),
+        FACTORY_ENTRY(Hsv),
+        FACTORY_ENTRY(Hsva),
+        FACTORY_ENTRY(Rgb),
+        FACTORY_ENTRY(Rgba),
+        FACTORY_ENTRY(Yiq),
+
+        // Network handlers
+        FACTORY_ENTRY(LoopbackHandler),
+        FACTORY_ENTRY(TcpClient),
+        FACTORY_ENTRY(TcpServerSingle),
+        FACTORY_ENTRY(TcpServerMultiple),
+        FACTORY_ENTRY(UdpBroadcastHandler),
+        FACTORY_ENTRY(UdpMulticastHandler),
+        FACTORY_ENTRY(UdpUnicastHandler),
+
+        // Random number generator and distributions
+        FACTORY_ENTRY(Rng),
+        FACTORY_ENTRY(Exponential),
+        FACTORY_ENTRY(Lognormal),
+        FACTORY_ENTRY(Pareto),
+        FACTORY_ENTRY(Uniform),
+
+        // General I/O Devices
+        FACTORY_ENTRY(IoHandler),
+        FACTORY_ENTRY(IoData),
+
+        // Earth models
+        FACTORY_ENTRY(EarthModel),
+
+        // Thread pool
+        FACTORY_ENTRY(ThreadPool),
+
+        // Ubf
+        FACTORY_ENTRY(ubf::Agent),
+        FACTORY_ENTRY(ubf::Arbiter)
+    };
+
+    return table.create(name);
 }
 
 }
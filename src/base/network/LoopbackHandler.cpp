@@ -0,0 +1,325 @@
+#include "openeaagles/base/network/LoopbackHandler.hpp"
+
+#include "openeaagles/base/Number.hpp"
+#include "openeaagles/base/util/atomics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace oe {
+namespace base {
+
+IMPLEMENT_SUBCLASS(LoopbackHandler, "LoopbackHandler")
+
+BEGIN_SLOTTABLE(LoopbackHandler)
+    "channel",          // 1) Channel number [ 0 .. MAX_CHANNELS-1 ] (default: 0)
+    "maxPackets",       // 2) Max number of queued packets (default: 65536)
+END_SLOTTABLE(LoopbackHandler)
+
+BEGIN_SLOT_MAP(LoopbackHandler)
+    ON_SLOT(1, setSlotChannel,    Number)
+    ON_SLOT(2, setSlotMaxPackets, Number)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Channel -- ring of packet buffers; the buffers keep their memory, so
+// there are no allocations once the ring has been filled.
+//------------------------------------------------------------------------------
+struct LoopbackHandler::Channel {
+   long semaphore {};                        // Locks this channel
+   std::vector< std::vector<char> > ring;    // Packet buffers (empty until the first handler's init())
+   std::vector<unsigned int> sizes;          // Packet sizes
+   unsigned int head {};                     // Index of the oldest packet
+   unsigned int count {};                    // Number of queued packets
+   unsigned long long nSent {};              // Number of packets queued
+   unsigned long long nDropped {};           // Number of packets dropped (queue full)
+
+   // waitForData() support: the senders notify only while there are waiters
+   std::mutex waitMutex;                     // Waiters' mutex
+   std::condition_variable dataReady;        // Packets have been queued
+   std::atomic<unsigned int> waiters {};     // Number of waiting receivers
+};
+
+LoopbackHandler::Channel LoopbackHandler::channels[MAX_CHANNELS];
+
+LoopbackHandler::LoopbackHandler()
+{
+    STANDARD_CONSTRUCTOR()
+}
+
+void LoopbackHandler::copyData(const LoopbackHandler& org, const bool)
+{
+    BaseClass::copyData(org);
+
+    channel = org.channel;
+    maxPackets = org.maxPackets;
+    connected = false;
+}
+
+void LoopbackHandler::deleteData()
+{
+    connected = false;
+}
+
+//------------------------------------------------------------------------------
+// init() -- creates our channel's queue, if it hasn't been created
+//------------------------------------------------------------------------------
+bool LoopbackHandler::init()
+{
+    bool ok = BaseClass::init();
+    if (ok) {
+        Channel* const ch = &channels[channel];
+        lock(ch->semaphore);
+        if (ch->ring.empty()) {
+            ch->ring.resize(maxPackets);
+            ch->sizes.resize(maxPackets);
+            ch->head = 0;
+            ch->count = 0;
+        }
+        unlock(ch->semaphore);
+        connected = true;
+    }
+    return ok;
+}
+
+bool LoopbackHandler::isConnected() const
+{
+    return connected;
+}
+
+bool LoopbackHandler::closeConnection()
+{
+    connected = false;
+    return true;
+}
+
+// Always unblocked I/O
+bool LoopbackHandler::setBlocked()
+{
+    return false;
+}
+
+bool LoopbackHandler::setNoWait()
+{
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// put() and get() -- the channel must be locked
+//------------------------------------------------------------------------------
+bool LoopbackHandler::put(Channel* const ch, const char* const packet, const int size)
+{
+    const unsigned int n = static_cast<unsigned int>(ch->ring.size());
+    if (ch->count >= n) {
+        ch->nDropped++;
+        return false;
+    }
+    const unsigned int idx = (ch->head + ch->count) % n;
+    ch->ring[idx].assign(packet, packet + size);
+    ch->sizes[idx] = static_cast<unsigned int>(size);
+    ch->count++;
+    ch->nSent++;
+    return true;
+}
+
+unsigned int LoopbackHandler::get(Channel* const ch, char* const packet, const int maxSize)
+{
+    unsigned int size = 0;
+    if (ch->count > 0) {
+        const unsigned int idx = ch->head;
+        size = ch->sizes[idx];
+        if (size > static_cast<unsigned int>(maxSize)) size = static_cast<unsigned int>(maxSize);
+        std::memcpy(packet, ch->ring[idx].data(), size);
+        ch->head = (idx + 1) % static_cast<unsigned int>(ch->ring.size());
+        ch->count--;
+    }
+    return size;
+}
+
+//------------------------------------------------------------------------------
+// Send and receive packets
+//------------------------------------------------------------------------------
+bool LoopbackHandler::sendData(const char* const packet, const int size)
+{
+    if (!connected || packet == nullptr || size <= 0) return false;
+
+    Channel* const ch = &channels[channel];
+    lock(ch->semaphore);
+    const bool ok = put(ch, packet, size);
+    unlock(ch->semaphore);
+    if (ok) notify(ch);
+    return ok;
+}
+
+unsigned int LoopbackHandler::recvData(char* const packet, const int maxSize)
+{
+    if (!connected || packet == nullptr || maxSize <= 0) return 0;
+
+    Channel* const ch = &channels[channel];
+    lock(ch->semaphore);
+    const unsigned int size = get(ch, packet, maxSize);
+    unlock(ch->semaphore);
+    return size;
+}
+
+// Batches are queued or dequeued with one lock
+unsigned int LoopbackHandler::sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n)
+{
+    unsigned int cnt = 0;
+    if (connected && packets != nullptr && sizes != nullptr) {
+        Channel* const ch = &channels[channel];
+        lock(ch->semaphore);
+        while (cnt < n && sizes[cnt] > 0 && put(ch, packets[cnt], sizes[cnt])) {
+            cnt++;
+        }
+        unlock(ch->semaphore);
+        if (cnt > 0) notify(ch);
+    }
+    return cnt;
+}
+
+unsigned int LoopbackHandler::recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes)
+{
+    unsigned int cnt = 0;
+    if (connected && buffer != nullptr && maxSize > 0) {
+        Channel* const ch = &channels[channel];
+        lock(ch->semaphore);
+        while (cnt < n) {
+            const unsigned int size = get(ch, buffer + cnt * maxSize, maxSize);
+            if (size == 0) break;
+            if (sizes != nullptr) sizes[cnt] = size;
+            cnt++;
+        }
+        unlock(ch->semaphore);
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// waitForData() -- waits up to 'timeout' seconds for a packet on our channel
+//------------------------------------------------------------------------------
+bool LoopbackHandler::waitForData(const double timeout)
+{
+    if (!connected) return BaseClass::waitForData(timeout);
+
+    Channel* const ch = &channels[channel];
+    std::unique_lock<std::mutex> guard(ch->waitMutex);
+
+    // Register before checking the queue, so a sender that queues a packet
+    // after the check sees us and notifies (under the mutex we're holding)
+    ch->waiters++;
+    lock(ch->semaphore);
+    bool ready = (ch->count > 0);
+    unlock(ch->semaphore);
+    if (!ready && timeout > 0) {
+        ch->dataReady.wait_for(guard, std::chrono::duration<double>(timeout));
+        lock(ch->semaphore);
+        ready = (ch->count > 0);
+        unlock(ch->semaphore);
+    }
+    ch->waiters--;
+    return ready;
+}
+
+// Wakes our channel's waiting receivers, if any
+void LoopbackHandler::notify(Channel* const ch)
+{
+    if (ch->waiters > 0) {
+        std::lock_guard<std::mutex> guard(ch->waitMutex);
+        ch->dataReady.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Channel statistics
+//------------------------------------------------------------------------------
+unsigned int LoopbackHandler::getNumQueued() const
+{
+    Channel* const ch = &channels[channel];
+    lock(ch->semaphore);
+    const unsigned int n = ch->count;
+    unlock(ch->semaphore);
+    return n;
+}
+
+unsigned long long LoopbackHandler::getNumSent() const
+{
+    Channel* const ch = &channels[channel];
+    lock(ch->semaphore);
+    const unsigned long long n = ch->nSent;
+    unlock(ch->semaphore);
+    return n;
+}
+
+unsigned long long LoopbackHandler::getNumDropped() const
+{
+    Channel* const ch = &channels[channel];
+    lock(ch->semaphore);
+    const unsigned long long n = ch->nDropped;
+    unlock(ch->semaphore);
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+// channel: Channel number
+bool LoopbackHandler::setSlotChannel(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+        const int ii = msg->getInt();
+        if (ii >= 0 && ii < static_cast<int>(MAX_CHANNELS)) {
+            channel = static_cast<unsigned int>(ii);
+            ok = true;
+        }
+    }
+    return ok;
+}
+
+// maxPackets: Max number of queued packets
+bool LoopbackHandler::setSlotMaxPackets(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+        const int ii = msg->getInt();
+        if (ii > 0) {
+            maxPackets = static_cast<unsigned int>(ii);
+            ok = true;
+        }
+    }
+    return ok;
+}
+
+std::ostream& LoopbackHandler::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+    int j = 0;
+    if ( !slotsOnly ) {
+        indent(sout,i);
+        sout << "( " << getFactoryName() << std::endl;
+        j = 4;
+    }
+
+    indent(sout,i+j);
+    sout << "channel: " << channel << std::endl;
+
+    indent(sout,i+j);
+    sout << "maxPackets: " << maxPackets << std::endl;
+
+    BaseClass::serialize(sout,i+j,true);
+
+    if ( !slotsOnly ) {
+        indent(sout,i);
+        sout << ")" << std::endl;
+    }
+
+    return sout;
+}
+
+}
+}
@@ -24,6 +24,8 @@
 
 #include "openeaagles/base/network/NetHandler.hpp"
 
+#include "openeaagles/base/util/system_utils.hpp"
+
 #include <iostream>
 
 namespace oe {
@@ -57,6 +59,46 @@ bool NetHandler::initNetwork(const bool noWaitFlag)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// sendDataBatch() -- send 'n' packets (default: one at a time)
+//------------------------------------------------------------------------------
+unsigned int NetHandler::sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n)
+{
+   unsigned int cnt = 0;
+   if (packets != nullptr && sizes != nullptr) {
+      while (cnt < n && sendData(packets[cnt], sizes[cnt])) {
+         cnt++;
+      }
+   }
+   return cnt;
+}
+
+//------------------------------------------------------------------------------
+// recvDataBatch() -- receive up to 'n' packets (default: one at a time)
+//------------------------------------------------------------------------------
+unsigned int NetHandler::recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes)
+{
+   unsigned int cnt = 0;
+   if (buffer != nullptr && maxSize > 0) {
+      while (cnt < n) {
+         const unsigned int size = recvData(buffer + cnt * maxSize, maxSize);
+         if (size == 0) break;
+         if (sizes != nullptr) sizes[cnt] = size;
+         cnt++;
+      }
+   }
+   return cnt;
+}
+
+//------------------------------------------------------------------------------
+// waitForData() -- wait for a packet (default: sleep for up to a millisecond)
+//------------------------------------------------------------------------------
+bool NetHandler::waitForData(const double timeout)
+{
+   if (timeout > 0) msleep(1);
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // init() -- initialize the network
 //------------------------------------------------------------------------------
@@ -10,6 +10,8 @@
     #include <arpa/inet.h>
     #include <sys/fcntl.h>
     #include <sys/ioctl.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
     #ifdef sun
         #include <sys/filio.h> // -- added for Solaris 10
     #endif
@@ -355,6 +357,139 @@ unsigned int PosixHandler::recvData(char* const packet, const int maxSize)
    return n;
 }
 
+// -------------------------------------------------------------
+// sendDataBatch() -- Send 'n' packets using sendmmsg()
+// -------------------------------------------------------------
+unsigned int PosixHandler::sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n)
+{
+#if defined(__linux__)
+    if (socketNum == INVALID_SOCKET || packets == nullptr || sizes == nullptr) return 0;
+
+    struct sockaddr_in addr;        // Working address structure
+    bzero(&addr, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = netAddr;
+    addr.sin_port = htons(port);
+
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+
+    unsigned int cnt = 0;
+    while (cnt < n) {
+        // Next batch of messages
+        unsigned int nb = n - cnt;
+        if (nb > MAX_BATCH) nb = MAX_BATCH;
+        bzero(msgs, nb * sizeof(struct mmsghdr));
+        for (unsigned int i = 0; i < nb; i++) {
+            iov[i].iov_base = const_cast<char*>(packets[cnt + i]);
+            iov[i].iov_len = static_cast<size_t>(sizes[cnt + i]);
+            msgs[i].msg_hdr.msg_name = &addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int result = ::sendmmsg(socketNum, msgs, nb, 0);
+        if (result == SOCKET_ERROR) {
+            std::perror("PosixHandler::sendDataBatch(): sendmmsg error msg");
+            if (isMessageEnabled(MSG_ERROR)) {
+                std::cerr << "PosixHandler::sendDataBatch(): sendmmsg error result: " << result << std::endl;
+            }
+            break;
+        }
+        cnt += static_cast<unsigned int>(result);
+        if (result == 0) break;
+    }
+    return cnt;
+#else
+    return BaseClass::sendDataBatch(packets, sizes, n);
+#endif
+}
+
+// -------------------------------------------------------------
+// recvDataBatch() -- Receive up to 'n' packets using recvmmsg()
+//                    and possible ignore our own local port messages.
+// -------------------------------------------------------------
+unsigned int PosixHandler::recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes)
+{
+#if defined(__linux__)
+    if (socketNum == INVALID_SOCKET || buffer == nullptr || maxSize <= 0) return 0;
+
+    struct sockaddr_in raddr[MAX_BATCH];
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+
+    unsigned int cnt = 0;
+    bool tryAgain = true;
+    while (tryAgain && cnt < n) {
+        tryAgain = false;
+
+        // Next batch of messages
+        unsigned int nb = n - cnt;
+        if (nb > MAX_BATCH) nb = MAX_BATCH;
+        bzero(msgs, nb * sizeof(struct mmsghdr));
+        for (unsigned int i = 0; i < nb; i++) {
+            iov[i].iov_base = buffer + (cnt + i) * maxSize;
+            iov[i].iov_len = static_cast<size_t>(maxSize);
+            msgs[i].msg_hdr.msg_name = &raddr[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(raddr[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Wait (if we're blocked) only for the first message
+        const int result = ::recvmmsg(socketNum, msgs, nb, MSG_WAITFORONE, nullptr);
+        if (result <= 0) break;
+
+        // Keep the packets that we're not ignoring (packed to the front)
+        unsigned int kept = 0;
+        for (unsigned int i = 0; i < static_cast<unsigned int>(result); i++) {
+            const unsigned int len = msgs[i].msg_len;
+            const uint16_t rport = ntohs(raddr[i].sin_port);
+            if (len == 0 || (ignoreSourcePort != 0 && rport == ignoreSourcePort)) continue;
+
+            const unsigned int j = cnt + kept;
+            if (j != (cnt + i)) {
+                std::memmove(buffer + j * maxSize, buffer + (cnt + i) * maxSize, len);
+            }
+            if (sizes != nullptr) sizes[j] = len;
+            fromAddr1 = raddr[i].sin_addr.s_addr;
+            fromPort1 = rport;
+            kept++;
+        }
+        cnt += kept;
+
+        // Full batch: there may be more waiting; nothing kept: try again (same as recvData())
+        tryAgain = (static_cast<unsigned int>(result) == nb) || (kept == 0);
+    }
+    return cnt;
+#else
+    return BaseClass::recvDataBatch(buffer, maxSize, n, sizes);
+#endif
+}
+
+// -------------------------------------------------------------
+// waitForData() -- Wait up to 'timeout' seconds for our socket
+//                  to become readable
+// -------------------------------------------------------------
+bool PosixHandler::waitForData(const double timeout)
+{
+    if (socketNum == INVALID_SOCKET) return BaseClass::waitForData(timeout);
+
+    fd_set rfds;
+    FD_ZERO(&rfds);
+    FD_SET(socketNum, &rfds);
+
+    const double t = (timeout > 0 ? timeout : 0);
+    struct timeval tv;
+    tv.tv_sec = static_cast<long>(t);
+    tv.tv_usec = static_cast<long>((t - static_cast<double>(tv.tv_sec)) * 1.0e6);
+
+    // (a signal or an error is reported as "may be waiting"; the receive will tell)
+    const int result = ::select(static_cast<int>(socketNum + 1), &rfds, nullptr, nullptr, &tv);
+    return (result != 0);
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -197,6 +197,20 @@ unsigned int TcpHandler::recvData(char* const packet, const int maxSize)
    return n;
 }
 
+// -------------------------------------------------------------
+// sendDataBatch(), recvDataBatch() -- TCP is a byte stream, so use
+// the one packet at a time defaults, which use sendData() and recvData()
+// -------------------------------------------------------------
+unsigned int TcpHandler::sendDataBatch(const char* const packets[], const int sizes[], const unsigned int n)
+{
+   return NetHandler::sendDataBatch(packets, sizes, n);
+}
+
+unsigned int TcpHandler::recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes)
+{
+   return NetHandler::recvDataBatch(buffer, maxSize, n, sizes);
+}
+
 }
 }
 
@@ -1,9 +1,228 @@
 
+#include "openeaagles/base/util/math_utils.hpp"
+
 #include <cmath>
 
+// ---
+// SIMD versions of the array functions: SSE2 (always available on x86-64)
+// and AVX, which is selected at run time.  Only operations that are exactly
+// rounded (add, multiply, divide and square root) are vectorized, so the
+// results match the scalar functions bit for bit.  The transcendental
+// functions (sin, cos, acos, atan2, pow) remain scalar library calls.
+// ---
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define OE_MATH_UTILS_X86_SIMD
+#include <immintrin.h>
+#define OE_TARGET_AVX __attribute__((target("avx")))
+#endif
+
 namespace oe {
 namespace base {
 
+#ifdef OE_MATH_UTILS_X86_SIMD
+namespace {
+
+// True if the CPU supports AVX (checked once)
+bool haveAvx()
+{
+   static const bool avx = (__builtin_cpu_supports("avx") != 0);
+   return avx;
+}
+
+// ---
+// sqrt
+// ---
+OE_TARGET_AVX unsigned int sqrtAvx(const double* const src, double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      _mm256_storeu_pd(dst + i, _mm256_sqrt_pd(_mm256_loadu_pd(src + i)));
+   }
+   return i;
+}
+
+OE_TARGET_AVX unsigned int sqrtAvx(const float* const src, float* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 8) <= n; i += 8) {
+      _mm256_storeu_ps(dst + i, _mm256_sqrt_ps(_mm256_loadu_ps(src + i)));
+   }
+   return i;
+}
+
+unsigned int sqrtSse(const double* const src, double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 2) <= n; i += 2) {
+      _mm_storeu_pd(dst + i, _mm_sqrt_pd(_mm_loadu_pd(src + i)));
+   }
+   return i;
+}
+
+unsigned int sqrtSse(const float* const src, float* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      _mm_storeu_ps(dst + i, _mm_sqrt_ps(_mm_loadu_ps(src + i)));
+   }
+   return i;
+}
+
+// ---
+// multiply by a constant
+// ---
+OE_TARGET_AVX unsigned int multConstAvx(const double* const src, const double c, double* const dst, const unsigned int n)
+{
+   const __m256d vc = _mm256_set1_pd(c);
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(src + i), vc));
+   }
+   return i;
+}
+
+OE_TARGET_AVX unsigned int multConstAvx(const float* const src, const float c, double* const dst, const unsigned int n)
+{
+   const __m128 vc = _mm_set1_ps(c);
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_mul_ps(_mm_loadu_ps(src + i), vc)));
+   }
+   return i;
+}
+
+unsigned int multConstSse(const double* const src, const double c, double* const dst, const unsigned int n)
+{
+   const __m128d vc = _mm_set1_pd(c);
+   unsigned int i = 0;
+   for (; (i + 2) <= n; i += 2) {
+      _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(src + i), vc));
+   }
+   return i;
+}
+
+unsigned int multConstSse(const float* const src, const float c, double* const dst, const unsigned int n)
+{
+   const __m128 vc = _mm_set1_ps(c);
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      const __m128 r = _mm_mul_ps(_mm_loadu_ps(src + i), vc);
+      _mm_storeu_pd(dst + i,     _mm_cvtps_pd(r));
+      _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(r, r)));
+   }
+   return i;
+}
+
+// ---
+// lengths:  sqrt( x*x + y*y + z*z )
+// ---
+OE_TARGET_AVX unsigned int lengthAvx(const double* const x, const double* const y, const double* const z, double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      const __m256d vx = _mm256_loadu_pd(x + i);
+      const __m256d vy = _mm256_loadu_pd(y + i);
+      const __m256d vz = _mm256_loadu_pd(z + i);
+      const __m256d s = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy)), _mm256_mul_pd(vz, vz));
+      _mm256_storeu_pd(dst + i, _mm256_sqrt_pd(s));
+   }
+   return i;
+}
+
+unsigned int lengthSse(const double* const x, const double* const y, const double* const z, double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 2) <= n; i += 2) {
+      const __m128d vx = _mm_loadu_pd(x + i);
+      const __m128d vy = _mm_loadu_pd(y + i);
+      const __m128d vz = _mm_loadu_pd(z + i);
+      const __m128d s = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz));
+      _mm_storeu_pd(dst + i, _mm_sqrt_pd(s));
+   }
+   return i;
+}
+
+// ---
+// normalize: lengths, then scale by 1/length (only if the length is greater than zero)
+// ---
+OE_TARGET_AVX unsigned int normalizeAvx(double* const x, double* const y, double* const z, double* const lengths, const unsigned int n)
+{
+   const __m256d zero = _mm256_setzero_pd();
+   const __m256d one = _mm256_set1_pd(1.0);
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      const __m256d vx = _mm256_loadu_pd(x + i);
+      const __m256d vy = _mm256_loadu_pd(y + i);
+      const __m256d vz = _mm256_loadu_pd(z + i);
+      const __m256d s = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy)), _mm256_mul_pd(vz, vz));
+      const __m256d len = _mm256_sqrt_pd(s);
+      const __m256d pos = _mm256_cmp_pd(len, zero, _CMP_GT_OQ);
+      const __m256d inv = _mm256_blendv_pd(one, _mm256_div_pd(one, len), pos);
+      _mm256_storeu_pd(x + i, _mm256_mul_pd(vx, inv));
+      _mm256_storeu_pd(y + i, _mm256_mul_pd(vy, inv));
+      _mm256_storeu_pd(z + i, _mm256_mul_pd(vz, inv));
+      _mm256_storeu_pd(lengths + i, len);
+   }
+   return i;
+}
+
+unsigned int normalizeSse(double* const x, double* const y, double* const z, double* const lengths, const unsigned int n)
+{
+   const __m128d zero = _mm_setzero_pd();
+   const __m128d one = _mm_set1_pd(1.0);
+   unsigned int i = 0;
+   for (; (i + 2) <= n; i += 2) {
+      const __m128d vx = _mm_loadu_pd(x + i);
+      const __m128d vy = _mm_loadu_pd(y + i);
+      const __m128d vz = _mm_loadu_pd(z + i);
+      const __m128d s = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz));
+      const __m128d len = _mm_sqrt_pd(s);
+      const __m128d pos = _mm_cmpgt_pd(len, zero);
+      const __m128d inv = _mm_or_pd(_mm_and_pd(pos, _mm_div_pd(one, len)), _mm_andnot_pd(pos, one));
+      _mm_storeu_pd(x + i, _mm_mul_pd(vx, inv));
+      _mm_storeu_pd(y + i, _mm_mul_pd(vy, inv));
+      _mm_storeu_pd(z + i, _mm_mul_pd(vz, inv));
+      _mm_storeu_pd(lengths + i, len);
+   }
+   return i;
+}
+
+// ---
+// dot products: ax*bx + ay*by + az*bz
+// ---
+OE_TARGET_AVX unsigned int dotAvx(
+      const double* const ax, const double* const ay, const double* const az,
+      const double* const bx, const double* const by, const double* const bz,
+      double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 4) <= n; i += 4) {
+      const __m256d xx = _mm256_mul_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i));
+      const __m256d yy = _mm256_mul_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i));
+      const __m256d zz = _mm256_mul_pd(_mm256_loadu_pd(az + i), _mm256_loadu_pd(bz + i));
+      _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_add_pd(xx, yy), zz));
+   }
+   return i;
+}
+
+unsigned int dotSse(
+      const double* const ax, const double* const ay, const double* const az,
+      const double* const bx, const double* const by, const double* const bz,
+      double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+   for (; (i + 2) <= n; i += 2) {
+      const __m128d xx = _mm_mul_pd(_mm_loadu_pd(ax + i), _mm_loadu_pd(bx + i));
+      const __m128d yy = _mm_mul_pd(_mm_loadu_pd(ay + i), _mm_loadu_pd(by + i));
+      const __m128d zz = _mm_mul_pd(_mm_loadu_pd(az + i), _mm_loadu_pd(bz + i));
+      _mm_storeu_pd(dst + i, _mm_add_pd(_mm_add_pd(xx, yy), zz));
+   }
+   return i;
+}
+
+}
+#endif
+
 //------------
 // returns number of digits in the whole number part (i.e. left of decimal)
 // of a floating point number
@@ -155,19 +374,23 @@ void atan2Array(const float* const yValues, const float* const xValues, float* c
 //------------
 void sqrtArray(const double* const src, double* const dst, const unsigned int n)
 {
-   const double* ps = src;
-   double* pd = dst;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = std::sqrt(*ps++);
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? sqrtAvx(src, dst, n) : sqrtSse(src, dst, n));
+#endif
+   for (; i < n; i++) {
+      dst[i] = std::sqrt(src[i]);
    }
 }
 
 void sqrtArray(const float* const src, float* const dst, const unsigned int n)
 {
-   const float* ps = src;
-   float* pd = dst;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = sqrtf(*ps++);
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? sqrtAvx(src, dst, n) : sqrtSse(src, dst, n));
+#endif
+   for (; i < n; i++) {
+      dst[i] = sqrtf(src[i]);
    }
 }
 
@@ -197,19 +420,77 @@ void pow10Array(const float* const src, float* const dst, const unsigned int n)
 //------------
 void multArrayConst(const double* const src, const double c, double* const dst, const unsigned int n)
 {
-   double* pd = dst;
-   const double* ps = src;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = *ps++ * c;
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? multConstAvx(src, c, dst, n) : multConstSse(src, c, dst, n));
+#endif
+   for (; i < n; i++) {
+      dst[i] = src[i] * c;
    }
 }
 
 void multArrayConst(const float* const src, const float c, double* const dst, const unsigned int n)
 {
-   double* pd = dst;
-   const float* ps = src;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = *ps++ * c;
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? multConstAvx(src, c, dst, n) : multConstSse(src, c, dst, n));
+#endif
+   for (; i < n; i++) {
+      dst[i] = src[i] * c;
+   }
+}
+
+//------------
+// Computes the lengths of 'n' 3D vectors, which are stored as component arrays
+//------------
+void lengthArray(const double* const x, const double* const y, const double* const z, double* const lengths, const unsigned int n)
+{
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? lengthAvx(x, y, z, lengths, n) : lengthSse(x, y, z, lengths, n));
+#endif
+   for (; i < n; i++) {
+      lengths[i] = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+   }
+}
+
+//------------
+// Normalizes, in place, 'n' 3D vectors, which are stored as component arrays,
+// and returns their lengths (same as Vec3d::normalize())
+//------------
+void normalizeArray(double* const x, double* const y, double* const z, double* const lengths, const unsigned int n)
+{
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? normalizeAvx(x, y, z, lengths, n) : normalizeSse(x, y, z, lengths, n));
+#endif
+   for (; i < n; i++) {
+      const double len = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+      if (len > 0.0) {
+         const double inv = 1.0/len;
+         x[i] *= inv;
+         y[i] *= inv;
+         z[i] *= inv;
+      }
+      lengths[i] = len;
+   }
+}
+
+//------------
+// Computes the dot products of two arrays of 'n' 3D vectors, which are
+// stored as component arrays
+//------------
+void dotArray(
+      const double* const ax, const double* const ay, const double* const az,
+      const double* const bx, const double* const by, const double* const bz,
+      double* const dst, const unsigned int n)
+{
+   unsigned int i = 0;
+#ifdef OE_MATH_UTILS_X86_SIMD
+   i = (haveAvx() ? dotAvx(ax, ay, az, bx, by, bz, dst, n) : dotSse(ax, ay, az, bx, by, bz, dst, n));
+#endif
+   for (; i < n; i++) {
+      dst[i] = ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
    }
 }
 
@@ -2,6 +2,7 @@
 #include "openeaagles/graphics/factory.hpp"
 
 #include "openeaagles/base/Object.hpp"
+#include "openeaagles/base/FactoryTable.hpp"
 
 #include "openeaagles/graphics/Graphic.hpp"
 #include "openeaagles/graphics/Display.hpp"
@@ -44,154 +45,70 @@ namespace graphics {
 
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj = nullptr;
-
-    // General graphics support
-    if ( name == Graphic::getFactoryName() ) {
-        obj = new Graphic();
-    }
-    else if ( name == Page::getFactoryName() ) {
-        obj = new Page();
-    }
-    else if ( name == Display::getFactoryName() ) {
-        obj = new Display();
-    }
-    else if ( name == Translator::getFactoryName() ) {
-        obj = new Translator();
-    }
-    else if ( name == Rotators::getFactoryName() ) {
-        obj = new Rotators();
-    }
-    else if ( name == ColorRotary::getFactoryName() ) {
-        obj = new ColorRotary();
-    }
-    else if ( name == ColorGradient::getFactoryName() ) {
-        obj = new ColorGradient();
-    }
-
-    // Shapes
-    else if ( name == Circle::getFactoryName() ) {
-        obj = new Circle();
-    }
-    else if ( name == Point::getFactoryName() ) {
-        obj = new Point();
-    }
-    else if ( name == Polygon::getFactoryName() ) {
-        obj = new Polygon();
-    }
-    else if ( name == LineLoop::getFactoryName() ) {
-        obj = new LineLoop();
-    }
-    else if ( name == Line::getFactoryName() ) {
-        obj = new Line();
-    }
-    else if ( name == Arc::getFactoryName() ) {
-        obj = new Arc();
-    }
-    else if ( name == OcclusionCircle::getFactoryName() ) {
-        obj = new OcclusionCircle();
-    }
-    else if ( name == OcclusionArc::getFactoryName() ) {
-        obj = new OcclusionArc();
-    }
-    else if ( name == Quad::getFactoryName() ) {
-        obj = new Quad();
-    }
-    else if ( name == Triangle::getFactoryName() ) {
-        obj = new Triangle();
-    }
-
-    // Fields
-    else if ( name == AsciiText::getFactoryName() ) {
-        obj = new AsciiText();
-    }
-    else if ( name == Cursor::getFactoryName() ) {
-        obj = new Cursor();
-    }
-
-    // Readouts
-    else if ( name == NumericReadout::getFactoryName() ) {
-        obj = new NumericReadout();
-    }
-    else if ( name == HexReadout::getFactoryName() ) {
-        obj = new HexReadout();
-    }
-    else if ( name == OctalReadout::getFactoryName() ) {
-        obj = new OctalReadout();
-    }
-    else if ( name == TimeReadout::getFactoryName() ) {
-        obj = new TimeReadout();
-    }
-    else if ( name == DirectionReadout::getFactoryName() ) {
-        obj = new DirectionReadout();
-    }
-    else if ( name == LatitudeReadout::getFactoryName() ) {
-        obj = new LatitudeReadout();
-    }
-    else if ( name == LongitudeReadout::getFactoryName() ) {
-        obj = new LongitudeReadout();
-    }
-    else if ( name == Rotary::getFactoryName() ) {
-        obj = new Rotary();
-    }
-    else if ( name == Rotary2::getFactoryName() ) {
-        obj = new Rotary2();
-    }
-
-    // Stroke Font
-    else if ( name == StrokeFont::getFactoryName() ) {
-        obj = new StrokeFont();
-    }
-
-    // Bitmap Font
-    else if ( name == BitmapFont::getFactoryName() ) {
-        obj = new BitmapFont();
-    }
-
-    // FTGL Fonts
-    else if ( name == FtglBitmapFont::getFactoryName() ) {
-        obj = new FtglBitmapFont();
-    }
-    else if ( name == FtglOutlineFont::getFactoryName() ) {
-        obj = new FtglOutlineFont();
-    }
-    else if ( name == FtglExtrdFont::getFactoryName() ) {
-        obj = new FtglExtrdFont();
-    }
-    else if ( name == FtglPixmapFont::getFactoryName() ) {
-        obj = new FtglPixmapFont();
-    }
-    else if ( name == FtglPolygonFont::getFactoryName() ) {
-        obj = new FtglPolygonFont();
-    }
-    else if ( name == FtglHaloFont::getFactoryName() ) {
-        obj = new FtglHaloFont();
-    }
-    else if ( name == FtglTextureFont::getFactoryName() ) {
-        obj = new FtglTextureFont();
-    }
-
-    // Bitmap Textures
-    else if ( name == BmpTexture::getFactoryName() ) {
-        obj = new BmpTexture();
-    }
-    // Material
-    else if ( name == Material::getFactoryName() ) {
-        obj = new Material();
-    }
-    // pages
-    else if ( name == MfdPage::getFactoryName() ) {
-        obj = new MfdPage();
-    }
-    else if ( name == MapPage::getFactoryName() ) {
-        obj = new MapPage();
-    }
-    // Symbol loader
-    else if ( name == SymbolLoader::getFactoryName() ) {
-        obj = new SymbolLoader();
-    }
-
-    return obj;
+    static const base::FactoryTable table = {
+        // General graphics support
+        FACTORY_ENTRY(Graphic),
+        FACTORY_ENTRY(Page),
+        FACTORY_ENTRY(Display),
+        FACTORY_ENTRY(Translator),
+        FACTORY_ENTRY(Rotators),
+        FACTORY_ENTRY(ColorRotary),
+        FACTORY_ENTRY(ColorGradient),
+
+        // Shapes
+        FACTORY_ENTRY(Circle),
+        FACTORY_ENTRY(Point),
+        FACTORY_ENTRY(Polygon),
+        FACTORY_ENTRY(LineLoop),
+        FACTORY_ENTRY(Line),
+        FACTORY_ENTRY(Arc),
+        FACTORY_ENTRY(OcclusionCircle),
+        FACTORY_ENTRY(OcclusionArc),
+        FACTORY_ENTRY(Quad),
+        FACTORY_ENTRY(Triangle),
+
+        // Fields
+        FACTORY_ENTRY(AsciiText),
+        FACTORY_ENTRY(Cursor),
+
+        // Readouts
+        FACTORY_ENTRY(NumericReadout),
+        FACTORY_ENTRY(HexReadout),
+        FACTORY_ENTRY(OctalReadout),
+        FACTORY_ENTRY(TimeReadout),
+        FACTORY_ENTRY(DirectionReadout),
+        FACTORY_ENTRY(LatitudeReadout),
+        FACTORY_ENTRY(LongitudeReadout),
+        FACTORY_ENTRY(Rotary),
+        FACTORY_ENTRY(Rotary2),
+
+        // Stroke Font
+        FACTORY_ENTRY(StrokeFont),
+
+        // Bitmap Font
+        FACTORY_ENTRY(BitmapFont),
+
+        // FTGL Fonts
+        FACTORY_ENTRY(FtglBitmapFont),
+        FACTORY_ENTRY(FtglOutlineFont),
+        FACTORY_ENTRY(FtglExtrdFont),
+        FACTORY_ENTRY(FtglPixmapFont),
+        FACTORY_ENTRY(FtglPolygonFont),
+        FACTORY_ENTRY(FtglHaloFont),
+        FACTORY_ENTRY(FtglTextureFont),
+
+        // Bitmap Textures
+        FACTORY_ENTRY(BmpTexture),
+        // Material
+        FACTORY_ENTRY(Material),
+        // pages
+        FACTORY_ENTRY(MfdPage),
+        FACTORY_ENTRY(MapPage),
+        // Symbol loader
+        FACTORY_ENTRY(SymbolLoader)
+    };
+
+    return table.create(name);
 }
 
 }
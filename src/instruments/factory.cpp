@@ -2,6 +2,7 @@
 #include "openeaagles/instruments/factory.hpp"
 
 #include "openeaagles/base/Object.hpp"
+#include "openeaagles/base/FactoryTable.hpp"
 
 // Top Level objects
 #include "openeaagles/instruments/Instrument.hpp"
@@ -56,118 +57,64 @@ namespace instruments {
 
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj = nullptr;
-
-    // Instrument
-    if ( name == Instrument::getFactoryName() ) {
-        obj = new Instrument;
-    }
-    // Analog Dial
-    else if ( name == AnalogDial::getFactoryName() ) {
-        obj = new AnalogDial;
-    }
-    // Tick Marks for the analog dial
-    else if ( name == DialTickMarks::getFactoryName() ) {
-        obj = new DialTickMarks;
-    }
-    // Arc Segments for the analog dial
-    else if ( name == DialArcSegment::getFactoryName() ) {
-        obj = new DialArcSegment;
-    }
-    // Dial Pointer
-    else if ( name == DialPointer::getFactoryName() ) {
-        obj = new DialPointer;
-    }
-    // CompassRose
-    else if ( name == CompassRose::getFactoryName() ) {
-        obj = new CompassRose;
-    }
-    // Bearing Pointer
-    else if ( name == BearingPointer::getFactoryName() ) {
-        obj = new BearingPointer;
-    }
-    // AltitudeDial
-    else if ( name == AltitudeDial::getFactoryName() ) {
-        obj = new AltitudeDial;
-    }
-    // GMeterDial
-    else if ( name == GMeterDial::getFactoryName() ) {
-        obj = new GMeterDial;
-    }    
-    // Here is the analog gauge and its pieces
-    // AnalogGauge
-    else if ( name == AnalogGauge::getFactoryName() ) {
-        obj = new AnalogGauge;
-    }
-    else if ( name == GaugeSlider::getFactoryName() ) {
-        obj = new GaugeSlider;
-    }
-    // Tape
-    else if ( name == Tape::getFactoryName() ) {
-        obj = new Tape;
-    }
-    // digital AOA gauge
-    else if ( name == AoAIndexer::getFactoryName() ) {
-        obj = new AoAIndexer;
-    }
-    // Tick Marks (horizontal and vertical)
-    else if ( name == TickMarks::getFactoryName() ) {
-        obj = new TickMarks;
-    }
-    // Landing Gear
-    else if ( name == LandingGear::getFactoryName() ) {
-        obj = new LandingGear;
-    }
-    // Landing Lights
-    else if ( name == LandingLight::getFactoryName() ) {
-        obj = new LandingLight;
-    }
-    // EngPage
-    else if ( name == EngPage::getFactoryName() ) {
-        obj = new EngPage;
-    }
-    // Button
-    else if (name == Button::getFactoryName() ) {
-        obj = new Button;
-    }
-    // Push Button
-    else if (name == PushButton::getFactoryName() ) {
-        obj = new PushButton;
-    }
-    // Rotary Switch
-    else if (name == RotarySwitch::getFactoryName() ) {
-        obj = new RotarySwitch;
-    }
-    // Knob
-    else if (name == Knob::getFactoryName() ) {
-        obj = new Knob;
-    }
-    // Switch
-    else if (name == Switch::getFactoryName() ) {
-        obj = new Switch;
-    }
-    // Hold Switch
-    else if (name == SolenoidSwitch::getFactoryName() ) {
-        obj = new SolenoidSwitch;
-    }
-    // Hold Button
-    else if (name == SolenoidButton::getFactoryName() ) {
-        obj = new SolenoidButton;
-    }
-    // Adi
-    else if (name == Adi::getFactoryName() ) {
-        obj = new Adi;
-    }
-    // Ghost Horizon
-    else if (name == GhostHorizon::getFactoryName() ) {
-        obj = new GhostHorizon;
-    }
-    // Eadi3D
-    else if (name == Eadi3DPage::getFactoryName() ) {
-        obj = new Eadi3DPage;
-    }
-
-    return obj;
+    static const base::FactoryTable table = {
+        // Instrument
+        FACTORY_ENTRY(Instrument),
+        // Analog Dial
+        FACTORY_ENTRY(AnalogDial),
+        // Tick Marks for the analog dial
+        FACTORY_ENTRY(DialTickMarks),
+        // Arc Segments for the analog dial
+        FACTORY_ENTRY(DialArcSegment),
+        // Dial Pointer
+        FACTORY_ENTRY(DialPointer),
+        // CompassRose
+        FACTORY_ENTRY(CompassRose),
+        // Bearing Pointer
+        FACTORY_ENTRY(BearingPointer),
+        // AltitudeDial
+        FACTORY_ENTRY(AltitudeDial),
+        // GMeterDial
+        FACTORY_ENTRY(GMeterDial),
+        // Here is the analog gauge and its pieces
+        // AnalogGauge
+        FACTORY_ENTRY(AnalogGauge),
+        FACTORY_ENTRY(GaugeSlider),
+        // Tape
+        FACTORY_ENTRY(Tape),
+        // digital AOA gauge
+        FACTORY_ENTRY(AoAIndexer),
+        // Tick Marks (horizontal and vertical)
+        FACTORY_ENTRY(TickMarks),
+        // Landing Gear
+        FACTORY_ENTRY(LandingGear),
+        // Landing Lights
+        FACTORY_ENTRY(LandingLight),
+        // EngPage
+        FACTORY_ENTRY(EngPage),
+        // Button
+        FACTORY_ENTRY(Button),
+        // Push Button
+        FACTORY_ENTRY(PushButton),
+        // Rotary Switch
+        FACTORY_ENTRY(RotarySwitch),
+        // Knob
+        FACTORY_ENTRY(Knob),
+        // Switch
+        FACTORY_ENTRY(Switch),
+        // Hold Switch
+        FACTORY_ENTRY(SolenoidSwitch),
+        // Hold Button
+        FACTORY_ENTRY(SolenoidButton),
+        // Adi
+        FACTORY_ENTRY(Adi),
+        // Ghost Horizon
+        FACTORY_ENTRY(GhostHorizon),
+        // Eadi3D
+        FACTORY_ENTRY(Eadi3DPage)
+    };
+
+    return table.create(name);
 }
 
 }
@@ -0,0 +1,203 @@
+#include "openeaagles/interop/common/AreaOfInterest.hpp"
+
+#include "openeaagles/models/player/Player.hpp"
+
+#include "openeaagles/base/List.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+
+#include <cmath>
+
+namespace oe {
+namespace interop {
+
+const double AreaOfInterest::DEFAULT_CELL_SIZE = 200000.0;   // 200 km
+const double AreaOfInterest::MIN_CELL_SIZE = 1000.0;         // 1 km
+
+// Time (seconds) between the checks for timed out entities
+static const double EXPIRE_INTERVAL = 1.0;
+
+//------------------------------------------------------------------------------
+// Cell keys -- 21 bits per axis, which is enough for +/- 1M cells
+//------------------------------------------------------------------------------
+unsigned long long AreaOfInterest::cellKey(const int ix, const int iy, const int iz)
+{
+   const unsigned long long mask = 0x1fffff;
+   return ( (static_cast<unsigned long long>(ix) & mask) << 42 ) |
+          ( (static_cast<unsigned long long>(iy) & mask) << 21 ) |
+          (  static_cast<unsigned long long>(iz) & mask );
+}
+
+int AreaOfInterest::cellCoord(const double v) const
+{
+   return static_cast<int>( std::floor(v / cellSize) );
+}
+
+//------------------------------------------------------------------------------
+// Sets the grid cell size (meters); takes effect at the next rebuild()
+//------------------------------------------------------------------------------
+bool AreaOfInterest::setCellSize(const double meters)
+{
+   bool ok = false;
+   if (meters >= MIN_CELL_SIZE) {
+      cellSize = meters;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// rebuild() -- bins the positions of the active local players into the grid
+//------------------------------------------------------------------------------
+void AreaOfInterest::rebuild(const base::PairStream* const players)
+{
+   cells.clear();
+   cx.clear();
+   cy.clear();
+   cz.clear();
+   start.clear();
+   items.clear();
+
+   // Collect the positions; the local players are first on the list
+   pos.clear();
+   if (players != nullptr) {
+      const base::List::Item* item = players->getFirstItem();
+      bool finished = false;
+      while (item != nullptr && !finished) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto player = static_cast<const models::Player*>(pair->object());
+         if (player->isLocalPlayer()) {
+            if (player->isActive()) pos.push_back(player->getGeocPosition());
+         }
+         else finished = true;
+         item = item->getNext();
+      }
+   }
+
+   // Find (or create) each position's cell and count the items per cell
+   cellOf.resize(pos.size());
+   for (unsigned int i = 0; i < pos.size(); i++) {
+      const int ix = cellCoord(pos[i].x());
+      const int iy = cellCoord(pos[i].y());
+      const int iz = cellCoord(pos[i].z());
+      const auto ins = cells.emplace(cellKey(ix, iy, iz), static_cast<unsigned int>(cx.size()));
+      if (ins.second) {
+         cx.push_back(ix);
+         cy.push_back(iy);
+         cz.push_back(iz);
+         start.push_back(0);
+      }
+      cellOf[i] = ins.first->second;
+      start[cellOf[i]]++;
+   }
+
+   // Counts to start indexes
+   unsigned int sum = 0;
+   for (unsigned int c = 0; c < start.size(); c++) {
+      const unsigned int k = start[c];
+      start[c] = sum;
+      sum += k;
+   }
+   start.push_back(sum);
+
+   // Fill the cells; 'start' is shifted by one cell while filling
+   items.resize(pos.size());
+   for (unsigned int i = 0; i < pos.size(); i++) {
+      items[ start[cellOf[i]]++ ] = pos[i];
+   }
+   for (unsigned int c = static_cast<unsigned int>(cx.size()); c > 0; c--) {
+      start[c] = start[c-1];
+   }
+   start[0] = 0;
+}
+
+//------------------------------------------------------------------------------
+// isInterested() -- True if 'p' is within 'range' of a local player
+//------------------------------------------------------------------------------
+bool AreaOfInterest::isInterested(const base::Vec3d& p, const double range) const
+{
+   const unsigned int ncells = static_cast<unsigned int>(cx.size());
+   if (ncells == 0) return true;
+
+   const double r2 = range * range;
+
+   // Bounding box of the range sphere, in cells
+   const int x0 = cellCoord(p.x() - range);
+   const int x1 = cellCoord(p.x() + range);
+   const int y0 = cellCoord(p.y() - range);
+   const int y1 = cellCoord(p.y() + range);
+   const int z0 = cellCoord(p.z() - range);
+   const int z1 = cellCoord(p.z() + range);
+
+   const double boxCells = static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1) * static_cast<double>(z1 - z0 + 1);
+
+   bool found = false;
+   if (boxCells <= static_cast<double>(ncells)) {
+      // Small box: look up each of the box's cells
+      for (int ix = x0; ix <= x1 && !found; ix++) {
+         for (int iy = y0; iy <= y1 && !found; iy++) {
+            for (int iz = z0; iz <= z1 && !found; iz++) {
+               const auto it = cells.find(cellKey(ix, iy, iz));
+               if (it != cells.end()) {
+                  const unsigned int c = it->second;
+                  for (unsigned int i = start[c]; i < start[c+1] && !found; i++) {
+                     found = ((items[i] - p).length2() <= r2);
+                  }
+               }
+            }
+         }
+      }
+   }
+   else {
+      // Large box: check each of the occupied cells
+      for (unsigned int c = 0; c < ncells && !found; c++) {
+         if (cx[c] >= x0 && cx[c] <= x1 &&
+             cy[c] >= y0 && cy[c] <= y1 &&
+             cz[c] >= z0 && cz[c] <= z1) {
+            for (unsigned int i = start[c]; i < start[c+1] && !found; i++) {
+               found = ((items[i] - p).length2() <= r2);
+            }
+         }
+      }
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Filtered entity bookkeeping
+//------------------------------------------------------------------------------
+void AreaOfInterest::filtered(const unsigned long long id, const double time, const double timeout)
+{
+   filteredTable[id] = time + timeout;
+   nFilteredUpdates++;
+}
+
+void AreaOfInterest::admitted(const unsigned long long id)
+{
+   nAdmitted++;
+   if (filteredTable.erase(id) > 0) nPromoted++;
+}
+
+void AreaOfInterest::expire(const double time)
+{
+   if (time >= nextExpire || time < (nextExpire - EXPIRE_INTERVAL)) {
+      auto it = filteredTable.begin();
+      while (it != filteredTable.end()) {
+         if (it->second < time) it = filteredTable.erase(it);
+         else ++it;
+      }
+      nextExpire = time + EXPIRE_INTERVAL;
+   }
+}
+
+void AreaOfInterest::reset()
+{
+   filteredTable.clear();
+   nextExpire = 0;
+   nFilteredUpdates = 0;
+   nAdmitted = 0;
+   nPromoted = 0;
+}
+
+}
+}
@@ -0,0 +1,212 @@
+#include "openeaagles/interop/common/DrEngine.hpp"
+
+#include "openeaagles/base/util/atomics.hpp"
+
+namespace oe {
+namespace interop {
+
+DrEngine::~DrEngine()
+{
+   for (unsigned int k = 0; k < NUM_KERNELS; k++) {
+      const unsigned int n = nBlocks[k];
+      for (unsigned int i = 0; i < n; i++) {
+         delete blocks[k][i];
+         blocks[k][i] = nullptr;
+      }
+      nBlocks[k] = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Returns the block and its slot index of a slot handle, or zero
+//------------------------------------------------------------------------------
+DrEngine::Block* DrEngine::getBlock(const int h, unsigned int* const idx) const
+{
+   Block* blk = nullptr;
+   if (h >= 0) {
+      const unsigned int k = static_cast<unsigned int>(h) / (MAX_BLOCKS * BLOCK_SIZE);
+      const unsigned int n = static_cast<unsigned int>(h) % (MAX_BLOCKS * BLOCK_SIZE);
+      if (k < NUM_KERNELS && (n / BLOCK_SIZE) < MAX_BLOCKS) {
+         blk = blocks[k][n / BLOCK_SIZE];
+         *idx = (n % BLOCK_SIZE);
+      }
+   }
+   return blk;
+}
+
+//------------------------------------------------------------------------------
+// Slot locks -- lockSlot() waits for the slot's sequence number to be even,
+// makes it odd and returns its previous (even) value; unlockSlot() makes it
+// even again (i.e., 's' plus two).
+//------------------------------------------------------------------------------
+unsigned int DrEngine::lockSlot(Block* const blk, const unsigned int i)
+{
+   std::atomic<unsigned int>& seq = blk->seq[i];
+   unsigned int s = seq.load(std::memory_order_relaxed);
+   while ( (s & 1) != 0 || !seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire) ) {
+      if ((s & 1) != 0) s = seq.load(std::memory_order_relaxed);
+   }
+   return s;
+}
+
+void DrEngine::unlockSlot(Block* const blk, const unsigned int i, const unsigned int s)
+{
+   blk->seq[i].store(s + 2, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// allocate() -- allocates a slot for kernel 'k'; returns the handle or -1
+//------------------------------------------------------------------------------
+int DrEngine::allocate(const Kernel k)
+{
+   if (k >= NUM_KERNELS) return -1;
+
+   int h = -1;
+   base::lock(slotLock);
+
+   if (freeSlots[k].empty() && nBlocks[k] < MAX_BLOCKS) {
+      // New block; its slots are added to the free list in reverse order,
+      // so they're used in order.
+      const unsigned int b = nBlocks[k];
+      blocks[k][b] = new Block();
+      nBlocks[k].store(b + 1, std::memory_order_release);
+      const int h0 = static_cast<int>(k * MAX_BLOCKS * BLOCK_SIZE + b * BLOCK_SIZE);
+      for (int i = BLOCK_SIZE - 1; i >= 0; i--) {
+         freeSlots[k].push_back(h0 + i);
+      }
+   }
+
+   if (!freeSlots[k].empty()) {
+      h = freeSlots[k].back();
+      freeSlots[k].pop_back();
+      nSlots++;
+   }
+
+   base::unlock(slotLock);
+   return h;
+}
+
+//------------------------------------------------------------------------------
+// release() -- releases a slot; its data are cleared
+//------------------------------------------------------------------------------
+void DrEngine::release(const int h)
+{
+   unsigned int i = 0;
+   Block* const blk = getBlock(h, &i);
+   if (blk != nullptr) {
+      const unsigned int s = lockSlot(blk, i);
+      blk->p0x[i] = 0;  blk->p0y[i] = 0;  blk->p0z[i] = 0;
+      blk->v0x[i] = 0;  blk->v0y[i] = 0;  blk->v0z[i] = 0;
+      blk->a0x[i] = 0;  blk->a0y[i] = 0;  blk->a0z[i] = 0;
+      blk->t[i] = 0;
+      unlockSlot(blk, i, s);
+
+      base::lock(slotLock);
+      freeSlots[getKernel(h)].push_back(h);
+      nSlots--;
+      base::unlock(slotLock);
+   }
+}
+
+//------------------------------------------------------------------------------
+// set() -- sets the DR data of a slot; its position is not used until the
+//          next advance()
+//------------------------------------------------------------------------------
+void DrEngine::set(
+      const int h,
+      const base::Vec3d& p,
+      const base::Vec3d& v,
+      const base::Vec3d& a,
+      const double time
+   )
+{
+   unsigned int i = 0;
+   Block* const blk = getBlock(h, &i);
+   if (blk != nullptr) {
+      const unsigned int s = lockSlot(blk, i);
+      blk->p0x[i] = p[0];  blk->p0y[i] = p[1];  blk->p0z[i] = p[2];
+      blk->v0x[i] = v[0];  blk->v0y[i] = v[1];  blk->v0z[i] = v[2];
+      blk->a0x[i] = a[0];  blk->a0y[i] = a[1];  blk->a0z[i] = a[2];
+      blk->t[i] = time;
+      unlockSlot(blk, i, s);
+   }
+}
+
+//------------------------------------------------------------------------------
+// update() -- sets the slot's new DR time, and returns its position, if it
+//             was computed by advance() for this DR time, and the slot hasn't
+//             changed since the advance() read it
+//------------------------------------------------------------------------------
+bool DrEngine::update(const int h, const double time, base::Vec3d* const pNewPos)
+{
+   bool ok = false;
+   unsigned int i = 0;
+   Block* const blk = getBlock(h, &i);
+   if (blk != nullptr) {
+      const unsigned int s = lockSlot(blk, i);
+      if (blk->pseq[i] == s && blk->pt[i] == time) {
+         pNewPos->set(blk->px[i], blk->py[i], blk->pz[i]);
+         ok = true;
+      }
+      blk->t[i] = time;
+      unlockSlot(blk, i, s);
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// advance() -- computes the positions of all slots at their DR time plus 'dt'
+//------------------------------------------------------------------------------
+void DrEngine::advance(const double dt)
+{
+   const unsigned int n1 = nBlocks[FIRST_ORDER].load(std::memory_order_acquire);
+   for (unsigned int b = 0; b < n1; b++) {
+      blocks[FIRST_ORDER][b]->firstOrder(dt);
+   }
+   const unsigned int n2 = nBlocks[SECOND_ORDER].load(std::memory_order_acquire);
+   for (unsigned int b = 0; b < n2; b++) {
+      blocks[SECOND_ORDER][b]->secondOrder(dt);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Block kernels -- same operations, in the same order, as the FPW and FVW
+// cases of Nib::mainDeadReckoning(); a fixed count, so they're vectorized.
+// (The free slots are zero, so they're computed without a test)
+//------------------------------------------------------------------------------
+
+// Saves the sequence numbers before the slots' data are read
+void DrEngine::Block::saveSequence()
+{
+   for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+      pseq[i] = seq[i].load(std::memory_order_acquire);
+   }
+}
+
+void DrEngine::Block::firstOrder(const double dt)
+{
+   saveSequence();
+   for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+      const double dT = t[i] + dt;
+      pt[i] = dT;
+      px[i] = p0x[i] + v0x[i]*dT;
+      py[i] = p0y[i] + v0y[i]*dT;
+      pz[i] = p0z[i] + v0z[i]*dT;
+   }
+}
+
+void DrEngine::Block::secondOrder(const double dt)
+{
+   saveSequence();
+   for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+      const double dT = t[i] + dt;
+      const double hdT2 = 0.5*dT*dT;
+      pt[i] = dT;
+      px[i] = p0x[i] + v0x[i]*dT + a0x[i]*hdT2;
+      py[i] = p0y[i] + v0y[i]*dT + a0y[i]*hdT2;
+      pz[i] = p0z[i] + v0z[i]*dT + a0z[i]*hdT2;
+   }
+}
+
+}
+}
@@ -28,6 +28,7 @@
 #include "openeaagles/base/Number.hpp"
 #include "openeaagles/base/Pair.hpp"
 #include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/Profiler.hpp"
 #include "openeaagles/base/String.hpp"
 
 #include "openeaagles/base/units/Angles.hpp"
@@ -36,6 +37,7 @@
 
 #include "openeaagles/base/util/str_utils.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 
@@ -132,15 +134,17 @@ void NetIO::copyData(const NetIO& org, const bool)
    netInit = org.netInit;
    netInitFail = org.netInitFail;
 
+   clearNewOutputPlayers();
+   playerEventSeq = 0;
+   outputScanReq = true;
+   outputDeletes.clear();
+
    setMaxEntityRange(org.maxEntityRange);
    setMaxTimeDR(org.maxTimeDR);
    setMaxPositionErr(org.maxPositionErr);
    setMaxOrientationErr(org.maxOrientationErr);
    setMaxAge(org.maxAge);
 
-   nInNibs = 0;
-   nOutNibs = 0;
-
    clearInputEntityTypes();
    for (unsigned int i = 0; i < org.nInputEntityTypes; i++) {
       Ntm* cp = org.inputEntityTypes[i]->clone();
@@ -158,17 +162,9 @@ void NetIO::copyData(const NetIO& org, const bool)
 
 void NetIO::deleteData()
 {
-   for (unsigned int i = 0; i < nInNibs; i++) {
-      inputList[i]->unref();
-      inputList[i] = nullptr;
-   }
-   nInNibs = 0;
-
-   for (unsigned int i = 0; i < nOutNibs; i++) {
-      outputList[i]->unref();
-      outputList[i] = nullptr;
-   }
-   nOutNibs = 0;
+   clearNewOutputPlayers();
+   inputTable.clear();
+   outputTable.clear();
 
    clearInputEntityTypes();
    clearOutputEntityTypes();
@@ -198,12 +194,15 @@ void NetIO::reset()
 //------------------------------------------------------------------------------
 bool NetIO::shutdownNotification()
 {
-    for (unsigned int i = 0; i < nInNibs; i++) {
-        inputList[i]->event(SHUTDOWN_EVENT);
+    // (skip the empty entries left by removeNibFromList())
+    for (unsigned int i = 0; i < inputTable.size(); i++) {
+        Nib* nib = inputTable.get(i);
+        if (nib != nullptr) nib->event(SHUTDOWN_EVENT);
     }
 
-    for (unsigned int i = 0; i < nOutNibs; i++) {
-        outputList[i]->event(SHUTDOWN_EVENT);
+    for (unsigned int i = 0; i < outputTable.size(); i++) {
+        Nib* nib = outputTable.get(i);
+        if (nib != nullptr) nib->event(SHUTDOWN_EVENT);
     }
     return BaseClass::shutdownNotification();
 }
@@ -345,6 +344,8 @@ bool NetIO::setFederationName(const base::String* const msg)
 void NetIO::inputFrame(const double)
 {
    if (isNetworkInitialized()) {
+      base::ProfileScope ps("inputFrame", this);
+      inputTable.compact(); // Remove the NIBs left by removeNibFromList()
       netInputHander();     // Input handler
       processInputList();   // Update players/systems from the Input-list
       cleanupInputList();   // Cleanup the Input-List (remove old NABs)
@@ -357,8 +358,26 @@ void NetIO::inputFrame(const double)
 void NetIO::outputFrame(const double)
 {
    if (isNetworkInitialized()) {
-      updateOutputList();   // Update the Output-List from the simulation player list
-      processOutputList();  // Create output packets from Output-List
+      base::ProfileScope ps("outputFrame", this);
+      outputTable.compact();   // Remove the NIBs left by removeNibFromList()
+      updateOutputList();      // Update the Output-List from the simulation player list
+      processOutputList();     // Create output packets from Output-List
+   }
+}
+
+//------------------------------------------------------------------------------
+// deadReckoningFrame() -- dead reckons the incoming entities in one pass
+//                         (time-critical thread)
+//------------------------------------------------------------------------------
+void NetIO::deadReckoningFrame(const double dt)
+{
+   if (isNetworkInitialized() && isInputEnabled()) {
+      // The IPlayers dead reckon in phase zero of this frame using their
+      // fourth phase delta time, which is zero while the simulation is
+      // frozen (see Simulation::updateTC() and Player::updateTC())
+      const simulation::Simulation* const sim = getSimulation();
+      const double dt4 = (sim != nullptr && sim->isFrozen()) ? 0.0 : (dt / 4.0) * 4.0f;
+      drEngine.advance(dt4);
    }
 }
 
@@ -401,18 +420,15 @@ void NetIO::cleanupInputList()
    // Current exec time
    const double curExecTime = getSimulation()->getExecTimeSec();
 
-   for (unsigned int idx = 0; idx < nInNibs; idx++) {
-      Nib* nib = inputList[idx];
+   for (unsigned int idx = 0; idx < inputTable.size(); idx++) {
+      Nib* nib = inputTable.get(idx);
+      if (nib == nullptr) continue;   // removed by removeNibFromList()
       if ( (nib->isTimeoutEnabled() && ((curExecTime - nib->getTimeExec()) > getMaxAge(nib)) )) {
             // We have one that's timed-out --
             //std::cout << "REMOVED(TO): cur=" << curExecTime << ", NIB=" << nib->getTimeExec() << std::endl;
 
-            // 1) Shift the rest of the list down one
-            nInNibs--;
-            for (unsigned int i = idx; i < nInNibs; i++) {
-               inputList[i] = inputList[i+1];
-            }
-            inputList[nInNibs] = nullptr;
+            // 1) Detach it from the list (the list is compacted below)
+            inputTable.detach(idx);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -421,118 +437,257 @@ void NetIO::cleanupInputList()
             // We have one that has a DELETE_REQUEST
             //std::cout << "REMOVED(DR): cur=" << curExecTime << ", NIB=" << nib->getTimeExec() << std::endl;
 
-            // 1) Shift the rest of the list down one
-            nInNibs--;
-            for (unsigned int i = idx; i < nInNibs; i++) {
-               inputList[i] = inputList[i+1];
-            }
-            inputList[nInNibs] = nullptr;
+            // 1) Detach it from the list (the list is compacted below)
+            inputTable.detach(idx);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
       }
    }
+
+   // Remove the detached NIBs in one pass
+   inputTable.compact();
 }
 
 //------------------------------------------------------------------------------
 // updateOutputList() --
 //   Update the Output-List from the simulation player list (Background thread)
+//   -- the player list is only scanned when the player events can't be used
 //------------------------------------------------------------------------------
 void NetIO::updateOutputList()
 {
-
    if (isNetworkInitialized()) {
+      if (outputScanReq || !isOutputEnabled() || !processPlayerEvents()) {
+         scanOutputList();
+      }
+   }
+}
 
-      // ---
-      // Remove all DELETE_REQUEST mode NIBs
-      //   -- The DELETE_REQUEST were issued last pass, so the network
-      //       specific software should have handled them by now.
-      //   -- As NIBs are removed, the table above the NIB is shifted down.
-      //   -- We're also clearing the NIB's 'checked' flag
-      // ---
-      {
-         unsigned int i = 0;  // src index
-         unsigned int j = 0;  // dest index
-         while (i < nOutNibs) {
-            if (outputList[i]->isMode(models::Player::DELETE_REQUEST)) {
-               // Deleting this NIB
-               //std::cout << "NetIO::updateOutputList() cleanup: nib = " << outputList[i] << std::endl;
-               destroyOutputNib(outputList[i++]);
-            }
-            else {
-               if (i != j) outputList[j] = outputList[i];
-               outputList[j]->setCheckedFlag(false);
-               i++;
-               j++;
-            }
-         }
-         nOutNibs = j;
+//------------------------------------------------------------------------------
+// scanOutputList() --
+//   Update the Output-List by scanning the simulation player list
+//------------------------------------------------------------------------------
+void NetIO::scanOutputList()
+{
+   // The scan covers all player events up to now, and all waiting players
+   playerEventSeq = getSimulation()->getPlayerEvents()->getSequence();
+   clearNewOutputPlayers();
+   outputScanReq = false;
+   outputDeletes.clear();
+
+   // ---
+   // Remove all DELETE_REQUEST mode NIBs
+   //   -- The DELETE_REQUEST were issued last pass, so the network
+   //       specific software should have handled them by now.
+   //   -- The removed NIBs are detached, and then the table is compacted
+   //       in one pass.
+   //   -- We're also clearing the NIB's 'checked' flag
+   // ---
+   for (unsigned int i = 0; i < outputTable.size(); i++) {
+      Nib* nib = outputTable.get(i);
+      if (nib == nullptr) continue;   // removed by removeNibFromList()
+      if (nib->isMode(models::Player::DELETE_REQUEST)) {
+         // Deleting this NIB
+         //std::cout << "NetIO::updateOutputList() cleanup: nib = " << nib << std::endl;
+         outputTable.detach(i);
+         destroyOutputNib(nib);
+      }
+      else {
+         nib->setCheckedFlag(false);
       }
+   }
+   outputTable.compact();
+
+   // --- ---
+   // Match the main player list with the output-list ...
+   // --- ---
+   if ( isOutputEnabled() ) {
+
+      // Get the player list pointer (pre-ref()'d)
+      base::PairStream* players = getSimulation()->getPlayers();
+
+      // For all players
+      bool finished = false;
+      unsigned int newCount = 0;
+      base::List::Item* playerItem = players->getFirstItem();
+      while (playerItem != nullptr && !finished) {
+
+         // Get player list items
+         base::Pair* playerPair = static_cast<base::Pair*>(playerItem->getValue());
+         models::Player* player = static_cast<models::Player*>(playerPair->object());
+
+         if (player->isLocalPlayer() || (isRelayEnabled() && player->getNetworkID() != getNetworkID()) )  {
+            if ( player->isActive() && player->isNetOutputEnabled()) {
+
+               // We have (1) an active local player to output or
+               //         (2) an active networked player to relay ...
+
+               // Find the output NIB for this player
+               Nib* nib = findNib(player, OUTPUT_NIB);
+               if (nib == nullptr && newCount < MAX_NEW_OUTGOING) {
+                  // Not Found then create a new output NIB for this player
+                  nib = insertNewOutputNib( player );
+                  newCount++;
+               }
+               else if (nib == nullptr) {
+                  // Too many new NIBs this frame; scan again next frame
+                  outputScanReq = true;
+               }
 
-      // --- ---
-      // Match the main player list with the output-list ...
-      // --- ---
-      if ( isOutputEnabled() ) {
-
-         // Get the player list pointer (pre-ref()'d)
-         base::PairStream* players = getSimulation()->getPlayers();
-
-         // For all players
-         bool finished = false;
-         unsigned int newCount = 0;
-         base::List::Item* playerItem = players->getFirstItem();
-         while (playerItem != nullptr && !finished) {
-
-            // Get player list items
-            base::Pair* playerPair = static_cast<base::Pair*>(playerItem->getValue());
-            models::Player* player = static_cast<models::Player*>(playerPair->object());
-
-            if (player->isLocalPlayer() || (isRelayEnabled() && player->getNetworkID() != getNetworkID()) )  {
-               if ( player->isActive() && player->isNetOutputEnabled()) {
-
-                  // We have (1) an active local player to output or
-                  //         (2) an active networked player to relay ...
-
-                  // Find the output NIB for this player
-                  Nib* nib = findNib(player, OUTPUT_NIB);
-                  if (nib == nullptr && newCount < MAX_NEW_OUTGOING) {
-                     // Not Found then create a new output NIB for this player
-                     nib = insertNewOutputNib( player );
-                     newCount++;
-                  }
-
-                  // Mark this NIB as checked
-                  if (nib != nullptr) {
-                     nib->setCheckedFlag(true);
-                  }
+               // Mark this NIB as checked
+               if (nib != nullptr) {
+                  nib->setCheckedFlag(true);
                }
             }
-            else {
-               // Finished with local players and we're not relaying
-               finished = !isRelayEnabled();
-            }
-
-            // get the next player
-            playerItem = playerItem->getNext();
+         }
+         else {
+            // Finished with local players and we're not relaying
+            finished = !isRelayEnabled();
          }
 
-         players->unref();
+         // get the next player
+         playerItem = playerItem->getNext();
       }
 
-      // ---
-      // Any NIB that was not checked needs to be removed
-      // ---
-      for (unsigned int i = 0; i < nOutNibs; i++) {
-         if ( !outputList[i]->isChecked() ) {
-            // Request removal;
-            // (note: the network specific code now has one frame to cleanup its own code
-            //  before the NIB is dropped from the output list next frame -- see above)
-            outputList[i]->setMode(models::Player::DELETE_REQUEST);
+      players->unref();
+   }
+
+   // ---
+   // Any NIB that was not checked needs to be removed
+   // ---
+   for (unsigned int i = 0; i < outputTable.size(); i++) {
+      Nib* nib = outputTable.get(i);
+      if ( nib != nullptr && !nib->isChecked() ) {
+         // Request removal;
+         // (note: the network specific code now has one frame to cleanup its own code
+         //  before the NIB is dropped from the output list next frame -- see above)
+         nib->setMode(models::Player::DELETE_REQUEST);
+         outputDeletes.push_back(nib);
+      }
+   }
+
+   // While output is disabled, keep scanning (the output list is empty)
+   if (!isOutputEnabled()) outputScanReq = true;
+}
+
+//------------------------------------------------------------------------------
+// processPlayerEvents() --
+//   Update the Output-List from the simulation player events; the cost is
+//   proportional to the number of changes.  Returns false, without changing
+//   the Output-List, if any of the player events have been lost.
+//------------------------------------------------------------------------------
+bool NetIO::processPlayerEvents()
+{
+   // Get the new player events
+   playerEvents.clear();
+   const bool ok = getSimulation()->getPlayerEvents()->getEvents(&playerEventSeq, &playerEvents);
+   if (!ok) {
+      for (unsigned int i = 0; i < playerEvents.size(); i++) {
+         playerEvents[i].player->unref();
+      }
+      playerEvents.clear();
+      return false;
+   }
+
+   // ---
+   // Remove the NIBs that we set to DELETE_REQUEST last pass
+   //   -- Only the NIB pointers are compared, so the NIBs that are
+   //       not being removed aren't touched.
+   //   -- Their players are checked again, in case they still need
+   //       an output NIB (e.g., a player that was re-activated)
+   // ---
+   if (!outputDeletes.empty()) {
+      std::sort(outputDeletes.begin(), outputDeletes.end());
+      Nib** const nibs = outputTable.data();
+      for (unsigned int i = 0; i < outputTable.size(); i++) {
+         Nib* nib = nibs[i];
+         if (nib != nullptr && std::binary_search(outputDeletes.begin(), outputDeletes.end(), nib) &&
+             nib->isMode(models::Player::DELETE_REQUEST)) {
+            outputTable.detach(i);
+            models::Player* player = nib->getPlayer();
+            if (player != nullptr) {
+               player->ref();
+               newOutputPlayers.push_back(player);
+            }
+            destroyOutputNib(nib);
          }
       }
+      outputTable.compact();
+      outputDeletes.clear();
+   }
+
+   // ---
+   // Check the players of the new events; the event types don't matter,
+   // since the players' current states are checked
+   // ---
+   for (unsigned int i = 0; i < playerEvents.size(); i++) {
+      const auto player = static_cast<models::Player*>(playerEvents[i].player);
+      checkOutputPlayer(player);
+      player->unref();
+   }
+   playerEvents.clear();
+
+   // ---
+   // Create the output NIBs of the waiting players, no more than
+   // MAX_NEW_OUTGOING per frame
+   // ---
+   unsigned int newCount = 0;
+   unsigned int n = 0;
+   while (n < newOutputPlayers.size() && newCount < MAX_NEW_OUTGOING) {
+      models::Player* player = newOutputPlayers[n++];
+      if (isOutputPlayer(player) && findNib(player, OUTPUT_NIB) == nullptr) {
+         insertNewOutputNib(player);
+         newCount++;
+      }
+      player->unref();
+   }
+   newOutputPlayers.erase(newOutputPlayers.begin(), newOutputPlayers.begin() + n);
 
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// checkOutputPlayer() --
+//   Queues the player for a new output NIB, or requests the removal of its
+//   output NIB, as needed.
+//------------------------------------------------------------------------------
+void NetIO::checkOutputPlayer(models::Player* const player)
+{
+   Nib* nib = findNib(player, OUTPUT_NIB);
+   if (isOutputPlayer(player)) {
+      if (nib == nullptr) {
+         player->ref();
+         newOutputPlayers.push_back(player);
+      }
+   }
+   else if (nib != nullptr) {
+      // Request removal (see processPlayerEvents())
+      nib->setMode(models::Player::DELETE_REQUEST);
+      outputDeletes.push_back(nib);
    }
+}
 
+//------------------------------------------------------------------------------
+// isOutputPlayer() --
+//   True if the player is (1) an active local player to output or
+//   (2) an active networked player to relay
+//------------------------------------------------------------------------------
+bool NetIO::isOutputPlayer(const models::Player* const player) const
+{
+   return player->isOnPlayerList() &&
+          (player->isLocalPlayer() || (isRelayEnabled() && player->getNetworkID() != getNetworkID())) &&
+          player->isActive() && player->isNetOutputEnabled();
+}
+
+//------------------------------------------------------------------------------
+// clearNewOutputPlayers() -- clears the players waiting for an output NIB
+//------------------------------------------------------------------------------
+void NetIO::clearNewOutputPlayers()
+{
+   for (unsigned int i = 0; i < newOutputPlayers.size(); i++) {
+      newOutputPlayers[i]->unref();
+   }
+   newOutputPlayers.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -546,6 +701,7 @@ void NetIO::processOutputList()
    for (unsigned int idx = 0; idx < getOutputListSize(); idx++) {
 
       Nib* nib = getOutputNib(idx);
+      if (nib == nullptr) continue;   // removed by removeNibFromList()
       const double curExecTime = getSimulation()->getExecTimeSec();
 
       if (nib->isEntityTypeValid()) {
@@ -759,20 +915,13 @@ bool NetIO::addNib2InputList(Nib* const nib)
 //------------------------------------------------------------------------------
 Nib* NetIO::findNib(const unsigned short playerID, const base::String* const federateName, const IoType ioType)
 {
-   // Define the key
-   NibKey key(playerID, federateName);
-
-   // Binary search the table for the NIB
+   // Hashed lookup by the player ID and federate name
    Nib* found = nullptr;
    if (ioType == INPUT_NIB) {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, inputList.data(), nInNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
+      found = inputTable.find(playerID, federateName);
    }
    else {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, outputList.data(), nOutNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
+      found = outputTable.find(playerID, federateName);
    }
    return found;
 }
@@ -800,42 +949,8 @@ Nib* NetIO::findNib(const models::Player* const player, const IoType ioType)
 bool NetIO::addNibToList(Nib* const nib, const IoType ioType)
 {
    bool ok = false;
-   if (nib != nullptr) {
-      Nib** tbl = inputList.data();
-      int n = nInNibs;
-      if (ioType == OUTPUT_NIB) {
-         tbl = outputList.data();
-         n = nOutNibs;
-      }
-
-      if (n < MAX_OBJECTS) {
-
-         // Put the NIB on the top of the table
-         nib->ref();
-         tbl[n] = nib;
-
-         // Create a key for this new NIB
-         NibKey key(nib->getPlayerID(), nib->getFederateName());
-
-         if (n > 0) {
-            // Now, 'bubble down' to its correct position
-            int idx = n-1;
-            while (idx >= 0 && compareKey2Nib(&key, &tbl[idx]) <= 0) {
-               // Swap the table entries
-               Nib* tmp = tbl[idx];
-               tbl[idx] = tbl[idx+1];
-               tbl[idx+1] = tmp;
-               idx--;
-            }
-         }
-
-         // Increment the count
-         if (ioType == OUTPUT_NIB) nOutNibs++;
-         else nInNibs++;
-
-         ok = true;
-      }
-   }
+   if (ioType == OUTPUT_NIB) ok = outputTable.add(nib);
+   else ok = inputTable.add(nib);
    return ok;
 }
 
@@ -844,61 +959,8 @@ bool NetIO::addNibToList(Nib* const nib, const IoType ioType)
 //------------------------------------------------------------------------------
 void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
 {
-   Nib** tbl = inputList.data();
-   int n = nInNibs;
-   if (ioType == OUTPUT_NIB) {
-      tbl = outputList.data();
-      n = nOutNibs;
-   }
-
-   int found = -1;
-   // Find the NIB
-   for (int i = 0; i < n && found < 0; i++) {
-      if (nib == tbl[i]) found = i;
-   }
-
-   // Shift down all items above this NIB one position
-   if (found >= 0) {
-      tbl[found]->unref();
-      int n1 = (n - 1);
-      for (int i = found; i < n1; i++) {
-         tbl[i] = tbl[i+1];
-      }
-      tbl[n-1] = nullptr;
-
-      // Decrement the count
-      if (ioType == OUTPUT_NIB) --nOutNibs;
-      else --nInNibs;
-   }
-}
-
-//------------------------------------------------------------------------------
-// bsearch callbacks: object name compare function --
-//   True types are (const NibKey* key, const Nib** nib)
-//------------------------------------------------------------------------------
-int NetIO::compareKey2Nib(const void* key, const void* nib)
-{
-
-   // The Key
-   const NibKey* pKey = static_cast<const NibKey*>(key);
-
-   // The NIB
-   const Nib* const* pp = static_cast<const Nib* const*>(nib);
-   const Nib* pNib = *pp;
-
-   // Default to equal
-   int result = 0;
-
-   // First, compare the player IDs
-   if (pKey->id > pNib->getPlayerID()) result = +1;
-   else if (pKey->id < pNib->getPlayerID()) result = -1;
-
-   if (result == 0) {
-      // If they're the same, compare the federate names
-      result = std::strcmp(*pKey->fName, *pNib->getFederateName());
-   }
-
-   return result;
+   if (ioType == OUTPUT_NIB) outputTable.remove(nib);
+   else inputTable.remove(nib);
 }
 
 //------------------------------------------------------------------------------
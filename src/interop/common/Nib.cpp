@@ -47,6 +47,8 @@ void Nib::initData()
    drPos.set(0,0,0);
    drAngles.set(0,0,0);
 
+   drFixedAngles.set(0,0,0);
+
    smoothVel.set(0,0,0);
 }
 
@@ -98,6 +100,10 @@ void Nib::copyData(const Nib& org, const bool cc)
    drPos = org.drPos;
    drAngles = org.drAngles;
 
+   // (our DR engine slot is from our own NetIO)
+   drFixedAnglesFlg = org.drFixedAnglesFlg;
+   drFixedAngles = org.drFixedAngles;
+
    smoothVel = org.smoothVel;
    smoothTime = org.smoothTime;
 
@@ -286,6 +292,7 @@ bool Nib::setTypeMapper(const Ntm* const p)
 //------------------------------------------------------------------------------
 bool Nib::setNetIO(NetIO* const p)
 {
+    if (p != pNetIO) releaseDrSlot();   // the slot is from the old NetIO's DR engine
     pNetIO = p;
     return true;
 }
@@ -717,8 +724,21 @@ bool Nib::updateDeadReckoning(
    if (ok) {
       double time = updateDrTime(dt);
 
-      // Main Dead Reckoning Function
-      mainDeadReckoning( time, &drPos, &drAngles );
+      // Our position from the DR engine (batched), when it was computed by
+      // its last frame, or the main Dead Reckoning Function
+      DrEngine* const engine = (drSlot >= 0 && pNetIO != nullptr ? pNetIO->getDrEngine() : nullptr);
+      if (engine != nullptr && engine->update(drSlot, time, &drPos)) {
+         if (drFixedAnglesFlg) {
+            drAngles = drFixedAngles;
+         }
+         else {
+            base::Vec3d pos;
+            mainDeadReckoning( time, &pos, &drAngles );
+         }
+      }
+      else {
+         mainDeadReckoning( time, &drPos, &drAngles );
+      }
       //std::cout << "updateDeadReckoning(): geoc pos(";
       //std::cout << drPos[0] << ", ";
       //std::cout << drPos[1] << ", ";
@@ -795,6 +815,9 @@ bool Nib::resetDeadReckoning(
    drNum = dr;
    drTime = time;
 
+   // Our DR engine slot and fixed DR angles (incoming only)
+   if (ioType == NetIO::INPUT_NIB) updateDrSlot();
+
    //if (ioType == NetIO::INPUT_NIB) {
       //std::cout << "resetDeadReckoning(): drTime = " << drTimeN1 << std::endl;
       //std::cout << "drPos(";
@@ -822,6 +845,54 @@ bool Nib::resetDeadReckoning(
    return true;
 }
 
+//------------------------------------------------------------------------------
+// updateDrSlot() -- updates our DR engine slot with the DR data @ T0, and
+// our fixed DR angles; the world coordinate DR algorithms only.
+//------------------------------------------------------------------------------
+void Nib::updateDrSlot()
+{
+   // Position kernel of our DR algorithm
+   int k = -1;
+   if (drNum == FPW_DRM || drNum == RPW_DRM) k = DrEngine::FIRST_ORDER;
+   else if (drNum == FVW_DRM || drNum == RVW_DRM) k = DrEngine::SECOND_ORDER;
+
+   DrEngine* const engine = (pNetIO != nullptr ? pNetIO->getDrEngine() : nullptr);
+   if (engine == nullptr || k < 0) {
+      releaseDrSlot();
+      return;
+   }
+
+   // New slot if the kernel has changed
+   if (drSlot >= 0 && DrEngine::getKernel(drSlot) != k) releaseDrSlot();
+   if (drSlot < 0) drSlot = engine->allocate(static_cast<DrEngine::Kernel>(k));
+
+   if (drSlot >= 0) {
+      engine->set(drSlot, drP0, drV0, drA0, drTime);
+
+      // The DR angles are fixed without rotation, or with zero angular rates
+      // (i.e., drComputeMatrixDR() is the identity matrix), so they're
+      // computed once, by the main DR function
+      const double absAV2 = drAV0[0]*drAV0[0] + drAV0[1]*drAV0[1] + drAV0[2]*drAV0[2];
+      drFixedAnglesFlg = (drNum == FPW_DRM || drNum == FVW_DRM || !(absAV2 > 0.0));
+      if (drFixedAnglesFlg) {
+         base::Vec3d pos;
+         mainDeadReckoning(drTime, &pos, &drFixedAngles);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// releaseDrSlot() -- releases our DR engine slot
+//------------------------------------------------------------------------------
+void Nib::releaseDrSlot()
+{
+   if (drSlot >= 0) {
+      if (pNetIO != nullptr) pNetIO->getDrEngine()->release(drSlot);
+      drSlot = -1;
+   }
+   drFixedAnglesFlg = false;
+}
+
 //------------------------------------------------------------------------------
 // Main Dead Reckoning Function
 //------------------------------------------------------------------------------
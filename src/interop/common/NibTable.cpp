@@ -0,0 +1,206 @@
+
+#include "openeaagles/interop/common/NibTable.hpp"
+
+#include "openeaagles/interop/common/Nib.hpp"
+
+#include "openeaagles/base/String.hpp"
+
+#include <cstring>
+
+namespace oe {
+namespace interop {
+
+NibTable::~NibTable()
+{
+   clear();
+}
+
+//------------------------------------------------------------------------------
+// Key hash: FNV-1a of the federate name, then the player ID
+//------------------------------------------------------------------------------
+unsigned int NibTable::hashKey(const unsigned short playerID, const base::String* const federateName)
+{
+   unsigned int h = 2166136261u;
+   if (federateName != nullptr) {
+      const char* s = *federateName;
+      while (*s != '\0') { h = (h ^ static_cast<unsigned char>(*s++)) * 16777619u; }
+   }
+   h = (h ^ (playerID & 0xff)) * 16777619u;
+   h = (h ^ (playerID >> 8)) * 16777619u;
+   return h;
+}
+
+bool NibTable::isMatch(const Nib* const nib, const unsigned short playerID, const base::String* const federateName)
+{
+   bool match = false;
+   if (nib->getPlayerID() == playerID) {
+      const base::String* fName = nib->getFederateName();
+      const char* s1 = (federateName != nullptr ? static_cast<const char*>(*federateName) : "");
+      const char* s2 = (fName != nullptr ? static_cast<const char*>(*fName) : "");
+      match = (std::strcmp(s1, s2) == 0);
+   }
+   return match;
+}
+
+//------------------------------------------------------------------------------
+// find() -- finds the first NIB (in list order) with the player ID and
+// federate name; new NIBs are always placed after the existing NIBs in their
+// probe sequence, so the first match is the oldest.
+//------------------------------------------------------------------------------
+Nib* NibTable::find(const unsigned short playerID, const base::String* const federateName) const
+{
+   Nib* found = nullptr;
+   if (!slots.empty()) {
+      const unsigned int mask = static_cast<unsigned int>(slots.size() - 1);
+      const unsigned int hash = hashKey(playerID, federateName);
+      for (unsigned int i = (hash & mask); slots[i].used && found == nullptr; i = ((i + 1) & mask)) {
+         const Slot& slot = slots[i];
+         if (slot.nib != nullptr && slot.hash == hash && isMatch(slot.nib, playerID, federateName)) {
+            found = slot.nib;
+         }
+      }
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// add() -- adds a NIB to the end of the list
+//------------------------------------------------------------------------------
+bool NibTable::add(Nib* const nib)
+{
+   bool ok = false;
+   if (nib != nullptr) {
+      // Keep the table at most half full (including deleted slots)
+      if ((nUsed + 1) * 2 > slots.size()) {
+         rehash(size() - nDetached + 1);
+      }
+
+      const unsigned int hash = hashKey(nib->getPlayerID(), nib->getFederateName());
+      nib->ref();
+      insertSlot(nib, hash, size());
+      list.push_back(nib);
+      hashes.push_back(hash);
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// remove() -- removes a NIB from the list; its list index is found using its
+// hash slot, and its list entry is left empty until the next compact()
+//------------------------------------------------------------------------------
+bool NibTable::remove(Nib* const nib)
+{
+   bool ok = false;
+   if (nib != nullptr) {
+      const Slot* slot = findSlot(nib, hashKey(nib->getPlayerID(), nib->getFederateName()));
+      if (slot != nullptr) {
+         detach(slot->index);
+         nib->unref();
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// detach() -- detaches the idx'th NIB; the caller now owns the table's reference
+//------------------------------------------------------------------------------
+Nib* NibTable::detach(const unsigned int idx)
+{
+   Nib* nib = get(idx);
+   if (nib != nullptr) {
+      Slot* slot = findSlot(nib, hashes[idx]);
+      if (slot != nullptr) slot->nib = nullptr;
+      list[idx] = nullptr;
+      nDetached++;
+   }
+   return nib;
+}
+
+//------------------------------------------------------------------------------
+// compact() -- removes the empty entries left by detach() and remove(),
+// keeping the order, and updates the moved NIBs' slots
+//------------------------------------------------------------------------------
+void NibTable::compact()
+{
+   if (nDetached > 0) {
+      unsigned int j = 0;
+      for (unsigned int i = 0; i < list.size(); i++) {
+         if (list[i] != nullptr) {
+            if (j != i) {
+               list[j] = list[i];
+               hashes[j] = hashes[i];
+               Slot* slot = findSlot(list[j], hashes[j]);
+               if (slot != nullptr) slot->index = j;
+            }
+            j++;
+         }
+      }
+      list.resize(j);
+      hashes.resize(j);
+      nDetached = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+// clear() -- removes all NIBs
+//------------------------------------------------------------------------------
+void NibTable::clear()
+{
+   for (unsigned int i = 0; i < list.size(); i++) {
+      if (list[i] != nullptr) list[i]->unref();
+   }
+   list.clear();
+   hashes.clear();
+   slots.clear();
+   nUsed = 0;
+   nDetached = 0;
+}
+
+//------------------------------------------------------------------------------
+// Hash table support
+//------------------------------------------------------------------------------
+
+// Inserts the NIB at the end of its probe sequence (deleted slots are not
+// reused, so the older NIBs with the same key are found first)
+void NibTable::insertSlot(Nib* const nib, const unsigned int hash, const unsigned int index)
+{
+   const unsigned int mask = static_cast<unsigned int>(slots.size() - 1);
+   unsigned int i = (hash & mask);
+   while (slots[i].used) { i = ((i + 1) & mask); }
+   slots[i].nib = nib;
+   slots[i].hash = hash;
+   slots[i].index = index;
+   slots[i].used = true;
+   nUsed++;
+}
+
+// Finds the NIB's slot, or null if the NIB isn't in the table
+NibTable::Slot* NibTable::findSlot(const Nib* const nib, const unsigned int hash)
+{
+   Slot* found = nullptr;
+   if (!slots.empty()) {
+      const unsigned int mask = static_cast<unsigned int>(slots.size() - 1);
+      for (unsigned int i = (hash & mask); slots[i].used && found == nullptr; i = ((i + 1) & mask)) {
+         if (slots[i].nib == nib) found = &slots[i];
+      }
+   }
+   return found;
+}
+
+// Rebuilds the hash table, in list order, sized for at least 'minCount' NIBs
+void NibTable::rehash(const unsigned int minCount)
+{
+   unsigned int n = 16;
+   while (n < minCount * 4) { n *= 2; }
+
+   slots.assign(n, Slot());
+   nUsed = 0;
+   for (unsigned int i = 0; i < list.size(); i++) {
+      if (list[i] != nullptr) insertSlot(list[i], hashes[i], i);
+   }
+}
+
+}
+}
@@ -6,22 +6,27 @@
 #include "openeaagles/interop/dis/Nib.hpp"
 #include "openeaagles/interop/dis/Ntm.hpp"
 #include "openeaagles/interop/dis/EmissionPduHandler.hpp"
+#include "openeaagles/interop/dis/PduQueue.hpp"
 #include "openeaagles/interop/dis/pdu.hpp"
 
 #include "openeaagles/models/system/Radar.hpp"
 #include "openeaagles/models/WorldModel.hpp"
 
+#include "openeaagles/simulation/Station.hpp"
+
 #include "openeaagles/base/List.hpp"
 #include "openeaagles/base/network/NetHandler.hpp"
 #include "openeaagles/base/Pair.hpp"
 #include "openeaagles/base/PairStream.hpp"
 #include "openeaagles/base/String.hpp"
+#include "openeaagles/base/concurrent/SingleTask.hpp"
 
 #include "openeaagles/base/units/Angles.hpp"
 #include "openeaagles/base/units/Distances.hpp"
 #include "openeaagles/base/units/Times.hpp"
 
 #include "openeaagles/base/util/str_utils.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
 
 #include <cstdlib>
 #include <cstring>
@@ -69,6 +74,36 @@ private:
    base::List* subnodeList;   // List of NtmInputNode nodes below this level
 };
 
+//==============================================================================
+// Class: dis::InputThread
+// Description: NetIO's receiver thread (pipelined input)
+//==============================================================================
+
+class InputThread : public base::SingleTask
+{
+   DECLARE_SUBCLASS(InputThread, base::SingleTask)
+   public: InputThread(base::Component* const parent, const double priority);
+   private: virtual unsigned long userFunc() override;
+};
+
+IMPLEMENT_SUBCLASS(InputThread, "DisInputThread")
+EMPTY_SLOTTABLE(InputThread)
+EMPTY_COPYDATA(InputThread)
+EMPTY_DELETEDATA(InputThread)
+EMPTY_SERIALIZER(InputThread)
+
+InputThread::InputThread(base::Component* const parent, const double priority): base::SingleTask(parent, priority)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long InputThread::userFunc()
+{
+   const auto netIO = dynamic_cast<NetIO*>( getParent() );
+   if (netIO != nullptr) netIO->inputThreadLoop();
+   return 0;
+}
+
 
 //==============================================================================
 // Class: dis::NetIO
@@ -83,6 +118,8 @@ static const double HRT_BEAT_TIMER        = 5;
 static const double DRA_POS_THRST_DFLT    = 3.0;                                 //  meters
 static const double DRA_ORIENT_THRST_DFLT = static_cast<double>(3.0 * base::PI/180.0); //  radians
 
+static const double INPUT_WAIT_TIME       = 0.01;                                //  seconds (receiver thread's max wait for input)
+
 // DISv7 default heartbeats
 static const double HBT_PDU_EE          = 10;                           //  seconds
 static const double HBT_PDU_IFF         = 10;                           //  seconds
@@ -114,6 +151,9 @@ BEGIN_SLOTTABLE(NetIO)
    "siteID",               // 10: Site Identification
    "applicationID",        // 11: Application Identification
    "exerciseID",           // 12: Exercise Identification
+   "areaOfInterest",       // 13: Area-of-interest filtering of new incoming entities
+   "inputThread",          // 14: Two stage (pipelined) network input
+   "inputQueueSize",       // 15: Max number of PDUs in the pipelined input queue
 END_SLOTTABLE(NetIO)
 
 BEGIN_SLOT_MAP(NetIO)
@@ -141,6 +181,9 @@ BEGIN_SLOT_MAP(NetIO)
    ON_SLOT(10, setSlotSiteID,             base::Number)
    ON_SLOT(11, setSlotApplicationID,      base::Number)
    ON_SLOT(12, setSlotExerciseID,         base::Number)
+   ON_SLOT(13, setSlotAreaOfInterest,     base::Number)
+   ON_SLOT(14, setSlotInputThread,        base::Number)
+   ON_SLOT(15, setSlotInputQueueSize,     base::Number)
 END_SLOT_MAP()
 
 NetIO::NetIO() : netInput(nullptr), netOutput(nullptr)
@@ -170,6 +213,12 @@ void NetIO::copyData(const NetIO& org, const bool cc)
    appID = org.appID;
    exerciseID = org.exerciseID;
 
+   aoiEnabled = org.aoiEnabled;
+   aoi.reset();
+
+   inputThreadFlg = org.inputThreadFlg;
+   inputQueueSize = org.inputQueueSize;
+
    clearEmissionPduHandlers();
    for (unsigned int i = 0; i < org.nEmissionHandlers; i++) {
       const EmissionPduHandler* const tmp = org.emissionHandlers[i]->clone();
@@ -195,11 +244,25 @@ void NetIO::copyData(const NetIO& org, const bool cc)
 
 void NetIO::deleteData()
 {
+    stopInputThread();
+    if (inputQueue != nullptr) {
+        delete inputQueue;
+        inputQueue = nullptr;
+    }
     clearEmissionPduHandlers();
     netInput = nullptr;
     netOutput = nullptr;
 }
 
+//------------------------------------------------------------------------------
+// shutdownNotification() -- stops the receiver thread
+//------------------------------------------------------------------------------
+bool NetIO::shutdownNotification()
+{
+   stopInputThread();
+   return BaseClass::shutdownNotification();
+}
+
 //------------------------------------------------------------------------------
 // setVersion() -- Set the DIS version number
 //------------------------------------------------------------------------------
@@ -239,200 +302,320 @@ bool NetIO::initNetwork()
 //------------------------------------------------------------------------------
 void NetIO::netInputHander()
 {
-   // Read PDUs
-   unsigned int j0 = 0;
-   while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-      j0++;
+   // Where are our local players?
+   if (aoiEnabled) updateAreaOfInterest();
+
+   // Start the receiver thread
+   if (inputThreadFlg && !inputThreadStarted) createInputThread();
+
+   if (inputQueue != nullptr) {
+      // ---
+      // Pipelined input: process the PDUs that were decoded by the receiver thread
+      // ---
+      PDUHeader* header = reinterpret_cast<PDUHeader*>(&queuedPdu[0]);
+      const double time = base::getComputerTime();
+      const unsigned int max = inputQueue->getSize();
+      unsigned int n = 0;
+      while (n++ < max && inputQueue->get(header, time)) {
+         processInputPdu(header);
+      }
    }
+   else {
+      // ---
+      // Read PDUs and process them
+      // ---
+      unsigned int j0 = recvDataBatch(reinterpret_cast<char*>(&inputBuffer[0]), MAX_PDU_SIZE, MAX_PDUs);
+
+      while (j0 > 0) {
+
+         // Process incoming PDUs
+         for (unsigned int j1 = 0; j1 < j0; j1++) {
+            PDUHeader* header = reinterpret_cast<PDUHeader*>(&inputBuffer[j1][0]);
+            if (isInputEnabled() && decodeInputPdu(header)) {
+               processInputPdu(header);
+            }
+         }
 
-   while (j0 > 0) {
+         // Read more PDUs
+         j0 = recvDataBatch(reinterpret_cast<char*>(&inputBuffer[0]), MAX_PDU_SIZE, MAX_PDUs);
+      }
+   }
+}
 
-      // Process incoming PDUs
-      unsigned int j1 = 0;
-      while (j1 < j0) {
-         PDUHeader* header = reinterpret_cast<PDUHeader*>(&inputBuffer[j1++][0]);
+//------------------------------------------------------------------------------
+// decodeInputPdu() -- (stage one) Checks the PDU's exercise and its site and
+// application IDs, and byte swaps the PDU; returns true if the PDU is to be
+// processed.
+//------------------------------------------------------------------------------
+bool NetIO::decodeInputPdu(PDUHeader* const header)
+{
+   // Notes: the header's bytes are still in network order, but since the
+   // data we're using are all type 'char' then we're saving time by not
+   // doing an initial byte swap of the header.
 
-         if (isInputEnabled()) {
+   // Only when we're interested in this exercise ...
+   if (getExerciseID() != 0 && getExerciseID() != header->exerciseIdentifier) return false;
 
-            // Notes: the header's bytes are still in network order, but since the
-            // data we're using are all type 'char' then we're saving time by not
-            // doing an initial byte swap of the header.
+   const SimulationAddressDIS* id = nullptr;
+   switch (header->PDUType) {
 
-            if (getExerciseID() == 0 || (getExerciseID() == header->exerciseIdentifier)) {
-               // When we're interested in this exercise ...
-               switch (header->PDUType) {
+      case PDU_ENTITY_STATE: {
+         EntityStatePDU* pPdu = reinterpret_cast<EntityStatePDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->entityID.simulationID;
+      }
+      break;
 
-                  case PDU_ENTITY_STATE: {
-                     //std::cout << "Entity State PDU." << std::endl;
-                     EntityStatePDU* pPdu = reinterpret_cast<EntityStatePDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->entityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->entityID.simulationID.applicationIdentification) {
-                           processEntityStatePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_FIRE: {
-                     FirePDU* pPdu = reinterpret_cast<FirePDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->firingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->firingEntityID.simulationID.applicationIdentification) {
-                           processFirePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DETONATION: {
-                     DetonationPDU* pPdu = reinterpret_cast<DetonationPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->firingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->firingEntityID.simulationID.applicationIdentification) {
-                           processDetonationPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_SIGNAL: {
-                     SignalPDU* pPdu = reinterpret_cast<SignalPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->radioRefID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->radioRefID.simulationID.applicationIdentification) {
-                           processSignalPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_TRANSMITTER: {
-                     TransmitterPDU* pPdu = reinterpret_cast<TransmitterPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->radioRefID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->radioRefID.simulationID.applicationIdentification) {
-                           processTransmitterPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ELECTROMAGNETIC_EMISSION: {
-                     ElectromagneticEmissionPDU* pPdu = reinterpret_cast<ElectromagneticEmissionPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->emittingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->emittingEntityID.simulationID.applicationIdentification) {
-                           processElectromagneticEmissionPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DATA_QUERY: {
-                     DataQueryPDU* pPdu = reinterpret_cast<DataQueryPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processDataQueryPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DATA: {
-                     DataPDU* pPdu = reinterpret_cast<DataPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processDataPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_COMMENT: {
-                     CommentPDU* pPdu = reinterpret_cast<CommentPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processCommentPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_START_RESUME: {
-                     StartPDU* pPdu = reinterpret_cast<StartPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processStartPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_STOP_FREEZE: {
-                     StopPDU* pPdu = reinterpret_cast<StopPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processStopPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACKNOWLEDGE: {
-                     AcknowledgePDU* pPdu = reinterpret_cast<AcknowledgePDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processAcknowledgePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_REQUEST: {
-                     ActionRequestPDU* pPdu = reinterpret_cast<ActionRequestPDU*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionRequestPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_REQUEST_R: {
-                     ActionRequestPDU_R* pPdu = reinterpret_cast<ActionRequestPDU_R*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionRequestPDU_R(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_RESPONSE_R: {
-                     ActionResponsePDU_R* pPdu = reinterpret_cast<ActionResponsePDU_R*>(header);
-                     if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionResponsePDU_R(pPdu);
-                     }
-                  }
-                  break;
+      case PDU_FIRE: {
+         FirePDU* pPdu = reinterpret_cast<FirePDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->firingEntityID.simulationID;
+      }
+      break;
 
-                  default: {
-                     // Note: users will need to do their own byte swapping and checks
-                     processUserPDU(header);
-                  }
-                  break;
+      case PDU_DETONATION: {
+         DetonationPDU* pPdu = reinterpret_cast<DetonationPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->firingEntityID.simulationID;
+      }
+      break;
+
+      case PDU_SIGNAL: {
+         SignalPDU* pPdu = reinterpret_cast<SignalPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->radioRefID.simulationID;
+      }
+      break;
+
+      case PDU_TRANSMITTER: {
+         TransmitterPDU* pPdu = reinterpret_cast<TransmitterPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->radioRefID.simulationID;
+      }
+      break;
+
+      case PDU_ELECTROMAGNETIC_EMISSION: {
+         ElectromagneticEmissionPDU* pPdu = reinterpret_cast<ElectromagneticEmissionPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->emittingEntityID.simulationID;
+      }
+      break;
+
+      case PDU_DATA_QUERY: {
+         DataQueryPDU* pPdu = reinterpret_cast<DataQueryPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_DATA: {
+         DataPDU* pPdu = reinterpret_cast<DataPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_COMMENT: {
+         CommentPDU* pPdu = reinterpret_cast<CommentPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_START_RESUME: {
+         StartPDU* pPdu = reinterpret_cast<StartPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_STOP_FREEZE: {
+         StopPDU* pPdu = reinterpret_cast<StopPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_ACKNOWLEDGE: {
+         AcknowledgePDU* pPdu = reinterpret_cast<AcknowledgePDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_ACTION_REQUEST: {
+         ActionRequestPDU* pPdu = reinterpret_cast<ActionRequestPDU*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_ACTION_REQUEST_R: {
+         ActionRequestPDU_R* pPdu = reinterpret_cast<ActionRequestPDU_R*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      case PDU_ACTION_RESPONSE_R: {
+         ActionResponsePDU_R* pPdu = reinterpret_cast<ActionResponsePDU_R*>(header);
+         if (base::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+         id = &pPdu->originatingID.simulationID;
+      }
+      break;
+
+      default: {
+         // Note: users will need to do their own byte swapping and checks
+      }
+      break;
+
+   } // PDU switch
+
+   // Reject our own PDUs
+   return (id == nullptr || getSiteID() != id->siteIdentification || getApplicationID() != id->applicationIdentification);
+}
+
+//------------------------------------------------------------------------------
+// processInputPdu() -- (stage two) Processes a decoded PDU
+//------------------------------------------------------------------------------
+void NetIO::processInputPdu(PDUHeader* const header)
+{
+   switch (header->PDUType) {
+
+      case PDU_ENTITY_STATE:
+         processEntityStatePDU( reinterpret_cast<EntityStatePDU*>(header) );
+         break;
+
+      case PDU_FIRE:
+         processFirePDU( reinterpret_cast<FirePDU*>(header) );
+         break;
+
+      case PDU_DETONATION:
+         processDetonationPDU( reinterpret_cast<DetonationPDU*>(header) );
+         break;
+
+      case PDU_SIGNAL:
+         processSignalPDU( reinterpret_cast<SignalPDU*>(header) );
+         break;
+
+      case PDU_TRANSMITTER:
+         processTransmitterPDU( reinterpret_cast<TransmitterPDU*>(header) );
+         break;
+
+      case PDU_ELECTROMAGNETIC_EMISSION:
+         processElectromagneticEmissionPDU( reinterpret_cast<ElectromagneticEmissionPDU*>(header) );
+         break;
+
+      case PDU_DATA_QUERY:
+         processDataQueryPDU( reinterpret_cast<DataQueryPDU*>(header) );
+         break;
+
+      case PDU_DATA:
+         processDataPDU( reinterpret_cast<DataPDU*>(header) );
+         break;
+
+      case PDU_COMMENT:
+         processCommentPDU( reinterpret_cast<CommentPDU*>(header) );
+         break;
+
+      case PDU_START_RESUME:
+         processStartPDU( reinterpret_cast<StartPDU*>(header) );
+         break;
 
-               } // PDU switch
+      case PDU_STOP_FREEZE:
+         processStopPDU( reinterpret_cast<StopPDU*>(header) );
+         break;
 
-            } // if correct exercise
-         }  // Inputs enabled
+      case PDU_ACKNOWLEDGE:
+         processAcknowledgePDU( reinterpret_cast<AcknowledgePDU*>(header) );
+         break;
+
+      case PDU_ACTION_REQUEST:
+         processActionRequestPDU( reinterpret_cast<ActionRequestPDU*>(header) );
+         break;
+
+      case PDU_ACTION_REQUEST_R:
+         processActionRequestPDU_R( reinterpret_cast<ActionRequestPDU_R*>(header) );
+         break;
+
+      case PDU_ACTION_RESPONSE_R:
+         processActionResponsePDU_R( reinterpret_cast<ActionResponsePDU_R*>(header) );
+         break;
+
+      default:
+         // Note: the user PDU's bytes are still in network order
+         processUserPDU(header);
+         break;
+
+   } // PDU switch
+}
+
+//------------------------------------------------------------------------------
+// Pipelined input -- the receiver thread
+//------------------------------------------------------------------------------
+
+// Creates the input queue and the receiver thread; returns true if started
+bool NetIO::createInputThread()
+{
+   if (!inputThreadStarted) {
+      inputQueue = new PduQueue(inputQueueSize);
+      stopInput = false;
 
-      }  // processing PDUs
+      double priority = 0.5;
+      const simulation::Station* sta = getStation();
+      if (sta != nullptr) priority = sta->getNetworkPriority();
 
-      // Read more PDUs
-      j0 = 0;
-      while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-         j0++;
+      inputThread = new InputThread(this, priority);
+      inputThread->unref(); // 'inputThread' is a safe_ptr<>
+      if (!inputThread->create()) {
+         inputThread = nullptr;
+         delete inputQueue;
+         inputQueue = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "NetIO::createInputThread(): ERROR, failed to create the thread!" << std::endl;
+         }
       }
+      inputThreadStarted = true;
    }
+   return (inputQueue != nullptr);
+}
 
+// Stops the receiver thread (the input queue is kept until deleteData(),
+// so the network input thread can still use it)
+void NetIO::stopInputThread()
+{
+   if (inputThread != nullptr) {
+      stopInput = true;
+      while (!inputThread->isTerminated()) {
+         base::msleep(1);
+      }
+      inputThread = nullptr;
+   }
+}
+
+// Receiver thread's main loop: receive, decode and queue the PDUs until we're
+// stopped; while there's no input, the thread waits on the network input handler
+// for up to INPUT_WAIT_TIME at a time, so it still sees the stop request.
+void NetIO::inputThreadLoop()
+{
+   while (!stopInput) {
+      const unsigned int n = recvDataBatch(reinterpret_cast<char*>(&inputBuffer[0]), MAX_PDU_SIZE, MAX_PDUs, inputSizes);
+      if (n > 0) {
+         const double time = base::getComputerTime();
+         for (unsigned int i = 0; i < n; i++) {
+            PDUHeader* header = reinterpret_cast<PDUHeader*>(&inputBuffer[i][0]);
+            if (isInputEnabled() && decodeInputPdu(header)) {
+               inputQueue->put(header, inputSizes[i], time);
+            }
+         }
+      }
+      else if (netInput != nullptr) {
+         netInput->waitForData(INPUT_WAIT_TIME);
+      }
+      else {
+         base::msleep(1);
+      }
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -663,17 +846,80 @@ int NetIO::recvData(char* const packet, const int maxSize)
 }
 
 //------------------------------------------------------------------------------
-// sendData() -- send data packet
+// recvDataBatch() -- receive a batch of data packets
+//------------------------------------------------------------------------------
+unsigned int NetIO::recvDataBatch(char* const buffer, const int maxSize, const unsigned int n, unsigned int* const sizes)
+{
+   unsigned int result = 0;
+   if (netInput != nullptr) {
+      result = netInput->recvDataBatch(buffer, maxSize, n, sizes);
+   }
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// sendData() -- send data packet; while processing the output list, the
+// packet is copied to the output buffer and sent with the next batch.
 //------------------------------------------------------------------------------
 bool NetIO::sendData(const char* const packet, const int size)
 {
    bool result = 0;
    if (netOutput != nullptr) {
-      result = netOutput->sendData( packet, size );
+      bool queued = false;
+      if (size > 0 && size <= MAX_PDU_SIZE) {
+         base::lock(outputLock);
+         if (batchOutput) {
+            if (nOutputPdus >= MAX_OUTPUT_PDUs) flushOutputBuffer();
+            std::memcpy(&outputBuffer[nOutputPdus][0], packet, size);
+            outputSizes[nOutputPdus] = size;
+            nOutputPdus++;
+            queued = true;
+         }
+         base::unlock(outputLock);
+      }
+      if (queued) result = true;
+      else result = netOutput->sendData( packet, size );
    }
    return result;
 }
 
+//------------------------------------------------------------------------------
+// flushOutputBuffer() -- sends the output buffer's PDUs as a batch
+// (called with 'outputLock' locked)
+//------------------------------------------------------------------------------
+void NetIO::flushOutputBuffer()
+{
+   if (nOutputPdus > 0 && netOutput != nullptr) {
+      const char* packets[MAX_OUTPUT_PDUs];
+      for (unsigned int i = 0; i < nOutputPdus; i++) {
+         packets[i] = reinterpret_cast<const char*>(&outputBuffer[i][0]);
+      }
+      const unsigned int n = netOutput->sendDataBatch(packets, outputSizes, nOutputPdus);
+      if (n < nOutputPdus && isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "NetIO::flushOutputBuffer(): only " << n << " of " << nOutputPdus << " PDUs were sent" << std::endl;
+      }
+   }
+   nOutputPdus = 0;
+}
+
+//------------------------------------------------------------------------------
+// processOutputList() -- the PDUs sent while processing the output list
+// are sent in batches
+//------------------------------------------------------------------------------
+void NetIO::processOutputList()
+{
+   base::lock(outputLock);
+   batchOutput = true;
+   base::unlock(outputLock);
+
+   BaseClass::processOutputList();
+
+   base::lock(outputLock);
+   flushOutputBuffer();
+   batchOutput = false;
+   base::unlock(outputLock);
+}
+
 //------------------------------------------------------------------------------
 // makeTimeStamp() -- makes a DIS time stamp
 //------------------------------------------------------------------------------
@@ -1760,6 +2006,46 @@ bool NetIO::setSlotExerciseID(const base::Number* const num)
     return ok;
 }
 
+// Set the area-of-interest filter enabled flag
+bool NetIO::setSlotAreaOfInterest(const base::Number* const num)
+{
+    bool ok = false;
+    if (num != nullptr) {
+        aoiEnabled = num->getBoolean();
+        aoi.reset();
+        ok = true;
+    }
+    return ok;
+}
+
+// Set the pipelined input enabled flag (before the receiver thread is started)
+bool NetIO::setSlotInputThread(const base::Number* const num)
+{
+    bool ok = false;
+    if (num != nullptr && !inputThreadStarted) {
+        inputThreadFlg = num->getBoolean();
+        ok = true;
+    }
+    return ok;
+}
+
+// Set the pipelined input queue size (before the receiver thread is started)
+bool NetIO::setSlotInputQueueSize(const base::Number* const num)
+{
+    bool ok = false;
+    if (num != nullptr && !inputThreadStarted) {
+        const int v = num->getInt();
+        if (v > 0) {
+            inputQueueSize = static_cast<unsigned int>(v);
+            ok = true;
+        }
+        else {
+            std::cerr << "NetIO::setSlotInputQueueSize(): invalid size(" << v << "); must be greater than zero" << std::endl;
+        }
+    }
+    return ok;
+}
+
 std::ostream& NetIO::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
 {
     int j = 0;
@@ -51,6 +51,11 @@ void NetIO::processEntityStatePDU(const EntityStatePDU* const pdu)
     // ---
     Nib* nib = static_cast<Nib*>( findDisNib(playerId, site, app, INPUT_NIB) );
 
+    // ---
+    // Drop new entities that are outside of our area of interest
+    // ---
+    if (nib == nullptr && aoiEnabled && !isInAreaOfInterest(pdu)) return;
+
     // ---
     // When we don't have a NIB, create one
     // ---
@@ -119,5 +124,72 @@ void NetIO::processEntityStatePDU(const EntityStatePDU* const pdu)
     }
 }
 
+//------------------------------------------------------------------------------
+// updateAreaOfInterest() -- rebuilds the area-of-interest grid of our local
+// players and forgets the filtered entities that have timed out
+//------------------------------------------------------------------------------
+void NetIO::updateAreaOfInterest()
+{
+   // Cell size: the max of the max entity ranges
+   double maxRng = 0;
+   for (unsigned int i = 0; i < NUM_ENTITY_KINDS; i++) {
+      for (unsigned int j = 0; j < MAX_ENTITY_DOMAINS; j++) {
+         if (maxEntityRange[i][j] > maxRng) maxRng = maxEntityRange[i][j];
+      }
+   }
+   if (maxRng > interop::AreaOfInterest::MIN_CELL_SIZE) aoi.setCellSize(maxRng);
+   else aoi.setCellSize(interop::AreaOfInterest::MIN_CELL_SIZE);
+
+   simulation::Simulation* sim = getSimulation();
+   if (sim != nullptr) {
+      base::PairStream* players = sim->getPlayers();
+      aoi.rebuild(players);
+      if (players != nullptr) players->unref();
+      aoi.expire( static_cast<double>(sim->getExecTimeSec()) );
+   }
+   else {
+      aoi.rebuild(nullptr);
+   }
+}
+
+//------------------------------------------------------------------------------
+// isInAreaOfInterest() -- True if the new entity of the PDU is within range
+// of one of our local players; counts the entity as admitted or filtered.
+//------------------------------------------------------------------------------
+bool NetIO::isInAreaOfInterest(const EntityStatePDU* const pdu)
+{
+   const unsigned long long id =
+         (static_cast<unsigned long long>(pdu->entityID.simulationID.siteIdentification) << 32) |
+         (static_cast<unsigned long long>(pdu->entityID.simulationID.applicationIdentification) << 16) |
+          static_cast<unsigned long long>(pdu->entityID.ID);
+
+   bool ok = true;
+   const unsigned char k = pdu->entityType.kind;
+   const unsigned char d = pdu->entityType.domain;
+   if (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS && maxEntityRange[k][d] > 0) {
+
+      // Max range, plus how far the entity could move before we're
+      // expecting its next update
+      const base::Vec3d vel(
+            pdu->entityLinearVelocity.component[0],
+            pdu->entityLinearVelocity.component[1],
+            pdu->entityLinearVelocity.component[2]);
+      const double range = maxEntityRange[k][d] + vel.length() * maxTimeDR[k][d];
+
+      const base::Vec3d pos(
+            pdu->entityLocation.X_coord,
+            pdu->entityLocation.Y_coord,
+            pdu->entityLocation.Z_coord);
+
+      ok = aoi.isInterested(pos, range);
+      if (!ok) {
+         aoi.filtered(id, static_cast<double>(getSimulation()->getExecTimeSec()), maxAge[k][d]);
+      }
+   }
+
+   if (ok) aoi.admitted(id);
+   return ok;
+}
+
 }
 }
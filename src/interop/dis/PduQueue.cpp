@@ -0,0 +1,194 @@
+#include "openeaagles/interop/dis/PduQueue.hpp"
+#include "openeaagles/interop/dis/NetIO.hpp"
+#include "openeaagles/interop/dis/pdu.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace oe {
+namespace dis {
+
+static_assert(PduQueue::PDU_SIZE == NetIO::MAX_PDU_SIZE, "PduQueue::PDU_SIZE must be NetIO::MAX_PDU_SIZE");
+
+PduQueue::PduQueue(const unsigned int qsize) : nItems(qsize > 0 ? qsize : 1), ring(nItems), freeItems(nItems)
+{
+   items = new Item[nItems];
+   for (unsigned int i = 0; i < nItems; i++) {
+      freeItems.put(&items[i]);
+   }
+   queuedEntities.reserve(nItems);
+}
+
+PduQueue::~PduQueue()
+{
+   delete[] items;
+   items = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Key of an entity state PDU's entity, or NO_KEY
+//------------------------------------------------------------------------------
+unsigned long long PduQueue::entityKey(const PDUHeader* const pdu)
+{
+   unsigned long long key = NO_KEY;
+   if (pdu->PDUType == NetIO::PDU_ENTITY_STATE) {
+      const auto es = reinterpret_cast<const EntityStatePDU*>(pdu);
+      key = (static_cast<unsigned long long>(es->entityID.simulationID.siteIdentification) << 32) |
+            (static_cast<unsigned long long>(es->entityID.simulationID.applicationIdentification) << 16) |
+             static_cast<unsigned long long>(es->entityID.ID);
+   }
+   return key;
+}
+
+void PduQueue::fill(Item* const item, const PDUHeader* const pdu, const unsigned int size, const double time)
+{
+   const unsigned int n = (size < PDU_SIZE ? size : PDU_SIZE);
+   std::memcpy(item->data, pdu, n);
+   item->size = n;
+   item->time = time;
+}
+
+//------------------------------------------------------------------------------
+// put() -- (producer) queues a copy of the PDU
+//------------------------------------------------------------------------------
+bool PduQueue::put(const PDUHeader* const pdu, const unsigned int size, const double time)
+{
+   if (pdu == nullptr || size < sizeof(PDUHeader)) return false;
+   if (clearProducerStats.load(std::memory_order_relaxed) && clearProducerStats.exchange(false)) {
+      maxDepth = 0;
+      nReceived = 0;
+      nCoalesced = 0;
+      nDropped = 0;
+   }
+   nReceived++;
+
+   // Coalesce with a queued entity state PDU of the same entity
+   const unsigned long long key = entityKey(pdu);
+   if (key != NO_KEY) {
+      const auto it = queuedEntities.find(key);
+      if (it != queuedEntities.end()) {
+         Item* const item = it->second;
+         unsigned int expected = QUEUED;
+         if (item->state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire)) {
+            const bool same = (item->key == key);
+            if (same) fill(item, pdu, size, time);
+            item->state.store(QUEUED, std::memory_order_release);
+            if (same) {
+               nCoalesced++;
+               return true;
+            }
+         }
+      }
+   }
+
+   // New buffer
+   Item* const item = freeItems.get();
+   if (item == nullptr) {
+      nDropped++;
+      return false;
+   }
+   fill(item, pdu, size, time);
+   item->key = key;
+   item->state.store(QUEUED, std::memory_order_release);
+   ring.put(item);     // never full: there are only 'nItems' buffers
+
+   if (key != NO_KEY) {
+      // (the hints are only pruned when there are too many of them)
+      if (queuedEntities.size() >= 4 * nItems) queuedEntities.clear();
+      queuedEntities[key] = item;
+   }
+
+   const unsigned int depth = ring.entries();
+   if (depth > maxDepth) maxDepth = depth;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// get() -- (consumer) copies the next PDU and frees its buffer
+//------------------------------------------------------------------------------
+bool PduQueue::get(PDUHeader* const pdu, const double time)
+{
+   if (clearConsumerStats.load(std::memory_order_relaxed) && clearConsumerStats.exchange(false)) {
+      nLatency = 0;
+      sumLatency = 0.0;
+      maxLatency = 0.0;
+      for (unsigned int b = 0; b < NUM_BINS; b++) {
+         latencyBins[b] = 0;
+      }
+   }
+
+   Item* const item = ring.get();
+   if (item == nullptr) return false;
+
+   // Take it, unless the producer is writing a newer PDU into it
+   unsigned int expected = QUEUED;
+   while (!item->state.compare_exchange_weak(expected, TAKEN, std::memory_order_acquire)) {
+      expected = QUEUED;
+   }
+   std::memcpy(pdu, item->data, item->size);
+   const double latency = time - item->time;
+   item->state.store(FREE, std::memory_order_release);
+   freeItems.put(item);
+
+   nLatency++;
+   sumLatency = sumLatency + latency;
+   if (latency > maxLatency) maxLatency = latency;
+
+   const double usec = latency * 1.0e6;
+   unsigned int bin = 0;
+   if (usec >= 1.0) {
+      const double b = std::floor(4.0 * std::log2(usec)) + 1.0;
+      bin = (b < (NUM_BINS - 1) ? static_cast<unsigned int>(b) : (NUM_BINS - 1));
+   }
+   latencyBins[bin]++;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+double PduQueue::getCoalescingRatio() const
+{
+   const unsigned long long n = nReceived;
+   return (n > 0 ? static_cast<double>(nCoalesced) / static_cast<double>(n) : 0.0);
+}
+
+double PduQueue::getMeanLatency() const
+{
+   const unsigned long long n = nLatency;
+   return (n > 0 ? sumLatency / static_cast<double>(n) : 0.0);
+}
+
+// Upper edge of the histogram bin that holds the percentile
+double PduQueue::getLatencyPercentile(const double pct) const
+{
+   unsigned long long counts[NUM_BINS];
+   unsigned long long total = 0;
+   for (unsigned int b = 0; b < NUM_BINS; b++) {
+      counts[b] = latencyBins[b];
+      total += counts[b];
+   }
+   if (total == 0) return 0.0;
+
+   const double p = (pct < 0.0 ? 0.0 : (pct > 100.0 ? 100.0 : pct));
+   unsigned long long target = static_cast<unsigned long long>(std::ceil(p / 100.0 * static_cast<double>(total)));
+   if (target == 0) target = 1;
+
+   unsigned long long sum = 0;
+   unsigned int bin = 0;
+   while (bin < (NUM_BINS - 1) && (sum + counts[bin]) < target) {
+      sum += counts[bin];
+      bin++;
+   }
+   return std::pow(2.0, static_cast<double>(bin) / 4.0) * 1.0e-6;
+}
+
+// (the counters are cleared by their owners; see put() and get())
+void PduQueue::clearStatistics()
+{
+   clearProducerStats = true;
+   clearConsumerStats = true;
+}
+
+}
+}
@@ -0,0 +1,866 @@
+#include "openeaagles/interop/dis/TrafficGenerator.hpp"
+#include "openeaagles/interop/dis/NetIO.hpp"
+#include "openeaagles/interop/dis/pdu.hpp"
+
+#include "openeaagles/interop/common/Nib.hpp"
+
+#include "openeaagles/base/network/NetHandler.hpp"
+#include "openeaagles/base/units/Distances.hpp"
+#include "openeaagles/base/units/angle_utils.hpp"
+#include "openeaagles/base/units/distance_utils.hpp"
+#include "openeaagles/base/util/nav_utils.hpp"
+#include "openeaagles/base/List.hpp"
+#include "openeaagles/base/Number.hpp"
+#include "openeaagles/base/Rng.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace oe {
+namespace dis {
+
+IMPLEMENT_SUBCLASS(TrafficGenerator, "DisTrafficGenerator")
+
+BEGIN_SLOTTABLE(TrafficGenerator)
+   "netOutput",         //  1) Network output handler
+   "numEntities",       //  2) Number of entities
+   "siteID",            //  3) Site ID
+   "applicationID",     //  4) Application ID
+   "exerciseID",        //  5) Exercise ID
+   "latitude",          //  6) Center latitude (degrees)
+   "longitude",         //  7) Center longitude (degrees)
+   "radius",            //  8) Radius of the entities' area
+   "entityType",        //  9) Entities' DIS entity type vector
+   "munitionType",      // 10) Munition type vector
+   "emitterName",       // 11) Emission PDUs' emitter name
+   "entityStateRate",   // 12) Entity state PDUs per second of each entity
+   "fireRate",          // 13) Fire PDUs per second
+   "detonationRate",    // 14) Detonation PDUs per second
+   "emissionRate",      // 15) Electromagnetic emission PDUs per second
+   "signalRate",        // 16) Signal PDUs per second
+   "seed",              // 17) Random number seed
+END_SLOTTABLE(TrafficGenerator)
+
+BEGIN_SLOT_MAP(TrafficGenerator)
+   ON_SLOT( 1, setSlotNetOutput,       base::NetHandler)
+   ON_SLOT( 2, setSlotNumEntities,     base::Number)
+   ON_SLOT( 3, setSlotSiteID,          base::Number)
+   ON_SLOT( 4, setSlotApplicationID,   base::Number)
+   ON_SLOT( 5, setSlotExerciseID,      base::Number)
+   ON_SLOT( 6, setSlotLatitude,        base::Number)
+   ON_SLOT( 7, setSlotLongitude,       base::Number)
+   ON_SLOT( 8, setSlotRadius,          base::Distance)
+   ON_SLOT( 9, setSlotEntityType,      base::List)
+   ON_SLOT(10, setSlotMunitionType,    base::List)
+   ON_SLOT(11, setSlotEmitterName,     base::Number)
+   ON_SLOT(12, setSlotEntityStateRate, base::Number)
+   ON_SLOT(13, setSlotFireRate,        base::Number)
+   ON_SLOT(14, setSlotDetonationRate,  base::Number)
+   ON_SLOT(15, setSlotEmissionRate,    base::Number)
+   ON_SLOT(16, setSlotSignalRate,      base::Number)
+   ON_SLOT(17, setSlotSeed,            base::Number)
+END_SLOT_MAP()
+
+// Entities' speeds (m/sec), altitudes (meters) and max turn rate (radians/sec)
+static const double MIN_SPEED = 100.0;
+static const double MAX_SPEED = 300.0;
+static const double MIN_ALT = 1000.0;
+static const double MAX_ALT = 10000.0;
+static const double MAX_TURN_RATE = 3.0 * base::angle::D2RCC;
+
+// Mean time between an entity's changes of turn rate (seconds)
+static const double TURN_CHANGE_TIME = 30.0;
+
+// Signal PDUs' data: 20 msec of 16 bit PCM audio at 8000 samples per second
+static const unsigned int SIGNAL_SAMPLE_RATE = 8000;
+static const unsigned int SIGNAL_SAMPLES = 160;
+static const unsigned int SIGNAL_DATA_SIZE = SIGNAL_SAMPLES * 2;   // bytes
+static const unsigned short SIGNAL_ENCODING_PCM16 = 4;             // 16-bit linear PCM
+
+// Munitions' IDs are above the entities' IDs
+static const unsigned short MUNITION_ID_BASE = 0x8000;
+
+TrafficGenerator::TrafficGenerator()
+{
+   STANDARD_CONSTRUCTOR()
+   rates.fill(0.0);
+}
+
+void TrafficGenerator::copyData(const TrafficGenerator& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   netOutput = nullptr;
+   if (org.netOutput != nullptr) {
+      netOutput = static_cast<base::NetHandler*>(org.netOutput->clone());
+      netOutput->unref();
+   }
+   netInitialized = false;
+
+   numEntities = org.numEntities;
+   siteID = org.siteID;
+   appID = org.appID;
+   exerciseID = org.exerciseID;
+   refLat = org.refLat;
+   refLon = org.refLon;
+   radius = org.radius;
+   entityType = org.entityType;
+   munitionType = org.munitionType;
+   emitterName = org.emitterName;
+   esRate = org.esRate;
+   rates = org.rates;
+   seed = org.seed;
+
+   entitiesCreated = false;
+}
+
+void TrafficGenerator::deleteData()
+{
+   netOutput = nullptr;
+   if (rng != nullptr) rng->unref();
+   rng = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// reset() -- the entities are re-created by the next updateData()
+//------------------------------------------------------------------------------
+void TrafficGenerator::reset()
+{
+   BaseClass::reset();
+   entitiesCreated = false;
+}
+
+//------------------------------------------------------------------------------
+// updateData() -- moves the entities and sends the PDUs that are due
+//------------------------------------------------------------------------------
+void TrafficGenerator::updateData(const double dt)
+{
+   BaseClass::updateData(dt);
+
+   if (netOutput == nullptr) return;
+   if (!netInitialized) {
+      netInitialized = netOutput->initNetwork(true);
+      if (!netInitialized) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "TrafficGenerator::updateData(): failure to initialize the network output handler" << std::endl;
+         }
+         netOutput = nullptr;
+         return;
+      }
+   }
+   if (!entitiesCreated) createEntities();
+
+   time += dt;
+   moveEntities(dt);
+
+   // Entity state PDUs
+   const double period = 1.0 / esRate;
+   for (unsigned int i = 0; i < numEntities; i++) {
+      if (nextEs[i] <= time) {
+         queuePdu(ENTITY_STATE, makeEntityState(i, nextPdu()));
+         nextEs[i] += period;
+         if (nextEs[i] <= time) nextEs[i] = time + period;
+      }
+   }
+
+   // Fire, detonation, emission and signal PDUs
+   for (unsigned int k = FIRE; k < NUM_PDU_KINDS; k++) {
+      due[k] += rates[k] * dt;
+      while (due[k] >= 1.0) {
+         due[k] -= 1.0;
+         // (separate statements, so the random number sequence
+         //  doesn't depend on the argument evaluation order)
+         const unsigned int i = randomEntity();
+         const unsigned int j = ((k == FIRE || k == DETONATION) ? randomEntity() : i);  // target
+         char* const pdu = nextPdu();
+         switch (k) {
+            case FIRE :       queuePdu(FIRE, makeFire(i, j, pdu)); break;
+            case DETONATION : queuePdu(DETONATION, makeDetonation(i, j, pdu)); break;
+            case EMISSION :   queuePdu(EMISSION, makeEmission(i, pdu)); break;
+            case SIGNAL :     queuePdu(SIGNAL, makeSignal(i, pdu)); break;
+         }
+      }
+   }
+
+   flush();
+}
+
+//------------------------------------------------------------------------------
+// Entities
+//------------------------------------------------------------------------------
+
+// Random positions within 'radius' of the center, with random headings,
+// speeds, altitudes and turn rates
+void TrafficGenerator::createEntities()
+{
+   if (rng != nullptr) rng->unref();
+   rng = new base::Rng(seed);
+
+   lat.resize(numEntities);
+   lon.resize(numEntities);
+   alt.resize(numEntities);
+   hdg.resize(numEntities);
+   spd.resize(numEntities);
+   turn.resize(numEntities);
+   nextEs.resize(numEntities);
+
+   const double erad = base::nav::ERAD60 * base::distance::NM2M;
+   const double cosLat = std::cos(refLat * base::angle::D2RCC);
+   const double period = 1.0 / esRate;
+
+   for (unsigned int i = 0; i < numEntities; i++) {
+      const double r = radius * std::sqrt(rng->drawHalfOpen());
+      const double brg = 2.0 * base::PI * rng->drawHalfOpen();
+      lat[i] = refLat + (r * std::cos(brg) / erad) * base::angle::R2DCC;
+      lon[i] = refLon + (r * std::sin(brg) / (erad * cosLat)) * base::angle::R2DCC;
+      alt[i] = MIN_ALT + (MAX_ALT - MIN_ALT) * rng->drawHalfOpen();
+      hdg[i] = 2.0 * base::PI * rng->drawHalfOpen();
+      spd[i] = MIN_SPEED + (MAX_SPEED - MIN_SPEED) * rng->drawHalfOpen();
+      turn[i] = MAX_TURN_RATE * (2.0 * rng->drawHalfOpen() - 1.0);
+
+      // Spread the entity state PDUs over the update period
+      nextEs[i] = time + period * static_cast<double>(i) / static_cast<double>(numEntities);
+   }
+
+   due.fill(0.0);
+   entitiesCreated = true;
+}
+
+// Flies the entities on their tracks; an entity that's outside of the
+// area turns back towards the center.
+void TrafficGenerator::moveEntities(const double dt)
+{
+   const double erad = base::nav::ERAD60 * base::distance::NM2M;
+   const double cosLat = std::cos(refLat * base::angle::D2RCC);
+   const double pChange = dt / TURN_CHANGE_TIME;
+
+   for (unsigned int i = 0; i < numEntities; i++) {
+      // Position (north and east of the center)
+      const double north = (lat[i] - refLat) * base::angle::D2RCC * erad;
+      const double east = (lon[i] - refLon) * base::angle::D2RCC * erad * cosLat;
+
+      if ( (north * north + east * east) > (radius * radius) ) {
+         const double err = base::angle::aepcdRad(std::atan2(-east, -north) - hdg[i]);
+         if (std::fabs(err) > base::PI / 2.0) {
+            turn[i] = (err > 0.0 ? MAX_TURN_RATE : -MAX_TURN_RATE);
+         }
+      }
+      else if (rng->drawHalfOpen() < pChange) {
+         turn[i] = MAX_TURN_RATE * (2.0 * rng->drawHalfOpen() - 1.0);
+      }
+
+      hdg[i] = base::angle::aepcdRad(hdg[i] + turn[i] * dt);
+      const double vn = spd[i] * std::cos(hdg[i]);
+      const double ve = spd[i] * std::sin(hdg[i]);
+      const double cosEntLat = std::cos(lat[i] * base::angle::D2RCC);
+      lat[i] += (vn * dt / erad) * base::angle::R2DCC;
+      lon[i] += (ve * dt / (erad * cosEntLat)) * base::angle::R2DCC;
+   }
+}
+
+// Entity 'i' geocentric position (meters), velocity (m/sec) and Euler angles (radians)
+void TrafficGenerator::entityState(const unsigned int i, double pos[3], double vel[3], double angles[3]) const
+{
+   base::nav::convertGeod2Ecef(lat[i], lon[i], alt[i], &pos[0], &pos[1], &pos[2]);
+
+   base::Matrixd wm;
+   base::nav::computeWorldMatrix(lat[i], lon[i], &wm);
+
+   // NED to ECEF velocity
+   const base::Vec3d velNed(spd[i] * std::cos(hdg[i]), spd[i] * std::sin(hdg[i]), 0.0);
+   const base::Vec3d velEcef = velNed * wm;
+   vel[0] = velEcef[0];
+   vel[1] = velEcef[1];
+   vel[2] = velEcef[2];
+
+   // Bank into the turn
+   const double roll = std::atan2(spd[i] * turn[i], base::ETHGM);
+   base::Vec3d geocAngles;
+   base::nav::convertGeodAngles2EcefAngles(wm, base::Vec3d(roll, 0.0, hdg[i]), &geocAngles);
+   angles[0] = geocAngles[base::nav::IPHI];
+   angles[1] = geocAngles[base::nav::ITHETA];
+   angles[2] = geocAngles[base::nav::IPSI];
+}
+
+unsigned int TrafficGenerator::randomEntity()
+{
+   const unsigned int i = static_cast<unsigned int>(rng->drawHalfOpen() * static_cast<double>(numEntities));
+   return (i < numEntities ? i : numEntities - 1);
+}
+
+//------------------------------------------------------------------------------
+// Batch of outgoing PDUs
+//------------------------------------------------------------------------------
+char* TrafficGenerator::nextPdu()
+{
+   if (nBatch >= MAX_BATCH) flush();
+   if (batch.empty()) batch.resize(MAX_BATCH * MAX_PDU_SIZE);
+   return &batch[nBatch * MAX_PDU_SIZE];
+}
+
+void TrafficGenerator::queuePdu(const PduKind k, const unsigned int length)
+{
+   batchPdus[nBatch] = &batch[nBatch * MAX_PDU_SIZE];
+   batchSizes[nBatch] = static_cast<int>(length);
+   batchKinds[nBatch] = k;
+   nBatch++;
+}
+
+void TrafficGenerator::flush()
+{
+   if (nBatch > 0) {
+      const unsigned int n = netOutput->sendDataBatch(batchPdus.data(), batchSizes.data(), nBatch);
+      for (unsigned int i = 0; i < nBatch; i++) {
+         if (i < n) nSent[batchKinds[i]]++;
+         else nFailed[batchKinds[i]]++;
+      }
+      nBatch = 0;
+   }
+}
+
+// DIS relative time stamp of the generator's time (see NetIO::makeTimeStamp())
+unsigned int TrafficGenerator::timeStamp() const
+{
+   const double secondsThisHour = std::fmod(time, 3600.0);
+   const unsigned int ts = static_cast<unsigned int>((secondsThisHour / 3600.0) * 0x7fffffff);
+   return (ts << 1);
+}
+
+//------------------------------------------------------------------------------
+// PDUs -- each is made in 'buffer', in network byte order; returns its length
+//------------------------------------------------------------------------------
+unsigned int TrafficGenerator::makeEntityState(const unsigned int i, char* const buffer) const
+{
+   std::memset(buffer, 0, sizeof(EntityStatePDU));
+   const auto pdu = reinterpret_cast<EntityStatePDU*>(buffer);
+
+   pdu->header.protocolVersion = NetIO::VERSION_1278_1A;
+   pdu->header.exerciseIdentifier = exerciseID;
+   pdu->header.PDUType = NetIO::PDU_ENTITY_STATE;
+   pdu->header.protocolFamily = NetIO::PDU_FAMILY_ENTITY_INFO;
+   pdu->header.timeStamp = timeStamp();
+   pdu->header.length = sizeof(EntityStatePDU);
+
+   pdu->entityID.simulationID.siteIdentification = siteID;
+   pdu->entityID.simulationID.applicationIdentification = appID;
+   pdu->entityID.ID = static_cast<unsigned short>(i + 1);
+   pdu->forceID = ((i & 1) == 0 ? NetIO::FRIENDLY_FORCE : NetIO::OPPOSING_FORCE);
+   pdu->numberOfArticulationParameters = 0;
+
+   pdu->entityType.kind          = static_cast<unsigned char>(entityType[0]);
+   pdu->entityType.domain        = static_cast<unsigned char>(entityType[1]);
+   pdu->entityType.country       = entityType[2];
+   pdu->entityType.category      = static_cast<unsigned char>(entityType[3]);
+   pdu->entityType.subcategory   = static_cast<unsigned char>(entityType[4]);
+   pdu->entityType.specific      = static_cast<unsigned char>(entityType[5]);
+   pdu->entityType.extra         = static_cast<unsigned char>(entityType[6]);
+   pdu->alternativeType = pdu->entityType;
+
+   double pos[3] = {};
+   double vel[3] = {};
+   double angles[3] = {};
+   entityState(i, pos, vel, angles);
+
+   pdu->entityLinearVelocity.component[0] = static_cast<float>(vel[0]);
+   pdu->entityLinearVelocity.component[1] = static_cast<float>(vel[1]);
+   pdu->entityLinearVelocity.component[2] = static_cast<float>(vel[2]);
+   pdu->entityLocation.X_coord = pos[0];
+   pdu->entityLocation.Y_coord = pos[1];
+   pdu->entityLocation.Z_coord = pos[2];
+   pdu->entityOrientation.phi   = static_cast<float>(angles[0]);
+   pdu->entityOrientation.theta = static_cast<float>(angles[1]);
+   pdu->entityOrientation.psi   = static_cast<float>(angles[2]);
+
+   pdu->appearance = 0x00400000;    // Power plant on
+   pdu->deadReckoningAlgorithm = interop::Nib::FPW_DRM;
+
+   std::snprintf(reinterpret_cast<char*>(pdu->entityMarking.marking), EntityMarking::BUFF_SIZE, "TG%u", i + 1);
+   pdu->entityMarking.characterSet = 1;
+
+   if (base::NetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   return sizeof(EntityStatePDU);
+}
+
+unsigned int TrafficGenerator::makeFire(const unsigned int i, const unsigned int tgt, char* const buffer)
+{
+   std::memset(buffer, 0, sizeof(FirePDU));
+   const auto pdu = reinterpret_cast<FirePDU*>(buffer);
+
+   pdu->header.protocolVersion = NetIO::VERSION_1278_1A;
+   pdu->header.exerciseIdentifier = exerciseID;
+   pdu->header.PDUType = NetIO::PDU_FIRE;
+   pdu->header.protocolFamily = NetIO::PDU_FAMILY_WARFARE;
+   pdu->header.timeStamp = timeStamp();
+   pdu->header.length = sizeof(FirePDU);
+
+   eventNumber++;
+   pdu->firingEntityID.simulationID.siteIdentification = siteID;
+   pdu->firingEntityID.simulationID.applicationIdentification = appID;
+   pdu->firingEntityID.ID = static_cast<unsigned short>(i + 1);
+   pdu->targetEntityID.simulationID.siteIdentification = siteID;
+   pdu->targetEntityID.simulationID.applicationIdentification = appID;
+   pdu->targetEntityID.ID = static_cast<unsigned short>(tgt + 1);
+   pdu->munitionID.simulationID.siteIdentification = siteID;
+   pdu->munitionID.simulationID.applicationIdentification = appID;
+   pdu->munitionID.ID = static_cast<unsigned short>(MUNITION_ID_BASE | (eventNumber & 0x7fff));
+   pdu->eventID.simulationID.siteIdentification = siteID;
+   pdu->eventID.simulationID.applicationIdentification = appID;
+   pdu->eventID.eventNumber = eventNumber;
+
+   double pos[3] = {};
+   double vel[3] = {};
+   double angles[3] = {};
+   entityState(i, pos, vel, angles);
+   pdu->location.X_coord = pos[0];
+   pdu->location.Y_coord = pos[1];
+   pdu->location.Z_coord = pos[2];
+   pdu->velocity.component[0] = static_cast<float>(vel[0]);
+   pdu->velocity.component[1] = static_cast<float>(vel[1]);
+   pdu->velocity.component[2] = static_cast<float>(vel[2]);
+
+   pdu->burst.munition.kind         = static_cast<unsigned char>(munitionType[0]);
+   pdu->burst.munition.domain       = static_cast<unsigned char>(munitionType[1]);
+   pdu->burst.munition.country      = munitionType[2];
+   pdu->burst.munition.category     = static_cast<unsigned char>(munitionType[3]);
+   pdu->burst.munition.subcategory  = static_cast<unsigned char>(munitionType[4]);
+   pdu->burst.munition.specific     = static_cast<unsigned char>(munitionType[5]);
+   pdu->burst.munition.extra        = static_cast<unsigned char>(munitionType[6]);
+   pdu->burst.quantity = 1;
+
+   if (base::NetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   return sizeof(FirePDU);
+}
+
+unsigned int TrafficGenerator::makeDetonation(const unsigned int i, const unsigned int tgt, char* const buffer)
+{
+   std::memset(buffer, 0, sizeof(DetonationPDU));
+   const auto pdu = reinterpret_cast<DetonationPDU*>(buffer);
+
+   pdu->header.protocolVersion = NetIO::VERSION_1278_1A;
+   pdu->header.exerciseIdentifier = exerciseID;
+   pdu->header.PDUType = NetIO::PDU_DETONATION;
+   pdu->header.protocolFamily = NetIO::PDU_FAMILY_WARFARE;
+   pdu->header.timeStamp = timeStamp();
+   pdu->header.length = sizeof(DetonationPDU);
+
+   eventNumber++;
+   pdu->firingEntityID.simulationID.siteIdentification = siteID;
+   pdu->firingEntityID.simulationID.applicationIdentification = appID;
+   pdu->firingEntityID.ID = static_cast<unsigned short>(i + 1);
+   pdu->targetEntityID.simulationID.siteIdentification = siteID;
+   pdu->targetEntityID.simulationID.applicationIdentification = appID;
+   pdu->targetEntityID.ID = static_cast<unsigned short>(tgt + 1);
+   pdu->munitionID.simulationID.siteIdentification = siteID;
+   pdu->munitionID.simulationID.applicationIdentification = appID;
+   pdu->munitionID.ID = static_cast<unsigned short>(MUNITION_ID_BASE | (eventNumber & 0x7fff));
+   pdu->eventID.simulationID.siteIdentification = siteID;
+   pdu->eventID.simulationID.applicationIdentification = appID;
+   pdu->eventID.eventNumber = eventNumber;
+
+   // At the target's position
+   double pos[3] = {};
+   double vel[3] = {};
+   double angles[3] = {};
+   entityState(tgt, pos, vel, angles);
+   pdu->location.X_coord = pos[0];
+   pdu->location.Y_coord = pos[1];
+   pdu->location.Z_coord = pos[2];
+
+   pdu->burst.munition.kind         = static_cast<unsigned char>(munitionType[0]);
+   pdu->burst.munition.domain       = static_cast<unsigned char>(munitionType[1]);
+   pdu->burst.munition.country      = munitionType[2];
+   pdu->burst.munition.category     = static_cast<unsigned char>(munitionType[3]);
+   pdu->burst.munition.subcategory  = static_cast<unsigned char>(munitionType[4]);
+   pdu->burst.munition.specific     = static_cast<unsigned char>(munitionType[5]);
+   pdu->burst.munition.extra        = static_cast<unsigned char>(munitionType[6]);
+   pdu->burst.quantity = 1;
+
+   pdu->detonationResult = 0;       // Other
+   pdu->numberOfArticulationParameters = 0;
+
+   if (base::NetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   return sizeof(DetonationPDU);
+}
+
+// One emission system with one search beam
+unsigned int TrafficGenerator::makeEmission(const unsigned int i, char* const buffer)
+{
+   const unsigned int length = sizeof(ElectromagneticEmissionPDU) + sizeof(EmissionSystem) + sizeof(EmitterBeamData);
+   std::memset(buffer, 0, length);
+
+   const auto pdu = reinterpret_cast<ElectromagneticEmissionPDU*>(buffer);
+   pdu->header.protocolVersion = NetIO::VERSION_1278_1A;
+   pdu->header.exerciseIdentifier = exerciseID;
+   pdu->header.PDUType = NetIO::PDU_ELECTROMAGNETIC_EMISSION;
+   pdu->header.protocolFamily = NetIO::PDU_FAMILY_DIS_EMISSION_REG;
+   pdu->header.timeStamp = timeStamp();
+   pdu->header.length = static_cast<unsigned short>(length);
+
+   eventNumber++;
+   pdu->emittingEntityID.simulationID.siteIdentification = siteID;
+   pdu->emittingEntityID.simulationID.applicationIdentification = appID;
+   pdu->emittingEntityID.ID = static_cast<unsigned short>(i + 1);
+   pdu->eventID.simulationID.siteIdentification = siteID;
+   pdu->eventID.simulationID.applicationIdentification = appID;
+   pdu->eventID.eventNumber = eventNumber;
+   pdu->stateUpdateIndicator = ElectromagneticEmissionPDU::STATE_UPDATE;
+   pdu->numberOfSystems = 1;
+
+   const auto es = reinterpret_cast<EmissionSystem*>(buffer + sizeof(ElectromagneticEmissionPDU));
+   es->systemDataLength = static_cast<unsigned char>((sizeof(EmissionSystem) + sizeof(EmitterBeamData)) / 4);
+   es->numberOfBeams = 1;
+   es->emitterSystem.emitterName = emitterName;
+   es->emitterSystem.function = 1;                  // Multi-function
+   es->emitterSystem.emitterIdentificationNumber = 1;
+
+   const auto bd = reinterpret_cast<EmitterBeamData*>(buffer + sizeof(ElectromagneticEmissionPDU) + sizeof(EmissionSystem));
+   bd->beamDataLength = static_cast<unsigned char>(sizeof(EmitterBeamData) / 4);
+   bd->beamIDNumber = 1;
+   bd->parameterData.frequency = 9.5e9f;            // Hz
+   bd->parameterData.frequencyRange = 1.0e7f;       // Hz
+   bd->parameterData.effectiveRadiatedPower = 70.0f; // dBm
+   bd->parameterData.pulseRepetitiveFrequency = 1000.0f;
+   bd->parameterData.pulseWidth = 1.0f;
+   bd->beamData.beamAzimuthSweep = static_cast<float>(60.0 * base::angle::D2RCC);
+   bd->beamData.beamElevationSweep = static_cast<float>(10.0 * base::angle::D2RCC);
+   bd->beamFunction = 2;                            // Search
+
+   if (base::NetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   return length;
+}
+
+// One block of 16 bit PCM audio samples
+unsigned int TrafficGenerator::makeSignal(const unsigned int i, char* const buffer) const
+{
+   const unsigned int length = sizeof(SignalPDU) + SIGNAL_DATA_SIZE;
+   std::memset(buffer, 0, length);
+
+   const auto pdu = reinterpret_cast<SignalPDU*>(buffer);
+   pdu->header.protocolVersion = NetIO::VERSION_1278_1A;
+   pdu->header.exerciseIdentifier = exerciseID;
+   pdu->header.PDUType = NetIO::PDU_SIGNAL;
+   pdu->header.protocolFamily = NetIO::PDU_FAMILY_RADIO_COMM;
+   pdu->header.timeStamp = timeStamp();
+   pdu->header.length = static_cast<unsigned short>(length);
+
+   pdu->radioRefID.simulationID.siteIdentification = siteID;
+   pdu->radioRefID.simulationID.applicationIdentification = appID;
+   pdu->radioRefID.ID = static_cast<unsigned short>(i + 1);
+   pdu->radioID = 1;
+   pdu->encodingScheme = SIGNAL_ENCODING_PCM16;
+   pdu->sampleRate = SIGNAL_SAMPLE_RATE;
+   pdu->dataLength = static_cast<unsigned short>(SIGNAL_DATA_SIZE * 8);   // bits
+   pdu->samples = static_cast<unsigned short>(SIGNAL_SAMPLES);
+
+   if (base::NetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   return length;
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+unsigned long long TrafficGenerator::getTotalSent() const
+{
+   unsigned long long n = 0;
+   for (unsigned int k = 0; k < NUM_PDU_KINDS; k++) {
+      n += nSent[k];
+   }
+   return n;
+}
+
+double TrafficGenerator::getSendRate() const
+{
+   return (time > 0.0 ? static_cast<double>(getTotalSent()) / time : 0.0);
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool TrafficGenerator::setSlotNetOutput(base::NetHandler* const msg)
+{
+   netOutput = msg;
+   netInitialized = false;
+   return true;
+}
+
+bool TrafficGenerator::setSlotNumEntities(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 1 && n <= static_cast<int>(MAX_ENTITIES)) {
+         numEntities = static_cast<unsigned int>(n);
+         entitiesCreated = false;
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotSiteID(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 1 && v <= 65535) {
+         siteID = static_cast<unsigned short>(v);
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotApplicationID(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 1 && v <= 65535) {
+         appID = static_cast<unsigned short>(v);
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotExerciseID(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 0 && v <= 255) {
+         exerciseID = static_cast<unsigned char>(v);
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotLatitude(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double v = msg->getReal();
+      if (v >= -89.0 && v <= 89.0) {
+         refLat = v;
+         entitiesCreated = false;
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotLongitude(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double v = msg->getReal();
+      if (v >= -180.0 && v <= 180.0) {
+         refLon = v;
+         entitiesCreated = false;
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotRadius(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double v = base::Meters::convertStatic( *msg );
+      if (v > 0.0) {
+         radius = v;
+         entitiesCreated = false;
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+// Entity type vector: [ kind domain country category subcategory specific extra ]
+static bool getTypeCodes(const base::List* const msg, std::array<unsigned short, 7>* const codes)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      int values[7] = {};
+      const unsigned int n = msg->getNumberList(values, 7);
+      if (n >= 4) {
+         // Need at least kind, domain, country & category
+         for (unsigned int i = 0; i < 7; i++) {
+            (*codes)[i] = static_cast<unsigned short>(values[i]);
+         }
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotEntityType(const base::List* const msg)
+{
+   return getTypeCodes(msg, &entityType);
+}
+
+bool TrafficGenerator::setSlotMunitionType(const base::List* const msg)
+{
+   return getTypeCodes(msg, &munitionType);
+}
+
+bool TrafficGenerator::setSlotEmitterName(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 0 && v <= 65535) {
+         emitterName = static_cast<unsigned short>(v);
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotEntityStateRate(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double v = msg->getReal();
+      if (v > 0.0) {
+         esRate = v;
+         entitiesCreated = false;
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotFireRate(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr && msg->getReal() >= 0.0) {
+      rates[FIRE] = msg->getReal();
+      ok = true;
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotDetonationRate(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr && msg->getReal() >= 0.0) {
+      rates[DETONATION] = msg->getReal();
+      ok = true;
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotEmissionRate(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr && msg->getReal() >= 0.0) {
+      rates[EMISSION] = msg->getReal();
+      ok = true;
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotSignalRate(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr && msg->getReal() >= 0.0) {
+      rates[SIGNAL] = msg->getReal();
+      ok = true;
+   }
+   return ok;
+}
+
+bool TrafficGenerator::setSlotSeed(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      seed = static_cast<unsigned int>(msg->getInt());
+      entitiesCreated = false;
+      ok = true;
+   }
+   return ok;
+}
+
+std::ostream& TrafficGenerator::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+   int j = 0;
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << "( " << getFactoryName() << std::endl;
+      j = 4;
+   }
+
+   if (netOutput != nullptr) {
+      indent(sout,i+j);
+      sout << "netOutput: ";
+      netOutput->serialize(sout,(i+j+4),true);
+   }
+
+   indent(sout,i+j);
+   sout << "numEntities: " << numEntities << std::endl;
+
+   indent(sout,i+j);
+   sout << "siteID: " << siteID << std::endl;
+
+   indent(sout,i+j);
+   sout << "applicationID: " << appID << std::endl;
+
+   indent(sout,i+j);
+   sout << "exerciseID: " << static_cast<unsigned int>(exerciseID) << std::endl;
+
+   indent(sout,i+j);
+   sout << "latitude: " << refLat << std::endl;
+
+   indent(sout,i+j);
+   sout << "longitude: " << refLon << std::endl;
+
+   indent(sout,i+j);
+   sout << "radius: ( Meters " << radius << " )" << std::endl;
+
+   indent(sout,i+j);
+   sout << "entityType: [";
+   for (unsigned int k = 0; k < 7; k++) sout << " " << entityType[k];
+   sout << " ]" << std::endl;
+
+   indent(sout,i+j);
+   sout << "munitionType: [";
+   for (unsigned int k = 0; k < 7; k++) sout << " " << munitionType[k];
+   sout << " ]" << std::endl;
+
+   indent(sout,i+j);
+   sout << "emitterName: " << emitterName << std::endl;
+
+   indent(sout,i+j);
+   sout << "entityStateRate: " << esRate << std::endl;
+
+   indent(sout,i+j);
+   sout << "fireRate: " << rates[FIRE] << std::endl;
+
+   indent(sout,i+j);
+   sout << "detonationRate: " << rates[DETONATION] << std::endl;
+
+   indent(sout,i+j);
+   sout << "emissionRate: " << rates[EMISSION] << std::endl;
+
+   indent(sout,i+j);
+   sout << "signalRate: " << rates[SIGNAL] << std::endl;
+
+   indent(sout,i+j);
+   sout << "seed: " << seed << std::endl;
+
+   BaseClass::serialize(sout,i+j,true);
+
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << ")" << std::endl;
+   }
+
+   return sout;
+}
+
+}
+}
@@ -6,6 +6,7 @@
 #include "openeaagles/interop/dis/NetIO.hpp"
 #include "openeaagles/interop/dis/Ntm.hpp"
 #include "openeaagles/interop/dis/EmissionPduHandler.hpp"
+#include "openeaagles/interop/dis/TrafficGenerator.hpp"
 
 #include <string>
 
@@ -26,6 +27,9 @@ base::Object* factory(const std::string& name)
     else if ( name == EmissionPduHandler::getFactoryName() ) {
         obj = new EmissionPduHandler();
     }
+    else if ( name == TrafficGenerator::getFactoryName() ) {
+        obj = new TrafficGenerator();
+    }
 
     return obj;
 }
@@ -0,0 +1,81 @@
+
+#include "openeaagles/models/EmissionPool.hpp"
+
+#include "openeaagles/models/Emission.hpp"
+
+#include <atomic>
+#include <typeinfo>
+
+namespace oe {
+namespace models {
+
+EmissionPool::~EmissionPool()
+{
+   clear();
+}
+
+//------------------------------------------------------------------------------
+// alloc() -- returns a pre-ref()'d copy of the template emission
+//------------------------------------------------------------------------------
+Emission* EmissionPool::alloc(const Emission& tmpl)
+{
+   // Only exact Emission objects are pooled, because operator=() only
+   // copies the Emission part of a derived class.
+   const bool poolable = (typeid(tmpl) == typeid(Emission));
+
+   // Reuse a free emission
+   if (poolable && !freeList.empty()) {
+      Slot& slot = pool[freeList.back()];
+      freeList.pop_back();
+      *slot.em = tmpl;
+      slot.cleared = false;
+      slot.em->ref();
+      return slot.em;
+   }
+
+   // Otherwise, clone a new one (and keep it, if there's room)
+   Emission* em = tmpl.clone();
+   numCreated++;
+   if (poolable && pool.size() < maxSize) {
+      em->ref();
+      pool.push_back( Slot{em, false} );
+      if (freeList.capacity() < pool.capacity()) freeList.reserve(pool.capacity());
+   }
+   return em;
+}
+
+//------------------------------------------------------------------------------
+// sweep() -- clears the emissions that have been returned by all of the
+// receivers and rebuilds the free list
+//------------------------------------------------------------------------------
+void EmissionPool::sweep()
+{
+   freeList.clear();
+   for (unsigned int i = 0; i < pool.size(); i++) {
+      Slot& slot = pool[i];
+      if (slot.em->getRefCount() <= 1) {
+         // Synchronize with the receivers' unref() before we touch it
+         std::atomic_thread_fence(std::memory_order_acquire);
+         if (!slot.cleared) {
+            slot.em->clear();
+            slot.cleared = true;
+         }
+         freeList.push_back(i);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// clear() -- releases all of the pooled emissions
+//------------------------------------------------------------------------------
+void EmissionPool::clear()
+{
+   for (unsigned int i = 0; i < pool.size(); i++) {
+      pool[i].em->unref();
+   }
+   pool.clear();
+   freeList.clear();
+}
+
+}
+}
@@ -0,0 +1,225 @@
+
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
+
+#include "openeaagles/models/player/Player.hpp"
+
+#include "openeaagles/simulation/PlayerRegistry.hpp"
+
+#include "openeaagles/base/PairStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oe {
+namespace models {
+
+const double PlayerSpatialIndex::DEFAULT_CELL_SIZE = 20000.0;  // 20 km
+const double PlayerSpatialIndex::MIN_CELL_SIZE = 100.0;        // 100 m
+const double PlayerSpatialIndex::PAD_TIME = 0.5;               // 0.5 seconds
+
+//------------------------------------------------------------------------------
+// Cell keys -- 21 bits per axis, which is enough for +/- 1M cells
+//------------------------------------------------------------------------------
+unsigned long long PlayerSpatialIndex::cellKey(const int ix, const int iy, const int iz)
+{
+   const unsigned long long mask = 0x1fffff;
+   return ( (static_cast<unsigned long long>(ix) & mask) << 42 ) |
+          ( (static_cast<unsigned long long>(iy) & mask) << 21 ) |
+          (  static_cast<unsigned long long>(iz) & mask );
+}
+
+int PlayerSpatialIndex::cellCoord(const double v) const
+{
+   return static_cast<int>( std::floor(v / cellSize) );
+}
+
+//------------------------------------------------------------------------------
+// Constructor -- builds both grids from the player list's registry
+//------------------------------------------------------------------------------
+PlayerSpatialIndex::PlayerSpatialIndex(simulation::PlayerRegistry* const reg, const double meters, const double time)
+   : registry(reg), cellSize(meters >= MIN_CELL_SIZE ? meters : MIN_CELL_SIZE), buildTime(time)
+{
+   std::vector<base::Vec3d> ecefPos;
+   std::vector<unsigned int> ecefIdx;
+   std::vector<base::Vec3d> nedPos;
+   std::vector<unsigned int> nedIdx;
+
+   if (reg != nullptr) {
+      const unsigned int n = reg->getNumPlayers();
+      ecefPos.reserve(n);
+      ecefIdx.reserve(n);
+      nedPos.reserve(n);
+      nedIdx.reserve(n);
+      for (unsigned int i = 0; i < n; i++) {
+         const auto p = static_cast<const Player*>(reg->getPlayer(i));
+
+         ecefPos.push_back(p->getGeocPosition());
+         ecefIdx.push_back(i);
+
+         if (p->isPositionVectorValid()) {
+            nedPos.push_back(p->getPosition());
+            nedIdx.push_back(i);
+         }
+
+         const double v = p->getTotalVelocity();
+         if (v > maxSpeed) maxSpeed = v;
+      }
+   }
+
+   buildGrid(&ecefGrid, ecefPos, ecefIdx);
+   buildGrid(&nedGrid, nedPos, nedIdx);
+}
+
+//------------------------------------------------------------------------------
+// True if the index was built from this player list
+//------------------------------------------------------------------------------
+bool PlayerSpatialIndex::isIndexing(const base::PairStream* const players) const
+{
+   const simulation::PlayerRegistry* reg = registry;
+   return (players != nullptr && reg != nullptr && reg->getPlayerList() == players);
+}
+
+// Player at registry index 'idx'
+Player* PlayerSpatialIndex::getPlayer(const unsigned int idx) const
+{
+   const simulation::PlayerRegistry* reg = registry;
+   return (reg != nullptr) ? static_cast<Player*>(reg->getPlayer(idx)) : nullptr;
+}
+
+//------------------------------------------------------------------------------
+// buildGrid() -- bins the positions into the grid's cells; the items within
+// each cell remain in list order.
+//------------------------------------------------------------------------------
+void PlayerSpatialIndex::buildGrid(Grid* const grid, const std::vector<base::Vec3d>& pos, const std::vector<unsigned int>& idx) const
+{
+   // Find (or create) each position's cell and count the items per cell
+   std::vector<unsigned int> cellOf(pos.size());
+   std::vector<unsigned int>& count = grid->start;
+   for (unsigned int i = 0; i < pos.size(); i++) {
+      const int ix = cellCoord(pos[i].x());
+      const int iy = cellCoord(pos[i].y());
+      const int iz = cellCoord(pos[i].z());
+      const auto ins = grid->cells.emplace(cellKey(ix, iy, iz), static_cast<unsigned int>(grid->cx.size()));
+      if (ins.second) {
+         grid->cx.push_back(ix);
+         grid->cy.push_back(iy);
+         grid->cz.push_back(iz);
+         count.push_back(0);
+      }
+      cellOf[i] = ins.first->second;
+      count[cellOf[i]]++;
+   }
+
+   // Counts to start indexes
+   unsigned int sum = 0;
+   for (unsigned int c = 0; c < count.size(); c++) {
+      const unsigned int k = count[c];
+      count[c] = sum;
+      sum += k;
+   }
+   count.push_back(sum);
+
+   // Fill the cells (in list order); 'start' is shifted by one cell while filling
+   grid->items.resize(pos.size());
+   for (unsigned int i = 0; i < pos.size(); i++) {
+      grid->items[ grid->start[cellOf[i]]++ ] = idx[i];
+   }
+   for (unsigned int c = static_cast<unsigned int>(grid->cx.size()); c > 0; c--) {
+      grid->start[c] = grid->start[c-1];
+   }
+   grid->start[0] = 0;
+}
+
+//------------------------------------------------------------------------------
+// query() -- Collects the candidate players, in list order
+//------------------------------------------------------------------------------
+unsigned int PlayerSpatialIndex::query(
+      const base::Vec3d& p0,
+      const double range,
+      const bool ecef,
+      const double time,
+      std::vector<unsigned int>* const candidates
+   ) const
+{
+   if (candidates == nullptr) return 0;
+   candidates->clear();
+
+   queryGrid( (ecef ? ecefGrid : nedGrid), p0, paddedRange(range, time), false, candidates);
+
+   // back to list order
+   std::sort(candidates->begin(), candidates->end());
+
+   return static_cast<unsigned int>(candidates->size());
+}
+
+unsigned int PlayerSpatialIndex::queryHorizontal(
+      const base::Vec3d& p0,
+      const double range,
+      const double time,
+      std::vector<unsigned int>* const candidates
+   ) const
+{
+   if (candidates == nullptr) return 0;
+   candidates->clear();
+
+   queryGrid(nedGrid, p0, paddedRange(range, time), true, candidates);
+
+   // back to list order
+   std::sort(candidates->begin(), candidates->end());
+
+   return static_cast<unsigned int>(candidates->size());
+}
+
+// Pads the range by how far the players could have moved since the build
+double PlayerSpatialIndex::paddedRange(const double range, const double time) const
+{
+   double age = time - buildTime;
+   if (age < 0.0) age = 0.0;
+   return range + maxSpeed * (age + PAD_TIME);
+}
+
+// Collects the items of the cells within the bounding box of the query
+// sphere (or, 'horizontal', the query circle at all altitudes)
+void PlayerSpatialIndex::queryGrid(const Grid& grid, const base::Vec3d& p0, const double r, const bool horizontal, std::vector<unsigned int>* const candidates) const
+{
+   const unsigned int ncells = static_cast<unsigned int>(grid.cx.size());
+   if (ncells == 0) return;
+
+   // Bounding box of the query sphere, in cells
+   const int x0 = cellCoord(p0.x() - r);
+   const int x1 = cellCoord(p0.x() + r);
+   const int y0 = cellCoord(p0.y() - r);
+   const int y1 = cellCoord(p0.y() + r);
+   const int z0 = cellCoord(p0.z() - r);
+   const int z1 = cellCoord(p0.z() + r);
+
+   const double boxCells = static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1) * static_cast<double>(z1 - z0 + 1);
+
+   if (!horizontal && boxCells <= static_cast<double>(ncells)) {
+      // Small box: look up each of the box's cells
+      for (int ix = x0; ix <= x1; ix++) {
+         for (int iy = y0; iy <= y1; iy++) {
+            for (int iz = z0; iz <= z1; iz++) {
+               const auto it = grid.cells.find(cellKey(ix, iy, iz));
+               if (it != grid.cells.end()) {
+                  const unsigned int c = it->second;
+                  candidates->insert(candidates->end(), grid.items.begin() + grid.start[c], grid.items.begin() + grid.start[c+1]);
+               }
+            }
+         }
+      }
+   }
+   else {
+      // Large box (or horizontal): check each of the occupied cells
+      for (unsigned int c = 0; c < ncells; c++) {
+         if (grid.cx[c] >= x0 && grid.cx[c] <= x1 &&
+             grid.cy[c] >= y0 && grid.cy[c] <= y1 &&
+             (horizontal || (grid.cz[c] >= z0 && grid.cz[c] <= z1))) {
+            candidates->insert(candidates->end(), grid.items.begin() + grid.start[c], grid.items.begin() + grid.start[c+1]);
+         }
+      }
+   }
+}
+
+}
+}
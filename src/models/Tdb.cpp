@@ -4,17 +4,21 @@
 #include "openeaagles/models/player/Player.hpp"
 #include "openeaagles/models/system/Gimbal.hpp"
 #include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
 
 #include "openeaagles/terrain/Terrain.hpp"
+#include "openeaagles/terrain/Viewshed.hpp"
 
 #include "openeaagles/base/List.hpp"
 #include "openeaagles/base/PairStream.hpp"
 #include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/Profiler.hpp"
 
 #include "openeaagles/base/util/nav_utils.hpp"
 #include "openeaagles/base/util/osg_utils.hpp"
 
 #include <cmath>
+#include <vector>
 
 namespace oe {
 namespace models {
@@ -139,6 +143,13 @@ bool Tdb::resizeArrays(const unsigned int newSize)
          if (ra2 != nullptr)  { delete[] ra2; ra2 = nullptr; }
          if (ra  != nullptr)  { delete[] ra;  ra  = nullptr; }
 
+         if (losX != nullptr) { delete[] losX; losX = nullptr; }
+         if (losY != nullptr) { delete[] losY; losY = nullptr; }
+         if (losZ != nullptr) { delete[] losZ; losZ = nullptr; }
+         if (dvX  != nullptr) { delete[] dvX;  dvX  = nullptr; }
+         if (dvY  != nullptr) { delete[] dvY;  dvY  = nullptr; }
+         if (dvZ  != nullptr) { delete[] dvZ;  dvZ  = nullptr; }
+
          // Allocate new memory
          if (newSize > 0) {
             ranges   = new double[newSize];
@@ -159,6 +170,12 @@ bool Tdb::resizeArrays(const unsigned int newSize)
             za = new double[newSize];
             ra2 = new double[newSize];
             ra = new double[newSize];
+            losX = new double[newSize];
+            losY = new double[newSize];
+            losZ = new double[newSize];
+            dvX = new double[newSize];
+            dvY = new double[newSize];
+            dvZ = new double[newSize];
          }
 
       }
@@ -182,6 +199,8 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    // ---
    if (gimbal == nullptr || ownship == nullptr || players == nullptr || maxTargets == 0) return 0;
 
+   base::ProfileScope ps("processPlayers", this);
+
    // ---
    // Terrain occulting check setup
    // ---
@@ -277,123 +296,329 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    // Are we a space vehicle?
    const bool osSpaceVehicle = ownship->isMajorType(Player::SPACE_VEHICLE);
 
+   // Players-of-interest filter
+   PoiFilter f;
+   f.terrain = terrain;
+   f.maxRange = maxRange;
+   f.maxAngle = maxAngle;
+   f.cosMaxFov = cosMaxFov;
+   f.mask = mask;
+   f.localOnly = localOnly;
+   f.checkHorizon = checkHorizon;
+   f.osSpaceVehicle = osSpaceVehicle;
+   f.osLat = osLat;
+   f.osLon = osLon;
+   f.osAlt = osAlt;
+   f.hDist = hDist;
+   f.hTanAng = hTanAng;
+   f.p0 = p0;
+   f.wm = wm;
+   f.rm = rm;
+
+   // With terrain occulting, the targets that pass the other filters are
+   // collected and checked in batches (see addVisibleTargets()); a batch is
+   // checked when it could fill the target list, so we get the same targets
+   // as checking them one at a time.
+   const bool batch = (terrain != nullptr && !osSpaceVehicle);
+   static thread_local std::vector<Player*> pending;
+   static thread_local std::vector<double> pendingTans;
+   pending.clear();
+   pendingTans.clear();
+
    // ---
-   // 1) Scan the player list ---
+   // Use the world model's spatial index to find the candidate players that
+   // could be in range; only if we have a max range and the index was built
+   // from this player list.  Otherwise, scan the whole player list.
    // ---
-   bool finished = false;
-   for (base::List::Item* item = players->getFirstItem(); item != nullptr && numTgts < maxTargets && !finished; item = item->getNext()) {
-
-      // Get the pointer to the target player
-      base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-      Player* target = static_cast<Player*>(pair->object());
-
-      // Did we complete the local only players?
-      finished = localOnly && target->isNetworkedPlayer();
-
-      // We should process this target if ...
-      const bool processTgt =
-         !finished &&                                       // we're not finished AND
-         target != ownship &&                               // its not our ownship AND
-         target->isActive() &&                              // the target is active AND
-         target->isMajorType(mask) &&                       // the target is one of the selected types AND
-         (usingEcefFlg || target->isPositionVectorValid()); // we're using ECEF or the target's position vector is valid
-
-      if ( processTgt ) {
-
-         // Target Line-Of-Sight (LOS) vector
-         base::Vec3d tlos;
-         if (usingEcefFlg) tlos = target->getGeocPosition() - p0;
-         else tlos = target->getPosition() - p0;
-
-         // Normalized and compute length: unit LOS vector and range (meters)
-         const double range = tlos.normalize();
-
-         // In-range check (only if maxRange is greater than zero)
-         bool inRange = (maxRange == 0);
-         if ( !inRange ) {
-            inRange = range <= maxRange;
-         }
-
-         if (inRange) {
+   const WorldModel* const sim = ownship->getWorldModel();
+   const PlayerSpatialIndex* const index = (sim != nullptr ? sim->getPlayerSpatialIndex() : nullptr);
+   if (maxRange > 0 && index != nullptr && index->isIndexing(players)) {
 
-            // LOS vector in local tangent plane NED
-            base::Vec3d losNED = tlos;
-            if (usingEcefFlg) {
-               // LOS vector: ECEF to NED
-               losNED = wm * tlos;
+      // ---
+      // 1) Scan the candidate players (in player list order) ---
+      // ---
+      static thread_local std::vector<unsigned int> candidates;
+      const unsigned int nc = index->query(p0, maxRange, usingEcefFlg, sim->getExecTimeSec(), &candidates);
+
+      // Candidate ranges (meters); the LOS vectors are gathered into
+      // component arrays (SoA) and the ranges computed by a single kernel.
+      static thread_local std::vector<double> cx, cy, cz, crng;
+      cx.resize(nc);
+      cy.resize(nc);
+      cz.resize(nc);
+      crng.resize(nc);
+      for (unsigned int i = 0; i < nc; i++) {
+         const Player* const target = index->getPlayer(candidates[i]);
+         const base::Vec3d& pt = (usingEcefFlg ? target->getGeocPosition() : target->getPosition());
+         cx[i] = pt.x() - p0.x();
+         cy[i] = pt.y() - p0.y();
+         cz[i] = pt.z() - p0.z();
+      }
+      base::lengthArray(cx.data(), cy.data(), cz.data(), crng.data(), nc);
+
+      // Out of range candidates can be skipped; isPlayerOfInterest() would
+      // reject them using the same range.  Skipping a networked player
+      // doesn't change the local-only 'finished' check, because all players
+      // after it in the list are networked as well.
+      bool finished = false;
+      for (unsigned int i = 0; i < nc && numTgts < maxTargets && !finished; i++) {
+         if (crng[i] > maxRange) continue;
+         Player* target = index->getPlayer(candidates[i]);
+         double tanTgtAng = 0;
+         if ( isPlayerOfInterest(f, target, &finished, &tanTgtAng) ) {
+            if (batch) {
+               pending.push_back(target);
+               pendingTans.push_back(tanTgtAng);
+               if (numTgts + pending.size() >= maxTargets) {
+                  addVisibleTargets(f, pending.data(), pendingTans.data(), static_cast<unsigned int>(pending.size()));
+                  pending.clear();
+                  pendingTans.clear();
+               }
             }
-
-            // Compute the tangent of the angle from our local level to
-            // the target (positive angles are down)
-            double tanTgtAng = 999999.9; // initial tangent (down)
-            double xyRng = std::sqrt(losNED[0]*losNED[0] + losNED[1]*losNED[1]);
-            if (xyRng > 0) tanTgtAng = losNED[2]/xyRng;
-            else if (losNED[2] <= 0) tanTgtAng = -999999.9; // up
-
-            // Horizon check
-            bool aboveHorizon = true;
-            if (usingEcefFlg && checkHorizon) {
-               // We can see targets that are above the horizon or
-               // targets that are on or above the earth and are closer
-               // than the horizon
-               aboveHorizon = (tanTgtAng <= hTanAng) || (range <= hDist);
+            else {
+               // Ref() and save the target pointer
+               target->ref();
+               targets[numTgts++] = target;
             }
+         }
+      }
+   }
+   else {
 
-            if (aboveHorizon) {
-
-               // In FOV check (only if maxAngle is greater than zero)
-               bool inFov = (maxAngle == 0);
-               if ( !inFov ) {
-                  // LOS vector: NED to gimbal coordinates
-                  const base::Vec3d losG = rm * losNED;
-                  inFov = (losG.x() >= cosMaxFov);
-               }
-
-               if (inFov) {
-
-                  // Terrain occulting if we have terrain data and we're not a space vehicle
-                  bool occulted = false;
-                  if (terrain != nullptr && !osSpaceVehicle) {
-
-                     const double tgtLat = target->getLatitude();
-                     const double tgtLon = target->getLongitude();
-                     const double tgtAlt = target->getAltitudeM();
-
-                     // Is the target a space vehicle?
-                     if ( target->isMajorType(Player::SPACE_VEHICLE) ) {
-                        // Get the true, great-circle bearing to the target
-                        double tbrg(0), distNM(0);
-                        base::nav::vll2bd(osLat, osLon, tgtLat, tgtLon, &tbrg, &distNM);
-
-                        // Set the distance to check to 60 nm
-                        double dist = 60.0 * base::distance::NM2M;
-
-                        // Terrain occulting check toward the space vehicle
-                        occulted = terrain->targetOcculting2(osLat, osLon, osAlt, tbrg, dist, -tanTgtAng);
-                     }
-                     else {
-                        // Occulting check between two standard player
-                        occulted = terrain->targetOcculting(osLat, osLon, static_cast<double>(osAlt),
-                                                            tgtLat, tgtLon, static_cast<double>(tgtAlt));
-                     }
-                  }
-
-                  if (!occulted) {
-                     // !!! All is well with this target !!!
-
-                     // Ref() and save the target pointer
-                     target->ref();
-                     targets[numTgts++] = target;
-                  }
+      // ---
+      // 1) Scan the player list ---
+      // ---
+      bool finished = false;
+      for (base::List::Item* item = players->getFirstItem(); item != nullptr && numTgts < maxTargets && !finished; item = item->getNext()) {
+
+         // Get the pointer to the target player
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         Player* target = static_cast<Player*>(pair->object());
+
+         double tanTgtAng = 0;
+         if ( isPlayerOfInterest(f, target, &finished, &tanTgtAng) ) {
+            if (batch) {
+               pending.push_back(target);
+               pendingTans.push_back(tanTgtAng);
+               if (numTgts + pending.size() >= maxTargets) {
+                  addVisibleTargets(f, pending.data(), pendingTans.data(), static_cast<unsigned int>(pending.size()));
+                  pending.clear();
+                  pendingTans.clear();
                }
             }
+            else {
+               // Ref() and save the target pointer
+               target->ref();
+               targets[numTgts++] = target;
+            }
          }
       }
    }
 
+   // ---
+   // 2) Terrain occulting check of the remaining targets
+   // ---
+   if (!pending.empty()) {
+      addVisibleTargets(f, pending.data(), pendingTans.data(), static_cast<unsigned int>(pending.size()));
+      pending.clear();
+      pendingTans.clear();
+   }
+
+   if (index != nullptr) index->unref();
    return numTgts;
 }
 
+//------------------------------------------------------------------------------
+// Player-of-interest filter --- returns true if the target player passes
+// all of the filters (player type, max range, horizon and max angle); the
+// terrain occulting checks are done by addVisibleTargets().  The 'finished'
+// flag is set when we've completed the local players and we're only
+// interested in local players.  The tangent of the angle from our local
+// level to the target (positive down) is returned in 'tanTgtAngOut'.
+//------------------------------------------------------------------------------
+bool Tdb::isPlayerOfInterest(const PoiFilter& f, Player* const target, bool* const finished, double* const tanTgtAngOut) const
+{
+   // Did we complete the local only players?
+   *finished = f.localOnly && target->isNetworkedPlayer();
+
+   // We should process this target if ...
+   const bool processTgt =
+      !(*finished) &&                                    // we're not finished AND
+      target != ownship &&                               // its not our ownship AND
+      target->isActive() &&                              // the target is active AND
+      target->isMajorType(f.mask) &&                     // the target is one of the selected types AND
+      (usingEcefFlg || target->isPositionVectorValid()); // we're using ECEF or the target's position vector is valid
+
+   if ( !processTgt ) return false;
+
+   // Target Line-Of-Sight (LOS) vector
+   base::Vec3d tlos;
+   if (usingEcefFlg) tlos = target->getGeocPosition() - f.p0;
+   else tlos = target->getPosition() - f.p0;
+
+   // Normalized and compute length: unit LOS vector and range (meters)
+   const double range = tlos.normalize();
+
+   // In-range check (only if maxRange is greater than zero)
+   bool inRange = (f.maxRange == 0);
+   if ( !inRange ) {
+      inRange = range <= f.maxRange;
+   }
+   if (!inRange) return false;
+
+   // LOS vector in local tangent plane NED
+   base::Vec3d losNED = tlos;
+   if (usingEcefFlg) {
+      // LOS vector: ECEF to NED
+      losNED = f.wm * tlos;
+   }
+
+   // Compute the tangent of the angle from our local level to
+   // the target (positive angles are down)
+   double tanTgtAng = 999999.9; // initial tangent (down)
+   double xyRng = std::sqrt(losNED[0]*losNED[0] + losNED[1]*losNED[1]);
+   if (xyRng > 0) tanTgtAng = losNED[2]/xyRng;
+   else if (losNED[2] <= 0) tanTgtAng = -999999.9; // up
+
+   // Horizon check
+   bool aboveHorizon = true;
+   if (usingEcefFlg && f.checkHorizon) {
+      // We can see targets that are above the horizon or
+      // targets that are on or above the earth and are closer
+      // than the horizon
+      aboveHorizon = (tanTgtAng <= f.hTanAng) || (range <= f.hDist);
+   }
+   if (!aboveHorizon) return false;
+
+   // In FOV check (only if maxAngle is greater than zero)
+   bool inFov = (f.maxAngle == 0);
+   if ( !inFov ) {
+      // LOS vector: NED to gimbal coordinates
+      const base::Vec3d losG = f.rm * losNED;
+      inFov = (losG.x() >= f.cosMaxFov);
+   }
+   if (!inFov) return false;
+
+   *tanTgtAngOut = tanTgtAng;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Terrain occulting check of a batch of players-of-interest --- the targets
+// that aren't occulted by the terrain are added, in order, to the target list
+// until it's full.  'tanTgtAngs' are the tangents of the angles from our local
+// level to the targets (positive down), from isPlayerOfInterest().
+//------------------------------------------------------------------------------
+void Tdb::addVisibleTargets(const PoiFilter& f, Player** const tgts, const double* const tanTgtAngs, const unsigned int n)
+{
+   if (f.terrain == nullptr || n == 0) return;
+
+   // Gimbal's terrain occulting results cache (for our observer cell)
+   std::unordered_map<unsigned long long, bool>* cache = nullptr;
+   if (gimbal->isTerrainOccultingCacheEnabled()) {
+      cache = gimbal->getOccultingCache(getOccultingCell(f.osLat, f.osLon, f.osAlt));
+      if (cache->size() >= MAX_OCCULTING_CACHE) cache->clear();
+   }
+
+   // Gimbal's viewshed (stationary ownship)
+   const terrain::Viewshed* const viewshed = gimbal->getViewshed();
+
+   // Visible flags of the targets
+   static thread_local std::vector<char> visible;
+   visible.assign(n, 0);
+
+   // Targets checked with the batched occulting check
+   static thread_local std::vector<unsigned int> idx;
+   static thread_local std::vector<unsigned long long> keys;
+   static thread_local std::vector<double> lats, lons, alts;
+   idx.clear();
+   keys.clear();
+   lats.clear();
+   lons.clear();
+   alts.clear();
+
+   for (unsigned int i = 0; i < n; i++) {
+      const Player* const target = tgts[i];
+      const double tgtLat = target->getLatitude();
+      const double tgtLon = target->getLongitude();
+      const double tgtAlt = target->getAltitudeM();
+
+      // Is the target a space vehicle?
+      if ( target->isMajorType(Player::SPACE_VEHICLE) ) {
+         // Get the true, great-circle bearing to the target
+         double tbrg(0), distNM(0);
+         base::nav::vll2bd(f.osLat, f.osLon, tgtLat, tgtLon, &tbrg, &distNM);
+
+         // Set the distance to check to 60 nm
+         double dist = 60.0 * base::distance::NM2M;
+
+         // Terrain occulting check toward the space vehicle
+         visible[i] = !f.terrain->targetOcculting2(f.osLat, f.osLon, f.osAlt, tbrg, dist, -tanTgtAngs[i]);
+         continue;
+      }
+
+      // Within the viewshed?
+      bool occulted = false;
+      if (viewshed != nullptr && viewshed->targetOcculting(tgtLat, tgtLon, tgtAlt, &occulted)) {
+         visible[i] = !occulted;
+         continue;
+      }
+
+      // Cached result?
+      unsigned long long key = 0;
+      if (cache != nullptr) {
+         key = getOccultingCell(tgtLat, tgtLon, tgtAlt);
+         const auto it = cache->find(key);
+         if (it != cache->end()) {
+            visible[i] = it->second;
+            continue;
+         }
+      }
+
+      // Occulting check between two standard players (batched)
+      idx.push_back(i);
+      keys.push_back(key);
+      lats.push_back(tgtLat);
+      lons.push_back(tgtLon);
+      alts.push_back(tgtAlt);
+   }
+
+   const unsigned int m = static_cast<unsigned int>(idx.size());
+   if (m > 0) {
+      static thread_local std::vector<unsigned int> mask;
+      mask.assign((m + 31) / 32, 0);
+      f.terrain->targetOccultingMask(f.osLat, f.osLon, f.osAlt, lats.data(), lons.data(), alts.data(), m, mask.data());
+      for (unsigned int j = 0; j < m; j++) {
+         const bool vis = ((mask[j / 32] >> (j % 32)) & 1u) != 0;
+         visible[idx[j]] = vis;
+         if (cache != nullptr) (*cache)[keys[j]] = vis;
+      }
+   }
+
+   // Ref() and save the visible target pointers
+   for (unsigned int i = 0; i < n && numTgts < maxTargets; i++) {
+      if (visible[i]) {
+         tgts[i]->ref();
+         targets[numTgts++] = tgts[i];
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Terrain occulting cache cell of a position: latitude and longitude in 3 arc
+// second (1/1200 degree) steps, and altitude in 10 meter steps (-1000 meters
+// and up), packed into 64 bits.
+//------------------------------------------------------------------------------
+unsigned long long Tdb::getOccultingCell(const double lat, const double lon, const double alt)
+{
+   const unsigned long long ilat = static_cast<unsigned long long>((lat + 90.0) * 1200.0) & 0x3FFFF;    // 18 bits
+   const unsigned long long ilon = static_cast<unsigned long long>((lon + 180.0) * 1200.0) & 0x7FFFF;   // 19 bits
+   double a = (alt + 1000.0) / 10.0;
+   if (a < 0) a = 0;
+   const unsigned long long ialt = static_cast<unsigned long long>(a) & 0xFFFFF;                         // 20 bits
+   return (ilat << 39) | (ilon << 20) | ialt;
+}
+
 
 //------------------------------------------------------------------------------
 // Compute Boresight Data --- Scan the target list, which as been pre-processed by
@@ -435,6 +660,7 @@ unsigned int Tdb::computeBoresightData()
          v0 = ownship->getVelocity();  // Local gaming area velocity vector (NED)
       }
 
+      // Target LOS and relative velocity vectors (SoA)
       for (unsigned int i = 0; i < numTgts; i++) {
 
          // Target vectors (ECEF or local gaming area NED)
@@ -451,16 +677,23 @@ unsigned int Tdb::computeBoresightData()
             vt = targets[i]->getVelocity();  // Local gaming area velocity vector (NED)
          }
 
-         // Target LOS vector
-         base::Vec3d los = (pt - p0);
+         losX[i] = pt.x() - p0.x();
+         losY[i] = pt.y() - p0.y();
+         losZ[i] = pt.z() - p0.z();
+         dvX[i] = vt.x() - v0.x();
+         dvY[i] = vt.y() - v0.y();
+         dvZ[i] = vt.z() - v0.z();
+      }
 
-         // Normalized and compute length [unit vector and range(meters)]
-         ranges[i] = los.normalize();
+      // Normalize the LOS vectors and compute the ranges (meters)
+      base::normalizeArray(losX, losY, losZ, ranges, numTgts);
 
-         // Computer range rate (meters/sec)
-         rngRates[i] = ( (vt - v0) * los );
+      // Compute range rates (meters/sec)
+      base::dotArray(dvX, dvY, dvZ, losX, losY, losZ, rngRates, numTgts);
 
-         // Save the LOS vectors (own to tgt) and (tgt back to own)
+      // Save the LOS vectors (own to tgt) and (tgt back to own)
+      for (unsigned int i = 0; i < numTgts; i++) {
+         const base::Vec3d los(losX[i], losY[i], losZ[i]);
          if (usingEcefFlg) {
             // Rotate the LOS vectors into their local tangent planes
             losO2T[i] = wm * los;
@@ -7,8 +7,11 @@
 #include "openeaagles/base/PairStream.hpp"
 #include "openeaagles/base/Pair.hpp"
 
+#include "openeaagles/base/units/Distances.hpp"
 #include "openeaagles/base/util/nav_utils.hpp"
 
+#include "openeaagles/simulation/PlayerRegistry.hpp"
+
 // environment models
 #include "openeaagles/models/environment/AbstractAtmosphere.hpp"
 #include "openeaagles/terrain/Terrain.hpp"
@@ -36,6 +39,9 @@ BEGIN_SLOTTABLE(WorldModel)
 
    "terrain",                 //  6) Terrain elevation database
    "atmosphere",              //  7) Atmospheric model
+
+   "playerIndexCellSize",     //  8) Cell size of the players-of-interest spatial index,
+                              //     or zero to disable the index (default: 20 km)
 END_SLOTTABLE(WorldModel)
 
 BEGIN_SLOT_MAP(WorldModel)
@@ -54,6 +60,8 @@ BEGIN_SLOT_MAP(WorldModel)
 
     ON_SLOT( 6, setSlotTerrain,      terrain::Terrain)
     ON_SLOT( 7, setSlotAtmosphere,   AbstractAtmosphere)
+
+    ON_SLOT( 8, setSlotPlayerIndexCellSize, base::Distance)
 END_SLOT_MAP()
 
 WorldModel::WorldModel()
@@ -83,6 +91,10 @@ void WorldModel::copyData(const WorldModel& org, const bool cc)
    gaUseEmFlg = org.gaUseEmFlg;
    wm = org.wm;
 
+   playerIndex = nullptr;
+   playerIndexCellSize = org.playerIndexCellSize;
+   playerIndexEnabled = org.playerIndexEnabled;
+
 
    if (org.terrain != nullptr) {
       terrain::Terrain* copy = org.terrain->clone();
@@ -105,6 +117,7 @@ void WorldModel::copyData(const WorldModel& org, const bool cc)
 
 void WorldModel::deleteData()
 {
+   playerIndex = nullptr;
    setSlotAtmosphere( nullptr );
    setSlotTerrain( nullptr );
 }
@@ -128,6 +141,22 @@ void WorldModel::reset()
    if (atmosphere != nullptr) atmosphere->reset();
 }
 
+//------------------------------------------------------------------------------
+// updatePlayerList() -- update the player list, and then build and swap in
+// a new players-of-interest spatial index (readers keep the old one until
+// they're done with it)
+//------------------------------------------------------------------------------
+void WorldModel::updatePlayerList()
+{
+   BaseClass::updatePlayerList();
+
+   if (playerIndexEnabled) {
+      simulation::PlayerRegistry* reg = getPlayerRegistry();
+      playerIndex.set(new PlayerSpatialIndex(reg, playerIndexCellSize, getExecTimeSec()), false);
+      if (reg != nullptr) reg->unref();
+   }
+}
+
 bool WorldModel::shutdownNotification()
 {
    // ---
@@ -160,6 +189,12 @@ bool WorldModel::isGamingAreaUsingEarthModel() const
    return gaUseEmFlg;
 }
 
+// Players-of-interest spatial index, or zero if disabled; pre-ref()'d
+const PlayerSpatialIndex* WorldModel::getPlayerSpatialIndex() const
+{
+   return (playerIndexEnabled ? playerIndex.getRefPtr() : nullptr);
+}
+
 // Returns the reference latitude
 double WorldModel::getRefLatitude() const
 {
@@ -304,6 +339,32 @@ bool WorldModel::setSlotGamingAreaRange(const base::Distance* const msg)
    return ok;
 }
 
+bool WorldModel::setSlotPlayerIndexCellSize(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double v = base::Meters::convertStatic(*msg);
+      if (v == 0.0) {
+         playerIndex = nullptr;
+         playerIndexEnabled = false;
+         ok = true;
+      }
+      else {
+         ok = (v >= PlayerSpatialIndex::MIN_CELL_SIZE);
+         if (ok) {
+            playerIndex = nullptr;
+            playerIndexCellSize = v;
+            playerIndexEnabled = true;
+         }
+         else {
+            std::cerr << "WorldModel::setSlotPlayerIndexCellSize(): invalid cell size: " << v;
+            std::cerr << " meters; use zero or at least " << PlayerSpatialIndex::MIN_CELL_SIZE << " meters" << std::endl;
+         }
+      }
+   }
+   return ok;
+}
+
 bool WorldModel::setSlotEarthModel(const base::EarthModel* const msg)
 {
    return setEarthModel(msg);
@@ -2,6 +2,7 @@
 #include "openeaagles/models/factory.hpp"
 
 #include "openeaagles/base/Object.hpp"
+#include "openeaagles/base/FactoryTable.hpp"
 
 // dynamics models
 #include "openeaagles/models/dynamics/JSBSimModel.hpp"
@@ -96,349 +97,157 @@ namespace models {
 
 base::Object* factory(const std::string& name)
 {
-   base::Object* obj = nullptr;
-
-   // dynamics models
-   if ( name == RacModel::getFactoryName() ) {              // RAC
-      obj = new RacModel();
-   }
-   else if ( name == JSBSimModel::getFactoryName() ) {      // JSBSim
-      obj = new JSBSimModel();
-   }
-   else if ( name == LaeroModel::getFactoryName() ) {       // Laero
-      obj = new LaeroModel();
-   }
-
-   // environment
-   else if ( name == IrAtmosphere::getFactoryName() ) {
-      obj = new IrAtmosphere;
-   }
-   else if ( name == IrAtmosphere1::getFactoryName() ) {
-      obj = new IrAtmosphere1;
-   }
-
-   // sensor models
-   if ( name == Gmti::getFactoryName() ) {
-      obj = new Gmti();
-   }
-   else if ( name == Stt::getFactoryName() ) {
-      obj = new Stt();
-   }
-   else if ( name == Tws::getFactoryName() ) {
-      obj = new Tws();
-   }
-
-   // world models
-   else if ( name == WorldModel::getFactoryName() ) {
-      obj = new WorldModel();
-   }
-   
-   // Players
-   else if ( name == Player::getFactoryName() ) {
-      obj = new Player();
-   }
-   else if ( name == AirVehicle::getFactoryName() ) {
-      obj = new AirVehicle();
-   }
-   else if ( name == Building::getFactoryName() ) {
-      obj = new Building();
-   }
-   else if ( name == GroundVehicle::getFactoryName() ) {
-      obj = new GroundVehicle();
-   }
-   else if ( name == LifeForm::getFactoryName() ) {
-      obj = new LifeForm();
-   }
-   else if ( name == Ship::getFactoryName() ) {
-      obj = new Ship();
-   }
-   else if ( name == SpaceVehicle::getFactoryName() ) {
-      obj = new SpaceVehicle();
-   }
-
-   // Air Vehicles
-   else if ( name == Aircraft::getFactoryName() ) {
-      obj = new Aircraft();
-   }
-   else if ( name == Helicopter::getFactoryName() ) {
-      obj = new Helicopter();
-   }
-   else if ( name == UnmannedAirVehicle::getFactoryName() ) {
-      obj = new UnmannedAirVehicle();
-   }
-
-   // Ground Vehicles
-   else if ( name == Tank::getFactoryName() ) {
-      obj = new Tank();
-   }
-   else if ( name == ArmoredVehicle::getFactoryName() ) {
-      obj = new ArmoredVehicle();
-   }
-   else if ( name == WheeledVehicle::getFactoryName() ) {
-      obj = new WheeledVehicle();
-   }
-   else if ( name == Artillery::getFactoryName() ) {
-      obj = new Artillery();
-   }
-   else if ( name == SamVehicle::getFactoryName() ) {
-      obj = new SamVehicle();
-   }
-   else if ( name == GroundStation::getFactoryName() ) {
-      obj = new GroundStation();
-   }
-   else if ( name == GroundStationRadar::getFactoryName() ) {
-      obj = new GroundStationRadar();
-   }
-   else if ( name == GroundStationUav::getFactoryName() ) {
-      obj = new GroundStationUav();
-   }
-
-   // Space Vehicles
-   else if ( name == MannedSpaceVehicle::getFactoryName() ) {
-      obj = new MannedSpaceVehicle();
-   }
-   else if ( name == UnmannedSpaceVehicle::getFactoryName() ) {
-      obj = new UnmannedSpaceVehicle();
-   }
-   else if ( name == BoosterSpaceVehicle::getFactoryName() ) {
-      obj = new BoosterSpaceVehicle();
-   }
-
-   // System
-   else if ( name == System::getFactoryName() ) {
-      obj = new System();
-   }
-   else if ( name == AvionicsPod::getFactoryName() ) {
-      obj = new AvionicsPod();
-   }
-
-   // Basic Pilot types
-   else if ( name == Pilot::getFactoryName() ) {
-      obj = new Pilot();
-   }
-   else if ( name == Autopilot::getFactoryName() ) {
-      obj = new Autopilot();
-   }
-
-   // Navigation types
-   else if ( name == Navigation::getFactoryName() ) {
-      obj = new Navigation();
-   }
-   else if ( name == Ins::getFactoryName() ) {
-      obj = new Ins();
-   }
-   else if ( name == Gps::getFactoryName() ) {
-      obj = new Gps();
-   }
-   else if ( name == Route::getFactoryName() ) {
-      obj = new Route();
-   }
-   else if ( name == Steerpoint::getFactoryName() ) {
-      obj = new Steerpoint();
-   }
-
-   // Target Data
-   else if ( name == TargetData::getFactoryName() ) {
-      obj = new TargetData();
-   }
-
-   // Bullseye
-   else if ( name == Bullseye::getFactoryName() ) {
-      obj = new Bullseye();
-   }
-
-   // Actions
-   else if ( name == ActionImagingSar::getFactoryName() ) {
-      obj = new ActionImagingSar();
-   }
-   else if ( name == ActionWeaponRelease::getFactoryName() ) {
-      obj = new ActionWeaponRelease();
-   }
-   else if ( name == ActionDecoyRelease::getFactoryName() ) {
-      obj = new ActionDecoyRelease();
-   }
-   else if ( name == ActionCamouflageType::getFactoryName() ) {
-      obj = new ActionCamouflageType();
-   }
-
-   // Bombs and Missiles
-   else if ( name == Bomb::getFactoryName() ) {
-      obj = new Bomb();
-   }
-   else if ( name == Missile::getFactoryName() ) {
-      obj = new Missile();
-   }
-   else if ( name == Aam::getFactoryName() ) {
-      obj = new Aam();
-   }
-   else if ( name == Agm::getFactoryName() ) {
-      obj = new Agm();
-   }
-   else if ( name == Sam::getFactoryName() ) {
-      obj = new Sam();
-   }
-
-   // Effects
-   else if ( name == Chaff::getFactoryName() ) {
-      obj = new Chaff();
-   }
-   else if ( name == Decoy::getFactoryName() ) {
-      obj = new Decoy();
-   }
-   else if ( name == Flare::getFactoryName() ) {
-      obj = new Flare();
-   }
-
-   // Stores, stores manager and external stores (FuelTank, Gun & Bullets (used by the Gun))
-   else if ( name == Stores::getFactoryName() ) {
-      obj = new Stores();
-   }
-   else if ( name == SimpleStoresMgr::getFactoryName() ) {
-      obj = new SimpleStoresMgr();
-   }
-   else if ( name == FuelTank::getFactoryName() ) {
-      obj = new FuelTank();
-   }
-   else if ( name == Gun::getFactoryName() ) {
-      obj = new Gun();
-   }
-   else if ( name == Bullet::getFactoryName() ) {
-      obj = new Bullet();
-   }
-
-   // Data links
-   else if ( name == Datalink::getFactoryName() ) {
-      obj = new Datalink();
-   }
-
-   // Gimbals, Antennas and Optics
-   else if ( name == Gimbal::getFactoryName() ) {
-      obj = new Gimbal();
-   }
-   else if ( name == ScanGimbal::getFactoryName() ) {
-      obj = new ScanGimbal();
-   }
-   else if ( name == StabilizingGimbal::getFactoryName() ) {
-      obj = new StabilizingGimbal();
-   }
-   else if ( name == Antenna::getFactoryName() ) {
-      obj = new Antenna();
-   }
-   else if ( name == IrSeeker::getFactoryName() ) {
-      obj = new IrSeeker();
-   }
-
-   // R/F Signatures
-   else if ( name == SigConstant::getFactoryName() ) {
-      obj = new SigConstant();
-   }
-   else if ( name == SigSphere::getFactoryName() ) {
-      obj = new SigSphere();
-   }
-   else if ( name == SigPlate::getFactoryName() ) {
-      obj = new SigPlate();
-   }
-   else if ( name == SigDihedralCR::getFactoryName() ) {
-      obj = new SigDihedralCR();
-   }
-   else if ( name == SigTrihedralCR::getFactoryName() ) {
-      obj = new SigTrihedralCR();
-   }
-   else if ( name == SigSwitch::getFactoryName() ) {
-      obj = new SigSwitch();
-   }
-   else if ( name == SigAzEl::getFactoryName() ) {
-      obj = new SigAzEl();
-   }
-   // IR Signatures
-   else if ( name == IrSignature::getFactoryName() ) {
-      obj = new IrSignature();
-   }
-   else if ( name == AircraftIrSignature::getFactoryName() ) {
-      obj = new AircraftIrSignature;
-   }
-   else if ( name == IrShape::getFactoryName() ) {
-      obj = new IrShape();
-   }
-   else if ( name == IrSphere::getFactoryName() ) {
-      obj = new IrSphere();
-   }
-   else if ( name == IrBox::getFactoryName() ) {
-      obj = new IrBox();
-   }
-    // Onboard Computers
-   else if ( name == OnboardComputer::getFactoryName() ) {
-      obj = new OnboardComputer();
-   }
-   // Radios
-   else if ( name == Radio::getFactoryName() ) {
-      obj = new Radio();
-   }
-   else if ( name == CommRadio::getFactoryName() ) {
-      obj = new CommRadio();
-   }
-   else if ( name == Iff::getFactoryName() ) {
-      obj = new Iff();
-   }
-   // Sensors
-   else if ( name == RfSensor::getFactoryName() ) {
-      obj = new RfSensor();
-   }
-   else if ( name == SensorMgr::getFactoryName() ) {
-      obj = new SensorMgr();
-   }
-   else if ( name == Radar::getFactoryName() ) {
-      obj = new Radar();
-   }
-   else if ( name == Rwr::getFactoryName() ) {
-      obj = new Rwr();
-   }
-   else if ( name == Sar::getFactoryName() ) {
-      obj = new Sar();
-   }
-   else if ( name == Jammer::getFactoryName() ) {
-      obj = new Jammer();
-   }
-   else if ( name == IrSensor::getFactoryName() ) {
-      obj = new IrSensor();
-   }
-   else if ( name == MergingIrSensor::getFactoryName() ) {
-      obj = new MergingIrSensor();
-   }
-
-   // Tracks
-   else if ( name == Track::getFactoryName() ) {
-      obj = new Track();
-   }
-
-   // Track Managers
-   else if ( name == GmtiTrkMgr::getFactoryName() ) {
-      obj = new GmtiTrkMgr();
-   }
-   else if ( name == AirTrkMgr::getFactoryName() ) {
-      obj = new AirTrkMgr();
-   }
-   else if ( name == RwrTrkMgr::getFactoryName() ) {
-      obj = new RwrTrkMgr();
-   }
-   else if ( name == AirAngleOnlyTrkMgr::getFactoryName() ) {
-      obj = new AirAngleOnlyTrkMgr();
-   }
-
-   // UBF Agents
-   else if ( name == SimAgent::getFactoryName() ) {
-      obj = new SimAgent();
-   }
-   else if ( name == MultiActorAgent::getFactoryName() ) {
-      obj = new MultiActorAgent();
-   }
-
-   // Collision detection component
-   else if ( name == CollisionDetect::getFactoryName() ) {
-      obj = new CollisionDetect();
-   }
-
-   return obj;
+   static const base::FactoryTable table = {
+      // dynamics models
+      FACTORY_ENTRY(RacModel),                 // RAC
+      FACTORY_ENTRY(JSBSimModel),              // JSBSim
+      FACTORY_ENTRY(LaeroModel),               // Laero
+
+      // environment
+      FACTORY_ENTRY(IrAtmosphere),
+      FACTORY_ENTRY(IrAtmosphere1),
+
+      // sensor models
+      FACTORY_ENTRY(Gmti),
+      FACTORY_ENTRY(Stt),
+      FACTORY_ENTRY(Tws),
+
+      // world models
+      FACTORY_ENTRY(WorldModel),
+
+      // Players
+      FACTORY_ENTRY(Player),
+      FACTORY_ENTRY(AirVehicle),
+      FACTORY_ENTRY(Building),
+      FACTORY_ENTRY(GroundVehicle),
+      FACTORY_ENTRY(LifeForm),
+      FACTORY_ENTRY(Ship),
+      FACTORY_ENTRY(SpaceVehicle),
+
+      // Air Vehicles
+      FACTORY_ENTRY(Aircraft),
+      FACTORY_ENTRY(Helicopter),
+      FACTORY_ENTRY(UnmannedAirVehicle),
+
+      // Ground Vehicles
+      FACTORY_ENTRY(Tank),
+      FACTORY_ENTRY(ArmoredVehicle),
+      FACTORY_ENTRY(WheeledVehicle),
+      FACTORY_ENTRY(Artillery),
+      FACTORY_ENTRY(SamVehicle),
+      FACTORY_ENTRY(GroundStation),
+      FACTORY_ENTRY(GroundStationRadar),
+      FACTORY_ENTRY(GroundStationUav),
+
+      // Space Vehicles
+      FACTORY_ENTRY(MannedSpaceVehicle),
+      FACTORY_ENTRY(UnmannedSpaceVehicle),
+      FACTORY_ENTRY(BoosterSpaceVehicle),
+
+      // System
+      FACTORY_ENTRY(System),
+      FACTORY_ENTRY(AvionicsPod),
+
+      // Basic Pilot types
+      FACTORY_ENTRY(Pilot),
+      FACTORY_ENTRY(Autopilot),
+
+      // Navigation types
+      FACTORY_ENTRY(Navigation),
+      FACTORY_ENTRY(Ins),
+      FACTORY_ENTRY(Gps),
+      FACTORY_ENTRY(Route),
+      FACTORY_ENTRY(Steerpoint),
+
+      // Target Data
+      FACTORY_ENTRY(TargetData),
+
+      // Bullseye
+      FACTORY_ENTRY(Bullseye),
+
+      // Actions
+      FACTORY_ENTRY(ActionImagingSar),
+      FACTORY_ENTRY(ActionWeaponRelease),
+      FACTORY_ENTRY(ActionDecoyRelease),
+      FACTORY_ENTRY(ActionCamouflageType),
+
+      // Bombs and Missiles
+      FACTORY_ENTRY(Bomb),
+      FACTORY_ENTRY(Missile),
+      FACTORY_ENTRY(Aam),
+      FACTORY_ENTRY(Agm),
+      FACTORY_ENTRY(Sam),
+
+      // Effects
+      FACTORY_ENTRY(Chaff),
+      FACTORY_ENTRY(Decoy),
+      FACTORY_ENTRY(Flare),
+
+      // Stores, stores manager and external stores (FuelTank, Gun & Bullets (used by the Gun))
+      FACTORY_ENTRY(Stores),
+      FACTORY_ENTRY(SimpleStoresMgr),
+      FACTORY_ENTRY(FuelTank),
+      FACTORY_ENTRY(Gun),
+      FACTORY_ENTRY(Bullet),
+
+      // Data links
+      FACTORY_ENTRY(Datalink),
+
+      // Gimbals, Antennas and Optics
+      FACTORY_ENTRY(Gimbal),
+      FACTORY_ENTRY(ScanGimbal),
+      FACTORY_ENTRY(StabilizingGimbal),
+      FACTORY_ENTRY(Antenna),
+      FACTORY_ENTRY(IrSeeker),
+
+      // R/F Signatures
+      FACTORY_ENTRY(SigConstant),
+      FACTORY_ENTRY(SigSphere),
+      FACTORY_ENTRY(SigPlate),
+      FACTORY_ENTRY(SigDihedralCR),
+      FACTORY_ENTRY(SigTrihedralCR),
+      FACTORY_ENTRY(SigSwitch),
+      FACTORY_ENTRY(SigAzEl),
+      // IR Signatures
+      FACTORY_ENTRY(IrSignature),
+      FACTORY_ENTRY(AircraftIrSignature),
+      FACTORY_ENTRY(IrShape),
+      FACTORY_ENTRY(IrSphere),
+      FACTORY_ENTRY(IrBox),
+      // Onboard Computers
+      FACTORY_ENTRY(OnboardComputer),
+      // Radios
+      FACTORY_ENTRY(Radio),
+      FACTORY_ENTRY(CommRadio),
+      FACTORY_ENTRY(Iff),
+      // Sensors
+      FACTORY_ENTRY(RfSensor),
+      FACTORY_ENTRY(SensorMgr),
+      FACTORY_ENTRY(Radar),
+      FACTORY_ENTRY(Rwr),
+      FACTORY_ENTRY(Sar),
+      FACTORY_ENTRY(Jammer),
+      FACTORY_ENTRY(IrSensor),
+      FACTORY_ENTRY(MergingIrSensor),
+
+      // Tracks
+      FACTORY_ENTRY(Track),
+
+      // Track Managers
+      FACTORY_ENTRY(GmtiTrkMgr),
+      FACTORY_ENTRY(AirTrkMgr),
+      FACTORY_ENTRY(RwrTrkMgr),
+      FACTORY_ENTRY(AirAngleOnlyTrkMgr),
+
+      // UBF Agents
+      FACTORY_ENTRY(SimAgent),
+      FACTORY_ENTRY(MultiActorAgent),
+
+      // Collision detection component
+      FACTORY_ENTRY(CollisionDetect)
+   };
+
+   return table.create(name);
 }
 
 }
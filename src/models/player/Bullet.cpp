@@ -1,11 +1,13 @@
 
 #include "openeaagles/models/player/Bullet.hpp"
 #include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
 
 #include "openeaagles/base/List.hpp"
 #include "openeaagles/base/PairStream.hpp"
 
 #include <cmath>
+#include <vector>
 
 namespace oe {
 namespace models {
@@ -16,6 +18,8 @@ EMPTY_SERIALIZER(Bullet)
 // Default Parameters
 const double Bullet::DEFAULT_MUZZLE_VEL = 1000.0f;     // Meters / second
 const double Bullet::DEFAULT_MAX_TOF = 3.0f;           // Seconds
+const double Bullet::HIT_RANGE = 10.0;                 // Meters
+const double Bullet::CLOSE_RANGE = 1.0;                // Meters
 
 int Bullet::getCategory() const               { return (GRAVITY); }
 const char* Bullet::getDescription() const    { return "Bullets"; }
@@ -38,14 +42,16 @@ void Bullet::copyData(const Bullet& org, const bool)
    nbt = 0;
    hitPlayer = nullptr;
 
-   for (int i = 0; i < MBT; i++) {
-      bursts[i].bPos = org.bursts[i].bPos;
-      bursts[i].bVel = org.bursts[i].bVel;
-      bursts[i].bTof = org.bursts[i].bTof;
-      bursts[i].bNum = org.bursts[i].bNum;
-      bursts[i].bRate = org.bursts[i].bRate;
-      bursts[i].bEvent = org.bursts[i].bEvent;
-   }
+   bx = org.bx;
+   by = org.by;
+   bz = org.bz;
+   bvx = org.bvx;
+   bvy = org.bvy;
+   bvz = org.bvz;
+   bTof = org.bTof;
+   bNum = org.bNum;
+   bRate = org.bRate;
+   bEvent = org.bEvent;
 }
 
 void Bullet::deleteData()
@@ -79,9 +85,10 @@ void Bullet::weaponDynamics(const double dt)
       if (nbt > 0) {
 
          // We control the position and altitude!
-         setPosition( bursts[0].bPos[0], bursts[0].bPos[1], bursts[0].bPos[2], true );
+         setPosition( bx[0], by[0], bz[0], true );
 
-         setVelocity( bursts[0].bVel );
+         const base::Vec3d vel(bvx[0], bvy[0], bvz[0]);
+         setVelocity( vel );
 
          setAcceleration( 0, 0, 0 );
 
@@ -89,7 +96,7 @@ void Bullet::weaponDynamics(const double dt)
 
          setAngularVelocities( 0, 0, 0 );
 
-         setVelocityBody ( bursts[0].bVel.length(), 0, 0 );
+         setVelocityBody ( vel.length(), 0, 0 );
       }
    }
 }
@@ -106,13 +113,14 @@ void Bullet::updateTOF(const double)
       int n = 0;
       int nhits = 0;
       for (int i = 0; i < nbt; i++) {
-         if (bursts[i].bStatus == Burst::ACTIVE) {
+         if (bStatus[i] == BURST_ACTIVE) {
             n++;
-            if ( bursts[i].bTof >= getMaxTOF() ) {
-               bursts[i].bStatus = Burst::MISS;
+            if ( bTof[i] >= getMaxTOF() ) {
+               bStatus[i] = BURST_MISS;
+               bActive[i] = 0.0;
             }
          }
-         else if (bursts[i].bStatus == Burst::HIT) {
+         else if (bStatus[i] == BURST_HIT) {
             nhits++;
          }
       }
@@ -128,7 +136,7 @@ void Bullet::updateTOF(const double)
             setDetonationResults( DETONATE_NONE );
          }
          // final time of flight (slave to the first burst)
-         setTOF( bursts[0].bTof );
+         setTOF( bTof[0] );
       }
    }
 }
@@ -139,6 +147,7 @@ void Bullet::updateTOF(const double)
 void Bullet::resetBurstTrajectories()
 {
    nbt = 0;
+   bActive.fill(0.0);
 }
 
 //------------------------------------------------------------------------------
@@ -147,13 +156,21 @@ void Bullet::resetBurstTrajectories()
 bool Bullet::burstOfBullets(const base::Vec3d* const pos, const base::Vec3d* const vel, const int num, const int rate, const int e)
 {
    if (nbt < MBT && pos != nullptr && vel != nullptr) {
-      bursts[nbt].bPos = *pos;  // Burst positions -- world  (m)
-      bursts[nbt].bVel = *vel;  // Burst velocities -- world (m)
-      bursts[nbt].bTof = 0;    // Burst time of flight      (sec)
-      bursts[nbt].bNum = num;  // Number of rounds in burst
-      bursts[nbt].bRate = rate;// Round rate for this burst (rds per sec)
-      bursts[nbt].bEvent = e;  // Release event number for burst
-      bursts[nbt].bStatus = Burst::ACTIVE;
+      bx[nbt] = pos->x();      // Burst positions -- NED  (m)
+      by[nbt] = pos->y();
+      bz[nbt] = pos->z();
+      bx0[nbt] = pos->x();
+      by0[nbt] = pos->y();
+      bz0[nbt] = pos->z();
+      bvx[nbt] = vel->x();     // Burst velocities -- NED (m)
+      bvy[nbt] = vel->y();
+      bvz[nbt] = vel->z();
+      bTof[nbt] = 0;           // Burst time of flight      (sec)
+      bNum[nbt] = num;         // Number of rounds in burst
+      bRate[nbt] = rate;       // Round rate for this burst (rds per sec)
+      bEvent[nbt] = e;         // Release event number for burst
+      bStatus[nbt] = BURST_ACTIVE;
+      bActive[nbt] = 1.0;
       nbt++;
    }
    return true;
@@ -166,90 +183,174 @@ void Bullet::updateBurstTrajectories(const double dt)
 {
    static const double g = base::ETHG * base::distance::FT2M;      // Acceleration of Gravity (m/s/s)
 
-   // For all active bursts
-   for (int i = 0; i < nbt; i++) {
-      if (bursts[i].bStatus == Burst::ACTIVE) {
-         bursts[i].bVel[Player::IDOWN] = bursts[i].bVel[Player::IDOWN] + (g*dt);  // falling bullets
-
-         bursts[i].bPos = bursts[i].bPos + (bursts[i].bVel * dt);
-         bursts[i].bTof += dt;
-      }
+   // All MBT bursts in one branch free loop (a fixed count, so it's
+   // vectorized); the inactive and unused bursts are scaled by zero, so
+   // they don't move.
+   for (int i = 0; i < MBT; i++) {
+      const double dta = dt * bActive[i];
+      bx0[i] = bx[i];
+      by0[i] = by[i];
+      bz0[i] = bz[i];
+      bvz[i] += (g * dta);     // falling bullets
+      bx[i] += (bvx[i] * dta);
+      by[i] += (bvy[i] * dta);
+      bz[i] += (bvz[i] * dta);
+      bTof[i] += dta;
    }
+   bdt = dt;
 }
 
 //------------------------------------------------------------------------------
-// checkForTargetHit() -- check to see if we hit anything
+// checkForTargetHit() -- check to see if we hit anything; the segments that
+// the active bursts traveled during the last update are checked.
 //------------------------------------------------------------------------------
 bool Bullet::checkForTargetHit()
 {
    Player* ownship = getLaunchVehicle();
    Player* tgt = getTargetPlayer();
    if (ownship != nullptr && tgt != nullptr) {
-      base::Vec3d osPos = tgt->getPosition();
+
+      // Target position, now and at the start of the update
+      const base::Vec3d tp1 = tgt->getPosition();
+      const base::Vec3d tp0 = tp1 - (tgt->getVelocity() * bdt);
+      const double hr2 = HIT_RANGE * HIT_RANGE;
 
       // For all active bursts ...
       for (int i = 0; i < nbt; i++) {
-         if (bursts[i].bStatus == Burst::ACTIVE) {
+         if (bStatus[i] == BURST_ACTIVE) {
+
+            // The burst's segment relative to the target: a + d*s, [ 0 .. 1 ]
+            const double ax = bx0[i] - tp0.x();
+            const double ay = by0[i] - tp0.y();
+            const double az = bz0[i] - tp0.z();
+            const double dx = (bx[i] - tp1.x()) - ax;
+            const double dy = (by[i] - tp1.y()) - ay;
+            const double dz = (bz[i] - tp1.z()) - az;
+
+            // Closest point to the target
+            const double dd = (dx*dx + dy*dy + dz*dz);
+            double sc = 1.0;
+            if (dd > 0) {
+               sc = -(ax*dx + ay*dy + az*dz) / dd;
+               if (sc < 0) sc = 0;
+               else if (sc > 1) sc = 1;
+            }
+            const double cx = ax + dx*sc;
+            const double cy = ay + dy*sc;
+            const double cz = az + dz*sc;
+            const double r2 = (cx*cx + cy*cy + cz*cz);
 
             // Check if we're within range of the target
-            base::Vec3d rPos = bursts[i].bPos - osPos;
-            double rng = rPos.length();
-            if (rng < 10.0) {
+            if (r2 < hr2) {
                // Yes -- it's a hit!
-               bursts[i].bStatus = Burst::HIT;
-               setHitPlayer(tgt);
-               setLocationOfDetonation();
-               tgt->processDetonation(rng,this);
+               burstHit(i, tgt, std::sqrt(r2));
             }
-
          }
       }
    }
-   // if we are just flying along, check our range to the nearest player and tell him we killed it
+
+   // if we are just flying along, check the range to the life forms and tell them we hit them
    else {
-        //base::Vec3 old = getEulerAngles();
-        base::Vec3d myPos = getPosition();
-        base::Vec3d tgtPos;
-        base::Vec3d vecPos;
-        //double az = 0;
-        //double el = 0;
-        double range = 0;
-        //double diffAz = 0;
-        //double diffEl = 0;
-        double maxRange = 1; // close range of detonation
-        WorldModel* sim = getWorldModel();
-        if (sim != nullptr) {
-            base::PairStream* players = sim->getPlayers();
-            if (players != nullptr) {
-                base::List::Item* item = players->getFirstItem();
-                while (item != nullptr) {
-                    const auto pair = static_cast<base::Pair*>(item->getValue());
-                    if (pair != nullptr) {
-                        const auto player = dynamic_cast<Player*>(pair->object());
-                        if (player != nullptr && player != ownship && player->isMajorType(LIFE_FORM) && !player->isDestroyed()) {
-                            // ok, calculate our position from this guy
-                            tgtPos = player->getPosition();
-                            vecPos = tgtPos - myPos;
-                            //az = std::atan2(vecPos.y(), vecPos.x());
-                            range = (vecPos.x() * vecPos.x() + vecPos.y() * vecPos.y());
-                            range = std::sqrt(range);
-                            if (range < maxRange) {
-                                // tell this target we hit it
-                                player->processDetonation(range, this);
-                            }
-                        }
-                    }
-                    item = item->getNext();
-                }
-                players->unref();
-                players = nullptr;
+      WorldModel* sim = getWorldModel();
+      base::PairStream* players = (sim != nullptr ? sim->getPlayers() : nullptr);
+      if (players != nullptr && nbt > 0) {
+
+         // Horizontal bounds of the active burst segments
+         bool active = false;
+         double xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+         for (int i = 0; i < nbt; i++) {
+            if (bStatus[i] == BURST_ACTIVE) {
+               const double x0 = std::fmin(bx0[i], bx[i]);
+               const double x1 = std::fmax(bx0[i], bx[i]);
+               const double y0 = std::fmin(by0[i], by[i]);
+               const double y1 = std::fmax(by0[i], by[i]);
+               if (!active || x0 < xmin) xmin = x0;
+               if (!active || x1 > xmax) xmax = x1;
+               if (!active || y0 < ymin) ymin = y0;
+               if (!active || y1 > ymax) ymax = y1;
+               active = true;
             }
-        }
+         }
 
+         // ---
+         // Candidate players, in player list order: the players that could be
+         // within range of the bounds of the burst segments, from the world
+         // model's spatial index (horizontal query), if it was built from this
+         // player list; otherwise all of the players on the list.  Either way,
+         // they're then checked against the bounds of the burst segments.
+         // ---
+         static thread_local std::vector<Player*> tgts;
+         tgts.clear();
+         const PlayerSpatialIndex* const index = sim->getPlayerSpatialIndex();
+         if (active && index != nullptr && index->isIndexing(players)) {
+            const base::Vec3d center((xmin + xmax) * 0.5, (ymin + ymax) * 0.5, 0.0);
+            const double r = 0.5 * std::sqrt((xmax - xmin)*(xmax - xmin) + (ymax - ymin)*(ymax - ymin)) + CLOSE_RANGE;
+            static thread_local std::vector<unsigned int> candidates;
+            const unsigned int nc = index->queryHorizontal(center, r, sim->getExecTimeSec(), &candidates);
+            for (unsigned int i = 0; i < nc; i++) {
+               tgts.push_back( index->getPlayer(candidates[i]) );
+            }
+         }
+         else if (active) {
+            for (base::List::Item* item = players->getFirstItem(); item != nullptr; item = item->getNext()) {
+               const auto pair = static_cast<base::Pair*>(item->getValue());
+               tgts.push_back( static_cast<Player*>(pair->object()) );
+            }
+         }
+         if (index != nullptr) index->unref();
+
+         const double cr2 = CLOSE_RANGE * CLOSE_RANGE;
+         for (unsigned int k = 0; k < tgts.size(); k++) {
+            Player* const player = tgts[k];
+            if (player != ownship && player->isMajorType(LIFE_FORM) && !player->isDestroyed()) {
+
+               // Horizontal range to the burst segments
+               const base::Vec3d tgtPos = player->getPosition();
+               if (tgtPos.x() < (xmin - CLOSE_RANGE) || tgtPos.x() > (xmax + CLOSE_RANGE) ||
+                   tgtPos.y() < (ymin - CLOSE_RANGE) || tgtPos.y() > (ymax + CLOSE_RANGE)) continue;
+
+               for (int i = 0; i < nbt; i++) {
+                  if (bStatus[i] == BURST_ACTIVE) {
+                     const double ax = bx0[i] - tgtPos.x();
+                     const double ay = by0[i] - tgtPos.y();
+                     const double dx = bx[i] - bx0[i];
+                     const double dy = by[i] - by0[i];
+                     const double dd = (dx*dx + dy*dy);
+                     double sc = 1.0;
+                     if (dd > 0) {
+                        sc = -(ax*dx + ay*dy) / dd;
+                        if (sc < 0) sc = 0;
+                        else if (sc > 1) sc = 1;
+                     }
+                     const double cx = ax + dx*sc;
+                     const double cy = ay + dy*sc;
+                     const double r2 = (cx*cx + cy*cy);
+                     if (r2 < cr2) {
+                        // tell this player we hit it
+                        burstHit(i, player, std::sqrt(r2));
+                     }
+                  }
+               }
+            }
+         }
+      }
+      if (players != nullptr) players->unref();
    }
    return false;
 }
 
+//------------------------------------------------------------------------------
+// burstHit() -- burst 'i' hit player 'p' at range 'range' (meters)
+//------------------------------------------------------------------------------
+void Bullet::burstHit(const int i, Player* const p, const double range)
+{
+   bStatus[i] = BURST_HIT;
+   bActive[i] = 0.0;
+   setHitPlayer(p);
+   setLocationOfDetonation();
+   p->processDetonation(range, this);
+}
+
 //------------------------------------------------------------------------------
 // setHitPlayer() -- set a pointer to the player we just hit
 //------------------------------------------------------------------------------
@@ -133,35 +133,11 @@ void Antenna::process(const double dt)
 
    // ---
    // Recycle emissions ...
-   // Update emission queues: from 'in-use' to 'free'
+   // Sweep the emission pool: returned emissions are cleared and freed
    // ---
    if (recycle) {
-      unsigned int n = inUseEmQueue.entries();
-
-      for (unsigned int i = 0; i < n; i++) {
-
-         base::lock(inUseEmLock);
-         Emission* em = inUseEmQueue.get();
-         base::unlock(inUseEmLock);
-
-         if (em != nullptr && em->getRefCount() > 1) {
-            // Others are still referencing the emission, put back on in-use queue
-            base::lock(inUseEmLock);
-            inUseEmQueue.put(em);
-            base::unlock(inUseEmLock);
-         }
-
-         else if (em != nullptr && em->getRefCount() <= 1) {
-            // No one else is referencing the emission, push to the free stack
-            em->clear();
-            base::lock(freeEmLock);
-            if (freeEmStack.isNotFull()) freeEmStack.push(em);
-            else em->unref();
-            base::unlock(freeEmLock);
-         }
-      }
+      emPool.sweep();
    }
-
 }
 
 
@@ -181,21 +157,7 @@ bool Antenna::setSystem(RfSystem* const s)
 //------------------------------------------------------------------------------
 void Antenna::clearQueues()
 {
-   base::lock(freeEmLock);
-   Emission* em = freeEmStack.pop();
-   while (em != nullptr) {
-      em->unref();
-      em = freeEmStack.pop();
-   }
-   base::unlock(freeEmLock);
-
-   base::lock(inUseEmLock);
-   em = inUseEmQueue.get();
-   while (em != nullptr) {
-      em->unref();
-      em = inUseEmQueue.get();
-   }
-   base::unlock(inUseEmLock);
+   emPool.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -493,28 +455,15 @@ void Antenna::rfTransmit(Emission* const xmit)
          // Only of power exceeds an optional threshold
          if (erp[i] > threshold) {
 
-            // Get a free emission packet
+            // Get a free emission packet (a copy of the template emission)
             Emission* em(nullptr);
-            if (recycle) {
-               base::lock(freeEmLock);
-               em = freeEmStack.pop();
-               base::unlock(freeEmLock);
-            }
-
-            bool cloned = false;
-            if (em == nullptr) {
-               // Otherwise, clone a new one
-               em = xmit->clone();
-               cloned = true;
-            }
+            if (recycle) em = emPool.alloc(*xmit);
+            else em = xmit->clone();
 
             // Send the emission to the other player
             if (em != nullptr) {
 
-               // a) Copy the template emission
-               if (!cloned) *em = *xmit;
-
-               // b) Set target unique data
+               // a) Set target unique data
                em->setGimbal(this);
                em->setOwnship(ownship);
 
@@ -531,25 +480,12 @@ void Antenna::rfTransmit(Emission* const xmit)
                em->setPolarization(getPolarization());
                em->setLocalPlayersOnly( isLocalPlayersOfInterestOnly() );
 
-               // c) Send the emission to the target
+               // b) Send the emission to the target
                targets[i]->event(RF_EMISSION, em);
 
-               // d) Recycle the emission (we don't bother)
-               //bool recycled = false;
-               //if (recycle) {
-               //   base::lock(inUseEmLock);
-               //   if (inUseEmQueue.isNotFull()) {
-                     // Store for future reference
-               //      inUseEmQueue.put(em);
-               //      recycled = true;
-               //   }
-               //   base::unlock(inUseEmLock);
-               //}
-
-               // or just forget it
-               //else {
-                  em->unref();
-               //}
+               // c) Release our reference; recycled emissions return to
+               //    the pool once the receivers have released theirs.
+               em->unref();
 
             }
             else {
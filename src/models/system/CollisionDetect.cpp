@@ -2,6 +2,7 @@
 #include "openeaagles/models/system/CollisionDetect.hpp"
 #include "openeaagles/models/player/Player.hpp"
 #include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
 
 #include "openeaagles/base/Number.hpp"
 #include "openeaagles/base/Pair.hpp"
@@ -10,6 +11,7 @@
 #include "openeaagles/base/units/Distances.hpp"
 
 #include <cmath>
+#include <vector>
 
 namespace oe {
 namespace models {
@@ -193,13 +195,38 @@ void CollisionDetect::updateData(const double dt)
    base::PairStream* plist = sim->getPlayers();
    if (plist != nullptr) {
 
-      base::List::Item* item = plist->getFirstItem();
+      // ---
+      // Candidate players, in player list order.  Use the world model's
+      // spatial index to find the players that could be within our max range;
+      // only if we have a max range and the index was built from this player
+      // list.  Otherwise, all of the players.  Skipping an out of range
+      // networked player doesn't change the local-only 'finished' check,
+      // because all players after it in the list are networked as well.
+      // ---
+      static thread_local std::vector<Player*> tgts;
+      tgts.clear();
+      const PlayerSpatialIndex* const index = sim->getPlayerSpatialIndex();
+      const bool useIndex = (maxRange2Players > 0.0 && index != nullptr && index->isIndexing(plist));
+      if (useIndex) {
+         static thread_local std::vector<unsigned int> candidates;
+         const unsigned int nc = index->query(ownPos, maxRange2Players, usingEcefFlg, sim->getExecTimeSec(), &candidates);
+         for (unsigned int i = 0; i < nc; i++) {
+            tgts.push_back( index->getPlayer(candidates[i]) );
+         }
+      }
+      if (index != nullptr) index->unref();
+      if (!useIndex) {
+         for (base::List::Item* item = plist->getFirstItem(); item != nullptr; item = item->getNext()) {
+            base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+            tgts.push_back( static_cast<Player*>(pair->object()) );
+         }
+      }
+
       bool finished = false;
-      while ( item != nullptr && !finished ) {
+      for (unsigned int i = 0; i < tgts.size() && !finished; i++) {
 
          // Get the pointer to the target player
-         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-         Player* target = static_cast<Player*>(pair->object());
+         Player* target = tgts[i];
 
          // Did we complete the local only players?
          finished = localOnly && target->isNetworkedPlayer();
@@ -265,9 +292,6 @@ void CollisionDetect::updateData(const double dt)
                }
             }
          }
-
-         // Next player ...
-         item = item->getNext();
       }
 
       // Unref the player list
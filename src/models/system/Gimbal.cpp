@@ -3,6 +3,10 @@
 #include "openeaagles/models/player/Player.hpp"
 #include "openeaagles/models/Emission.hpp"
 #include "openeaagles/models/Tdb.hpp"
+#include "openeaagles/models/WorldModel.hpp"
+
+#include "openeaagles/terrain/Terrain.hpp"
+#include "openeaagles/terrain/Viewshed.hpp"
 
 #include "openeaagles/base/Identifier.hpp"
 #include "openeaagles/base/Integer.hpp"
@@ -69,6 +73,9 @@ BEGIN_SLOTTABLE(Gimbal)
     "localPlayersOfInterestOnly",   // 34: Sets the local only players of interest flag (default: false)
     "useWorldCoordinates",          // 35: Using player of interest's world (ECEF) coordinate system
     "ownHeadingOnly",               // 36: Whether only the ownship heading is used by the target data block
+    "terrainOccultingCache",        // 37: Enable the terrain occulting results cache (default: false)
+    "viewshed",                     // 38: Enable the terrain occulting viewshed of a stationary ownship (default: false)
+    "viewshedThreshold",            // 39: Distance the ownship can move before the viewshed is rebuilt (default: 10 meters)
 END_SLOTTABLE(Gimbal)
 
 BEGIN_SLOT_MAP(Gimbal)
@@ -120,6 +127,9 @@ BEGIN_SLOT_MAP(Gimbal)
 
     ON_SLOT(35, setSlotUseWorldCoordinates, base::Number)                // Using player of interest's world (ECEF) coordinate system
     ON_SLOT(36,setSlotUseOwnHeadingOnly,base::Number)
+    ON_SLOT(37, setSlotTerrainOccultingCache, base::Number)              // Enable the terrain occulting results cache (default: false)
+    ON_SLOT(38, setSlotViewshed, base::Number)                           // Enable the terrain occulting viewshed (default: false)
+    ON_SLOT(39, setSlotViewshedThreshold, base::Distance)                // Viewshed rebuild threshold (default: 10 meters)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(Gimbal)
@@ -130,6 +140,7 @@ END_EVENT_HANDLER()
 // Static variables
 //------------------------------------------------------------------------------
 const double Gimbal::defaultTolerance = 0.1 * (base::PI/180.0);
+const double Gimbal::viewshedMaxSpeed = 0.1;
 
 Gimbal::Gimbal()
 {
@@ -182,6 +193,9 @@ void Gimbal::copyData(const Gimbal& org, const bool cc)
    maxAnglePlayers = org.maxAnglePlayers;
    localOnly = org.localOnly;
    terrainOcculting = org.terrainOcculting;
+   occultingCache = org.occultingCache;
+   viewshedEnabled = org.viewshedEnabled;
+   viewshedThreshold = org.viewshedThreshold;
    checkHorizon = org.checkHorizon;
    useWorld = org.useWorld;
    ownHeadingOnly = org.ownHeadingOnly;
@@ -189,11 +203,26 @@ void Gimbal::copyData(const Gimbal& org, const bool cc)
    maxPlayers = org.maxPlayers;
 
    tdb = nullptr;
+
+   // (our viewshed is built as needed)
+   if (viewshed != nullptr) {
+      viewshed->unref();
+      viewshed = nullptr;
+   }
+
+   // (the terrain occulting cache isn't copied)
+   occultingResults.clear();
+   occultingCacheCell = 0;
 }
 
 void Gimbal::deleteData()
 {
    tdb = nullptr;
+
+   if (viewshed != nullptr) {
+      viewshed->unref();
+      viewshed = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -215,6 +244,11 @@ bool Gimbal::shutdownNotification()
 {
     tdb = nullptr;
 
+    if (viewshed != nullptr) {
+       viewshed->unref();
+       viewshed = nullptr;
+    }
+
     return BaseClass::shutdownNotification();
 }
 
@@ -532,6 +566,51 @@ bool Gimbal::setTerrainOccultingEnabled(const bool flg)
    return true;
 }
 
+// Sets the terrain occulting cache enabled flag
+bool Gimbal::setTerrainOccultingCacheEnabled(const bool flg)
+{
+   occultingCache = flg;
+   return true;
+}
+
+// Sets the terrain occulting viewshed enabled flag
+bool Gimbal::setViewshedEnabled(const bool flg)
+{
+   viewshedEnabled = flg;
+   return true;
+}
+
+// Sets the distance (meters) the ownship can move before the viewshed is rebuilt
+bool Gimbal::setViewshedThreshold(const double meters)
+{
+   bool ok = false;
+   if (meters >= 0) {
+      viewshedThreshold = meters;
+      ok = true;
+   }
+   return ok;
+}
+
+// Returns the terrain occulting viewshed, if enabled and built
+const terrain::Viewshed* Gimbal::getViewshed() const
+{
+   const terrain::Viewshed* p = nullptr;
+   if (viewshedEnabled && viewshed != nullptr && viewshed->isValid()) {
+      p = viewshed;
+   }
+   return p;
+}
+
+// Returns the terrain occulting results cache for the observer cell
+std::unordered_map<unsigned long long, bool>* Gimbal::getOccultingCache(const unsigned long long osCell) const
+{
+   if (osCell != occultingCacheCell) {
+      occultingResults.clear();
+      occultingCacheCell = osCell;
+   }
+   return &occultingResults;
+}
+
 // Sets the horizon check enabled flag
 bool Gimbal::setHorizonCheckEnabled(const bool flg)
 {
@@ -1106,6 +1185,36 @@ bool Gimbal::setSlotTerrainOcculting(const base::Number* const msg)
    return ok;
 }
 
+// Enable the terrain occulting results cache (default: false)
+bool Gimbal::setSlotTerrainOccultingCache(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setTerrainOccultingCacheEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+// Enable the terrain occulting viewshed (default: false)
+bool Gimbal::setSlotViewshed(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setViewshedEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+// Viewshed rebuild threshold (default: 10 meters)
+bool Gimbal::setSlotViewshedThreshold(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setViewshedThreshold( base::Meters::convertStatic(*msg) );
+   }
+   return ok;
+}
+
 // Enable horizon masking check (default: true)
 bool Gimbal::setSlotCheckHorizon(const base::Number* const msg)
 {
@@ -1321,6 +1430,11 @@ void Gimbal::limitVec(base::Vec3d& vec, const base::Vec3d& ll, const base::Vec3d
 //------------------------------------------------------------------------------
 unsigned int Gimbal::processPlayersOfInterest(base::PairStream* const poi)
 {
+   // Keep our terrain occulting viewshed up to date
+   if (viewshedEnabled && terrainOcculting) {
+      updateViewshed();
+   }
+
    const auto tdb0 = new Tdb(maxPlayers, this);
 
    unsigned int ntgts = tdb0->processPlayers(poi);
@@ -1330,6 +1444,52 @@ unsigned int Gimbal::processPlayersOfInterest(base::PairStream* const poi)
    return ntgts;
 }
 
+//------------------------------------------------------------------------------
+// Updates the terrain occulting viewshed --- the viewshed is built at our
+// ownship's position, and is rebuilt only if the ownship moves more than
+// the threshold distance (horizontal or vertical) from where it was built.
+// The viewshed is only for a stationary ownship, so it's cleared while the
+// ownship is moving.  Returns true if the viewshed is valid.
+//------------------------------------------------------------------------------
+bool Gimbal::updateViewshed()
+{
+   const Player* const own = getOwnship();
+   if (own == nullptr) return false;
+
+   // Moving?
+   if (own->getTotalVelocity() > viewshedMaxSpeed) {
+      if (viewshed != nullptr) viewshed->clear();
+      return false;
+   }
+
+   const WorldModel* const sim = own->getWorldModel();
+   const terrain::Terrain* const terrain = (sim != nullptr ? sim->getTerrain() : nullptr);
+   if (terrain == nullptr || !terrain->isDataLoaded()) return false;
+
+   const double lat = own->getLatitude();
+   const double lon = own->getLongitude();
+   const double alt = own->getAltitudeM();
+
+   // Still close enough to where the viewshed was built?
+   if (viewshed != nullptr && viewshed->isValid()) {
+      double brg = 0.0;
+      double distNM = 0.0;
+      base::nav::fll2bd(viewshed->getRefLatitude(), viewshed->getRefLongitude(), lat, lon, &brg, &distNM);
+      const double dist = distNM * base::distance::NM2M;
+      const double dalt = std::fabs(alt - viewshed->getRefAltitude());
+      if (dist <= viewshedThreshold && dalt <= viewshedThreshold) return true;
+   }
+
+   if (viewshed == nullptr) viewshed = new terrain::Viewshed();
+
+   // Out to our max range to the players of interest, if any, otherwise
+   // out to the viewshed's max range.
+   double maxRange = terrain::Viewshed::MAX_RANGE_STEPS * terrain::Viewshed::RANGE_STEP;
+   if (maxRngPlayers > 0 && maxRngPlayers < maxRange) maxRange = maxRngPlayers;
+
+   return viewshed->build(terrain, lat, lon, alt, maxRange);
+}
+
 //------------------------------------------------------------------------------
 // Returns the current TDB (pre-ref())
 //------------------------------------------------------------------------------
@@ -104,6 +104,11 @@ void IrSeeker::reset()
 //------------------------------------------------------------------------------
 unsigned int IrSeeker::processPlayersOfInterest(base::PairStream* const poi)
 {
+   // Keep our terrain occulting viewshed up to date
+   if (isViewshedEnabled() && isTerrainOccultingEnabled()) {
+      updateViewshed();
+   }
+
    const auto tdb0 = new TdbIr(getMaxPlayersOfInterest(), this);
 
    unsigned int ntgts = tdb0->processPlayers(poi);
@@ -32,16 +32,24 @@ void Jammer::copyData(const Jammer& org, const bool)
     BaseClass::copyData(org);
 }
 
-EMPTY_DELETEDATA(Jammer)
+void Jammer::deleteData()
+{
+    if (xmitEm != nullptr) {
+        xmitEm->unref();
+        xmitEm = nullptr;
+    }
+}
 
 //------------------------------------------------------------------------------
 // transmit() -- send jam emissions
 //------------------------------------------------------------------------------
 void Jammer::transmit(const double)
 {
-    // Send the emission to the other player
+    // Send the emission to the other player; the antenna only copies the
+    // template emission, so we keep and reuse it.
     if ( !areEmissionsDisabled() && isTransmitting() ) {
-        const auto em = new Emission();
+        if (xmitEm == nullptr) xmitEm = new Emission();
+        Emission* const em = xmitEm;
         em->setFrequency(getFrequency());
         const double p = getPeakPower();
         em->setPower(p);
@@ -52,7 +60,6 @@ void Jammer::transmit(const double)
         em->setReturnRequest(false);
         em->setECM(Emission::ECM_NOISE);
         getAntenna()->rfTransmit(em);
-        em->unref();
     }
 }
 
@@ -79,6 +79,11 @@ void Radar::copyData(const Radar& org, const bool)
 void Radar::deleteData()
 {
    clearTracksAndQueues();
+
+   if (xmitEm != nullptr) {
+      xmitEm->unref();
+      xmitEm = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -156,8 +161,10 @@ void Radar::transmit(const double dt)
 
    // Transmitting, scanning and have an antenna?
    if ( !areEmissionsDisabled() && isTransmitting() ) {
-      // Send the emission to the other player
-      const auto em = new Emission();
+      // Send the emission to the other player; the antenna only copies the
+      // template emission, so we keep and reuse it.
+      if (xmitEm == nullptr) xmitEm = new Emission();
+      Emission* const em = xmitEm;
       em->setFrequency(getFrequency());
       em->setBandwidth(getBandwidth());
       const double prf1 = getPRF();
@@ -173,7 +180,6 @@ void Radar::transmit(const double dt)
       em->setReturnRequest( isReceiverEnabled() );
       em->setTransmitter(this);
       getAntenna()->rfTransmit(em);
-      em->unref();
    }
 
 }
@@ -206,19 +212,12 @@ void Radar::receive(const double dt)
    // Process Returned Emissions
    // ---
 
-   Emission* em = nullptr;
-   double signal = 0;
-
-   // Get an emission from the queue
-   base::lock(packetLock);
-   if (np > 0) {
-      np--; // Decrement 'np', now the array index
-      em = packets[np];
-      signal = signals[np];
-   }
-   base::unlock(packetLock);
-
-   while (em != nullptr) {
+   // Take all of the emissions received this frame in a single batch
+   // (processed newest first)
+   EmissionBatch* const batch = takeReceivedEmissions();
+   for (unsigned int ip = batch->np; ip > 0; ip--) {
+      Emission* const em = batch->packets[ip-1];
+      double signal = batch->signals[ip-1];
 
       // exclude noise jammers (accounted for already in RfSystem::rfReceivedEmission)
       if (em->getTransmitter() == this || (em->isECM() && !em->isECMType(Emission::ECM_NOISE)) ) {
@@ -293,24 +292,10 @@ void Radar::receive(const double dt)
             base::unlock(myLock);
          }
       }
-
-      em->unref();   // this unref() undoes the ref() done by RfSystem::rfReceivedEmission
-      em = nullptr;
-
-      //if (np >= 0 && np < MAX_EMISSIONS) {
-      //    packets[np] = 0;
-      //    signals[np] = 0;
-      //}
-
-      // Get another emission from the queue
-      base::lock(packetLock);
-      if (np > 0) {
-         np--;
-         em = packets[np];
-         signal = signals[np];
-      }
-      base::unlock(packetLock);
    }
+
+   // Release the batch's emissions (undoes the ref() done by RfSystem::rfReceivedEmission)
+   releaseEmissionBatch(batch);
    //std::cout << std::endl;
 
    numberOfJammedEmissions = countNumJammedEm;
@@ -225,19 +225,12 @@ void Radio::receive(const double dt)
    // Process Emissions
    // ---
 
-   Emission* em = nullptr;
-   double signal = 0;
-
-   // Get an emission from the queue
-   base::lock(packetLock);
-   if (np > 0) {
-      np--; // Decrement 'np', now the array index
-      em = packets[np];
-      signal = signals[np];
-   }
-   base::unlock(packetLock);
-
-   while (em != nullptr) {
+   // Take all of the emissions received this frame in a single batch
+   // (processed newest first)
+   EmissionBatch* const batch = takeReceivedEmissions();
+   for (unsigned int ip = batch->np; ip > 0; ip--) {
+      Emission* const em = batch->packets[ip-1];
+      const double signal = batch->signals[ip-1];
 
 
       // Signal/Noise  (Equation 2-9)
@@ -249,19 +242,10 @@ void Radio::receive(const double dt)
          // Report this valid emission to the radio model ...
          receivedEmissionReport(em);
       }
-
-      em->unref();
-      em = nullptr;
-
-      // Get another emission from the queue
-      base::lock(packetLock);
-      if (np > 0) {
-         np--;
-         em = packets[np];
-         signal = signals[np];
-      }
-      base::unlock(packetLock);
    }
+
+   // Release the batch's emissions (undoes the ref() done by RfSystem::rfReceivedEmission)
+   releaseEmissionBatch(batch);
 }
 
 //------------------------------------------------------------------------------
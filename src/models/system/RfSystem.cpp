@@ -93,13 +93,7 @@ void RfSystem::deleteData()
 {
    setAntenna(nullptr);
    setSlotAntennaName(nullptr);
-   for (unsigned int i = 0; i < np && i < MAX_EMISSIONS; i++) {
-      if (packets[i] != nullptr) {
-         packets[i]->unref();
-         packets[i] = nullptr;
-      }
-   }
-   np = 0;
+   clearReceivedEmissions();
 }
 
 //------------------------------------------------------------------------------
@@ -109,13 +103,7 @@ bool RfSystem::shutdownNotification()
 {
    setAntenna(nullptr);
 
-   for (unsigned int i = 0; i < np && i < MAX_EMISSIONS; i++) {
-      if (packets[i] != nullptr) {
-         packets[i]->unref();
-         packets[i] = nullptr;
-      }
-   }
-   np = 0;
+   clearReceivedEmissions();
 
    return BaseClass::shutdownNotification();
 }
@@ -242,11 +230,12 @@ void RfSystem::rfReceivedEmission(Emission* const em, Antenna* const, double raG
 
          // Save packet and signal for receive()
          base::lock(packetLock);
-         if (np < MAX_EMISSIONS) {
+         EmissionBatch& batch = batches[inBatch];
+         if (batch.np < MAX_EMISSIONS) {
             em->ref();
-            packets[np] = em;
-            signals[np] = signal;
-            np++;
+            batch.packets[batch.np] = em;
+            batch.signals[batch.np] = signal;
+            batch.np++;
          }
          base::unlock(packetLock);
 
@@ -255,6 +244,42 @@ void RfSystem::rfReceivedEmission(Emission* const em, Antenna* const, double raG
 }
 
 
+//------------------------------------------------------------------------------
+// takeReceivedEmissions() -- hands off the batch of received emissions; new
+// emissions are collected in the other batch.
+//------------------------------------------------------------------------------
+RfSystem::EmissionBatch* RfSystem::takeReceivedEmissions()
+{
+   base::lock(packetLock);
+   EmissionBatch* batch = &batches[inBatch];
+   inBatch = (inBatch + 1) % batches.size();
+   base::unlock(packetLock);
+   return batch;
+}
+
+//------------------------------------------------------------------------------
+// releaseEmissionBatch() -- unref()s the batch's emissions and empties it
+//------------------------------------------------------------------------------
+void RfSystem::releaseEmissionBatch(EmissionBatch* const batch)
+{
+   if (batch == nullptr) return;
+   for (unsigned int i = 0; i < batch->np; i++) {
+      batch->packets[i]->unref();
+      batch->packets[i] = nullptr;
+   }
+   batch->np = 0;
+}
+
+// Releases the emissions in both batches
+void RfSystem::clearReceivedEmissions()
+{
+   base::lock(packetLock);
+   for (unsigned int i = 0; i < batches.size(); i++) {
+      releaseEmissionBatch(&batches[i]);
+   }
+   base::unlock(packetLock);
+}
+
 //------------------------------------------------------------------------------
 // transmitPower() -- Compute transmitter power (Part of equation 2-1)
 //------------------------------------------------------------------------------
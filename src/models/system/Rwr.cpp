@@ -87,19 +87,12 @@ void Rwr::receive(const double dt)
 
    // Process received emissions
    TrackManager* tm = getTrackManager();
-   Emission* em = nullptr;
-   double signal = 0;
-
-   // Get an emission from the queue
-   base::lock(packetLock);
-   if (np > 0) {
-      np--; // Decrement 'np', now the array index
-      em = packets[np];
-      signal = signals[np];
-   }
-   base::unlock(packetLock);
-
-   while (em != nullptr) {
+   // Take all of the emissions received this frame in a single batch
+   // (processed newest first)
+   EmissionBatch* const batch = takeReceivedEmissions();
+   for (unsigned int ip = batch->np; ip > 0; ip--) {
+      Emission* const em = batch->packets[ip-1];
+      const double signal = batch->signals[ip-1];
 
       //std::cout << "Rwr::receive(" << em->getOwnship() << "): ";
       //std::cout << " pwr=" << em->getPower();
@@ -145,23 +138,11 @@ void Rwr::receive(const double dt)
             rptQueue.put(em);
          }
       }
-
-      // finished
-      em->unref();   // this unref() undoes the ref() done by RfSystem::rfReceivedEmission
-      em = nullptr;
-
-
-      // Get another emission from the queue
-      base::lock(packetLock);
-      if (np > 0) {
-         np--;
-         em = packets[np];
-         signal = signals[np];
-      }
-      base::unlock(packetLock);
-
    }
 
+   // Release the batch's emissions (undoes the ref() done by RfSystem::rfReceivedEmission)
+   releaseEmissionBatch(batch);
+
    // Transfer the rays
    xferRays();
 }
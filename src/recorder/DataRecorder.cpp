@@ -1026,10 +1026,11 @@ void DataRecorder::sendDataRecord(pb::DataRecord* const msg)
          fileIdMsg->set_subject_num(getSubjectNum());
          fileIdMsg->set_year(getYear());
 
-         // Create a handle and send the message to be processed
+         // Create a handle and queue the message ahead of this one, so it's
+         // processed by the same thread as the other records
          const auto h = new DataRecordHandle(msg);
 
-         outputHandler->processRecord(h);
+         outputHandler->addToQueue(h);
          h->unref();
 
       }
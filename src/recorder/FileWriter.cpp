@@ -56,6 +56,8 @@ void FileWriter::deleteData()
    }
    sout = nullptr;
 
+   if (obuf != nullptr) { delete[] obuf; obuf = nullptr; }
+
    setFilename(nullptr);
    setPathName(nullptr);
 }
@@ -66,7 +68,9 @@ void FileWriter::deleteData()
 //------------------------------------------------------------------------------
 bool FileWriter::shutdownNotification()
 {
-   // Close the file, if it's still open
+   // Write the records still queued for the writer thread, then
+   // close the file, if it's still open
+   stopWriterThread();
    if (isOpen()) closeFile();
 
    return BaseClass::shutdownNotification();
@@ -201,6 +205,13 @@ bool FileWriter::openFile()
          //---
          if (sout == nullptr) sout = new std::ofstream();
 
+         //---
+         // Use a large output buffer, so the records are written in large
+         // blocks (set before opening the file)
+         //---
+         if (obuf == nullptr) obuf = new char[OUTPUT_BUFFER_SIZE];
+         sout->rdbuf()->pubsetbuf(obuf, OUTPUT_BUFFER_SIZE);
+
          //---
          // Open the file (binary output mode)
          //---
@@ -218,6 +229,16 @@ bool FileWriter::openFile()
             tFailed = true;
          }
 
+         // Write the file header
+         else if (!writeHeader()) {
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "FileWriter::openFile(): Failed to write the file header: " << fullname << std::endl;
+            }
+            sout->close();
+            tOpened = false;
+            tFailed = true;
+         }
+
       }
 
       delete[] fullname;
@@ -263,7 +284,10 @@ void FileWriter::closeFile()
          handle = nullptr;
       }
 
-      // now close the file
+      // write the file trailer and close the file
+      if (!writeTrailer() && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+         std::cerr << "FileWriter::closeFile(): Failed to write the file trailer: " << getFullFilename() << std::endl;
+      }
       sout->close();
       fileOpened = false;
       fileFailed = false;
@@ -293,40 +317,8 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       // The DataRecord to be sent
       const pb::DataRecord* dataRecord = handle->getRecord();
 
-      // Serialize the DataRecord
-      std::string wireFormat;
-      bool ok = dataRecord->SerializeToString(&wireFormat);
-
-      // Write the serialized DataRecord with its length to the file
-      if (ok) {
-         unsigned int n = wireFormat.length();
-
-         // Convert size to an integer string
-         char nbuff[8];
-         std::sprintf(nbuff, "%04d", n);
-
-         // Convert the leading zeros to spaces
-         if (nbuff[0] == '0') {
-            nbuff[0] = ' ';
-            if (nbuff[1] == '0') {
-               nbuff[1] = ' ';
-               if (nbuff[2] == '0') {
-                  nbuff[2] = ' ';
-               }
-            }
-         }
-
-         // Write the size of the serialized DataRecord as an ascii string
-         sout->write(nbuff, 4);
-
-         // Write the serialized DataRecord
-         sout->write( wireFormat.c_str(), n );
-      }
-
-      else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-         // If we had an error serializing the DataRecord
-         std::cerr << "FileWriter::processRecordImp() -- SerializeToString() error" << std::endl;
-      }
+      // Serialize and write the DataRecord
+      writeRecord(dataRecord);
 
       // Check for END_OF_DATA message
       thisIsEodMsg = (dataRecord->id() == REID_END_OF_DATA);
@@ -343,6 +335,62 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// File format: the data file is a sequence of serialized data records, each
+// preceded by its size as a 4 character ascii string.  There's no file
+// header or trailer.
+//------------------------------------------------------------------------------
+bool FileWriter::writeHeader()
+{
+   return true;
+}
+
+bool FileWriter::writeRecord(const pb::DataRecord* const dataRecord)
+{
+   // Serialize the DataRecord
+   std::string wireFormat;
+   bool ok = dataRecord->SerializeToString(&wireFormat);
+
+   // Write the serialized DataRecord with its length to the file
+   if (ok) {
+      unsigned int n = wireFormat.length();
+
+      // Convert size to an integer string
+      char nbuff[8];
+      std::sprintf(nbuff, "%04d", n);
+
+      // Convert the leading zeros to spaces
+      if (nbuff[0] == '0') {
+         nbuff[0] = ' ';
+         if (nbuff[1] == '0') {
+            nbuff[1] = ' ';
+            if (nbuff[2] == '0') {
+               nbuff[2] = ' ';
+            }
+         }
+      }
+
+      // Write the size of the serialized DataRecord as an ascii string
+      sout->write(nbuff, 4);
+
+      // Write the serialized DataRecord
+      sout->write( wireFormat.c_str(), n );
+   }
+
+   else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+      // If we had an error serializing the DataRecord
+      std::cerr << "FileWriter::writeRecord() -- SerializeToString() error" << std::endl;
+   }
+
+   return ok;
+}
+
+bool FileWriter::writeTrailer()
+{
+   return true;
+}
+
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -0,0 +1,208 @@
+#include "openeaagles/recorder/IndexedFileFormat.hpp"
+
+#ifdef OE_RECORDER_LZ4
+#include <lz4.h>
+#endif
+
+#include <cstring>
+
+namespace oe {
+namespace recorder {
+
+const char IndexedFileFormat::FILE_MAGIC[8]   = { 'O', 'E', 'R', 'E', 'C', 'I', 'D', 'X' };
+const char IndexedFileFormat::FOOTER_MAGIC[8] = { 'O', 'E', 'R', 'E', 'C', 'E', 'N', 'D' };
+const char IndexedFileFormat::BLOCK_MARKER[4] = { 'O', 'E', 'B', 'K' };
+const char IndexedFileFormat::INDEX_MARKER[4] = { 'O', 'E', 'I', 'X' };
+
+//------------------------------------------------------------------------------
+// Encoders
+//------------------------------------------------------------------------------
+void IndexedFileFormat::putVarint(std::string* const buf, const unsigned long long v)
+{
+   unsigned long long x = v;
+   while (x >= 0x80) {
+      buf->push_back( static_cast<char>((x & 0x7f) | 0x80) );
+      x >>= 7;
+   }
+   buf->push_back( static_cast<char>(x) );
+}
+
+void IndexedFileFormat::putUInt32(std::string* const buf, const unsigned int v)
+{
+   for (unsigned int i = 0; i < 4; i++) {
+      buf->push_back( static_cast<char>((v >> (i * 8)) & 0xff) );
+   }
+}
+
+void IndexedFileFormat::putUInt64(std::string* const buf, const unsigned long long v)
+{
+   for (unsigned int i = 0; i < 8; i++) {
+      buf->push_back( static_cast<char>((v >> (i * 8)) & 0xff) );
+   }
+}
+
+void IndexedFileFormat::putDouble(std::string* const buf, const double v)
+{
+   unsigned long long bits = 0;
+   std::memcpy(&bits, &v, sizeof(bits));
+   putUInt64(buf, bits);
+}
+
+void IndexedFileFormat::putBlockInfo(std::string* const buf, const BlockInfo& info, const bool withOffset)
+{
+   if (withOffset) putVarint(buf, info.offset);
+   putVarint(buf, info.rawSize);
+   putVarint(buf, info.packedSize);
+   putVarint(buf, info.numRecords);
+   putDouble(buf, info.minSimTime);
+   putDouble(buf, info.maxSimTime);
+   putVarint(buf, info.ids.size());
+   for (unsigned int i = 0; i < info.ids.size(); i++) {
+      putVarint(buf, info.ids[i]);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Decoders
+//------------------------------------------------------------------------------
+bool IndexedFileFormat::getVarint(const char** const p, const char* const end, unsigned long long* const v)
+{
+   unsigned long long x = 0;
+   unsigned int shift = 0;
+   bool done = false;
+   const char* q = *p;
+   while (!done && q < end && shift < 64) {
+      const unsigned char b = static_cast<unsigned char>(*q++);
+      x |= (static_cast<unsigned long long>(b & 0x7f) << shift);
+      shift += 7;
+      done = ((b & 0x80) == 0);
+   }
+   if (done) {
+      *p = q;
+      *v = x;
+   }
+   return done;
+}
+
+bool IndexedFileFormat::getUInt32(const char** const p, const char* const end, unsigned int* const v)
+{
+   bool ok = (end - *p) >= 4;
+   if (ok) {
+      unsigned int x = 0;
+      for (unsigned int i = 0; i < 4; i++) {
+         x |= (static_cast<unsigned int>(static_cast<unsigned char>((*p)[i])) << (i * 8));
+      }
+      *p += 4;
+      *v = x;
+   }
+   return ok;
+}
+
+bool IndexedFileFormat::getUInt64(const char** const p, const char* const end, unsigned long long* const v)
+{
+   bool ok = (end - *p) >= 8;
+   if (ok) {
+      unsigned long long x = 0;
+      for (unsigned int i = 0; i < 8; i++) {
+         x |= (static_cast<unsigned long long>(static_cast<unsigned char>((*p)[i])) << (i * 8));
+      }
+      *p += 8;
+      *v = x;
+   }
+   return ok;
+}
+
+bool IndexedFileFormat::getDouble(const char** const p, const char* const end, double* const v)
+{
+   unsigned long long bits = 0;
+   bool ok = getUInt64(p, end, &bits);
+   if (ok) std::memcpy(v, &bits, sizeof(bits));
+   return ok;
+}
+
+bool IndexedFileFormat::getBlockInfo(const char** const p, const char* const end, BlockInfo* const info, const bool withOffset)
+{
+   unsigned long long offset = 0;
+   unsigned long long rawSize = 0;
+   unsigned long long packedSize = 0;
+   unsigned long long numRecords = 0;
+   unsigned long long numIds = 0;
+
+   bool ok = true;
+   if (withOffset) ok = getVarint(p, end, &offset);
+   ok = ok && getVarint(p, end, &rawSize) && rawSize <= MAX_BLOCK_SIZE;
+   ok = ok && getVarint(p, end, &packedSize) && packedSize <= MAX_BLOCK_SIZE;
+   ok = ok && getVarint(p, end, &numRecords) && numRecords <= rawSize;
+   ok = ok && getDouble(p, end, &info->minSimTime);
+   ok = ok && getDouble(p, end, &info->maxSimTime);
+   ok = ok && getVarint(p, end, &numIds) && numIds <= static_cast<unsigned long long>(end - *p);
+
+   if (ok) {
+      info->offset = offset;
+      info->rawSize = static_cast<unsigned int>(rawSize);
+      info->packedSize = static_cast<unsigned int>(packedSize);
+      info->numRecords = static_cast<unsigned int>(numRecords);
+      info->ids.resize(static_cast<unsigned int>(numIds));
+      for (unsigned int i = 0; ok && i < info->ids.size(); i++) {
+         unsigned long long id = 0;
+         ok = getVarint(p, end, &id);
+         info->ids[i] = static_cast<unsigned int>(id);
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Block data compression (LZ4, if enabled)
+//------------------------------------------------------------------------------
+#ifdef OE_RECORDER_LZ4
+
+bool IndexedFileFormat::isCompressionAvailable()
+{
+   return true;
+}
+
+bool IndexedFileFormat::compress(const std::string& in, std::string* const out)
+{
+   bool ok = false;
+   const int n = static_cast<int>(in.size());
+   const int bound = LZ4_compressBound(n);
+   if (bound > 0) {
+      out->resize(static_cast<unsigned int>(bound));
+      const int m = LZ4_compress_default(in.data(), &(*out)[0], n, bound);
+      if (m > 0) {
+         out->resize(static_cast<unsigned int>(m));
+         ok = true;
+      }
+   }
+   return ok;
+}
+
+bool IndexedFileFormat::decompress(const char* const in, const unsigned int n, const unsigned int rawSize, std::string* const out)
+{
+   out->resize(rawSize);
+   const int m = LZ4_decompress_safe(in, &(*out)[0], static_cast<int>(n), static_cast<int>(rawSize));
+   return (m >= 0 && static_cast<unsigned int>(m) == rawSize);
+}
+
+#else
+
+bool IndexedFileFormat::isCompressionAvailable()
+{
+   return false;
+}
+
+bool IndexedFileFormat::compress(const std::string&, std::string* const)
+{
+   return false;
+}
+
+bool IndexedFileFormat::decompress(const char* const, const unsigned int, const unsigned int, std::string* const)
+{
+   return false;
+}
+
+#endif
+
+}
+}
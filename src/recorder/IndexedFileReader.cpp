@@ -0,0 +1,407 @@
+#include "openeaagles/recorder/IndexedFileReader.hpp"
+#include "openeaagles/recorder/protobuf/DataRecord.pb.h"
+#include "openeaagles/recorder/DataRecordHandle.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace oe {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(IndexedFileReader, "RecorderIndexedFileReader")
+EMPTY_SLOTTABLE(IndexedFileReader)
+EMPTY_SERIALIZER(IndexedFileReader)
+
+IndexedFileReader::IndexedFileReader()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void IndexedFileReader::initData()
+{
+   index.clear();
+   codec = IndexedFileFormat::CODEC_NONE;
+   nextBlock = 0;
+   blockData.clear();
+   blockPos = 0;
+   seekSimTime = 0;
+   seeking = false;
+}
+
+void IndexedFileReader::copyData(const IndexedFileReader& org, const bool)
+{
+   BaseClass::copyData(org);
+   initData();
+   firstPassFlg = true;
+}
+
+void IndexedFileReader::deleteData()
+{
+   initData();
+}
+
+//------------------------------------------------------------------------------
+// get functions
+//------------------------------------------------------------------------------
+unsigned int IndexedFileReader::getNumRecords() const
+{
+   unsigned int n = 0;
+   for (unsigned int i = 0; i < index.size(); i++) {
+      n += index[i].numRecords;
+   }
+   return n;
+}
+
+double IndexedFileReader::getFirstSimTime() const
+{
+   double t = 0;
+   for (unsigned int i = 0; i < index.size(); i++) {
+      if (i == 0 || index[i].minSimTime < t) t = index[i].minSimTime;
+   }
+   return t;
+}
+
+double IndexedFileReader::getLastSimTime() const
+{
+   double t = 0;
+   for (unsigned int i = 0; i < index.size(); i++) {
+      if (i == 0 || index[i].maxSimTime > t) t = index[i].maxSimTime;
+   }
+   return t;
+}
+
+//------------------------------------------------------------------------------
+// Open the data file and read its index
+//------------------------------------------------------------------------------
+bool IndexedFileReader::openFile()
+{
+   // When we're already open, just return
+   if (isOpen()) return true;
+
+   initData();
+   bool ok = BaseClass::openFile();
+   if (ok) {
+      ok = readIndex();
+      if (!ok) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "IndexedFileReader::openFile(): Not a valid indexed data file" << std::endl;
+         }
+         BaseClass::closeFile();
+         setFailed(true);
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Close the data file
+//------------------------------------------------------------------------------
+void IndexedFileReader::closeFile()
+{
+   BaseClass::closeFile();
+   initData();
+}
+
+//------------------------------------------------------------------------------
+// Positions the reader at the first data record at or after 'simTime'
+//------------------------------------------------------------------------------
+bool IndexedFileReader::seekTime(const double simTime)
+{
+   if (firstPassFlg) {
+      if ( !isOpen() && !isFailed() ) {
+         openFile();
+      }
+      firstPassFlg = false;
+   }
+
+   bool ok = false;
+   if (isOpen()) {
+      nextBlock = 0;
+      blockData.clear();
+      blockPos = 0;
+      seekSimTime = simTime;
+      seeking = true;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Read a record
+//------------------------------------------------------------------------------
+const DataRecordHandle* IndexedFileReader::readRecordImp()
+{
+   DataRecordHandle* handle = nullptr;
+
+   // First pass?  Does the file need to be opened?
+   if (firstPassFlg) {
+      if ( !isOpen() && !isFailed() ) {
+         openFile();
+      }
+      firstPassFlg = false;
+   }
+
+   bool finished = false;
+   while (!finished && isOpen() && !isFailed()) {
+
+      if (blockPos >= blockData.size()) {
+         // ---
+         // Read the next block that has enabled data records
+         // ---
+         while (nextBlock < index.size() && !isBlockEnabled(index[nextBlock])) {
+            nextBlock++;
+         }
+
+         if (nextBlock < index.size()) {
+            if (!readBlock(nextBlock++)) {
+               if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                  std::cerr << "IndexedFileReader::readRecord() -- error reading data block" << std::endl;
+               }
+               setFailed(true);
+            }
+         }
+         else finished = true;  // end of data
+      }
+
+      else {
+         // ---
+         // Next data record from the block
+         // ---
+         const char* p = blockData.data() + blockPos;
+         const char* const end = blockData.data() + blockData.size();
+         unsigned long long id = 0;
+         double simTime = 0;
+         unsigned long long n = 0;
+         bool ok = IndexedFileFormat::getVarint(&p, end, &id) &&
+                   IndexedFileFormat::getDouble(&p, end, &simTime) &&
+                   IndexedFileFormat::getVarint(&p, end, &n) &&
+                   n <= static_cast<unsigned long long>(end - p);
+
+         if (ok) {
+            blockPos = static_cast<unsigned int>((p - blockData.data()) + n);
+
+            // Skip the disabled records and the records before the seek time
+            // without parsing them
+            bool wanted = isDataEnabled(static_cast<unsigned int>(id));
+            if (wanted && seeking) {
+               if (simTime < seekSimTime) wanted = false;
+               else seeking = false;
+            }
+
+            if (wanted) {
+               // Parse the DataRecord
+               auto dataRecord = new pb::DataRecord();
+               if (dataRecord->ParseFromArray(p, static_cast<int>(n))) {
+                  // Create a handle for the DataRecord (it now has ownership)
+                  handle = new DataRecordHandle(dataRecord);
+                  finished = true;
+               }
+               else {
+                  if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                     std::cerr << "IndexedFileReader::readRecord() -- ParseFromArray() error" << std::endl;
+                  }
+                  delete dataRecord;
+               }
+            }
+         }
+         else {
+            if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "IndexedFileReader::readRecord() -- error reading data record" << std::endl;
+            }
+            blockData.clear();
+            blockPos = 0;
+         }
+      }
+   }
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// True if the block could have data records that we want
+//------------------------------------------------------------------------------
+bool IndexedFileReader::isBlockEnabled(const IndexedFileFormat::BlockInfo& info) const
+{
+   bool enabled = false;
+   if ( !(seeking && info.maxSimTime < seekSimTime) ) {
+      for (unsigned int i = 0; !enabled && i < info.ids.size(); i++) {
+         enabled = isDataEnabled(info.ids[i]);
+      }
+   }
+   return enabled;
+}
+
+//------------------------------------------------------------------------------
+// readIndex() -- reads the file header and the block index
+//------------------------------------------------------------------------------
+bool IndexedFileReader::readIndex()
+{
+   std::ifstream* sin = getInputStream();
+
+   sin->seekg(0, std::ios_base::end);
+   const auto fileSize = static_cast<unsigned long long>(sin->tellg());
+
+   // File header
+   bool ok = (fileSize >= IndexedFileFormat::HEADER_SIZE);
+   if (ok) {
+      char buff[IndexedFileFormat::HEADER_SIZE];
+      sin->seekg(0, std::ios_base::beg);
+      sin->read(buff, sizeof(buff));
+
+      const char* p = buff + sizeof(IndexedFileFormat::FILE_MAGIC);
+      const char* const end = buff + sizeof(buff);
+      unsigned int version = 0;
+      ok = !sin->fail() &&
+           std::memcmp(buff, IndexedFileFormat::FILE_MAGIC, sizeof(IndexedFileFormat::FILE_MAGIC)) == 0 &&
+           IndexedFileFormat::getUInt32(&p, end, &version) && version <= IndexedFileFormat::FORMAT_VERSION &&
+           IndexedFileFormat::getUInt32(&p, end, &codec) && codec <= IndexedFileFormat::CODEC_LZ4;
+   }
+
+   if (ok && codec == IndexedFileFormat::CODEC_LZ4 && !IndexedFileFormat::isCompressionAvailable()) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "IndexedFileReader::readIndex(): LZ4 isn't enabled (OE_RECORDER_LZ4); the compressed data blocks can't be read" << std::endl;
+      }
+   }
+
+   // Block index, from the footer
+   bool haveIndex = false;
+   if (ok && fileSize >= (IndexedFileFormat::HEADER_SIZE + IndexedFileFormat::FOOTER_SIZE)) {
+      char buff[IndexedFileFormat::FOOTER_SIZE];
+      sin->seekg(fileSize - IndexedFileFormat::FOOTER_SIZE, std::ios_base::beg);
+      sin->read(buff, sizeof(buff));
+
+      const char* p = buff;
+      unsigned long long indexOffset = 0;
+      if ( !sin->fail() &&
+           IndexedFileFormat::getUInt64(&p, buff + sizeof(buff), &indexOffset) &&
+           std::memcmp(p, IndexedFileFormat::FOOTER_MAGIC, sizeof(IndexedFileFormat::FOOTER_MAGIC)) == 0 &&
+           indexOffset >= IndexedFileFormat::HEADER_SIZE &&
+           indexOffset <= (fileSize - IndexedFileFormat::FOOTER_SIZE) ) {
+
+         packed.resize(static_cast<unsigned int>(fileSize - IndexedFileFormat::FOOTER_SIZE - indexOffset));
+         sin->seekg(indexOffset, std::ios_base::beg);
+         sin->read(&packed[0], packed.size());
+
+         const char* q = packed.data();
+         const char* const end = packed.data() + packed.size();
+         unsigned long long n = 0;
+         haveIndex = !sin->fail() &&
+                     packed.size() >= IndexedFileFormat::MARKER_SIZE &&
+                     std::memcmp(q, IndexedFileFormat::INDEX_MARKER, IndexedFileFormat::MARKER_SIZE) == 0;
+         if (haveIndex) {
+            q += IndexedFileFormat::MARKER_SIZE;
+            haveIndex = IndexedFileFormat::getVarint(&q, end, &n) && n <= packed.size();
+         }
+         if (haveIndex) {
+            index.resize(static_cast<unsigned int>(n));
+            for (unsigned int i = 0; haveIndex && i < index.size(); i++) {
+               haveIndex = IndexedFileFormat::getBlockInfo(&q, end, &index[i], true) && index[i].offset < indexOffset;
+            }
+         }
+         if (!haveIndex) index.clear();
+      }
+   }
+
+   // No index -- rebuild it from the block headers
+   if (ok && !haveIndex) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "IndexedFileReader::readIndex(): No block index; scanning the data blocks" << std::endl;
+      }
+      ok = scanBlocks(fileSize);
+   }
+
+   sin->clear();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// scanBlocks() -- rebuilds the index from the block headers; stops at the
+// first incomplete block
+//------------------------------------------------------------------------------
+bool IndexedFileReader::scanBlocks(const unsigned long long fileSize)
+{
+   std::ifstream* sin = getInputStream();
+
+   index.clear();
+   unsigned long long offset = IndexedFileFormat::HEADER_SIZE;
+   bool finished = false;
+   while (!finished) {
+      char buff[IndexedFileFormat::MARKER_SIZE + 4];
+      sin->seekg(offset, std::ios_base::beg);
+      sin->read(buff, sizeof(buff));
+
+      const char* p = buff + IndexedFileFormat::MARKER_SIZE;
+      unsigned int n = 0;
+      bool ok = !sin->fail() &&
+                std::memcmp(buff, IndexedFileFormat::BLOCK_MARKER, IndexedFileFormat::MARKER_SIZE) == 0 &&
+                IndexedFileFormat::getUInt32(&p, buff + sizeof(buff), &n) && n <= IndexedFileFormat::MAX_BLOCK_SIZE;
+
+      IndexedFileFormat::BlockInfo info;
+      if (ok) {
+         packed.resize(n);
+         sin->read(&packed[0], n);
+         const char* q = packed.data();
+         ok = !sin->fail() && IndexedFileFormat::getBlockInfo(&q, packed.data() + n, &info, false);
+      }
+
+      if (ok) {
+         const unsigned int dataSize = (info.packedSize > 0 ? info.packedSize : info.rawSize);
+         const unsigned long long next = offset + sizeof(buff) + n + dataSize;
+         ok = (next <= fileSize);
+         if (ok) {
+            info.offset = offset;
+            index.push_back(info);
+            offset = next;
+         }
+      }
+
+      finished = !ok;
+   }
+
+   sin->clear();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// readBlock() -- reads and decompresses the idx'th block
+//------------------------------------------------------------------------------
+bool IndexedFileReader::readBlock(const unsigned int idx)
+{
+   std::ifstream* sin = getInputStream();
+   const IndexedFileFormat::BlockInfo& info = index[idx];
+
+   blockData.clear();
+   blockPos = 0;
+
+   // Block marker and info size
+   char buff[IndexedFileFormat::MARKER_SIZE + 4];
+   sin->seekg(info.offset, std::ios_base::beg);
+   sin->read(buff, sizeof(buff));
+
+   const char* p = buff + IndexedFileFormat::MARKER_SIZE;
+   unsigned int n = 0;
+   bool ok = !sin->fail() &&
+             std::memcmp(buff, IndexedFileFormat::BLOCK_MARKER, IndexedFileFormat::MARKER_SIZE) == 0 &&
+             IndexedFileFormat::getUInt32(&p, buff + sizeof(buff), &n);
+
+   // Skip the block info and read the block data
+   if (ok) {
+      sin->seekg(n, std::ios_base::cur);
+      if (info.packedSize > 0) {
+         packed.resize(info.packedSize);
+         sin->read(&packed[0], info.packedSize);
+         ok = !sin->fail() && IndexedFileFormat::decompress(packed.data(), info.packedSize, info.rawSize, &blockData);
+      }
+      else {
+         blockData.resize(info.rawSize);
+         sin->read(&blockData[0], info.rawSize);
+         ok = !sin->fail();
+      }
+   }
+
+   if (!ok) blockData.clear();
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,280 @@
+#include "openeaagles/recorder/IndexedFileWriter.hpp"
+#include "openeaagles/recorder/FileReader.hpp"
+#include "openeaagles/recorder/protobuf/DataRecord.pb.h"
+#include "openeaagles/recorder/DataRecordHandle.hpp"
+#include "openeaagles/base/Number.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace oe {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(IndexedFileWriter, "RecorderIndexedFileWriter")
+
+BEGIN_SLOTTABLE(IndexedFileWriter)
+    "compress",         // 1) Compress the data blocks (default: true, if LZ4 is enabled)
+    "blockSize",        // 2) Uncompressed size of the data blocks (bytes)
+END_SLOTTABLE(IndexedFileWriter)
+
+BEGIN_SLOT_MAP(IndexedFileWriter)
+    ON_SLOT( 1, setSlotCompress,  base::Number)
+    ON_SLOT( 2, setSlotBlockSize, base::Number)
+END_SLOT_MAP()
+
+IndexedFileWriter::IndexedFileWriter()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void IndexedFileWriter::copyData(const IndexedFileWriter& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   compressFlg = org.compressFlg;
+   blockSize = org.blockSize;
+
+   block.clear();
+   blockInfo = IndexedFileFormat::BlockInfo();
+   index.clear();
+   offset = 0;
+}
+
+void IndexedFileWriter::deleteData()
+{
+   block.clear();
+   index.clear();
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool IndexedFileWriter::setCompressionEnabled(const bool flg)
+{
+   // (the blocks can only be compressed if LZ4 is enabled)
+   const bool ok = (!flg || IndexedFileFormat::isCompressionAvailable());
+   if (ok) compressFlg = flg;
+   else if (isMessageEnabled(MSG_WARNING)) {
+      std::cerr << "IndexedFileWriter::setCompressionEnabled(): LZ4 isn't enabled (OE_RECORDER_LZ4); the data blocks are stored uncompressed" << std::endl;
+   }
+   return ok;
+}
+
+bool IndexedFileWriter::setBlockSize(const unsigned int bytes)
+{
+   bool ok = false;
+   if (bytes >= MIN_BLOCK_SIZE && bytes <= MAX_BLOCK_SIZE) {
+      blockSize = bytes;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// convertFile() -- copies all of the data records from the reader
+//------------------------------------------------------------------------------
+bool IndexedFileWriter::convertFile(FileReader* const reader)
+{
+   bool ok = false;
+   if (reader != nullptr && openFile()) {
+      const DataRecordHandle* handle = reader->readRecord();
+      while (handle != nullptr) {
+         // (the file is closed by the END_OF_DATA message, if any)
+         if (isOpen()) processRecord(handle);
+         handle->unref();
+         handle = reader->readRecord();
+      }
+      // (the legacy reader's fail flag is also set at the end of its file)
+      closeFile();
+      ok = !isFailed();
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// File format (see IndexedFileFormat)
+//------------------------------------------------------------------------------
+
+// Writes the file header
+bool IndexedFileWriter::writeHeader()
+{
+   block.clear();
+   blockInfo = IndexedFileFormat::BlockInfo();
+   index.clear();
+
+   header.clear();
+   header.append(IndexedFileFormat::FILE_MAGIC, sizeof(IndexedFileFormat::FILE_MAGIC));
+   IndexedFileFormat::putUInt32(&header, IndexedFileFormat::FORMAT_VERSION);
+   IndexedFileFormat::putUInt32(&header, (compressFlg ? IndexedFileFormat::CODEC_LZ4 : IndexedFileFormat::CODEC_NONE));
+
+   std::ofstream* sout = getOutputStream();
+   sout->write(header.data(), header.size());
+   offset = header.size();
+
+   return !sout->fail();
+}
+
+// Adds the data record to the current block; writes the block when it's full
+bool IndexedFileWriter::writeRecord(const pb::DataRecord* const dataRecord)
+{
+   // Serialize the DataRecord
+   wireFormat.clear();
+   bool ok = dataRecord->SerializeToString(&wireFormat);
+
+   if (ok) {
+      const unsigned int id = dataRecord->id();
+      const double simTime = dataRecord->time().sim_time();
+
+      // Add it to the block
+      IndexedFileFormat::putVarint(&block, id);
+      IndexedFileFormat::putDouble(&block, simTime);
+      IndexedFileFormat::putVarint(&block, wireFormat.size());
+      block.append(wireFormat);
+
+      // Update the block info
+      if (blockInfo.numRecords == 0) {
+         blockInfo.minSimTime = simTime;
+         blockInfo.maxSimTime = simTime;
+      }
+      else {
+         if (simTime < blockInfo.minSimTime) blockInfo.minSimTime = simTime;
+         if (simTime > blockInfo.maxSimTime) blockInfo.maxSimTime = simTime;
+      }
+      blockInfo.numRecords++;
+
+      std::vector<unsigned int>& ids = blockInfo.ids;
+      const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+      if (it == ids.end() || *it != id) ids.insert(it, id);
+
+      // Write the block when it's full
+      if (block.size() >= blockSize) ok = writeBlock();
+   }
+
+   else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+      // If we had an error serializing the DataRecord
+      std::cerr << "IndexedFileWriter::writeRecord() -- SerializeToString() error" << std::endl;
+   }
+
+   return ok;
+}
+
+// Writes the last block, the index and the footer
+bool IndexedFileWriter::writeTrailer()
+{
+   bool ok = writeBlock();
+
+   if (ok) {
+      const unsigned long long indexOffset = offset;
+
+      header.clear();
+      header.append(IndexedFileFormat::INDEX_MARKER, sizeof(IndexedFileFormat::INDEX_MARKER));
+      IndexedFileFormat::putVarint(&header, index.size());
+      for (unsigned int i = 0; i < index.size(); i++) {
+         IndexedFileFormat::putBlockInfo(&header, index[i], true);
+      }
+      IndexedFileFormat::putUInt64(&header, indexOffset);
+      header.append(IndexedFileFormat::FOOTER_MAGIC, sizeof(IndexedFileFormat::FOOTER_MAGIC));
+
+      std::ofstream* sout = getOutputStream();
+      sout->write(header.data(), header.size());
+      offset += header.size();
+      ok = !sout->fail();
+   }
+
+   return ok;
+}
+
+// Compresses and writes the current block, if it's not empty
+bool IndexedFileWriter::writeBlock()
+{
+   bool ok = true;
+   if (blockInfo.numRecords > 0) {
+      blockInfo.offset = offset;
+      blockInfo.rawSize = static_cast<unsigned int>(block.size());
+      blockInfo.packedSize = 0;
+
+      // Compress the block; store it uncompressed if it doesn't get smaller
+      const std::string* data = &block;
+      if (compressFlg && IndexedFileFormat::compress(block, &packed) && packed.size() < block.size()) {
+         blockInfo.packedSize = static_cast<unsigned int>(packed.size());
+         data = &packed;
+      }
+
+      // Block marker, info size and info
+      std::string info;
+      IndexedFileFormat::putBlockInfo(&info, blockInfo, false);
+      header.clear();
+      header.append(IndexedFileFormat::BLOCK_MARKER, sizeof(IndexedFileFormat::BLOCK_MARKER));
+      IndexedFileFormat::putUInt32(&header, static_cast<unsigned int>(info.size()));
+      header.append(info);
+
+      // Write it
+      std::ofstream* sout = getOutputStream();
+      sout->write(header.data(), header.size());
+      sout->write(data->data(), data->size());
+      offset += header.size() + data->size();
+
+      ok = !sout->fail();
+      if (ok) index.push_back(blockInfo);
+      else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+         std::cerr << "IndexedFileWriter::writeBlock() -- error writing data block" << std::endl;
+      }
+
+      block.clear();
+      blockInfo = IndexedFileFormat::BlockInfo();
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool IndexedFileWriter::setSlotCompress(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCompressionEnabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+bool IndexedFileWriter::setSlotBlockSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) ok = setBlockSize( static_cast<unsigned int>(n) );
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "IndexedFileWriter::setSlotBlockSize(): invalid block size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+std::ostream& IndexedFileWriter::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+    int j = 0;
+    if ( !slotsOnly ) {
+        //indent(sout,i);
+        sout << "( " << getFactoryName() << std::endl;
+        j = 4;
+    }
+
+    indent(sout,i+j);
+    sout << "compress: " << (compressFlg ? "true" : "false") << std::endl;
+
+    indent(sout,i+j);
+    sout << "blockSize: " << blockSize << std::endl;
+
+    BaseClass::serialize(sout,i+j,true);
+
+    if ( !slotsOnly ) {
+        indent(sout,i);
+        sout << ")" << std::endl;
+    }
+
+    return sout;
+}
+
+}
+}
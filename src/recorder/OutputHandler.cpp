@@ -3,16 +3,70 @@
 #include "openeaagles/recorder/DataRecordHandle.hpp"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 
+#include "openeaagles/base/Identifier.hpp"
+#include "openeaagles/base/Number.hpp"
 #include "openeaagles/base/Pair.hpp"
 #include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/concurrent/SingleTask.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <chrono>
 
 namespace oe {
 namespace recorder {
 
+// Max time that the writer thread or a blocked producer waits before it
+// checks again for a stop request (a missed notification costs no more)
+static const std::chrono::milliseconds MAX_WAIT_TIME(10);
+
+//==============================================================================
+// OutputHandler's writer thread
+//==============================================================================
+
+class WriterThread : public base::SingleTask
+{
+   DECLARE_SUBCLASS(WriterThread, base::SingleTask)
+   public: WriterThread(base::Component* const parent, const double priority);
+   private: virtual unsigned long userFunc() override;
+};
+
+IMPLEMENT_SUBCLASS(WriterThread, "RecorderWriterThread")
+EMPTY_SLOTTABLE(WriterThread)
+EMPTY_COPYDATA(WriterThread)
+EMPTY_DELETEDATA(WriterThread)
+EMPTY_SERIALIZER(WriterThread)
+
+WriterThread::WriterThread(base::Component* const parent, const double priority): base::SingleTask(parent, priority)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long WriterThread::userFunc()
+{
+   const auto handler = dynamic_cast<OutputHandler*>( getParent() );
+   if (handler != nullptr) handler->writerLoop();
+   return 0;
+}
+
+//==============================================================================
+// OutputHandler class
+//==============================================================================
+
 IMPLEMENT_SUBCLASS(OutputHandler, "RecorderOutputHandler")
-EMPTY_SLOTTABLE(OutputHandler)
 EMPTY_SERIALIZER(OutputHandler)
 
+BEGIN_SLOTTABLE(OutputHandler)
+    "asyncWriter",      // 1) Use a dedicated writer thread (default: false)
+    "queueSize",        // 2) Writer thread's queue size (records)
+    "overflowPolicy",   // 3) Writer thread's queue overflow policy
+END_SLOTTABLE(OutputHandler)
+
+BEGIN_SLOT_MAP(OutputHandler)
+    ON_SLOT( 1, setSlotAsyncWriter,    base::Number)
+    ON_SLOT( 2, setSlotQueueSize,      base::Number)
+    ON_SLOT( 3, setSlotOverflowPolicy, base::Identifier)
+END_SLOT_MAP()
+
 OutputHandler::OutputHandler()
 {
    STANDARD_CONSTRUCTOR()
@@ -26,6 +80,11 @@ void OutputHandler::copyData(const OutputHandler& org, const bool)
    base::lock(semaphore);
    queue.clear();
    base::unlock(semaphore);
+
+   // or the writer thread
+   asyncFlg = org.asyncFlg;
+   queueSize = org.queueSize;
+   policy = org.policy;
 }
 
 void OutputHandler::deleteData()
@@ -34,6 +93,24 @@ void OutputHandler::deleteData()
    base::lock(semaphore);
    queue.clear();
    base::unlock(semaphore);
+
+   if (writerThread != nullptr) {
+      stopWriter = true;
+      writerThread->terminate();
+      writerThread = nullptr;
+   }
+
+   if (ring != nullptr) {
+      // (records that were queued after the writer thread was stopped)
+      const DataRecordHandle* p = ring->get();
+      while (p != nullptr) {
+         p->unref();
+         numDropped++;
+         p = ring->get();
+      }
+      delete ring;
+      ring = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -41,6 +118,9 @@ void OutputHandler::deleteData()
 //------------------------------------------------------------------------------
 bool OutputHandler::shutdownNotification()
 {
+   // Stop the writer thread and process the remaining records
+   stopWriterThread();
+
    // Pass the shutdown notification to our subcomponent recorders
    base::PairStream* subcomponents = getComponents();
    if (subcomponents != nullptr) {
@@ -57,6 +137,30 @@ bool OutputHandler::shutdownNotification()
 }
 
 
+//------------------------------------------------------------------------------
+// Stops the writer thread and processes the records remaining in its queue
+//------------------------------------------------------------------------------
+void OutputHandler::stopWriterThread()
+{
+   if (writerThread != nullptr) {
+      stopWriter = true;
+      {
+         // Wake the writer thread and any blocked producers
+         std::lock_guard<std::mutex> guard(waitMutex);
+         recordsQueued.notify_all();
+         spaceFreed.notify_all();
+      }
+      while (!writerThread->isTerminated()) {
+         base::msleep(1);
+      }
+      writerThread = nullptr;
+   }
+   if (ring != nullptr) {
+      while (processRing(WRITER_BATCH_SIZE) > 0) {}
+   }
+}
+
+
 //------------------------------------------------------------------------------
 // Pass the data record to all of our subcomponents for processing; they all
 // should be of type OutputHandler (see processComponents() above)
@@ -93,7 +197,57 @@ void OutputHandler::processRecord(const DataRecordHandle* const dataRecord)
 //------------------------------------------------------------------------------
 void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 {
-   if (dataRecord != nullptr) {
+   if (dataRecord == nullptr) return;
+
+   // Start the writer thread with the first record
+   if (asyncFlg && !writerStarted) createWriterThread();
+
+   if (writerStarted && ring != nullptr) {
+      // ---
+      // Writer thread's queue
+      // ---
+
+      // The writer thread has been stopped, and the output is being closed
+      if (stopWriter) {
+         numDropped++;
+         return;
+      }
+
+      dataRecord->ref();
+      if (!ring->put(dataRecord)) {
+         if (policy == DROP_NEWEST) {
+            dataRecord->unref();
+            numDropped++;
+         }
+         else if (policy == DROP_OLDEST) {
+            do {
+               const DataRecordHandle* oldest = ring->get();
+               if (oldest != nullptr) {
+                  oldest->unref();
+                  numDropped++;
+               }
+            } while (!ring->put(dataRecord));
+         }
+         else {
+            // Block until the writer thread makes room, or is stopped
+            std::unique_lock<std::mutex> guard(waitMutex);
+            blockedProducers++;
+            bool queued = false;
+            while (!queued && !stopWriter) {
+               queued = ring->put(dataRecord);
+               if (!queued) spaceFreed.wait_for(guard, MAX_WAIT_TIME);
+            }
+            blockedProducers--;
+            if (!queued) {
+               dataRecord->unref();
+               numDropped++;
+            }
+         }
+      }
+      notifyWriter();
+   }
+
+   else {
       base::lock( semaphore );
       // const cast away to put into the queue
       queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
@@ -107,6 +261,9 @@ void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 //------------------------------------------------------------------------------
 void OutputHandler::processQueue()
 {
+   // The writer thread is processing the queue
+   if (writerStarted && ring != nullptr) return;
+
    // Get the first record from the queue
    base::lock( semaphore );
    const DataRecordHandle* dataRecord = static_cast<const DataRecordHandle*>(queue.get());
@@ -126,6 +283,171 @@ void OutputHandler::processQueue()
 }
 
 
+//------------------------------------------------------------------------------
+// Writer thread
+//------------------------------------------------------------------------------
+
+// Number of records in the queue
+unsigned int OutputHandler::getQueueDepth() const
+{
+   unsigned int n = 0;
+   if (ring != nullptr) {
+      n = ring->entries();
+   }
+   else {
+      base::lock( semaphore );
+      n = queue.entries();
+      base::unlock( semaphore );
+   }
+   return n;
+}
+
+// Creates the queue and starts the writer thread; on failure, the records
+// are queued for processQueue()
+bool OutputHandler::createWriterThread()
+{
+   base::lock( semaphore );
+   if (!writerStarted) {
+      ring = new base::lockfree_queue<const DataRecordHandle*>(queueSize);
+      stopWriter = false;
+
+      writerThread = new WriterThread(this, 0.3);
+      writerThread->unref(); // 'writerThread' is a safe_ptr<>
+      if (!writerThread->create()) {
+         writerThread = nullptr;
+         delete ring;
+         ring = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "OutputHandler::createWriterThread(): ERROR, failed to create the thread!" << std::endl;
+         }
+      }
+      writerStarted = true;
+   }
+   base::unlock( semaphore );
+   return (ring != nullptr);
+}
+
+// Writer thread's main loop: process the queued records in batches until
+// we're stopped, and wait for more records while the queue is empty
+void OutputHandler::writerLoop()
+{
+   while (!stopWriter) {
+      if (processRing(WRITER_BATCH_SIZE) == 0) {
+         // Flag that we're waiting before the last check of the queue, so
+         // a producer that queues a record after the check will notify us
+         std::unique_lock<std::mutex> guard(waitMutex);
+         writerWaiting = true;
+         if (ring->isEmpty() && !stopWriter) recordsQueued.wait_for(guard, MAX_WAIT_TIME);
+         writerWaiting = false;
+      }
+   }
+}
+
+// Wakes the writer thread, if it's waiting for records
+void OutputHandler::notifyWriter()
+{
+   if (writerWaiting) {
+      std::lock_guard<std::mutex> guard(waitMutex);
+      recordsQueued.notify_one();
+   }
+}
+
+// Processes up to 'max' records from the writer thread's queue; returns the
+// number of records.  Only one thread drains the queue at a time, so the
+// records are processed (written) in order.
+unsigned int OutputHandler::processRing(const unsigned int max)
+{
+   std::lock_guard<std::mutex> guard(drainMutex);
+
+   // Take a batch of records from the queue, ...
+   const DataRecordHandle* batch[WRITER_BATCH_SIZE];
+   const unsigned int n = (max < WRITER_BATCH_SIZE ? max : WRITER_BATCH_SIZE);
+   unsigned int cnt = 0;
+   const DataRecordHandle* p = (n > 0 ? ring->get() : nullptr);
+   while (p != nullptr) {
+      batch[cnt++] = p;
+      p = (cnt < n ? ring->get() : nullptr);
+   }
+
+   // ... make room for any blocked producers, ...
+   if (cnt > 0 && blockedProducers > 0) {
+      std::lock_guard<std::mutex> wguard(waitMutex);
+      spaceFreed.notify_all();
+   }
+
+   // ... then process them
+   for (unsigned int i = 0; i < cnt; i++) {
+      processRecord(batch[i]);
+      batch[i]->unref();
+   }
+   return cnt;
+}
+
+//------------------------------------------------------------------------------
+// Set functions (set before the first record is queued)
+//------------------------------------------------------------------------------
+bool OutputHandler::setAsyncWriterEnabled(const bool flg)
+{
+   bool ok = !writerStarted;
+   if (ok) asyncFlg = flg;
+   return ok;
+}
+
+bool OutputHandler::setQueueSize(const unsigned int n)
+{
+   bool ok = !writerStarted && n > 0;
+   if (ok) queueSize = n;
+   return ok;
+}
+
+bool OutputHandler::setOverflowPolicy(const OverflowPolicy p)
+{
+   policy = p;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool OutputHandler::setSlotAsyncWriter(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setAsyncWriterEnabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+bool OutputHandler::setSlotQueueSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) ok = setQueueSize( static_cast<unsigned int>(n) );
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "OutputHandler::setSlotQueueSize(): invalid queue size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool OutputHandler::setSlotOverflowPolicy(const base::Identifier* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "block") ok = setOverflowPolicy(BLOCK);
+      else if (*msg == "dropOldest") ok = setOverflowPolicy(DROP_OLDEST);
+      else if (*msg == "dropNewest") ok = setOverflowPolicy(DROP_NEWEST);
+
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "OutputHandler::setSlotOverflowPolicy(): invalid policy: " << *msg;
+         std::cerr << "; use block, dropOldest or dropNewest" << std::endl;
+      }
+   }
+   return ok;
+}
+
+
 //------------------------------------------------------------------------------
 // processRecordImp() stub
 //------------------------------------------------------------------------------
@@ -6,6 +6,8 @@
 #include "openeaagles/recorder/DataRecorder.hpp"
 #include "openeaagles/recorder/FileWriter.hpp"
 #include "openeaagles/recorder/FileReader.hpp"
+#include "openeaagles/recorder/IndexedFileWriter.hpp"
+#include "openeaagles/recorder/IndexedFileReader.hpp"
 #include "openeaagles/recorder/OutputHandler.hpp"
 #include "openeaagles/recorder/NetInput.hpp"
 #include "openeaagles/recorder/NetOutput.hpp"
@@ -28,6 +30,12 @@ base::Object* factory(const std::string& name)
     else if ( name == FileReader::getFactoryName() ) {
         obj = new FileReader();
     }
+    else if ( name == IndexedFileWriter::getFactoryName() ) {
+        obj = new IndexedFileWriter();
+    }
+    else if ( name == IndexedFileReader::getFactoryName() ) {
+        obj = new IndexedFileReader();
+    }
     else if ( name == NetInput::getFactoryName() ) {
         obj = new NetInput();
     }
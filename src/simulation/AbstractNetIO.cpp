@@ -16,5 +16,12 @@ AbstractNetIO::AbstractNetIO()
    STANDARD_CONSTRUCTOR()
 }
 
+//------------------------------------------------------------------------------
+// deadReckoningFrame() -- default: the entities are dead reckoned by their players
+//------------------------------------------------------------------------------
+void AbstractNetIO::deadReckoningFrame(const double)
+{
+}
+
 }
 }
@@ -6,6 +6,7 @@
 
 #include "openeaagles/simulation/AbstractNetIO.hpp"
 #include "openeaagles/simulation/AbstractNib.hpp"
+#include "openeaagles/simulation/PlayerEvents.hpp"
 
 namespace oe {
 namespace simulation {
@@ -130,7 +131,9 @@ void AbstractPlayer::setName(const char* const str)
 // Sets the player's mode (ACTIVE, DEAD, etc)
 void AbstractPlayer::setMode(const Mode m)
 {
+   const bool changed = (m != mode);
    mode = m;
+   if (changed) postChanged();
 }
 
 // Sets the player's initial (reset) mode
@@ -166,6 +169,8 @@ const AbstractNib* AbstractPlayer::getLocalNib(const unsigned int netId) const
 // Sets a pointer to the Network Interface Block (NIB)
 bool AbstractPlayer::setNib(AbstractNib* const n)
 {
+   // the NIB decides isLocalPlayer(), so the output NIB list needs to know
+   const bool changed = (n != nib);
    if (nib != nullptr) nib->unref();
    nib = n;
    if (nib != nullptr) {
@@ -177,16 +182,32 @@ bool AbstractPlayer::setNib(AbstractNib* const n)
    else {
       netID = 0;
    }
+   if (changed) postChanged();
    return true;
 }
 
 // Sets the network output enabled flag
 bool AbstractPlayer::setEnableNetOutput(const bool x)
 {
+   const bool changed = (x != enableNetOutput);
    enableNetOutput = x;
+   if (changed) postChanged();
    return true;
 }
 
+// Sets the player list's events (set by the simulation; nullptr when removed)
+void AbstractPlayer::setPlayerEvents(PlayerEvents* const p)
+{
+   events = p;
+}
+
+// Posts a CHANGED event, if the player is on a player list
+void AbstractPlayer::postChanged()
+{
+   PlayerEvents* const p = events.load();
+   if (p != nullptr) p->post(this, PlayerEvents::CHANGED);
+}
+
 // Sets the outgoing NIB for network 'id'
 bool AbstractPlayer::setOutgoingNib(AbstractNib* const p, const unsigned int id)
 {
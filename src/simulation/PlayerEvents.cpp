@@ -0,0 +1,93 @@
+#include "openeaagles/simulation/PlayerEvents.hpp"
+
+#include "openeaagles/simulation/AbstractPlayer.hpp"
+
+#include "openeaagles/base/util/atomics.hpp"
+
+namespace oe {
+namespace simulation {
+
+PlayerEvents::~PlayerEvents()
+{
+   for (unsigned int i = 0; i < MAX_EVENTS; i++) {
+      if (ring[i].player != nullptr) ring[i].player->unref();
+      ring[i].player = nullptr;
+   }
+}
+
+unsigned long long PlayerEvents::getSequence() const
+{
+   base::lock(semaphore);
+   const unsigned long long seq = nextSeq;
+   base::unlock(semaphore);
+   return seq;
+}
+
+//------------------------------------------------------------------------------
+// post() -- posts an event for the player; the oldest event is dropped when
+// the log is full.
+//------------------------------------------------------------------------------
+void PlayerEvents::post(AbstractPlayer* const player, const Type type)
+{
+   if (player == nullptr) return;
+   player->ref();
+
+   base::lock(semaphore);
+   Event& ev = ring[nextSeq % MAX_EVENTS];
+   AbstractPlayer* const old = ev.player;
+   ev.player = player;
+   ev.type = type;
+   nextSeq++;
+   if ((nextSeq - firstSeq) > MAX_EVENTS) firstSeq = nextSeq - MAX_EVENTS;
+   base::unlock(semaphore);
+
+   // (unref() outside of the lock, in case it's the last reference)
+   if (old != nullptr) old->unref();
+}
+
+//------------------------------------------------------------------------------
+// resync() -- drops all events
+//------------------------------------------------------------------------------
+void PlayerEvents::resync()
+{
+   std::array<AbstractPlayer*, MAX_EVENTS> old {};
+
+   base::lock(semaphore);
+   for (unsigned int i = 0; i < MAX_EVENTS; i++) {
+      old[i] = ring[i].player;
+      ring[i].player = nullptr;
+   }
+   // (a consumer that is up to date has still missed the replaced list)
+   nextSeq++;
+   firstSeq = nextSeq;
+   base::unlock(semaphore);
+
+   for (unsigned int i = 0; i < MAX_EVENTS; i++) {
+      if (old[i] != nullptr) old[i]->unref();
+   }
+}
+
+//------------------------------------------------------------------------------
+// getEvents() -- appends the events from sequence number 'seq'
+//------------------------------------------------------------------------------
+bool PlayerEvents::getEvents(unsigned long long* const seq, std::vector<Event>* const events) const
+{
+   if (seq == nullptr || events == nullptr) return false;
+
+   base::lock(semaphore);
+   const bool ok = (*seq >= firstSeq && *seq <= nextSeq);
+   if (ok) {
+      for (unsigned long long n = *seq; n < nextSeq; n++) {
+         const Event& ev = ring[n % MAX_EVENTS];
+         ev.player->ref();
+         events->push_back(ev);
+      }
+   }
+   *seq = nextSeq;
+   base::unlock(semaphore);
+
+   return ok;
+}
+
+}
+}
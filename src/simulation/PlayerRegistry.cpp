@@ -0,0 +1,182 @@
+
+#include "openeaagles/simulation/PlayerRegistry.hpp"
+
+#include "openeaagles/simulation/AbstractPlayer.hpp"
+
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/Pair.hpp"
+
+#include <unordered_set>
+
+namespace oe {
+namespace simulation {
+
+//------------------------------------------------------------------------------
+// Constructor -- builds the player array and indexes from the player list
+//------------------------------------------------------------------------------
+PlayerRegistry::PlayerRegistry(base::PairStream* const playerList) : list(playerList)
+{
+   loadPlayers();
+
+   idNetIndex.reserve(players.size());
+   idIndex.reserve(players.size());
+   nameIndex.reserve(players.size());
+   for (unsigned int i = 0; i < players.size(); i++) {
+      indexPlayer(players[i]);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Constructor -- builds the player array from the player list, and updates
+// the previous registry's indexes with the removed and added players
+//------------------------------------------------------------------------------
+PlayerRegistry::PlayerRegistry(
+      base::PairStream* const playerList,
+      const PlayerRegistry* const prev,
+      const std::vector<AbstractPlayer*>& removed,
+      const std::vector<AbstractPlayer*>& added
+   ) : list(playerList)
+{
+   loadPlayers();
+
+   if (prev == nullptr) {
+      for (unsigned int i = 0; i < players.size(); i++) {
+         indexPlayer(players[i]);
+      }
+      return;
+   }
+
+   idNetIndex = prev->idNetIndex;
+   idIndex = prev->idIndex;
+   nameIndex = prev->nameIndex;
+
+   // Keys whose first player (in list order) has to be found again
+   std::unordered_set<unsigned long long> idNetStale;
+   std::unordered_set<unsigned short> idStale;
+   std::unordered_set<std::string> nameStale;
+
+   // Removed players: their keys are stale if they were the first player
+   for (unsigned int i = 0; i < removed.size(); i++) {
+      AbstractPlayer* const ip = removed[i];
+      const unsigned long long k = idKey(ip->getID(), ip->getNetworkID());
+      const auto it1 = idNetIndex.find(k);
+      if (it1 != idNetIndex.end() && it1->second == ip) {
+         idNetIndex.erase(it1);
+         idNetStale.insert(k);
+      }
+      const auto it2 = idIndex.find(ip->getID());
+      if (it2 != idIndex.end() && it2->second == ip) {
+         idIndex.erase(it2);
+         idStale.insert(ip->getID());
+      }
+      const base::Identifier* name = ip->getName();
+      if (!name->isEmpty()) {
+         const auto it3 = nameIndex.find(name->getString());
+         if (it3 != nameIndex.end() && it3->second == ip) {
+            nameIndex.erase(it3);
+            nameStale.insert(name->getString());
+         }
+      }
+   }
+
+   // Added players: new keys are added, and existing keys are stale, since
+   // the new player could be first
+   for (unsigned int i = 0; i < added.size(); i++) {
+      AbstractPlayer* const ip = added[i];
+      const unsigned long long k = idKey(ip->getID(), ip->getNetworkID());
+      if (!idNetIndex.emplace(k, ip).second) idNetStale.insert(k);
+      if (!idIndex.emplace(ip->getID(), ip).second) idStale.insert(ip->getID());
+      const base::Identifier* name = ip->getName();
+      if (!name->isEmpty() && !nameIndex.emplace(name->getString(), ip).second) nameStale.insert(name->getString());
+   }
+
+   // Find the first players of the stale keys
+   if (!idNetStale.empty() || !idStale.empty() || !nameStale.empty()) {
+      for (unsigned int i = 0; i < players.size(); i++) {
+         AbstractPlayer* const ip = players[i];
+         if (!idNetStale.empty()) {
+            const unsigned long long k = idKey(ip->getID(), ip->getNetworkID());
+            if (idNetStale.erase(k) > 0) idNetIndex[k] = ip;
+         }
+         if (!idStale.empty()) {
+            if (idStale.erase(ip->getID()) > 0) idIndex[ip->getID()] = ip;
+         }
+         if (!nameStale.empty()) {
+            const base::Identifier* name = ip->getName();
+            if (!name->isEmpty() && nameStale.erase(name->getString()) > 0) nameIndex[name->getString()] = ip;
+         }
+      }
+   }
+}
+
+PlayerRegistry::~PlayerRegistry()
+{
+}
+
+//------------------------------------------------------------------------------
+// loadPlayers() -- loads the player array from the player list
+//------------------------------------------------------------------------------
+void PlayerRegistry::loadPlayers()
+{
+   base::PairStream* const playerList = list;
+   if (playerList == nullptr) return;
+
+   players.reserve(playerList->entries());
+   const base::List::Item* item = playerList->getFirstItem();
+   while (item != nullptr) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      if (pair != nullptr) {
+         const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+         if (ip != nullptr) players.push_back(ip);
+      }
+      item = item->getNext();
+   }
+}
+
+//------------------------------------------------------------------------------
+// indexPlayer() -- adds the player to the indexes; emplace() keeps the first
+// player, in list order, for each key
+//------------------------------------------------------------------------------
+void PlayerRegistry::indexPlayer(AbstractPlayer* const ip)
+{
+   idNetIndex.emplace(idKey(ip->getID(), ip->getNetworkID()), ip);
+   idIndex.emplace(ip->getID(), ip);
+   const base::Identifier* name = ip->getName();
+   if (!name->isEmpty()) nameIndex.emplace(name->getString(), ip);
+}
+
+//------------------------------------------------------------------------------
+// findPlayer() -- Find a player that matches 'id' and 'netID'; a 'netID' of
+// zero (or less) matches any network
+//------------------------------------------------------------------------------
+AbstractPlayer* PlayerRegistry::findPlayer(const short id, const int netID) const
+{
+   if (id < 0) return nullptr;
+
+   AbstractPlayer* ip = nullptr;
+   if (netID > 0) {
+      const auto it = idNetIndex.find( idKey(static_cast<unsigned short>(id), netID) );
+      if (it != idNetIndex.end()) ip = it->second;
+   }
+   else {
+      const auto it = idIndex.find( static_cast<unsigned short>(id) );
+      if (it != idIndex.end()) ip = it->second;
+   }
+   return ip;
+}
+
+//------------------------------------------------------------------------------
+// findPlayerByName() -- Find a player by name
+//------------------------------------------------------------------------------
+AbstractPlayer* PlayerRegistry::findPlayerByName(const char* const playerName) const
+{
+   if (playerName == nullptr) return nullptr;
+
+   AbstractPlayer* ip = nullptr;
+   const auto it = nameIndex.find(std::string(playerName));
+   if (it != nameIndex.end()) ip = it->second;
+   return ip;
+}
+
+}
+}
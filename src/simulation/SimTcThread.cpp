@@ -4,7 +4,6 @@
 #include "openeaagles/simulation/Simulation.hpp"
 
 #include "openeaagles/base/Component.hpp"
-#include "openeaagles/base/PairStream.hpp"
 
 namespace oe {
 namespace simulation {
@@ -21,7 +20,7 @@ SimTcThread::SimTcThread(base::Component* const parent, const double priority):
 }
 
 void SimTcThread::start(
-         base::PairStream* const pl1,
+         PlayerRegistry* const pl1,
          const double dt1,
          const unsigned int idx1,
          const unsigned int n1
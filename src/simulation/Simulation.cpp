@@ -2,6 +2,7 @@
 #include "openeaagles/simulation/Simulation.hpp"
 
 #include "openeaagles/simulation/AbstractPlayer.hpp"
+#include "openeaagles/simulation/PlayerRegistry.hpp"
 
 #include "openeaagles/simulation/SimTcThread.hpp"
 #include "openeaagles/simulation/SimBgThread.hpp"
@@ -12,6 +13,7 @@
 
 #include "openeaagles/base/PairStream.hpp"
 #include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/Profiler.hpp"
 #include "openeaagles/base/units/Times.hpp"
 #include "openeaagles/base/Statistic.hpp"
 #include "openeaagles/base/util/system_utils.hpp"
@@ -24,6 +26,10 @@ namespace simulation {
 
 IMPLEMENT_PARTIAL_SUBCLASS(Simulation, "Simulation")
 
+// Minimum cost of a player (seconds); the computer time has microsecond
+// resolution, so cheap players would otherwise have no cost at all.
+const double Simulation::MIN_PLAYER_COST = 1.0e-6;
+
 BEGIN_SLOTTABLE(Simulation)
    "players",        // 1) All players
    "simulationTime", // 2) Simulation time
@@ -95,10 +101,11 @@ void Simulation::copyData(const Simulation& org, const bool)
    }
 
    // Copy active players
-   if (players != nullptr)     { players = nullptr; }
+   if (players != nullptr)     { setPlayerList(nullptr); }
    if (org.players != nullptr) {
-      players = org.players->clone();
-      players->unref();  // safe_ptr<> has it
+      base::PairStream* newList = org.players->clone();
+      setPlayerList(newList);
+      newList->unref();  // safe_ptr<> has it
    }
 
    // Timing
@@ -153,7 +160,7 @@ void Simulation::copyData(const Simulation& org, const bool)
 void Simulation::deleteData()
 {
    if (origPlayers != nullptr) { origPlayers = nullptr; }
-   if (players != nullptr)     { players = nullptr; }
+   if (players != nullptr)     { setPlayerList(nullptr); }
 
    base::Pair* newPlayer = newPlayerQueue.get();
    while (newPlayer != nullptr) {
@@ -241,7 +248,7 @@ void Simulation::reset()
    // ---
    // Swap the lists
    // ---
-   players = newList;
+   setPlayerList(newList);
 
    // ---
    // Create the T/C thread pool
@@ -545,29 +552,42 @@ void Simulation::updateTC(const double dt)
    // Called once per frame -- Process 4 phases per frame
    // ---
    {
-      // This locks the current player list for this time-critical frame
-      base::safe_ptr<base::PairStream> currentPlayerList = players;
+      // This locks the current player list (registry) for this time-critical frame
+      base::safe_ptr<PlayerRegistry> currentPlayers( registry.getRefPtr(), false );
+      tcCosts.resize(currentPlayers != nullptr ? currentPlayers->getNumPlayers() : 0);
 
+      static const char* const phaseNames[4] = { "phase0", "phase1", "phase2", "phase3" };
       for (unsigned int f = 0; f < 4; f++) {
+         base::ProfileScope ps(phaseNames[f], this);
 
          // Set the current phase
          setPhase(f);
 
-         if (reqTcThreads == 1) {
+         if (currentPlayers == nullptr) {
+            // No player list; nothing to do
+         }
+         else if (reqTcThreads == 1) {
             // Our single TC thread
-            updateTcPlayerList(currentPlayerList, (dt0/4.0), 1, 1);
+            updateTcPlayerList(currentPlayers, (dt0/4.0), 1, 1);
          }
          else if (numTcThreads > 0) {
+            // split this phase's players by their cost for this phase
+            for (unsigned int i = 0; i < tcCosts.size(); i++) {
+               const double c = currentPlayers->getPlayer(i)->getTcFrameCost(f);
+               tcCosts[i] = (c > MIN_PLAYER_COST ? c : MIN_PLAYER_COST);
+            }
+            tcScheduler.partition(tcCosts.data(), static_cast<unsigned int>(tcCosts.size()), reqTcThreads);
+
             // multiple threads
             for (unsigned short i = 0; i < numTcThreads; i++) {
 
                // assign the threads from the pool
                unsigned int idx = (i+1);
-               tcThreads[i]->start(currentPlayerList, (dt0/4.0), idx, reqTcThreads);
+               tcThreads[i]->start(currentPlayers, (dt0/4.0), idx, reqTcThreads);
             }
 
             // we're the last thread
-            updateTcPlayerList(currentPlayerList, (dt0/4.0), reqTcThreads, reqTcThreads);
+            updateTcPlayerList(currentPlayers, (dt0/4.0), reqTcThreads, reqTcThreads);
 
             // Now wait for the other thread(s) to complete
             base::SyncTask** pp = reinterpret_cast<base::SyncTask**>(&tcThreads[0]);
@@ -594,9 +614,39 @@ void Simulation::updateTC(const double dt)
 }
 
 //------------------------------------------------------------------------------
-// Time critical thread processing for every n'th player starting
-// with the idx'th player
+// Time critical thread processing -- for a single thread, all of the players;
+// for multiple threads, the chunks of players from the work-stealing schedule
 //------------------------------------------------------------------------------
+void Simulation::updateTcPlayerList(
+   PlayerRegistry* const playerList,
+   const double dt,
+   const unsigned int idx,
+   const unsigned int n)
+{
+   if (playerList == nullptr) return;
+
+   if (n > 1 && idx > 0) {
+      const unsigned int ph = phase();
+      unsigned int b = 0;
+      unsigned int e = 0;
+      while (tcScheduler.getNextChunk(idx-1, &b, &e)) {
+         for (unsigned int i = b; i < e; i++) {
+            AbstractPlayer* ip = playerList->getPlayer(i);
+            const double t0 = base::getComputerTime();
+            ip->tcFrame(dt);
+            ip->updateTcFrameCost(ph, base::getComputerTime() - t0);
+         }
+      }
+   }
+   else {
+      const unsigned int np = playerList->getNumPlayers();
+      for (unsigned int i = 0; i < np; i++) {
+         playerList->getPlayer(i)->tcFrame(dt);
+      }
+   }
+}
+
+// (Deprecated) Time critical thread processing of every n'th player on the list
 void Simulation::updateTcPlayerList(
    base::PairStream* const playerList,
    const double dt,
@@ -636,24 +686,32 @@ void Simulation::updateData(const double dt)
     updatePlayerList();
 
     // Update all players
-    if (players != nullptr) {
-         base::safe_ptr<base::PairStream> currentPlayerList = players;
+    if (registry != nullptr) {
+         base::safe_ptr<PlayerRegistry> currentPlayers( registry.getRefPtr(), false );
 
          if (reqBgThreads == 1) {
             // Our single thread
-            updateBgPlayerList(currentPlayerList, dt0, 1, 1);
+            updateBgPlayerList(currentPlayers, dt0, 1, 1);
          }
          else if (numBgThreads > 0) {
+            // split the players by their background cost
+            bgCosts.resize(currentPlayers->getNumPlayers());
+            for (unsigned int i = 0; i < bgCosts.size(); i++) {
+               const double c = currentPlayers->getPlayer(i)->getBgFrameCost();
+               bgCosts[i] = (c > MIN_PLAYER_COST ? c : MIN_PLAYER_COST);
+            }
+            bgScheduler.partition(bgCosts.data(), static_cast<unsigned int>(bgCosts.size()), reqBgThreads);
+
             // multiple threads
             for (unsigned short i = 0; i < numBgThreads; i++) {
 
                // assign the threads from the pool
                unsigned int idx = (i+1);
-               bgThreads[i]->start(currentPlayerList, dt0, idx, reqBgThreads);
+               bgThreads[i]->start(currentPlayers, dt0, idx, reqBgThreads);
             }
 
             // we're the last thread
-            updateBgPlayerList(currentPlayerList, dt0, reqBgThreads, reqBgThreads);
+            updateBgPlayerList(currentPlayers, dt0, reqBgThreads, reqBgThreads);
 
             // Now wait for the other thread(s) to complete
             base::SyncTask** pp = reinterpret_cast<base::SyncTask**>(&bgThreads[0]);
@@ -670,9 +728,43 @@ void Simulation::updateData(const double dt)
 }
 
 //------------------------------------------------------------------------------
-// Background thread processing for every n'th player starting
-// with the idx'th player
+// Background thread processing -- for a single thread, all of the players;
+// for multiple threads, the chunks of players from the work-stealing schedule
 //------------------------------------------------------------------------------
+void Simulation::updateBgPlayerList(
+         PlayerRegistry* const playerList,
+         const double dt,
+         const unsigned int idx,
+         const unsigned int n)
+{
+   if (playerList == nullptr) return;
+
+   if (n > 1 && idx > 0) {
+      unsigned int b = 0;
+      unsigned int e = 0;
+      while (bgScheduler.getNextChunk(idx-1, &b, &e)) {
+         for (unsigned int i = b; i < e; i++) {
+            AbstractPlayer* ip = playerList->getPlayer(i);
+            const double t0 = base::getComputerTime();
+            {
+               base::ProfileScope ps("updateData", ip);
+               ip->updateData(dt);
+            }
+            ip->updateBgFrameCost(base::getComputerTime() - t0);
+         }
+      }
+   }
+   else {
+      const unsigned int np = playerList->getNumPlayers();
+      for (unsigned int i = 0; i < np; i++) {
+         AbstractPlayer* ip = playerList->getPlayer(i);
+         base::ProfileScope ps("updateData", ip);
+         ip->updateData(dt);
+      }
+   }
+}
+
+// (Deprecated) Background thread processing of every n'th player on the list
 void Simulation::updateBgPlayerList(
          base::PairStream* const playerList,
          const double dt,
@@ -686,7 +778,7 @@ void Simulation::updateBgPlayerList(
       while (item != nullptr) {
          count++;
          if (count == index) {
-         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+            base::Pair* pair = static_cast<base::Pair*>(item->getValue());
             AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
             ip->updateData(dt);
             index += n;
@@ -727,6 +819,30 @@ const base::PairStream* Simulation::getPlayers() const
    return players.getRefPtr();
 }
 
+// Returns the player registry
+PlayerRegistry* Simulation::getPlayerRegistry()
+{
+   return registry.getRefPtr();
+}
+
+// Returns the player registry (const version)
+const PlayerRegistry* Simulation::getPlayerRegistry() const
+{
+   return registry.getRefPtr();
+}
+
+// Returns the player list's events
+PlayerEvents* Simulation::getPlayerEvents()
+{
+   return &playerEvents;
+}
+
+// Returns the player list's events (const version)
+const PlayerEvents* Simulation::getPlayerEvents() const
+{
+   return &playerEvents;
+}
+
 // Real-time cycle counter
 unsigned int Simulation::cycle() const
 {
@@ -802,7 +918,8 @@ AbstractDataRecorder* Simulation::getDataRecorder()
 {
    AbstractDataRecorder* p = nullptr;
    Station* sta = getStation();
-   if (sta != nullptr) p = sta->getDataRecorder();
+   // (no data recording while the station is degraded)
+   if (sta != nullptr && !sta->isDegraded()) p = sta->getDataRecorder();
    return p;
 }
 
@@ -844,7 +961,7 @@ bool Simulation::setSlotPlayers(base::PairStream* const pl)
    // Early out if we're just zeroing the player lists
    if (pl == nullptr) {
       origPlayers = nullptr;
-      players = nullptr;
+      setPlayerList(nullptr);
       return true;
    }
 
@@ -946,7 +1063,7 @@ bool Simulation::setSlotPlayers(base::PairStream* const pl)
       }
 
       // Set the active player list pointer
-      players = newList;
+      setPlayerList(newList);
       newList->unref();
    }
 
@@ -984,12 +1101,19 @@ void Simulation::updatePlayerList()
 
         // Update Required!
 
+        // (players are added and removed even while the station is degraded)
+        AbstractDataRecorder* recorder = (getStation() != nullptr ? getStation()->getDataRecorder() : nullptr);
+
         // ---
         // Something old and something new ...
         // ---
         base::safe_ptr<base::PairStream> newList( new base::PairStream() );
         newList->unref();  // 'newList' has it, so unref() from the 'new'
 
+        // removed and added players (to update the registry's indexes)
+        std::vector<AbstractPlayer*> removed;
+        std::vector<AbstractPlayer*> added;
+
         // ---
         // Copy players to the new list; except 'deleteRequest' mode players
         // ---
@@ -1007,8 +1131,11 @@ void Simulation::updatePlayerList()
                 // Deleting this player: remove us as its container
                 // and don't add to the new player list
                 p->container(nullptr);
+                p->setPlayerEvents(nullptr);
+                playerEvents.post(p, PlayerEvents::REMOVED);
+                removed.push_back(p);
 
-                BEGIN_RECORD_DATA_SAMPLE( getDataRecorder(), REID_PLAYER_REMOVED )
+                BEGIN_RECORD_DATA_SAMPLE( recorder, REID_PLAYER_REMOVED )
                    SAMPLE_1_OBJECT( p )
                 END_RECORD_DATA_SAMPLE()
             }
@@ -1022,7 +1149,7 @@ void Simulation::updatePlayerList()
             // get the player
             const auto ip = static_cast<AbstractPlayer*>(newPlayer->object());
 
-            BEGIN_RECORD_DATA_SAMPLE( getDataRecorder(), REID_NEW_PLAYER )
+            BEGIN_RECORD_DATA_SAMPLE( recorder, REID_NEW_PLAYER )
                SAMPLE_1_OBJECT( ip )
             END_RECORD_DATA_SAMPLE()
 
@@ -1032,6 +1159,9 @@ void Simulation::updatePlayerList()
 
             // Insert the new player into the new list in sorted order
             insertPlayerSort(newPlayer, newList);
+            ip->setPlayerEvents(&playerEvents);
+            playerEvents.post(ip, PlayerEvents::ADDED);
+            added.push_back(ip);
 
             newPlayer->unref();
 
@@ -1039,9 +1169,9 @@ void Simulation::updatePlayerList()
         }
 
         // ---
-        // Swap the lists
+        // Swap the lists (the changes have been posted to the player events)
         // ---
-        players = newList;
+        swapPlayerList(newList, removed, added);
     }
 }
 
@@ -1147,6 +1277,68 @@ bool Simulation::insertPlayerSort(base::Pair* const newPlayerPair, base::PairStr
 }
 
 
+//------------------------------------------------------------------------------
+// setPlayerList() -- Replaces the active player list; the changes are not
+//                    posted, so the player events are resync()'d
+//------------------------------------------------------------------------------
+void Simulation::setPlayerList(base::PairStream* const newList)
+{
+   setPlayerEvents(players, nullptr);
+   setPlayerEvents(newList, &playerEvents);
+   playerEvents.resync();
+   swapPlayerList(newList);
+}
+
+//------------------------------------------------------------------------------
+// setPlayerEvents() -- Sets the player events of all players on the list
+//------------------------------------------------------------------------------
+void Simulation::setPlayerEvents(base::PairStream* const list, PlayerEvents* const events)
+{
+   if (list != nullptr) {
+      base::List::Item* item = list->getFirstItem();
+      while (item != nullptr) {
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         static_cast<AbstractPlayer*>(pair->object())->setPlayerEvents(events);
+         item = item->getNext();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// swapPlayerList() -- Sets the active player list and its player registry
+//------------------------------------------------------------------------------
+void Simulation::swapPlayerList(base::PairStream* const newList)
+{
+   if (newList != nullptr) {
+      const auto reg = new PlayerRegistry(newList);
+      registry = reg;
+      reg->unref();  // safe_ptr<> has it
+   }
+   else {
+      registry = nullptr;
+   }
+   players = newList;
+}
+
+//------------------------------------------------------------------------------
+// swapPlayerList() -- Sets the active player list and its player registry,
+//                     which updates the current registry's indexes with the
+//                     removed and added players
+//------------------------------------------------------------------------------
+void Simulation::swapPlayerList(
+      base::PairStream* const newList,
+      const std::vector<AbstractPlayer*>& removed,
+      const std::vector<AbstractPlayer*>& added
+   )
+{
+   const PlayerRegistry* const prev = registry.getRefPtr();
+   const auto reg = new PlayerRegistry(newList, prev, removed, added);
+   if (prev != nullptr) prev->unref();
+   registry = reg;
+   reg->unref();  // safe_ptr<> has it
+   players = newList;
+}
+
 //------------------------------------------------------------------------------
 // findPlayer() -- Find a player that matches 'id' and 'networkID'
 //------------------------------------------------------------------------------
@@ -1162,33 +1354,13 @@ const AbstractPlayer* Simulation::findPlayer(const short id, const int netID) co
 
 AbstractPlayer* Simulation::findPlayerPrivate(const short id, const int netID) const
 {
-    // Quick out
-    if (players == nullptr) return nullptr;
-
-    // Find a Player that matches player ID and Sources
-    AbstractPlayer* iplayer = nullptr;
-    const base::List::Item* item = players->getFirstItem();
-    while (iplayer == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
-            if (ip != nullptr) {
-                if (netID > 0) {
-                    if ((ip->getID() == id) && (ip->getNetworkID() == netID)) {
-                        iplayer = ip;
-                    }
-                }
-                else {
-                    if (ip->getID() == id) {
-                        iplayer = ip;
-                    }
-                }
-            }
-        }
-        item = item->getNext();
-    }
-
-    return iplayer;
+   AbstractPlayer* iplayer = nullptr;
+   const PlayerRegistry* reg = registry.getRefPtr();
+   if (reg != nullptr) {
+      iplayer = reg->findPlayer(id, netID);
+      reg->unref();
+   }
+   return iplayer;
 }
 
 //------------------------------------------------------------------------------
@@ -1206,24 +1378,13 @@ const AbstractPlayer* Simulation::findPlayerByName(const char* const playerName)
 
 AbstractPlayer* Simulation::findPlayerByNamePrivate(const char* const playerName) const
 {
-    // Quick out
-    if (players == nullptr || playerName == nullptr) return nullptr;
-
-    // Find a Player named 'playerName'
-    AbstractPlayer* iplayer = nullptr;
-    const base::List::Item* item = players->getFirstItem();
-    while (iplayer == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
-            if (ip != nullptr && ip->isName(playerName)) {
-               iplayer = ip;
-            }
-        }
-        item = item->getNext();
-    }
-
-    return iplayer;
+   AbstractPlayer* iplayer = nullptr;
+   const PlayerRegistry* reg = registry.getRefPtr();
+   if (reg != nullptr) {
+      iplayer = reg->findPlayerByName(playerName);
+      reg->unref();
+   }
+   return iplayer;
 }
 
 //------------------------------------------------------------------------------
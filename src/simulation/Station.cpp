@@ -9,10 +9,12 @@
 #include "openeaagles/simulation/Simulation.hpp"
 
 #include "openeaagles/base/Color.hpp"
+#include "openeaagles/base/Identifier.hpp"
 #include "openeaagles/base/io/IoHandler.hpp"
 #include "openeaagles/base/Number.hpp"
 #include "openeaagles/base/Pair.hpp"
 #include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/Profiler.hpp"
 #include "openeaagles/base/Timers.hpp"
 #include "openeaagles/base/units/Times.hpp"
 
@@ -50,6 +52,11 @@ BEGIN_SLOTTABLE(Station)
    "startupResetTimer", // 16: Startup (initial) RESET event timer value (base::Time) (default: no reset event)
    "enableUpdateTimers",// 17: Enable calling base::Timers::updateTimers() from updateTC() (default: false)
    "dataRecorder",      // 18) Our Data Recorder
+   "profiler",          // 19) Frame profiler
+   "tcOverrunPolicy",   // 20: Time-critical thread frame overrun policy { catchUp, skip, degrade }
+   "tcMaxCatchUp",      // 21: Time-critical thread max catch-up frames (default: 0 -- no limit)
+   "tcCpu",             // 22: Time-critical thread CPU affinity (default: -1 -- none)
+   "tcRealtime",        // 23: Time-critical thread sets its own SCHED_FIFO priority (default: false)
 END_SLOTTABLE(Station)
 
 BEGIN_SLOT_MAP(Station)
@@ -82,6 +89,13 @@ BEGIN_SLOT_MAP(Station)
    ON_SLOT(17,  setSlotEnableUpdateTimers,    base::Number)
 
    ON_SLOT(18, setDataRecorder,               AbstractDataRecorder)
+
+   ON_SLOT(19, setProfiler,                   base::Profiler)
+
+   ON_SLOT(20, setSlotTimeCriticalOverrunPolicy, base::Identifier)
+   ON_SLOT(21, setSlotTimeCriticalMaxCatchUp,    base::Number)
+   ON_SLOT(22, setSlotTimeCriticalCpu,           base::Number)
+   ON_SLOT(23, setSlotTimeCriticalRealtime,      base::Number)
 END_SLOT_MAP()
 
 Station::Station()
@@ -145,10 +159,22 @@ void Station::copyData(const Station& org, const bool)
       if (copy != nullptr) copy->unref();
    }
 
+   {  // clone the profiler
+      base::Profiler* copy = nullptr;
+      if (org.profiler != nullptr) copy = org.profiler->clone();
+      setProfiler(copy);
+      if (copy != nullptr) copy->unref();
+   }
+
    tcRate = org.tcRate;
    tcPri = org.tcPri;
    tcStackSize = org.tcStackSize;
    fastForwardRate = org.fastForwardRate;
+   tcOverrunPolicy = org.tcOverrunPolicy;
+   tcMaxCatchUp = org.tcMaxCatchUp;
+   tcCpu = org.tcCpu;
+   tcRealtime = org.tcRealtime;
+   degraded = false;
 
    netRate = org.netRate;
    netPri = org.netPri;
@@ -201,6 +227,7 @@ void Station::deleteData()
    setSlotSimulation(nullptr);
    setSlotStartupResetTime(nullptr);
    setDataRecorder(nullptr);
+   setProfiler(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -292,14 +319,25 @@ void Station::updateTC(const double dt)
    // Process station inputs
    inputDevices(dt);
 
+   // Dead reckon the networks' incoming entities (before the simulation's frame)
+   if (networks != nullptr) {
+      base::List::Item* item = networks->getFirstItem();
+      while (item != nullptr) {
+         const auto pair = static_cast<base::Pair*>(item->getValue());
+         const auto p = static_cast<AbstractNetIO*>(pair->object());
+         p->deadReckoningFrame(dt);
+         item = item->getNext();
+      }
+   }
+
    // Update the simulation
    if (sim != nullptr) sim->tcFrame(dt);
 
    // Process station outputs
    outputDevices(dt);
 
-   // Our major subsystems
-   if (sim != nullptr && otw != nullptr) {
+   // Our major subsystems (not while degraded)
+   if (sim != nullptr && otw != nullptr && !degraded) {
       base::PairStream* playerList = sim->getPlayers();
       base::List::Item* item = otw->getFirstItem();
       while (item != nullptr) {
@@ -442,6 +480,9 @@ bool Station::shutdownNotification()
    // Shutdown the data recorder
    if (dataRecorder != nullptr) dataRecorder->event(SHUTDOWN_EVENT);
 
+   // Stop the profiler and write its trace
+   if (profiler != nullptr) profiler->event(SHUTDOWN_EVENT);
+
    return shutdown;
 }
 
@@ -484,8 +525,13 @@ void Station::outputDevices(const double dt)
 void Station::createTimeCriticalProcess()
 {
    if ( tcThread == nullptr ) {
-      tcThread = new TcThread(this, getTimeCriticalPriority(), getTimeCriticalRate());
-      tcThread->unref(); // 'tcThread' is a safe_ptr<>
+      TcThread* p = new TcThread(this, getTimeCriticalPriority(), getTimeCriticalRate());
+      p->setOverrunPolicy(tcOverrunPolicy);
+      p->setMaxCatchUpFrames(tcMaxCatchUp);
+      p->setCpuAffinity(tcCpu);
+      p->setRealtimeEnabled(tcRealtime);
+      tcThread = p;
+      p->unref(); // 'tcThread' is a safe_ptr<>
 
       if (tcStackSize > 0) tcThread->setStackSize( tcStackSize );
 
@@ -573,8 +619,8 @@ void Station::processBackgroundTasks(const double dt)
    // Our simulation model
    if (sim != nullptr) sim->updateData(dt);
 
-   // Our OTW interfaces
-   if (otw != nullptr) {
+   // Our OTW interfaces (not while degraded)
+   if (otw != nullptr && !degraded) {
       base::List::Item* item = otw ->getFirstItem();
       while (item != nullptr) {
          const auto pair = static_cast<base::Pair*>(item->getValue());
@@ -718,6 +764,18 @@ const AbstractDataRecorder* Station::getDataRecorder() const
    return dataRecorder;
 }
 
+// Returns the frame profiler
+base::Profiler* Station::getProfiler()
+{
+   return profiler;
+}
+
+// Returns the frame profiler (const version)
+const base::Profiler* Station::getProfiler() const
+{
+   return profiler;
+}
+
 // Time-critical thread rate (Hz)
 double Station::getTimeCriticalRate() const
 {
@@ -742,6 +800,43 @@ bool Station::doWeHaveTheTcThread() const
    return (tcThread != nullptr);
 }
 
+// Time-critical thread frame overrun policy
+base::PeriodicTask::OverrunPolicy Station::getTimeCriticalOverrunPolicy() const
+{
+   return tcOverrunPolicy;
+}
+
+// Time-critical thread max catch-up frames (or zero for no limit)
+unsigned int Station::getTimeCriticalMaxCatchUp() const
+{
+   return tcMaxCatchUp;
+}
+
+// Time-critical thread CPU affinity (or -1 for none)
+int Station::getTimeCriticalCpu() const
+{
+   return tcCpu;
+}
+
+// Time-critical thread sets its own SCHED_FIFO priority
+bool Station::isTimeCriticalRealtime() const
+{
+   return tcRealtime;
+}
+
+// The time-critical thread's frame statistics, or zero
+const base::PeriodicTask* Station::getTimeCriticalTask() const
+{
+   const base::Thread* p = tcThread;
+   return dynamic_cast<const base::PeriodicTask*>(p);
+}
+
+// Degraded mode
+bool Station::isDegraded() const
+{
+   return degraded;
+}
+
 // Pre-ref() pointer to the T/Cthread
 base::Thread* Station::getTcThread()
 {
@@ -976,6 +1071,17 @@ bool Station::setDataRecorder(AbstractDataRecorder* const p)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Sets the frame profiler
+//------------------------------------------------------------------------------
+bool Station::setProfiler(base::Profiler* const p)
+{
+   if (profiler != nullptr) { profiler->container(nullptr); profiler->unref(); }
+   profiler = p;
+   if (profiler != nullptr) { profiler->container(this); profiler->ref(); }
+   return true;
+}
+
 
 //-----------------------------------------------------------------------------
 // setSlotSimExec() -- Sets a pointer to our simulation executive
@@ -1333,6 +1439,46 @@ bool Station::setFastForwardRate(const unsigned int r)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Time-critical thread overrun handling and timing (set before creating the thread)
+//------------------------------------------------------------------------------
+bool Station::setTimeCriticalOverrunPolicy(const base::PeriodicTask::OverrunPolicy p)
+{
+   tcOverrunPolicy = p;
+   return true;
+}
+
+bool Station::setTimeCriticalMaxCatchUp(const unsigned int n)
+{
+   tcMaxCatchUp = n;
+   return true;
+}
+
+bool Station::setTimeCriticalCpu(const int cpu)
+{
+   tcCpu = (cpu >= 0 ? cpu : -1);
+   return true;
+}
+
+bool Station::setTimeCriticalRealtime(const bool flg)
+{
+   tcRealtime = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// setDegradedMode() -- enter or leave the degraded mode (called by the
+// time-critical thread with the 'degrade' overrun policy)
+//------------------------------------------------------------------------------
+void Station::setDegradedMode(const bool flg)
+{
+   const bool prev = degraded.exchange(flg);
+   if (flg != prev && isMessageEnabled(MSG_WARNING)) {
+      if (flg) std::cerr << "Station::setDegradedMode(): time-critical frame overrun; entering degraded mode" << std::endl;
+      else std::cerr << "Station::setDegradedMode(): leaving degraded mode" << std::endl;
+   }
+}
+
 //------------------------------------------------------------------------------
 // Sets the fast forward rate
 //------------------------------------------------------------------------------
@@ -1360,6 +1506,52 @@ bool Station::setSlotEnableUpdateTimers(const base::Number* const msg)
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// Time-critical thread overrun handling and timing slots
+//------------------------------------------------------------------------------
+bool Station::setSlotTimeCriticalOverrunPolicy(const base::Identifier* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "catchUp")      ok = setTimeCriticalOverrunPolicy(base::PeriodicTask::CATCH_UP);
+      else if (*msg == "skip")    ok = setTimeCriticalOverrunPolicy(base::PeriodicTask::SKIP);
+      else if (*msg == "degrade") ok = setTimeCriticalOverrunPolicy(base::PeriodicTask::DEGRADE);
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Station::setSlotTimeCriticalOverrunPolicy(): invalid policy: " << *msg;
+         std::cerr << "; use { catchUp, skip, degrade }" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Station::setSlotTimeCriticalMaxCatchUp(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) ok = setTimeCriticalMaxCatchUp(static_cast<unsigned int>(n));
+   }
+   return ok;
+}
+
+bool Station::setSlotTimeCriticalCpu(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setTimeCriticalCpu( msg->getInt() );
+   }
+   return ok;
+}
+
+bool Station::setSlotTimeCriticalRealtime(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setTimeCriticalRealtime( msg->getBoolean() );
+   }
+   return ok;
+}
+
 std::ostream& Station::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
 {
     int j = 0;
@@ -24,5 +24,11 @@ unsigned long TcThread::userFunc(const double dt)
    return 0;
 }
 
+void TcThread::degradedModeChanged(const bool degraded)
+{
+   Station* station = static_cast<Station*>(getParent());
+   station->setDegradedMode(degraded);
+}
+
 }
 }
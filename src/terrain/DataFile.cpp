@@ -315,6 +315,85 @@ bool DataFile::getElevation(
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Locates the elevations at an array of points (and sets valid flags if found)
+// returns the number of points found within this DataFile
+//------------------------------------------------------------------------------
+unsigned int DataFile::getElevationsAt(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of the arrays
+      const double* const lats,     // Latitudes of the points (degs)
+      const double* const lons,     // Longitudes of the points (degs)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr ||    // The elevation array wasn't provided, or
+        validFlags == nullptr ||    // the valid flag array wasn't provided, or
+        lats == nullptr ||          // the points weren't provided, or
+        lons == nullptr ||
+        !isDataLoaded()             // the data isn't loaded
+      ) return num;
+
+   // Upper limit points
+   const double maxLatPoint = static_cast<double>(nptlat-1);
+   const double maxLonPoint = static_cast<double>(nptlong-1);
+
+   const double swLat = getLatitudeSW();
+   const double swLon = getLongitudeSW();
+   const double latScale = 1.0 / latSpacing;
+   const double lonScale = 1.0 / lonSpacing;
+
+   for (unsigned int i = 0; i < n; i++) {
+
+      // Point within our data array
+      const double pointsLat = (lats[i] - swLat) * latScale;
+      const double pointsLon = (lons[i] - swLon) * lonScale;
+
+      if ( !validFlags[i] &&                                // Not already found and
+          (pointsLat >= 0 && pointsLat <= maxLatPoint) &&   // and within latitude range and
+          (pointsLon >= 0 && pointsLon <= maxLonPoint) ) {  // and within longitude range ...
+
+         double value = 0;          // the elevation (meters)
+         if (interp) {
+            // South-west corner post is [icol][irow]
+            unsigned int irow = static_cast<unsigned int>(pointsLat);
+            unsigned int icol = static_cast<unsigned int>(pointsLon);
+            if (irow > (nptlat-2)) irow = (nptlat-2);
+            if (icol > (nptlong-2)) icol = (nptlong-2);
+
+            // delta from s-w corner post
+            const double deltaLat = pointsLat - static_cast<double>(irow);
+            const double deltaLon = pointsLon - static_cast<double>(icol);
+
+            // Interpolate the west and east points, and then between them
+            const short* const west = columns[icol];
+            const short* const east = columns[icol+1];
+            const double westPoint = west[irow] + (west[irow+1] - west[irow]) * deltaLat;
+            const double eastPoint = east[irow] + (east[irow+1] - east[irow]) * deltaLat;
+            value = westPoint + (eastPoint - westPoint) * deltaLon;
+         }
+         else {
+            // Nearest post
+            unsigned int irow = static_cast<unsigned int>(pointsLat + 0.5);
+            unsigned int icol = static_cast<unsigned int>(pointsLon + 0.5);
+            if (irow >= nptlat) irow = (nptlat-1);
+            if (icol >= nptlong) icol = (nptlong-1);
+            value = static_cast<double>(columns[icol][irow]);
+         }
+
+         elevations[i] = value;
+         validFlags[i] = true;
+         num++;
+      }
+   }
+
+   return num;
+}
+
 //------------------------------------------------------------------------------
 // Computes the nearest row index for the latitude (degs).
 // Returns true if the index is valid
@@ -136,6 +136,26 @@ bool QuadMap::getElevation(
    return found;
 }
 
+//------------------------------------------------------------------------------
+// Locates the elevations at an array of points (and sets valid flags if found)
+// returns the number of points found within this QuadMap
+//------------------------------------------------------------------------------
+unsigned int QuadMap::getElevationsAt(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of the arrays
+      const double* const lats,     // Latitudes of the points (degs)
+      const double* const lons,     // Longitudes of the points (degs)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+   for (unsigned int i = 0; i < numDataFiles && num < n; i++) {
+      num += dataFiles[i]->getElevationsAt(elevations, validFlags, n, lats, lons, interp);
+   }
+   return num;
+}
+
 
 //------------------------------------------------------------------------------
 // Initializes the channel array
@@ -9,11 +9,15 @@
 #include "openeaagles/base/String.hpp"
 
 #include "openeaagles/base/util/nav_utils.hpp"
+#include "openeaagles/base/units/angle_utils.hpp"
+#include "openeaagles/base/units/distance_utils.hpp"
 
 #include "openeaagles/base/osg/Vec2d"
 #include "openeaagles/base/osg/Vec3d"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace oe {
 namespace terrain {
@@ -291,6 +295,161 @@ bool Terrain::targetOcculting2(
    return occulted;
 }
 
+//------------------------------------------------------------------------------
+// Locates the elevations at an array of points (and sets valid flags if
+// found); returns the number of points found.  Points with their valid
+// flags already set are skipped.
+//------------------------------------------------------------------------------
+unsigned int Terrain::getElevationsAt(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of the arrays
+      const double* const lats,     // Latitudes of the points (degs)
+      const double* const lons,     // Longitudes of the points (degs)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr ||    // The elevation array wasn't provided, or
+        validFlags == nullptr ||    // the valid flag array wasn't provided, or
+        lats == nullptr ||          // the points weren't provided
+        lons == nullptr
+      ) return num;
+
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i] && getElevation(&elevations[i], lats[i], lons[i], interp)) {
+         validFlags[i] = true;
+         num++;
+      }
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Batched target occulting: checks 'n' targets as seen from the ref point, and
+// sets bit 'i%32' of word 'i/32' of the 'visible' mask if target 'i' isn't
+// occulted.  Returns the number of visible targets.
+//
+// Each target is checked the same as targetOcculting(), but the profile's
+// points are located in blocks using getElevationsAt(), and the check stops
+// at the first block with an occulting point.  Only the interior points are
+// located; the end points aren't used by occultCheck().  The points are
+// stepped in latitude and longitude the same as TiledTerrain::getElevations()
+// (DataFile::getElevations() steps in post units, so only a point that's
+// halfway between two posts could round to the other post), and the line of
+// sight check is occultCheck()'s arithmetic.
+//------------------------------------------------------------------------------
+unsigned int Terrain::targetOccultingMask(
+      const double refLat,          // Ref latitude (degs)
+      const double refLon,          // Ref longitude (degs)
+      const double refAlt,          // Ref altitude (meters)
+      const double* const tgtLats,  // Target latitudes (degs)
+      const double* const tgtLons,  // Target longitudes (degs)
+      const double* const tgtAlts,  // Target altitudes (meters)
+      const unsigned int n,         // Number of targets
+      unsigned int* const visible,  // Visibility mask ((n+31)/32 words)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   // Same number of points as targetOcculting()
+   static const unsigned int MAX_POINTS = 1200;
+   static const unsigned int BLOCK_SIZE = 64;
+   static const double NOT_FOUND = -std::numeric_limits<double>::infinity();
+
+   if (visible == nullptr) return 0;
+   for (unsigned int i = 0; i < (n + 31) / 32; i++) {
+      visible[i] = 0;
+   }
+   if (tgtLats == nullptr || tgtLons == nullptr || tgtAlts == nullptr) return 0;
+
+   // Profiles can't start at the poles (see getElevations())
+   const bool validRef = (refLat >= -89.0 && refLat <= 89.0);
+   const double cosRefLat = std::cos(refLat * base::angle::D2RCC);
+
+   // Block of profile points
+   double lats[BLOCK_SIZE];
+   double lons[BLOCK_SIZE];
+   double ranges[BLOCK_SIZE];
+   double elevations[BLOCK_SIZE];
+   bool validFlags[BLOCK_SIZE];
+
+   unsigned int numVisible = 0;
+   for (unsigned int t = 0; t < n; t++) {
+
+      bool occulted = false;
+
+      // Compute bearing and distance to target (flat earth)
+      double brgDeg = 0.0;
+      double distNM = 0.0;
+      base::nav::fll2bd(refLat, refLon, tgtLats[t], tgtLons[t], &brgDeg, &distNM);
+      const double dist = (distNM * base::distance::NM2M);
+
+      // Number of points (default: 100M data)
+      unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
+      if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+
+      // Profiles with interior points
+      if (numPts > 2 && validRef) {
+
+         // Spacing between points (see getElevations())
+         const double deltaRng = dist / (numPts - 1);
+         const double dirR = brgDeg * base::angle::D2RCC;
+         const double deltaLat = (deltaRng * std::cos(dirR) * base::distance::M2NM) / 60.0;
+         const double deltaLon = (deltaRng * std::sin(dirR) * base::distance::M2NM) / (60.0 * cosRefLat);
+
+         // Tangent of the angle to the target point (see occultCheck())
+         const double tgtTan = (tgtAlts[t] - refAlt) / dist;
+
+         // First interior point
+         double pointLat = refLat + deltaLat;
+         double pointLon = refLon + deltaLon;
+         double currentRange = 0;
+
+         for (unsigned int k0 = 1; k0 < (numPts - 1) && !occulted; k0 += BLOCK_SIZE) {
+            const unsigned int nb = std::min(BLOCK_SIZE, (numPts - 1) - k0);
+
+            // Block's points
+            for (unsigned int j = 0; j < nb; j++) {
+               lats[j] = pointLat;
+               lons[j] = pointLon;
+               currentRange += deltaRng;
+               ranges[j] = currentRange;
+               elevations[j] = NOT_FOUND;
+               validFlags[j] = false;
+               pointLat += deltaLat;
+               pointLon += deltaLon;
+            }
+            for (unsigned int j = nb; j < BLOCK_SIZE; j++) {
+               ranges[j] = 1.0;
+               elevations[j] = NOT_FOUND;
+            }
+            getElevationsAt(elevations, validFlags, nb, lats, lons, interp);
+
+            // Any point on or above the line of sight?  The points that
+            // weren't found are still NOT_FOUND, which is below any line of
+            // sight, so the loop doesn't need the valid flags and the
+            // compiler can vectorize it.
+            double masked = 0.0;
+            for (unsigned int j = 0; j < BLOCK_SIZE; j++) {
+               const double tstTan = (elevations[j] - refAlt) / ranges[j];
+               masked = (tstTan >= tgtTan ? 1.0 : masked);
+            }
+            occulted = (masked != 0.0);
+         }
+      }
+
+      if (!occulted) {
+         visible[t / 32] |= (1u << (t % 32));
+         numVisible++;
+      }
+   }
+
+   return numVisible;
+}
+
 //------------------------------------------------------------------------------
 // Occulting check: returns true if a target at the altitude 'tgtAlt' and
 // range 'range' is occulted by the elevation points as seen from the
@@ -0,0 +1,939 @@
+#include "openeaagles/terrain/TiledTerrain.hpp"
+
+#include "openeaagles/base/Number.hpp"
+#include "openeaagles/base/util/atomics.hpp"
+#include "openeaagles/base/units/angle_utils.hpp"
+#include "openeaagles/base/units/distance_utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if defined(WIN32)
+  #include <io.h>
+#else
+  #include <dirent.h>
+  #include <sys/stat.h>
+#endif
+
+namespace oe {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(TiledTerrain, "TiledTerrain")
+
+BEGIN_SLOTTABLE(TiledTerrain)
+   "tileSize",    // 1) Size of the tiles (posts per side)
+   "cacheSize",   // 2) Max number of cached tiles
+END_SLOTTABLE(TiledTerrain)
+
+BEGIN_SLOT_MAP(TiledTerrain)
+   ON_SLOT(1, setSlotTileSize,  base::Number)
+   ON_SLOT(2, setSlotCacheSize, base::Number)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+static const unsigned int MIN_TILE_SIZE = 16;
+static const unsigned int MIN_CACHE_SIZE = 4;
+
+static const unsigned int NUM_GRID_LAT = 180;         // 1x1 degree cells
+static const unsigned int NUM_GRID_LON = 360;
+
+// DTED headers: UHL (80 bytes), DSI (648 bytes) and ACC (2700 bytes)
+static const std::streamoff DTED_UHL_SIZE = 80;
+static const std::streamoff DTED_DATA_OFFSET = 80 + 648 + 2700;
+static const std::streamoff DTED_COLUMN_HEADER_SIZE = 8;
+static const std::streamoff DTED_COLUMN_FOOTER_SIZE = 4;
+
+// SRTM file sizes
+static const std::streamoff SRTM3_FILE_SIZE = 2884802;
+static const std::streamoff SRTM1_FILE_SIZE = 25934402;
+
+TiledTerrain::TiledTerrain()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void TiledTerrain::copyData(const TiledTerrain& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   tileSize = org.tileSize;
+   cacheSize = org.cacheSize;
+
+   // Copy the cell index; our cache starts empty
+   cells = org.cells;
+   cellGrid = org.cellGrid;
+}
+
+void TiledTerrain::deleteData()
+{
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// Access functions
+//------------------------------------------------------------------------------
+
+// Has the data been loaded
+bool TiledTerrain::isDataLoaded() const
+{
+   return !cells.empty();
+}
+
+// Number of tiles in the cache
+unsigned int TiledTerrain::getNumCachedTiles() const
+{
+   base::lock(cacheLock);
+   const unsigned int n = static_cast<unsigned int>(cache.size());
+   base::unlock(cacheLock);
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool TiledTerrain::setTileSize(const unsigned int n)
+{
+   bool ok = false;
+   if (n >= MIN_TILE_SIZE) {
+      clearCache();
+      tileSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool TiledTerrain::setCacheSize(const unsigned int n)
+{
+   bool ok = false;
+   if (n >= MIN_CACHE_SIZE) {
+      clearCache();
+      cacheSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+void TiledTerrain::clearCacheStats()
+{
+   base::lock(cacheLock);
+   cacheHits = 0;
+   cacheMisses = 0;
+   cacheEvictions = 0;
+   base::unlock(cacheLock);
+}
+
+// Removes all tiles from the cache
+void TiledTerrain::clearCache()
+{
+   std::vector<Tile> tiles;
+   base::lock(cacheLock);
+   cache.swap(tiles);
+   tileSlots.clear();
+   lruHead = -1;
+   lruTail = -1;
+   base::unlock(cacheLock);
+
+   base::lock(fileLock);
+   if (cellFile.is_open()) cellFile.close();
+   cellFileIdx = -1;
+   std::vector<unsigned char>().swap(readBuffer);
+   base::unlock(fileLock);
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool TiledTerrain::setSlotTileSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= static_cast<int>(MIN_TILE_SIZE)) {
+         ok = setTileSize(static_cast<unsigned int>(n));
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledTerrain::setSlotTileSize(): invalid tile size: " << n;
+         std::cerr << "; min is " << MIN_TILE_SIZE << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool TiledTerrain::setSlotCacheSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= static_cast<int>(MIN_CACHE_SIZE)) {
+         ok = setCacheSize(static_cast<unsigned int>(n));
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledTerrain::setSlotCacheSize(): invalid cache size: " << n;
+         std::cerr << "; min is " << MIN_CACHE_SIZE << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Locates an array of (at least two) elevation points (and sets valid flags if found)
+// returns the number of points found within this database
+//------------------------------------------------------------------------------
+unsigned int TiledTerrain::getElevations(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of elevation and valdFlags arrays
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const double direction,       // True direction (heading) angle of the data (degs)
+      const double maxRng,          // Range to last elevation point (meters)
+      const bool interp            // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr ||       // The elevation array wasn't provided, or
+        validFlags == nullptr ||       // the valid flag array wasn't provided, or
+        n < 2 ||                       // there are too few points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0 ||                 // the max range is less than or equal to zero
+        !isDataLoaded()                // the data isn't loaded
+      ) return num;
+
+   // Spacing between points (degs)
+   const double deltaPoint = maxRng / (n - 1);
+   const double dirR = direction * base::angle::D2RCC;
+   const double deltaNorth = deltaPoint * std::cos(dirR) * base::distance::M2NM;  // (NM)
+   const double deltaEast  = deltaPoint * std::sin(dirR) * base::distance::M2NM;
+   const double deltaLat = deltaNorth/60.0;
+   const double deltaLon = deltaEast/(60.0 * std::cos(lat * base::angle::D2RCC));
+
+   // ---
+   // Loop for the number of points in the arrays
+   // ---
+   double pointLat = lat;
+   double pointLon = lon;
+
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i]) {
+         double value = 0;
+         if (lookup(&value, pointLat, pointLon, interp)) {
+            elevations[i] = value;
+            validFlags[i] = true;
+            num++;
+         }
+      }
+      pointLat += deltaLat;
+      pointLon += deltaLon;
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates an elevation value (meters) for a given reference point and returns
+// it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+//------------------------------------------------------------------------------
+bool TiledTerrain::getElevation(
+      double* const elev,     // The elevation value (meters)
+      const double lat,       // Reference latitude (degs)
+      const double lon,       // Reference longitude (degs)
+      const bool interp       // Interpolate between elevation posts (if true)
+   ) const
+{
+   // Early out tests
+   if ( elev == nullptr ||          // No elevation pointer, or
+        !isDataLoaded()             // not loaded
+      ) return false;
+
+   double value = 0.0;
+   const bool found = lookup(&value, lat, lon, interp);
+
+   if (found) {
+      *elev = value;
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevations at an array of points (and sets valid flags if found)
+// returns the number of points found
+//------------------------------------------------------------------------------
+unsigned int TiledTerrain::getElevationsAt(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of the arrays
+      const double* const lats,     // Latitudes of the points (degs)
+      const double* const lons,     // Longitudes of the points (degs)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr ||    // The elevation array wasn't provided, or
+        validFlags == nullptr ||    // the valid flag array wasn't provided, or
+        lats == nullptr ||          // the points weren't provided, or
+        lons == nullptr ||
+        !isDataLoaded()             // the data isn't loaded
+      ) return num;
+
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i] && lookup(&elevations[i], lats[i], lons[i], interp)) {
+         validFlags[i] = true;
+         num++;
+      }
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevation at a point.  The cache is locked only while the tile
+// is looked up and its posts are used; a missing tile is read from its cell
+// file with the cache unlocked, and then added to the cache.
+//------------------------------------------------------------------------------
+bool TiledTerrain::lookup(double* const elev, const double lat, const double lon, const bool interp) const
+{
+   int icell = -1;
+   const Cell* cell = findCell(lat, lon, &icell);
+   if (cell == nullptr) return false;
+
+   // ---
+   // Compute the lat and lon points
+   // ---
+   const double maxLatPoint = static_cast<double>(cell->nptlat - 1);
+   const double maxLonPoint = static_cast<double>(cell->nptlong - 1);
+
+   double pointsLat = (lat - cell->swLat) / cell->latSpacing;
+   if (pointsLat < 0) pointsLat = 0;
+   if (pointsLat > maxLatPoint) pointsLat = maxLatPoint;
+
+   double pointsLon = (lon - cell->swLon) / cell->lonSpacing;
+   if (pointsLon < 0) pointsLon = 0;
+   if (pointsLon > maxLonPoint) pointsLon = maxLonPoint;
+
+   // ---
+   // Post [icol][irow]: the south-west corner post, if interpolating between
+   // elevation posts, else the nearest post.
+   // ---
+   unsigned int irow = 0;
+   unsigned int icol = 0;
+   if (interp) {
+      irow = static_cast<unsigned int>(pointsLat);
+      icol = static_cast<unsigned int>(pointsLon);
+      if (irow > (cell->nptlat-2)) irow = (cell->nptlat-2);
+      if (icol > (cell->nptlong-2)) icol = (cell->nptlong-2);
+   }
+   else {
+      irow = static_cast<unsigned int>(pointsLat + 0.5);
+      icol = static_cast<unsigned int>(pointsLon + 0.5);
+      if (irow >= cell->nptlat) irow = (cell->nptlat-1);
+      if (icol >= cell->nptlong) icol = (cell->nptlong-1);
+   }
+
+   // delta from s-w corner post
+   const double deltaLat = pointsLat - static_cast<double>(irow);
+   const double deltaLon = pointsLon - static_cast<double>(icol);
+
+   // Cache hit?
+   double value = 0;
+   base::lock(cacheLock);
+   const Tile* tile = findTile(icell, irow, icol);
+   if (tile != nullptr) value = tileElevation(*tile, irow, icol, deltaLat, deltaLon, interp);
+   base::unlock(cacheLock);
+
+   if (tile == nullptr) {
+      // No -- read the tile, and then add it to the cache
+      Tile tmp;
+      initTile(&tmp, icell, irow, icol);
+      if (!readTile(&tmp, *cell)) return false;
+
+      base::lock(cacheLock);
+      tile = insertTile(&tmp);
+      value = tileElevation(*tile, irow, icol, deltaLat, deltaLon, interp);
+      base::unlock(cacheLock);
+   }
+
+   *elev = value;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Returns the elevation at post [icol][irow] of a tile, or interpolated
+// between it and the posts to its north and east.
+//------------------------------------------------------------------------------
+double TiledTerrain::tileElevation(
+      const Tile& tile,
+      const unsigned int irow,
+      const unsigned int icol,
+      const double deltaLat,
+      const double deltaLon,
+      const bool interp
+   ) const
+{
+   const short* west = &tile.posts[(icol - tile.col0) * tile.nrows + (irow - tile.row0)];
+   if (!interp) return static_cast<double>(west[0]);
+
+   // Get the elevations at each corner (the tile includes the posts north
+   // and east of [icol][irow])
+   const short* east = west + tile.nrows;
+   const double elevSW = static_cast<double>(west[0]);
+   const double elevNW = static_cast<double>(west[1]);
+   const double elevSE = static_cast<double>(east[0]);
+   const double elevNE = static_cast<double>(east[1]);
+
+   // Interpolate the west point
+   const double westPoint = elevSW + (elevNW - elevSW) * deltaLat;
+
+   // Interpolate the east point
+   const double eastPoint = elevSE + (elevNE - elevSE) * deltaLat;
+
+   // Interpolate between the west and east points
+   return westPoint + (eastPoint - westPoint) * deltaLon;
+}
+
+//------------------------------------------------------------------------------
+// Finds the cell that contains a point.  Points on the edge of a missing
+// cell are found in its neighbor, if any (the cells' edge posts overlap).
+//------------------------------------------------------------------------------
+const TiledTerrain::Cell* TiledTerrain::findCell(const double lat, const double lon, int* const idx) const
+{
+   if ( (lat < -90.0 || lat > 90.0) ||
+        (lon < -180.0 || lon > 180.0) ||
+        cellGrid.empty()
+      ) return nullptr;
+
+   const double flat = std::floor(lat);
+   const double flon = std::floor(lon);
+   int ilat = static_cast<int>(flat) + 90;
+   int ilon = static_cast<int>(flon) + 180;
+   if (ilat >= static_cast<int>(NUM_GRID_LAT)) ilat = NUM_GRID_LAT - 1;
+   if (ilon >= static_cast<int>(NUM_GRID_LON)) ilon = NUM_GRID_LON - 1;
+
+   int icell = cellGrid[ilat * NUM_GRID_LON + ilon];
+   if (icell < 0) {
+      // On a southern or western edge?
+      const bool latEdge = (lat == flat && ilat > 0);
+      const bool lonEdge = (lon == flon && ilon > 0);
+      if (latEdge) icell = cellGrid[(ilat - 1) * NUM_GRID_LON + ilon];
+      if (icell < 0 && lonEdge) icell = cellGrid[ilat * NUM_GRID_LON + (ilon - 1)];
+      if (icell < 0 && latEdge && lonEdge) icell = cellGrid[(ilat - 1) * NUM_GRID_LON + (ilon - 1)];
+   }
+
+   const Cell* p = nullptr;
+   if (icell >= 0) {
+      p = &cells[icell];
+      *idx = icell;
+   }
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// Returns the index of the tile that contains post [icol][irow] of a cell,
+// its row and column of tiles, and the cell's number of tiles.
+//
+// Tile layout: tile [tc][tr] starts at post [tc * tileSize][tr * tileSize] and
+// includes the first row and column of the next tiles.
+//------------------------------------------------------------------------------
+unsigned int TiledTerrain::tileIndex(
+      const Cell& cell,
+      const unsigned int irow,
+      const unsigned int icol,
+      unsigned int* const tr,
+      unsigned int* const tc,
+      unsigned int* const ntiles
+   ) const
+{
+   const unsigned int ntrows = std::max(1u, (cell.nptlat - 1 + tileSize - 1) / tileSize);
+   const unsigned int ntcols = std::max(1u, (cell.nptlong - 1 + tileSize - 1) / tileSize);
+   *tr = std::min(irow / tileSize, ntrows - 1);
+   *tc = std::min(icol / tileSize, ntcols - 1);
+   *ntiles = ntrows * ntcols;
+   return *tc * ntrows + *tr;
+}
+
+//------------------------------------------------------------------------------
+// Sets up an (unused) tile for the tile that contains post [icol][irow] of a cell
+//------------------------------------------------------------------------------
+void TiledTerrain::initTile(Tile* const tile, const int icell, const unsigned int irow, const unsigned int icol) const
+{
+   const Cell& cell = cells[icell];
+   unsigned int tr = 0, tc = 0, ntiles = 0;
+   tile->cell = icell;
+   tile->index = tileIndex(cell, irow, icol, &tr, &tc, &ntiles);
+   tile->row0 = tr * tileSize;
+   tile->col0 = tc * tileSize;
+   tile->nrows = std::min(tileSize + 1, cell.nptlat - tile->row0);
+   tile->ncols = std::min(tileSize + 1, cell.nptlong - tile->col0);
+   tile->posts.resize(tile->nrows * tile->ncols);
+}
+
+//------------------------------------------------------------------------------
+// Returns the cached tile that contains post [icol][irow] of a cell, or zero
+// if it's not in the cache; the cache must be locked.
+//------------------------------------------------------------------------------
+const TiledTerrain::Tile* TiledTerrain::findTile(const int icell, const unsigned int irow, const unsigned int icol) const
+{
+   // Same tile as the last lookup (i.e., the most recently used tile)?
+   if (lruHead >= 0) {
+      const Tile& head = cache[lruHead];
+      if (head.cell == icell && (irow - head.row0) < tileSize && (icol - head.col0) < tileSize) {
+         cacheHits++;
+         return &head;
+      }
+   }
+
+   unsigned int tr = 0, tc = 0, ntiles = 0;
+   const unsigned int index = tileIndex(cells[icell], irow, icol, &tr, &tc, &ntiles);
+
+   if (tileSlots.size() < cells.size()) tileSlots.resize(cells.size());
+   std::vector<int>& slots = tileSlots[icell];
+   if (slots.empty()) slots.assign(ntiles, -1);
+
+   const int slot = slots[index];
+   if (slot < 0) return nullptr;
+
+   cacheHits++;
+   if (slot != lruHead) touch(slot);
+   return &cache[slot];
+}
+
+//------------------------------------------------------------------------------
+// Adds a tile, which was read from its cell file, to the cache (its posts are
+// swapped with the slot's) and returns the cached tile; the cache must be locked.
+//------------------------------------------------------------------------------
+const TiledTerrain::Tile* TiledTerrain::insertTile(Tile* const tile) const
+{
+   if (tileSlots.size() < cells.size()) tileSlots.resize(cells.size());
+   std::vector<int>& slots = tileSlots[tile->cell];
+   if (slots.empty()) {
+      unsigned int tr = 0, tc = 0, ntiles = 0;
+      tileIndex(cells[tile->cell], tile->row0, tile->col0, &tr, &tc, &ntiles);
+      slots.assign(ntiles, -1);
+   }
+
+   // Added by another thread while we were reading it?
+   int slot = slots[tile->index];
+   if (slot >= 0) {
+      if (slot != lruHead) touch(slot);
+      return &cache[slot];
+   }
+
+   // No -- use a new slot or the least recently used one
+   cacheMisses++;
+   if (cache.size() < cacheSize) {
+      cache.emplace_back();
+      slot = static_cast<int>(cache.size() - 1);
+   }
+   else {
+      slot = lruTail;
+      unlink(slot);
+      const Tile& old = cache[slot];
+      if (old.cell >= 0) {
+         tileSlots[old.cell][old.index] = -1;
+         cacheEvictions++;
+      }
+   }
+
+   Tile& p = cache[slot];
+   p.posts.swap(tile->posts);
+   p.row0 = tile->row0;
+   p.col0 = tile->col0;
+   p.nrows = tile->nrows;
+   p.ncols = tile->ncols;
+   p.cell = tile->cell;
+   p.index = tile->index;
+
+   slots[p.index] = slot;
+   p.prev = -1;
+   p.next = lruHead;
+   if (lruHead >= 0) cache[lruHead].prev = slot;
+   lruHead = slot;
+   if (lruTail < 0) lruTail = slot;
+
+   return &p;
+}
+
+//------------------------------------------------------------------------------
+// Moves a cache slot to the front of the LRU list
+//------------------------------------------------------------------------------
+void TiledTerrain::touch(const int slot) const
+{
+   unlink(slot);
+   Tile& tile = cache[slot];
+   tile.prev = -1;
+   tile.next = lruHead;
+   if (lruHead >= 0) cache[lruHead].prev = slot;
+   lruHead = slot;
+   if (lruTail < 0) lruTail = slot;
+}
+
+//------------------------------------------------------------------------------
+// Removes a cache slot from the LRU list
+//------------------------------------------------------------------------------
+void TiledTerrain::unlink(const int slot) const
+{
+   Tile& tile = cache[slot];
+   if (tile.prev >= 0) cache[tile.prev].next = tile.next;
+   else lruHead = tile.next;
+   if (tile.next >= 0) cache[tile.next].prev = tile.prev;
+   else lruTail = tile.prev;
+   tile.prev = -1;
+   tile.next = -1;
+}
+
+//------------------------------------------------------------------------------
+// Reads a tile's posts from its cell file; the cache must not be locked (the
+// cell file is locked by 'fileLock').
+//------------------------------------------------------------------------------
+bool TiledTerrain::readTile(Tile* const tile, const Cell& cell) const
+{
+   base::lock(fileLock);
+
+   // (Re)open the cell file
+   if (cellFileIdx != tile->cell || !cellFile.is_open()) {
+      if (cellFile.is_open()) cellFile.close();
+      cellFile.clear();
+      cellFileIdx = -1;
+      cellFile.open(cell.filename.c_str(), std::ios::binary);
+      if (cellFile.fail()) {
+         base::unlock(fileLock);
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "TiledTerrain::readTile() ERROR, could not open file: " << cell.filename << std::endl;
+         }
+         return false;
+      }
+      cellFileIdx = tile->cell;
+   }
+
+   // Read the tile's span of column records (DTED) or rows (SRTM) at once
+   std::streamoff pos = 0;
+   std::streamoff size = 0;
+   std::streamoff stride = 0;
+   if (cell.format == DTED) {
+      stride = DTED_COLUMN_HEADER_SIZE + 2 * cell.nptlat + DTED_COLUMN_FOOTER_SIZE;
+      pos = DTED_DATA_OFFSET + tile->col0 * stride;
+      size = tile->ncols * stride;
+   }
+   else {
+      stride = 2 * cell.nptlong;
+      pos = (cell.nptlat - tile->row0 - tile->nrows) * stride;
+      size = tile->nrows * stride;
+   }
+   if (readBuffer.size() < static_cast<std::size_t>(size)) readBuffer.resize(static_cast<std::size_t>(size));
+
+   cellFile.seekg(pos, std::ios::beg);
+   cellFile.read(reinterpret_cast<char*>(&readBuffer[0]), size);
+   const bool ok = !cellFile.fail();
+
+   if (ok && cell.format == DTED) {
+      // Column records, south to north; signed magnitude, high byte first
+      for (unsigned int c = 0; c < tile->ncols; c++) {
+         const unsigned char* p = &readBuffer[c * stride + DTED_COLUMN_HEADER_SIZE + 2 * tile->row0];
+         short* posts = &tile->posts[c * tile->nrows];
+         for (unsigned int r = 0; r < tile->nrows; r++) {
+            const short mag = static_cast<short>(((p[2 * r] & 0x7f) << 8) | p[2 * r + 1]);
+            posts[r] = ((p[2 * r] & 0x80) != 0 ? -mag : mag);
+         }
+      }
+   }
+   else if (ok) {
+      // Rows, north to south; two's complement, high byte first
+      for (unsigned int r = 0; r < tile->nrows; r++) {
+         const unsigned char* p = &readBuffer[(tile->nrows - 1 - r) * stride + 2 * tile->col0];
+         short* posts = &tile->posts[r];
+         for (unsigned int c = 0; c < tile->ncols; c++) {
+            const int v = (p[2 * c] << 8) | p[2 * c + 1];
+            posts[c * tile->nrows] = static_cast<short>(v >= 0x8000 ? v - 0x10000 : v);
+         }
+      }
+   }
+
+   if (!ok) {
+      cellFile.close();
+      cellFileIdx = -1;
+   }
+
+   base::unlock(fileLock);
+
+   if (!ok && isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "TiledTerrain::readTile() ERROR reading data from file: " << cell.filename << std::endl;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Index the cells in our directory
+//------------------------------------------------------------------------------
+bool TiledTerrain::loadData()
+{
+   clearData();
+
+   const char* p = getPathname();
+   if (p == nullptr) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledTerrain::loadData() ERROR, no path name" << std::endl;
+      }
+      return false;
+   }
+
+   cellGrid.assign(NUM_GRID_LAT * NUM_GRID_LON, -1);
+   if (!indexDirectory(p, true) || cells.empty()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledTerrain::loadData() ERROR, no DTED or SRTM cells found in: " << p << std::endl;
+      }
+      clearData();
+      return false;
+   }
+
+   // Corners of the database
+   int lowerLat = 90;
+   int lowerLon = 180;
+   int upperLat = -90;
+   int upperLon = -180;
+   for (const Cell& cell : cells) {
+      lowerLat = std::min(lowerLat, cell.swLat);
+      lowerLon = std::min(lowerLon, cell.swLon);
+      upperLat = std::max(upperLat, cell.swLat + 1);
+      upperLon = std::max(upperLon, cell.swLon + 1);
+   }
+   setLatitudeSW(lowerLat);
+   setLongitudeSW(lowerLon);
+   setLatitudeNE(upperLat);
+   setLongitudeNE(upperLon);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Indexes the cell files in a directory and (optionally) its subdirectories
+//------------------------------------------------------------------------------
+bool TiledTerrain::indexDirectory(const std::string& dir, const bool subdirs)
+{
+   std::vector<std::string> files;
+   std::vector<std::string> dirs;
+
+#if defined(WIN32)
+   _finddata_t info;
+   const std::string pattern = dir + "/*";
+   const intptr_t handle = _findfirst(pattern.c_str(), &info);
+   if (handle == -1) return false;
+   do {
+      const std::string name(info.name);
+      if (name == "." || name == "..") continue;
+      if ((info.attrib & _A_SUBDIR) != 0) dirs.push_back(name);
+      else files.push_back(name);
+   } while (_findnext(handle, &info) == 0);
+   _findclose(handle);
+#else
+   DIR* d = opendir(dir.c_str());
+   if (d == nullptr) return false;
+   for (dirent* e = readdir(d); e != nullptr; e = readdir(d)) {
+      const std::string name(e->d_name);
+      if (name == "." || name == "..") continue;
+      struct stat st;
+      const std::string pathname = dir + "/" + name;
+      if (stat(pathname.c_str(), &st) != 0) continue;
+      if (S_ISDIR(st.st_mode)) dirs.push_back(name);
+      else if (S_ISREG(st.st_mode)) files.push_back(name);
+   }
+   closedir(d);
+#endif
+
+   // Sorted, so the first of any duplicate cells is always the same
+   std::sort(files.begin(), files.end());
+   std::sort(dirs.begin(), dirs.end());
+
+   for (const std::string& name : files) {
+      const std::string::size_type dot = name.rfind('.');
+      if (dot == std::string::npos) continue;
+      std::string ext = name.substr(dot);
+      std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+      if (ext == ".dt0" || ext == ".dt1" || ext == ".dt2") {
+         indexDtedCell(dir + "/" + name);
+      }
+      else if (ext == ".hgt") {
+         indexSrtmCell(dir + "/" + name, name);
+      }
+   }
+
+   if (subdirs) {
+      for (const std::string& name : dirs) {
+         indexDirectory(dir + "/" + name, false);
+      }
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Indexes a DTED cell using its User Header Label (UHL) record
+//------------------------------------------------------------------------------
+bool TiledTerrain::indexDtedCell(const std::string& filename)
+{
+   std::ifstream in(filename.c_str(), std::ios::binary);
+   char uhl[DTED_UHL_SIZE + 1] = {};
+   in.read(uhl, DTED_UHL_SIZE);
+   if (in.fail() || std::strncmp(uhl, "UHL1", 4) != 0) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TiledTerrain::indexDtedCell() WARNING, invalid DTED header: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   // UHL fields: origin longitude [4..11] and latitude [12..19] (DDDMMSSH),
+   // longitude [20..23] and latitude [24..27] intervals (tenths of seconds),
+   // and the number of longitude [47..50] and latitude [51..54] lines.
+   char field[9] = {};
+   Cell cell;
+   cell.filename = filename;
+   cell.format = DTED;
+
+   std::memcpy(field, &uhl[4], 3); field[3] = 0;
+   cell.swLon = std::atoi(field);
+   if (uhl[11] == 'W') cell.swLon = -cell.swLon;
+
+   std::memcpy(field, &uhl[12], 3); field[3] = 0;
+   cell.swLat = std::atoi(field);
+   if (uhl[19] == 'S') cell.swLat = -cell.swLat;
+
+   static const double TENTHS_OF_SECONDS_PER_DEGREE = 36000.0;
+   std::memcpy(field, &uhl[20], 4); field[4] = 0;
+   cell.lonSpacing = std::atoi(field) / TENTHS_OF_SECONDS_PER_DEGREE;
+   std::memcpy(field, &uhl[24], 4); field[4] = 0;
+   cell.latSpacing = std::atoi(field) / TENTHS_OF_SECONDS_PER_DEGREE;
+
+   std::memcpy(field, &uhl[47], 4); field[4] = 0;
+   cell.nptlong = static_cast<unsigned int>(std::atoi(field));
+   std::memcpy(field, &uhl[51], 4); field[4] = 0;
+   cell.nptlat = static_cast<unsigned int>(std::atoi(field));
+
+   return addCell(cell);
+}
+
+//------------------------------------------------------------------------------
+// Indexes a SRTM cell using its file name and size (see SrtmHgtFile)
+//------------------------------------------------------------------------------
+bool TiledTerrain::indexSrtmCell(const std::string& filename, const std::string& name)
+{
+   // nXXwXXX.hgt
+   if (name.size() != 11) return false;
+   const char ns = static_cast<char>(std::tolower(name[0]));
+   const char ew = static_cast<char>(std::tolower(name[3]));
+   if ((ns != 'n' && ns != 's') || (ew != 'e' && ew != 'w')) return false;
+
+   std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+   const std::streamoff size = in.tellg();
+
+   Cell cell;
+   cell.filename = filename;
+   cell.format = SRTM;
+   if (size == SRTM3_FILE_SIZE) {
+      cell.latSpacing = 3.0 / 3600.0;
+      cell.lonSpacing = 3.0 / 3600.0;
+      cell.nptlat = 1201;
+      cell.nptlong = 1201;
+   }
+   else if (size == SRTM1_FILE_SIZE) {
+      cell.latSpacing = 1.0 / 3600.0;
+      cell.lonSpacing = 1.0 / 3600.0;
+      cell.nptlat = 3601;
+      cell.nptlong = 3601;
+   }
+   else {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TiledTerrain::indexSrtmCell() WARNING, invalid SRTM file size: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   cell.swLat = std::atoi(name.substr(1, 2).c_str());
+   cell.swLon = std::atoi(name.substr(4, 3).c_str());
+   if (ns == 's') cell.swLat = -cell.swLat;
+   if (ew == 'w') cell.swLon = -cell.swLon;
+
+   return addCell(cell);
+}
+
+//------------------------------------------------------------------------------
+// Adds a cell to the index
+//------------------------------------------------------------------------------
+bool TiledTerrain::addCell(const Cell& cell)
+{
+   if ( (cell.swLat < -90 || cell.swLat >= 90) ||
+        (cell.swLon < -180 || cell.swLon >= 180) ||
+        cell.nptlat < 2 || cell.nptlong < 2 ||
+        cell.latSpacing <= 0 || cell.lonSpacing <= 0
+      ) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TiledTerrain::addCell() WARNING, invalid cell: " << cell.filename << std::endl;
+      }
+      return false;
+   }
+
+   int& idx = cellGrid[(cell.swLat + 90) * NUM_GRID_LON + (cell.swLon + 180)];
+   if (idx >= 0) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TiledTerrain::addCell() WARNING, duplicate cell: " << cell.filename;
+         std::cerr << "; using: " << cells[idx].filename << std::endl;
+      }
+      return false;
+   }
+
+   idx = static_cast<int>(cells.size());
+   cells.push_back(cell);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// clear our data
+//------------------------------------------------------------------------------
+void TiledTerrain::clearData()
+{
+   clearCache();
+   cells.clear();
+   cellGrid.clear();
+   BaseClass::clearData();
+}
+
+//------------------------------------------------------------------------------
+// serialize() --
+//------------------------------------------------------------------------------
+std::ostream& TiledTerrain::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+   int j = 0;
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << "( " << getFactoryName() << std::endl;
+      j = 4;
+   }
+
+   indent(sout,i+j);
+   sout << "tileSize: " << tileSize << std::endl;
+
+   indent(sout,i+j);
+   sout << "cacheSize: " << cacheSize << std::endl;
+
+   BaseClass::serialize(sout,i+j,true);
+
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << ")" << std::endl;
+   }
+
+   return sout;
+}
+
+}
+}
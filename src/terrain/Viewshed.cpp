@@ -0,0 +1,193 @@
+#include "openeaagles/terrain/Viewshed.hpp"
+#include "openeaagles/terrain/Terrain.hpp"
+
+#include "openeaagles/base/util/nav_utils.hpp"
+#include "openeaagles/base/units/distance_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oe {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(Viewshed, "Viewshed")
+EMPTY_SLOTTABLE(Viewshed)
+EMPTY_SERIALIZER(Viewshed)
+
+const double Viewshed::RANGE_STEP = 100.0;
+const double Viewshed::ELEVATION_TOLERANCE = 20.0;
+
+Viewshed::Viewshed()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void Viewshed::copyData(const Viewshed& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   upper = org.upper;
+   lower = org.lower;
+   refLat = org.refLat;
+   refLon = org.refLon;
+   refAlt = org.refAlt;
+   numAzBins = org.numAzBins;
+   numRngSteps = org.numRngSteps;
+}
+
+void Viewshed::deleteData()
+{
+   clear();
+}
+
+//------------------------------------------------------------------------------
+// Clears the table
+//------------------------------------------------------------------------------
+void Viewshed::clear()
+{
+   upper.clear();
+   lower.clear();
+   numAzBins = 0;
+   numRngSteps = 0;
+}
+
+//------------------------------------------------------------------------------
+// Builds the horizon tables of the ref point: one terrain profile per azimuth
+// bin, with the running max of the tangents of the angles to the terrain, which
+// is raised (upper) and lowered (lower) by ELEVATION_TOLERANCE.
+//------------------------------------------------------------------------------
+bool Viewshed::build(
+      const Terrain* const terrain, // Terrain database
+      const double lat,             // Ref latitude (degs)
+      const double lon,             // Ref longitude (degs)
+      const double alt,             // Ref altitude (meters)
+      const double maxRange,        // Max range (meters)
+      const unsigned int nAzBins    // Number of azimuth bins
+   )
+{
+   clear();
+
+   // Early out tests
+   if ( terrain == nullptr ||             // no terrain, or
+        !terrain->isDataLoaded() ||       // the terrain data isn't loaded, or
+        (lat < -89.0 || lat > 89.0) ||    // the profiles would start at the poles, or
+        maxRange < (2.0 * RANGE_STEP) ||  // the max range is too short, or
+        nAzBins < MIN_AZIMUTH_BINS        // too few azimuth bins
+      ) return false;
+
+   unsigned int nrng = static_cast<unsigned int>(std::ceil(maxRange / RANGE_STEP));
+   if (nrng > MAX_RANGE_STEPS) nrng = MAX_RANGE_STEPS;
+
+   upper.resize(nAzBins * nrng);
+   lower.resize(nAzBins * nrng);
+
+   // Profile arrays (ref point and range steps)
+   double elevations[MAX_RANGE_STEPS + 1];
+   bool validFlags[MAX_RANGE_STEPS + 1];
+
+   for (unsigned int bin = 0; bin < nAzBins; bin++) {
+
+      for (unsigned int k = 0; k <= nrng; k++) { validFlags[k] = false; }
+
+      // Profile along the center of the bin
+      const double brgDeg = (360.0 * bin) / nAzBins;
+      terrain->getElevations(elevations, validFlags, (nrng + 1), lat, lon, brgDeg, (nrng * RANGE_STEP), false);
+
+      // Running max of the tangents of the angles to the terrain points; each
+      // point is within half of a range step of a target's profile point.
+      double maxUpper = -1.0e30;
+      double maxLower = -1.0e30;
+      float* const rowUpper = &upper[bin * nrng];
+      float* const rowLower = &lower[bin * nrng];
+      for (unsigned int k = 1; k <= nrng; k++) {
+         if (validFlags[k]) {
+            const double rngNear = (k - 0.5) * RANGE_STEP;
+            const double rngFar = (k + 0.5) * RANGE_STEP;
+            const double dhUpper = elevations[k] + ELEVATION_TOLERANCE - alt;
+            const double dhLower = elevations[k] - ELEVATION_TOLERANCE - alt;
+            const double tstUpper = dhUpper / (dhUpper >= 0 ? rngNear : rngFar);
+            const double tstLower = dhLower / (dhLower >= 0 ? rngFar : rngNear);
+            if (tstUpper > maxUpper) maxUpper = tstUpper;
+            if (tstLower > maxLower) maxLower = tstLower;
+         }
+         rowUpper[k - 1] = static_cast<float>(maxUpper);
+         rowLower[k - 1] = static_cast<float>(maxLower);
+      }
+   }
+
+   refLat = lat;
+   refLon = lon;
+   refAlt = alt;
+   numAzBins = nAzBins;
+   numRngSteps = nrng;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Terrain occulting check of a target point --- the target's bearing and
+// distance, and the range to its last profile point, are the same as
+// Terrain::targetOcculting().  The target's profile isn't sampled at the same
+// points as the tables, so the angle to the target is checked against the
+// band from the lower to the upper horizon angles of the azimuth bins on each
+// side of the target, and of the range steps on each side of its last profile
+// point.  Targets within the band aren't checked.
+//------------------------------------------------------------------------------
+bool Viewshed::targetOcculting(
+      const double tgtLat,          // Target latitude (degs)
+      const double tgtLon,          // Target longitude (degs)
+      const double tgtAlt,          // Target altitude (meters)
+      bool* const occulted          // True if the target is occulted
+   ) const
+{
+   if (!isValid() || occulted == nullptr) return false;
+
+   // Compute bearing and distance to target (flat earth)
+   double brgDeg = 0.0;
+   double distNM = 0.0;
+   base::nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   const double dist = (distNM * base::distance::NM2M);
+
+   // Beyond the table?
+   if (dist > getMaxRange()) return false;
+
+   bool occ = false;
+
+   // Number of profile points (see Terrain::targetOcculting()); there are no
+   // points between the ref point and the target with only two.
+   const unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
+   if (numPts > 2) {
+
+      // Range steps up to the last point before the target
+      const double lastRng = dist * (numPts - 2) / (numPts - 1);
+      unsigned int k = static_cast<unsigned int>(lastRng / RANGE_STEP);
+      if (k > numRngSteps) k = numRngSteps;
+
+      if (k > 0) {
+         // Azimuth bins on each side of the target
+         int bin0 = static_cast<int>(std::floor((brgDeg * numAzBins) / 360.0)) % static_cast<int>(numAzBins);
+         if (bin0 < 0) bin0 += numAzBins;
+         const unsigned int bin1 = (bin0 + 1) % numAzBins;
+         const unsigned int i0 = bin0 * numRngSteps;
+         const unsigned int i1 = bin1 * numRngSteps;
+
+         // Range steps on each side of the last profile point
+         const unsigned int k1 = (k < numRngSteps ? k + 1 : k);
+
+         // Band of horizon angles
+         const double lo = std::min(lower[i0 + k - 1], lower[i1 + k - 1]);
+         const double hi = std::max(upper[i0 + k1 - 1], upper[i1 + k1 - 1]);
+
+         // Occulted if the terrain angle is on or above the angle to the target
+         const double tgtTan = (tgtAlt - refAlt) / dist;
+         if (tgtTan <= lo) occ = true;
+         else if (tgtTan > hi) occ = false;
+         else return false;   // Within the band; needs the full profile check
+      }
+   }
+
+   *occulted = occ;
+   return true;
+}
+
+}
+}
@@ -4,6 +4,7 @@
 #include "openeaagles/base/Object.hpp"
 
 #include "openeaagles/terrain/QuadMap.hpp"
+#include "openeaagles/terrain/TiledTerrain.hpp"
 #include "openeaagles/terrain/ded/DedFile.hpp"
 #include "openeaagles/terrain/dted/DtedFile.hpp"
 #include "openeaagles/terrain/srtm/SrtmHgtFile.hpp"
@@ -20,6 +21,9 @@ base::Object* factory(const std::string& name)
     if ( name == QuadMap::getFactoryName() ) {
         obj = new QuadMap();
     }
+    else if ( name == TiledTerrain::getFactoryName() ) {
+        obj = new TiledTerrain();
+    }
     else if ( name == DedFile::getFactoryName() ) {
         obj = new DedFile();
     }
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+// aoi_check -- interop::AreaOfInterest test
+//
+//    Places random local players (some inactive) around the world model's
+//    reference point, rebuilds the area of interest grid from the player list
+//    with several cell sizes, and checks that isInterested() gives the same
+//    results as checking the range to each active local player, for random
+//    entities and ranges.  Checks the filtered, admitted and promoted counts,
+//    and that an empty grid is interested in all entities.  Prints the time
+//    per isInterested() for each cell size, and per brute force check.
+//
+//    Usage: aoi_check [ players [ entities ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/interop/common/AreaOfInterest.hpp"
+
+#include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/player/AirVehicle.hpp"
+
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const double AREA = 1000000.0;            // Size of the gaming area (meters)
+static const double MAX_OFFSET = 300000.0;       // Max entity offset from a player (meters)
+static const unsigned int NEW_PLAYERS = 500;     // New players per player list update
+
+// (updatePlayerList() is run by the background thread, and the reference
+// point is set by slots)
+class TestWorldModel : public models::WorldModel
+{
+public:
+   using models::WorldModel::updatePlayerList;
+   using models::WorldModel::setRefLatitude;
+   using models::WorldModel::setRefLongitude;
+};
+
+// True if 'p' is within 'range' of one of the positions, or if there are none
+static bool isInRange(const std::vector<base::Vec3d>& positions, const base::Vec3d& p, const double range)
+{
+   bool found = positions.empty();
+   for (unsigned int i = 0; i < positions.size() && !found; i++) {
+      found = ((positions[i] - p).length2() <= range * range);
+   }
+   return found;
+}
+
+// Checks the filtered, admitted and promoted counts; returns the number of errors
+static long checkCounts()
+{
+   long errors = 0;
+   interop::AreaOfInterest aoi;
+   aoi.filtered(1, 0.0, 5.0);
+   aoi.filtered(1, 0.5, 5.0);
+   aoi.filtered(2, 0.0, 5.0);
+   if (aoi.getFilteredCount() != 3 || aoi.getNumFilteredEntities() != 2) errors++;
+   aoi.admitted(1);
+   aoi.admitted(3);
+   if (aoi.getAdmittedCount() != 2 || aoi.getPromotedCount() != 1 || aoi.getNumFilteredEntities() != 1) errors++;
+   aoi.expire(10.0);
+   aoi.admitted(2);
+   if (aoi.getNumFilteredEntities() != 0 || aoi.getPromotedCount() != 1) errors++;
+   aoi.reset();
+   if (aoi.getFilteredCount() != 0 || aoi.getAdmittedCount() != 0 || aoi.getPromotedCount() != 0) errors++;
+
+   // no local players: all entities are of interest
+   aoi.rebuild(nullptr);
+   if (!aoi.isInterested(base::Vec3d(1.0e7, 0.0, 0.0), 1.0)) errors++;
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 200);
+   const unsigned int ne = (argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 20000);
+
+   const auto station = new simulation::Station();
+   const auto sim = new TestWorldModel();
+   station->setSlotSimulation(sim);
+   sim->setRefLatitude(36.0);
+   sim->setRefLongitude(-116.0);
+   sim->reset();
+
+   std::mt19937 rng(19);
+   std::uniform_real_distribution<double> xy(-AREA / 2.0, AREA / 2.0);
+   std::uniform_real_distribution<double> alt(0.0, 10000.0);
+   std::uniform_real_distribution<double> offset(-MAX_OFFSET, MAX_OFFSET);
+   std::uniform_real_distribution<double> range(1000.0, 150000.0);
+
+   std::vector<models::Player*> players;
+   for (unsigned int i = 0; i < n; i++) {
+      const auto p = new models::AirVehicle();
+      p->setID(static_cast<unsigned short>(i + 1));
+      char name[16];
+      std::sprintf(name, "p%u", i + 1);
+      sim->addNewPlayer(name, p);
+      players.push_back(p);
+      if ((i % NEW_PLAYERS) == (NEW_PLAYERS - 1)) sim->updatePlayerList();
+   }
+   sim->updatePlayerList();
+
+   // Positions of the active local players
+   std::vector<base::Vec3d> active;
+   for (unsigned int i = 0; i < n; i++) {
+      players[i]->setPosition(xy(rng), xy(rng), -alt(rng));
+      if ((i % 7) == 3) players[i]->setMode(models::Player::INACTIVE);
+      else active.push_back(players[i]->getGeocPosition());
+   }
+
+   // Entities near the players, and their ranges
+   std::vector<base::Vec3d> entities(ne);
+   std::vector<double> ranges(ne);
+   for (unsigned int i = 0; i < ne; i++) {
+      const base::Vec3d& p0 = players[rng() % n]->getGeocPosition();
+      entities[i] = p0 + base::Vec3d(offset(rng), offset(rng), offset(rng));
+      ranges[i] = ((i % 50) == 0 ? 4.0 * MAX_OFFSET : range(rng));
+   }
+
+   long errors = checkCounts();
+   unsigned long numInterested = 0;
+   double tb = 0.0;
+   const double cellSizes[] = { 20000.0, 100000.0, interop::AreaOfInterest::DEFAULT_CELL_SIZE };
+   base::PairStream* const list = sim->getPlayers();
+   for (unsigned int c = 0; c < 3; c++) {
+      interop::AreaOfInterest aoi;
+      aoi.setCellSize(cellSizes[c]);
+      aoi.rebuild(list);
+      if (aoi.getNumLocalPlayers() != active.size()) errors++;
+
+      std::vector<char> interested(ne);
+      const double t0 = base::getComputerTime();
+      for (unsigned int i = 0; i < ne; i++) {
+         interested[i] = aoi.isInterested(entities[i], ranges[i]);
+      }
+      const double t1 = base::getComputerTime();
+      for (unsigned int i = 0; i < ne; i++) {
+         const bool inRange = isInRange(active, entities[i], ranges[i]);
+         if (inRange != (interested[i] != 0)) errors++;
+         if (inRange) numInterested++;
+      }
+      tb += (base::getComputerTime() - t1);
+      std::printf("cell size %.0f km: isInterested() %.2f us/entity\n", cellSizes[c] / 1000.0, (t1 - t0) * 1.0e6 / ne);
+   }
+   list->unref();
+
+   const double nc = 3.0 * ne;
+   std::printf("players %u, entities %u: %.1f%% of interest; brute force %.2f us/entity\n",
+               n, ne, numInterested * 100.0 / nc, tb * 1.0e6 / nc);
+
+   for (unsigned int i = 0; i < n; i++) {
+      players[i]->unref();
+   }
+   sim->unref();
+   station->unref();
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld entities (or counts) were not checked the same as the brute force checks\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+// collision_check -- CollisionDetect with the players-of-interest spatial index
+//
+//    Runs two copies of a world model with random moving air vehicles, each
+//    with a CollisionDetect (gaming area and geocentric coordinates; most with
+//    a max range, some without), one with and one without the spatial index,
+//    and checks that each player's collisions are the same in both, frame by
+//    frame.  Prints the number of collisions and the background time per
+//    frame of each.
+//
+//    Usage: collision_check [ players [ frames ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/player/AirVehicle.hpp"
+#include "openeaagles/models/system/CollisionDetect.hpp"
+
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/Float.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/units/Distances.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const double AREA = 40000.0;              // Size of the gaming area (meters)
+static const double COLLISION_RANGE = 150.0;     // (meters)
+static const double MAX_RANGE = 3000.0;          // (meters)
+static const double CELL_SIZE = 3000.0;          // Index cell size (meters)
+static const unsigned int MAX_COLLISIONS = 64;
+
+static const double TC_DT = 0.0125;              // Time critical frame (seconds)
+static const double BG_DT = 0.05;                // Background frame (seconds)
+
+struct World {
+   simulation::Station* station {};
+   models::WorldModel* sim {};
+   std::vector<models::CollisionDetect*> detectors;
+};
+
+static void setSlot(base::Object* const obj, const char* const slot, const double value)
+{
+   base::Float num(value);
+   obj->setSlotByName(slot, &num);
+}
+
+// Builds a world model with random players; 'cellSize' of zero disables the
+// spatial index
+static void buildWorld(World* const world, const unsigned int n, const double cellSize)
+{
+   std::mt19937 rng(17);
+   std::uniform_real_distribution<double> xy(-AREA / 2.0, AREA / 2.0);
+   std::uniform_real_distribution<double> alt(1000.0, 1300.0);
+   std::uniform_real_distribution<double> hdg(0.0, 6.28);
+   std::uniform_real_distribution<double> vel(0.0, 300.0);
+
+   const auto players = new base::PairStream();
+   for (unsigned int i = 0; i < n; i++) {
+      const auto cd = new models::CollisionDetect();
+      cd->setCollisionRange(COLLISION_RANGE);
+      cd->setMaxRange2Players((i % 10) == 9 ? 0.0 : MAX_RANGE);
+      cd->setMaxPlayers(60);
+      cd->setUseWorld((i % 2) != 0);
+      const auto components = new base::PairStream();
+      const auto cdPair = new base::Pair("cd", cd);
+      components->put(cdPair);
+      cdPair->unref();
+
+      const auto p = new models::AirVehicle();
+      p->setID(static_cast<unsigned short>(i + 1));
+      p->setInitPosition(xy(rng), xy(rng));
+      p->setInitAltitude(alt(rng));
+      setSlot(p, "initHeading", hdg(rng));
+      setSlot(p, "initVelocity", vel(rng));
+      p->setCrashOverride(true);
+      p->setKillOverride(true);
+      p->setSlotByName("components", components);
+      components->unref();
+
+      char name[16];
+      std::sprintf(name, "p%u", i + 1);
+      const auto pair = new base::Pair(name, p);
+      players->put(pair);
+      pair->unref();
+      p->unref();
+      world->detectors.push_back(cd);
+      cd->unref();
+   }
+
+   world->station = new simulation::Station();
+   world->sim = new models::WorldModel();
+   world->station->setSlotSimulation(world->sim);
+   setSlot(world->sim, "latitude", 36.0);
+   setSlot(world->sim, "longitude", -116.0);
+   const auto cs = new base::Meters(cellSize);
+   world->sim->setSlotByName("playerIndexCellSize", cs);
+   cs->unref();
+   world->sim->setSlotByName("players", players);
+   players->unref();
+   world->sim->event(base::Component::RESET_EVENT);
+}
+
+static void deleteWorld(World* const world)
+{
+   world->sim->unref();
+   world->station->unref();
+}
+
+// Runs a frame; returns the background time
+static double runFrame(World* const world)
+{
+   for (unsigned int k = 0; k < 4; k++) {
+      world->sim->updateTC(TC_DT);
+   }
+   const double t0 = base::getComputerTime();
+   world->sim->updateData(BG_DT);
+   return base::getComputerTime() - t0;
+}
+
+// Player IDs of a detector's collisions
+static unsigned int getCollisions(models::CollisionDetect* const cd, unsigned short* const ids)
+{
+   models::Player* list[MAX_COLLISIONS] {};
+   double distances[MAX_COLLISIONS] {};
+   const unsigned int n = cd->getCollisions(list, distances, MAX_COLLISIONS);
+   for (unsigned int i = 0; i < n; i++) {
+      ids[i] = list[i]->getID();
+      list[i]->unref();
+   }
+   return n;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 2000);
+   const unsigned int frames = (argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 100);
+
+   World indexed;
+   World scanned;
+   buildWorld(&indexed, n, CELL_SIZE);
+   buildWorld(&scanned, n, 0.0);
+
+   long mismatches = 0;
+   unsigned long collisions = 0;
+   unsigned long rangeless = 0;
+   double ti = 0.0, ts = 0.0;
+   for (unsigned int f = 0; f < frames; f++) {
+      ti += runFrame(&indexed);
+      ts += runFrame(&scanned);
+      for (unsigned int i = 0; i < n; i++) {
+         unsigned short ids1[MAX_COLLISIONS] {};
+         unsigned short ids2[MAX_COLLISIONS] {};
+         const unsigned int n1 = getCollisions(indexed.detectors[i], ids1);
+         const unsigned int n2 = getCollisions(scanned.detectors[i], ids2);
+         bool same = (n1 == n2);
+         for (unsigned int k = 0; k < n1 && same; k++) {
+            same = (ids1[k] == ids2[k]);
+         }
+         if (!same) mismatches++;
+         collisions += n2;
+         if ((i % 10) == 9) rangeless += n2;
+      }
+   }
+   std::printf("players %u, frames %u: %lu collisions (%lu without a max range); with the index %.2f ms/frame, without %.2f ms/frame\n",
+               n, frames, collisions, rangeless, ti * 1.0e3 / frames, ts * 1.0e3 / frames);
+
+   deleteWorld(&indexed);
+   deleteWorld(&scanned);
+
+   bool ok = true;
+   if (mismatches != 0) {
+      std::printf("FAILED: %ld collision lists were not the same with and without the index\n", mismatches);
+      ok = false;
+   }
+   if (collisions == 0 || rangeless == 0) {
+      std::printf("FAILED: too few collisions to compare\n");
+      ok = false;
+   }
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
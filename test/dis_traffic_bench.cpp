@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+// dis_traffic_bench -- DIS network input load test
+//
+//    Runs a station with a DIS NetIO whose network input is fed, through a
+//    loopback channel, by a DisTrafficGenerator (see dis_traffic_bench.edl),
+//    and reports:
+//       -- the generator's PDU rate,
+//       -- the NetIO's input queue latency percentiles (the time from the
+//          receiver thread's put() to the PDU's NIB update), and
+//       -- the station's frame times (updateTC() plus updateData()), without
+//          and then with the traffic.
+//
+//    Usage: dis_traffic_bench [ <edl file> [ <number of entities> ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/interop/dis/NetIO.hpp"
+#include "openeaagles/interop/dis/PduQueue.hpp"
+#include "openeaagles/interop/dis/TrafficGenerator.hpp"
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/edl_parser.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+// class factories
+#include "openeaagles/interop/dis/factory.hpp"
+#include "openeaagles/models/factory.hpp"
+#include "openeaagles/simulation/factory.hpp"
+#include "openeaagles/base/factory.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const double FRAME_RATE = 50.0;           // Station frame rate (Hz)
+static const unsigned int WARMUP_FRAMES = 10;    // Frames before the timing
+static const unsigned int IDLE_FRAMES = 100;     // Frames without the traffic
+static const unsigned int LOAD_FRAMES = 250;     // Frames with the traffic
+
+// our class factory
+static base::Object* factory(const std::string& name)
+{
+   base::Object* obj = dis::factory(name);
+   if (obj == nullptr) obj = models::factory(name);
+   if (obj == nullptr) obj = simulation::factory(name);
+   if (obj == nullptr) obj = base::factory(name);
+   return obj;
+}
+
+// Prints the mean, 99th percentile and max of the frame times (seconds)
+static void printFrameTimes(const char* const label, std::vector<double>* const times)
+{
+   std::sort(times->begin(), times->end());
+   double sum = 0;
+   for (unsigned int i = 0; i < times->size(); i++) sum += (*times)[i];
+   const unsigned int n = static_cast<unsigned int>(times->size());
+   std::printf("%-20s mean %8.3f ms   p99 %8.3f ms   max %8.3f ms\n", label,
+      (sum / n) * 1.0e3, (*times)[(n * 99) / 100] * 1.0e3, (*times)[n - 1] * 1.0e3);
+}
+
+// Runs 'n' station frames, and the generator when it's not zero
+static void runFrames(simulation::Station* const station, dis::TrafficGenerator* const gen,
+                      const unsigned int n, std::vector<double>* const times)
+{
+   const double dt = 1.0 / FRAME_RATE;
+   for (unsigned int i = 0; i < n; i++) {
+      if (gen != nullptr) gen->updateData(dt);
+      const double t0 = base::getComputerTime();
+      station->updateTC(dt);
+      station->updateData(dt);
+      times->push_back(base::getComputerTime() - t0);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   const char* const filename = (argc > 1 ? argv[1] : "dis_traffic_bench.edl");
+
+   unsigned int numErrors = 0;
+   base::Object* obj = base::edl_parser(filename, factory, &numErrors);
+   const auto list = dynamic_cast<base::PairStream*>(obj);
+   if (numErrors > 0 || list == nullptr) {
+      std::fprintf(stderr, "%s: invalid configuration (%u errors)\n", filename, numErrors);
+      return EXIT_FAILURE;
+   }
+
+   base::Pair* sp = list->findByName("station");
+   base::Pair* gp = list->findByName("generator");
+   const auto station = (sp != nullptr ? dynamic_cast<simulation::Station*>(sp->object()) : nullptr);
+   const auto gen = (gp != nullptr ? dynamic_cast<dis::TrafficGenerator*>(gp->object()) : nullptr);
+   if (station == nullptr || gen == nullptr) {
+      std::fprintf(stderr, "%s: needs a 'station' and a 'generator'\n", filename);
+      return EXIT_FAILURE;
+   }
+   if (argc > 2) {
+      const base::Integer num(std::atoi(argv[2]));
+      gen->setSlotNumEntities(&num);
+   }
+
+   dis::NetIO* netIO = nullptr;
+   base::PairStream* networks = station->getNetworks();
+   if (networks != nullptr) {
+      base::Pair* np = networks->findByType(typeid(dis::NetIO));
+      if (np != nullptr) netIO = static_cast<dis::NetIO*>(np->object());
+   }
+   if (netIO == nullptr) {
+      std::fprintf(stderr, "%s: the station has no DIS NetIO\n", filename);
+      return EXIT_FAILURE;
+   }
+
+   station->event(base::Component::RESET_EVENT);
+   gen->reset();
+
+   // (the first frames start the network input thread, etc)
+   std::vector<double> idle;
+   runFrames(station, nullptr, WARMUP_FRAMES, &idle);
+   idle.clear();
+   runFrames(station, nullptr, IDLE_FRAMES, &idle);
+
+   const double t0 = base::getComputerTime();
+   std::vector<double> load;
+   runFrames(station, gen, LOAD_FRAMES, &load);
+   const double elapsed = base::getComputerTime() - t0;
+
+   std::printf("entities            %u\n", gen->getNumEntities());
+   std::printf("PDUs sent           %llu (%.0f PDUs/s simulated, %.0f PDUs/s wall clock)\n",
+      gen->getTotalSent(), gen->getSendRate(), gen->getTotalSent() / elapsed);
+   base::PairStream* players = station->getPlayers();
+   if (players != nullptr) {
+      std::printf("players             %u (local and networked)\n", players->entries());
+      players->unref();
+   }
+
+   const dis::PduQueue* q = netIO->getInputQueue();
+   if (q != nullptr) {
+      std::printf("input queue         received %llu   coalesced %llu   dropped %llu\n",
+         q->getNumReceived(), q->getNumCoalesced(), q->getNumDropped());
+      std::printf("NIB latency         p50 %8.3f ms   p90 %8.3f ms   p99 %8.3f ms   max %8.3f ms\n",
+         q->getLatencyPercentile(50) * 1.0e3, q->getLatencyPercentile(90) * 1.0e3,
+         q->getLatencyPercentile(99) * 1.0e3, q->getMaxLatency() * 1.0e3);
+   }
+
+   printFrameTimes("frame (idle)", &idle);
+   printFrameTimes("frame (traffic)", &load);
+
+   station->event(base::Component::SHUTDOWN_EVENT);
+   list->unref();
+   return EXIT_SUCCESS;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
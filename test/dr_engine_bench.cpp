@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// dr_engine_bench -- batched dead reckoning (interop::DrEngine) benchmark
+//
+//    Dead reckons the same entities with two sets of input NIBs: one set
+//    uses a NetIO's DR engine, and the other set (no NetIO) uses
+//    Nib::mainDeadReckoning().  Checks that the positions and angles are bit
+//    for bit the same, and prints the time per frame of each.  About 0.5% of
+//    the entities are reset (i.e., new PDUs) each frame, and every 50th frame
+//    has a zero delta time (i.e., frozen players).
+//
+//    Usage: dr_engine_bench [ entities [ mixed (0/1) [ rotating (0/1) ] ] ]
+//       mixed       -- mixed DR algorithms (default), or only RVW
+//       rotating    -- a quarter of the entities rotate (default)
+//------------------------------------------------------------------------------
+
+#include "openeaagles/interop/dis/NetIO.hpp"
+#include "openeaagles/interop/dis/Nib.hpp"
+
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const int FRAMES = 500;
+static const double DT = 0.05;
+
+static bool same(const base::Vec3d& a, const base::Vec3d& b)
+{
+   return std::memcmp(a.ptr(), b.ptr(), 3 * sizeof(double)) == 0;
+}
+
+int main(int argc, char* argv[])
+{
+   const int n = (argc > 1 ? std::atoi(argv[1]) : 10000);
+   const bool mixed = (argc > 2 ? std::atoi(argv[2]) != 0 : true);
+   const bool rotating = (argc > 3 ? std::atoi(argv[3]) != 0 : true);
+
+   dis::NetIO* const netIO = new dis::NetIO();
+   std::vector<dis::Nib*> batched;    // using the DR engine
+   std::vector<dis::Nib*> single;     // using Nib::mainDeadReckoning()
+
+   std::mt19937 rng(11);
+   std::uniform_real_distribution<double> u(-1.0, 1.0);
+   const unsigned char algs[] = {
+      interop::Nib::FPW_DRM, interop::Nib::RPW_DRM, interop::Nib::RVW_DRM, interop::Nib::FVW_DRM, interop::Nib::RVB_DRM
+   };
+
+   // (re)sets the DR data of entity 'i'
+   auto reset = [&](const int i) {
+      const unsigned char dr = (mixed ? algs[rng() % 5] : interop::Nib::RVW_DRM);
+      const base::Vec3d p(6.4e6 * u(rng), 6.4e6 * u(rng), 6.4e6 * u(rng));
+      const base::Vec3d v(300.0 * u(rng), 300.0 * u(rng), 300.0 * u(rng));
+      const base::Vec3d a(5.0 * u(rng), 5.0 * u(rng), 5.0 * u(rng));
+      const base::Vec3d rpy(u(rng), u(rng), 3.0 * u(rng));
+      base::Vec3d av(0.0, 0.0, 0.0);
+      if (rotating && rng() % 4 == 0) av.set(0.1 * u(rng), 0.1 * u(rng), 0.1 * u(rng));
+      batched[i]->resetDeadReckoning(dr, p, v, a, rpy, av);
+      single[i]->resetDeadReckoning(dr, p, v, a, rpy, av);
+   };
+
+   for (int i = 0; i < n; i++) {
+      batched.push_back(new dis::Nib(interop::NetIO::INPUT_NIB));
+      batched.back()->setNetIO(netIO);
+      single.push_back(new dis::Nib(interop::NetIO::INPUT_NIB));
+      reset(i);
+   }
+   std::printf("entities %d, DR engine slots %u\n", n, netIO->getDrEngine()->getNumSlots());
+
+   std::vector<base::Vec3d> rb(2 * n), rs(2 * n);
+   long mismatches = 0;
+   double tb = 0.0, ts = 0.0;
+   for (int f = 0; f < FRAMES; f++) {
+      const double dt = (f % 50 == 7 ? 0.0 : DT);
+      for (int i = 0; i < n; i++) {
+         if (rng() % 200 == 0) reset(i);
+      }
+
+      const double t0 = base::getComputerTime();
+      netIO->getDrEngine()->advance(dt);
+      for (int i = 0; i < n; i++) {
+         batched[i]->updateDeadReckoning(dt, &rb[2*i], &rb[2*i+1]);
+      }
+      const double t1 = base::getComputerTime();
+      for (int i = 0; i < n; i++) {
+         single[i]->updateDeadReckoning(dt, &rs[2*i], &rs[2*i+1]);
+      }
+      const double t2 = base::getComputerTime();
+      tb += (t1 - t0);
+      ts += (t2 - t1);
+
+      for (int i = 0; i < 2 * n; i++) {
+         if (!same(rb[i], rs[i])) mismatches++;
+      }
+   }
+   std::printf("frames %d: DR engine %.3f ms/frame, per-NIB %.3f ms/frame\n", FRAMES, tb * 1000.0 / FRAMES, ts * 1000.0 / FRAMES);
+
+   for (int i = 0; i < n; i++) {
+      batched[i]->unref();
+      single[i]->unref();
+   }
+   const unsigned int leaked = netIO->getDrEngine()->getNumSlots();
+   netIO->unref();
+
+   bool ok = true;
+   if (mismatches != 0) {
+      std::printf("FAILED: %ld positions or angles are not bit for bit the same\n", mismatches);
+      ok = false;
+   }
+   if (leaked != 0) {
+      std::printf("FAILED: %u DR engine slots were not released\n", leaked);
+      ok = false;
+   }
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+// edl_cache_check -- compiled EDL file (edl_parser() cache) test
+//
+//    Writes an EDL file with many forms, slots, lists and primitives, then
+//    parses it, parses and compiles it, and loads the compiled file.  Checks
+//    that the three object trees serialize identically and that a changed
+//    EDL file isn't loaded from the old compiled file, and prints the times.
+//
+//    Usage: edl_cache_check [ number of forms ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/edl_parser.hpp"
+#include "openeaagles/base/factory.hpp"
+#include "openeaagles/base/Identifier.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace oe {
+namespace test {
+
+static const char* const EDL_FILE = "edl_cache_check.edl";
+static const char* const CACHE_FILE = "edl_cache_check.edlc";
+
+static void writeEdl(const unsigned int n, const unsigned int seed)
+{
+   std::ofstream sout(EDL_FILE);
+   sout << "{" << std::endl;
+   for (unsigned int i = 0; i < n; i++) {
+      sout << "   item" << i << ": {" << std::endl;
+      sout << "      name: \"item " << (i + seed) << "\"" << std::endl;
+      sout << "      flag: " << ((i % 2) ? "true" : "false") << std::endl;
+      sout << "      kind: k" << (i % 7) << std::endl;
+      sout << "      alt: ( Feet " << (i * 10) << " )" << std::endl;
+      sout << "      hdg: ( Degrees " << (i % 360) << ".5 )" << std::endl;
+      sout << "      color: ( rgb red: 0.25 green: 0." << (i % 10) << " blue: 1 )" << std::endl;
+      sout << "      range: ( NauticalMiles 2.5 )" << std::endl;
+      sout << "      list: [ " << i << " -1 2.5e3 ]" << std::endl;
+      sout << "      ( Feet 1 ) " << i << " \"s\"" << std::endl;
+      sout << "   }" << std::endl;
+   }
+   sout << "}" << std::endl;
+}
+
+// (List::serialize() writes to std::cout, so the number lists are written here)
+static void serialize(const base::Object* const obj, std::ostream& sout)
+{
+   const auto ps = dynamic_cast<const base::PairStream*>(obj);
+   const auto list = dynamic_cast<const base::List*>(obj);
+   if (ps != nullptr) {
+      sout << "{" << std::endl;
+      for (const base::List::Item* item = ps->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         sout << pair->slot()->getString() << ": ";
+         serialize(pair->object(), sout);
+      }
+      sout << "}" << std::endl;
+   }
+   else if (list != nullptr) {
+      double values[16] {};
+      const unsigned int n = list->getNumberList(values, 16);
+      sout << "[";
+      for (unsigned int i = 0; i < n; i++) sout << " " << values[i];
+      sout << " ]" << std::endl;
+   }
+   else if (obj != nullptr) {
+      obj->serialize(sout);
+   }
+}
+
+static std::string serialize(const base::Object* const obj)
+{
+   std::ostringstream sout;
+   serialize(obj, sout);
+   return sout.str();
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 2000);
+   writeEdl(n, 0);
+   std::remove(CACHE_FILE);
+
+   // parse, parse and compile, and load the compiled file
+   unsigned int err0 = 0, err1 = 0, err2 = 0;
+   const double t0 = base::getComputerTime();
+   base::Object* parsed = base::edl_parser(EDL_FILE, base::factory, &err0);
+   const double t1 = base::getComputerTime();
+   base::Object* compiled = base::edl_parser(EDL_FILE, base::factory, CACHE_FILE, &err1);
+   const double t2 = base::getComputerTime();
+   base::Object* loaded = base::edl_parser(EDL_FILE, base::factory, CACHE_FILE, &err2);
+   const double t3 = base::getComputerTime();
+
+   const std::string s0 = serialize(parsed);
+   bool ok = (parsed != nullptr && err0 == 0 && err1 == 0 && err2 == 0);
+   ok = ok && (serialize(compiled) == s0) && (serialize(loaded) == s0);
+   std::printf("forms %u, serialized %u bytes, trees identical: %s\n", n, static_cast<unsigned int>(s0.size()), (ok ? "yes" : "NO"));
+   std::printf("parse %.1f ms, parse+compile %.1f ms, compiled load %.1f ms\n", (t1 - t0) * 1000.0, (t2 - t1) * 1000.0, (t3 - t2) * 1000.0);
+
+   // a changed EDL file must be parsed, not loaded from the old compiled file
+   writeEdl(n, 1);
+   base::Object* reparsed = base::edl_parser(EDL_FILE, base::factory, &err0);
+   base::Object* changed = base::edl_parser(EDL_FILE, base::factory, CACHE_FILE, &err1);
+   const bool stale = (serialize(changed) != serialize(reparsed));
+   if (stale) std::printf("FAILED: changed EDL file was loaded from the old compiled file\n");
+   ok = ok && !stale;
+
+   base::Object* objs[] = { parsed, compiled, loaded, reparsed, changed };
+   for (base::Object* obj : objs) {
+      if (obj != nullptr) obj->unref();
+   }
+   std::remove(EDL_FILE);
+   std::remove(CACHE_FILE);
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// math_kernels_check -- base::math_utils array kernel test
+//
+//    Checks that sqrtArray(), multArrayConst(), lengthArray(), normalizeArray()
+//    and dotArray() give bit for bit the same results as their scalar loops
+//    (and normalizeArray() the same as Vec3d::normalize()) for array sizes of
+//    0 to 67 and 1003 elements, at unaligned offsets, including zero length
+//    vectors.  Prints the time per element of the kernels and the scalar loops.
+//
+//    Usage: math_kernels_check [ loops ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/util/math_utils.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+#include "openeaagles/base/osg/Vec3d"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int MAX_SIZE = 1003;
+static const unsigned int MAX_OFFSET = 4;
+
+static bool same(const double a, const double b)
+{
+   return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Checks the kernels with 'n' elements starting at 'off'; returns the number of errors
+static long check(const unsigned int n, const unsigned int off, std::mt19937& rng)
+{
+   std::uniform_real_distribution<double> u(-1.0e4, 1.0e4);
+   const unsigned int sz = n + MAX_OFFSET;
+   std::vector<double> xv(sz), yv(sz), zv(sz), r1v(sz), r2v(sz), r3v(sz), r4v(sz);
+   std::vector<float> fv(sz), fr(sz);
+   double* const x = xv.data() + off;
+   double* const y = yv.data() + off;
+   double* const z = zv.data() + off;
+   double* const r1 = r1v.data() + off;
+   double* const r2 = r2v.data() + off;
+   double* const r3 = r3v.data() + off;
+   double* const r4 = r4v.data() + off;
+   float* const f = fv.data() + off;
+   float* const fs = fr.data() + off;
+   for (unsigned int i = 0; i < n; i++) {
+      x[i] = u(rng);
+      y[i] = u(rng) * 1.0e-3;
+      z[i] = std::fabs(u(rng)) * 1.0e3;
+      if (i % 17 == 5) x[i] = y[i] = z[i] = 0.0;
+      f[i] = static_cast<float>(std::fabs(u(rng)));
+   }
+
+   long errors = 0;
+
+   base::sqrtArray(z, r1, n);
+   base::sqrtArray(f, fs, n);
+   for (unsigned int i = 0; i < n; i++) {
+      if (!same(r1[i], std::sqrt(z[i]))) errors++;
+      if (fs[i] != std::sqrt(f[i])) errors++;
+   }
+
+   base::multArrayConst(x, 3.3, r1, n);
+   for (unsigned int i = 0; i < n; i++) {
+      if (!same(r1[i], x[i] * 3.3)) errors++;
+   }
+   base::multArrayConst(f, 3.3f, r1, n);
+   for (unsigned int i = 0; i < n; i++) {
+      if (!same(r1[i], static_cast<double>(f[i] * 3.3f))) errors++;
+   }
+
+   base::lengthArray(x, y, z, r1, n);
+   base::dotArray(x, y, z, z, x, y, r2, n);
+   for (unsigned int i = 0; i < n; i++) {
+      if (!same(r1[i], std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]))) errors++;
+      if (!same(r2[i], x[i]*z[i] + y[i]*x[i] + z[i]*y[i])) errors++;
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      r2[i] = x[i];
+      r3[i] = y[i];
+      r4[i] = z[i];
+   }
+   base::normalizeArray(r2, r3, r4, r1, n);
+   for (unsigned int i = 0; i < n; i++) {
+      base::Vec3d v(x[i], y[i], z[i]);
+      const double len = v.normalize();
+      if (!same(r1[i], len) || !same(r2[i], v[0]) || !same(r3[i], v[1]) || !same(r4[i], v[2])) errors++;
+   }
+
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int loops = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 20000);
+
+   std::mt19937 rng(9);
+   long errors = 0;
+   for (unsigned int off = 0; off < MAX_OFFSET; off++) {
+      for (unsigned int n = 0; n <= 67; n++) {
+         errors += check(n, off, rng);
+      }
+      errors += check(MAX_SIZE, off, rng);
+   }
+
+   // Timing: lengths and dot products of MAX_SIZE vectors
+   std::vector<double> x(MAX_SIZE), y(MAX_SIZE), z(MAX_SIZE), r(MAX_SIZE);
+   std::uniform_real_distribution<double> u(-1.0e4, 1.0e4);
+   for (unsigned int i = 0; i < MAX_SIZE; i++) {
+      x[i] = u(rng);
+      y[i] = u(rng);
+      z[i] = u(rng);
+   }
+   double sum = 0.0;
+   const double t0 = base::getComputerTime();
+   for (unsigned int k = 0; k < loops; k++) {
+      base::lengthArray(x.data(), y.data(), z.data(), r.data(), MAX_SIZE);
+      base::dotArray(x.data(), y.data(), z.data(), z.data(), x.data(), y.data(), r.data(), MAX_SIZE);
+      sum += r[k % MAX_SIZE];
+   }
+   const double t1 = base::getComputerTime();
+   for (unsigned int k = 0; k < loops; k++) {
+      for (unsigned int i = 0; i < MAX_SIZE; i++) {
+         r[i] = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+      }
+      for (unsigned int i = 0; i < MAX_SIZE; i++) {
+         r[i] = x[i]*z[i] + y[i]*x[i] + z[i]*y[i];
+      }
+      sum += r[k % MAX_SIZE];
+   }
+   const double t2 = base::getComputerTime();
+   const double ne = static_cast<double>(loops) * MAX_SIZE;
+   std::printf("lengthArray()+dotArray() %.2f ns/element, scalar loops %.2f ns/element (%g)\n",
+               (t1 - t0) * 1.0e9 / ne, (t2 - t1) * 1.0e9 / ne, sum);
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld results were not the same as the scalar results\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// nib_table_check -- interop::NibTable test
+//
+//    Adds, removes, detaches and compacts random NIBs (with some duplicate
+//    player ID and federate name keys) and checks, against a simple list,
+//    that the table keeps its list order and that find() returns the first
+//    NIB on the list with the key, looking up the federate names by value.
+//    Prints the time per find().
+//
+//    Usage: nib_table_check [ rounds ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/interop/common/NibTable.hpp"
+#include "openeaagles/interop/dis/Nib.hpp"
+
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int NUM_FEDERATES = 4;
+static const unsigned int NUM_IDS = 4000;
+static const unsigned int NEW_NIBS = 600;     // NIBs added per round
+static const unsigned int OLD_NIBS = 500;     // NIBs removed or detached per round
+
+static const char* const FEDERATES[NUM_FEDERATES] = { "SITE1:APP1", "SITE1:APP2", "SITE2:APP1", "SITE3:APP7" };
+
+typedef std::pair<unsigned short, std::string> Key;
+
+// Checks the table against the list; returns the number of errors
+static long check(const interop::NibTable& table, const std::vector<interop::Nib*>& list, base::String* const names[], double* const t)
+{
+   long errors = 0;
+   if (table.size() != list.size()) errors++;
+   std::map<Key, interop::Nib*> first;
+   for (unsigned int i = 0; i < list.size(); i++) {
+      if (table.get(i) != list[i]) errors++;
+      if (list[i] != nullptr) {
+         first.insert(std::make_pair(Key(list[i]->getPlayerID(), *list[i]->getFederateName()), list[i]));
+      }
+   }
+
+   std::vector<interop::Nib*> found(NUM_FEDERATES * NUM_IDS);
+   const double t0 = base::getComputerTime();
+   for (unsigned int f = 0; f < NUM_FEDERATES; f++) {
+      for (unsigned short id = 1; id <= NUM_IDS; id++) {
+         found[f * NUM_IDS + id - 1] = table.find(id, names[f]);
+      }
+   }
+   *t += (base::getComputerTime() - t0);
+
+   for (unsigned int f = 0; f < NUM_FEDERATES; f++) {
+      for (unsigned short id = 1; id <= NUM_IDS; id++) {
+         const auto it = first.find(Key(id, FEDERATES[f]));
+         if (found[f * NUM_IDS + id - 1] != (it != first.end() ? it->second : nullptr)) errors++;
+      }
+   }
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int rounds = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 50);
+
+   // The NIBs' and find()'s federate names are different objects
+   base::String* nibNames[NUM_FEDERATES] {};
+   base::String* names[NUM_FEDERATES] {};
+   for (unsigned int f = 0; f < NUM_FEDERATES; f++) {
+      nibNames[f] = new base::String(FEDERATES[f]);
+      names[f] = new base::String(FEDERATES[f]);
+   }
+
+   std::mt19937 rng(5);
+   interop::NibTable table;
+   std::vector<interop::Nib*> list;
+   long errors = 0;
+   double t = 0.0;
+   for (unsigned int r = 0; r < rounds; r++) {
+      for (unsigned int i = 0; i < NEW_NIBS; i++) {
+         const auto nib = new dis::Nib(interop::NetIO::INPUT_NIB);
+         nib->setPlayerID(static_cast<unsigned short>(1 + rng() % NUM_IDS));
+         nib->setFederateName(nibNames[rng() % NUM_FEDERATES]);
+         if (!table.add(nib)) errors++;
+         list.push_back(nib);
+         nib->unref();
+      }
+
+      for (unsigned int i = 0; i < OLD_NIBS && !list.empty(); i++) {
+         const unsigned int idx = static_cast<unsigned int>(rng() % list.size());
+         if (list[idx] == nullptr) continue;
+         if ((i % 2) == 0) {
+            if (!table.remove(list[idx])) errors++;
+         }
+         else {
+            interop::Nib* const nib = table.detach(idx);
+            if (nib != list[idx]) errors++;
+            if (nib != nullptr) nib->unref();
+         }
+         list[idx] = nullptr;
+      }
+      errors += check(table, list, names, &t);
+
+      if ((r % 3) == 2) {
+         table.compact();
+         std::vector<interop::Nib*> compacted;
+         for (unsigned int i = 0; i < list.size(); i++) {
+            if (list[i] != nullptr) compacted.push_back(list[i]);
+         }
+         list.swap(compacted);
+         errors += check(table, list, names, &t);
+      }
+   }
+
+   const double nf = static_cast<double>(NUM_FEDERATES) * NUM_IDS * (rounds + rounds / 3);
+   std::printf("rounds %u, NIBs %u: %.1f ns/find\n", rounds, table.size(), t * 1.0e9 / nf);
+
+   table.clear();
+   for (unsigned int f = 0; f < NUM_FEDERATES; f++) {
+      nibNames[f]->unref();
+      names[f]->unref();
+   }
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld NIBs were out of order or not found as expected\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
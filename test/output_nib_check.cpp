@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+// output_nib_check -- DIS NetIO output list test
+//
+//    Runs a station with a DIS NetIO (loopback network handlers) while random
+//    local players are added, deleted, deactivated and reactivated, and have
+//    their network output disabled and enabled, and checks after each frame
+//    that the NetIO has an output NIB for each (and only each) active local
+//    player with network output enabled.  Some frames change more players
+//    than the player list events hold, so the NetIO has to rescan the list.
+//    Prints the time per station background frame.
+//
+//    Usage: output_nib_check [ frames ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/interop/dis/NetIO.hpp"
+#include "openeaagles/interop/common/Nib.hpp"
+
+#include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/player/AirVehicle.hpp"
+
+#include "openeaagles/simulation/PlayerEvents.hpp"
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/network/LoopbackHandler.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int NUM_PLAYERS = 1000;    // Initial players
+static const unsigned int MAX_PLAYERS = 1500;
+static const unsigned int NEW_PLAYERS = 5;       // Max new players per frame
+static const unsigned int CHANGES = 20;          // Max changed players per frame
+static const unsigned int BURST_FRAMES = 50;     // Every 50th frame changes all players
+static const double DT = 0.02;                   // Frame time (seconds)
+
+// (the output list is protected)
+class TestNetIO : public dis::NetIO
+{
+public:
+   using dis::NetIO::getOutputListSize;
+   using dis::NetIO::getOutputNib;
+};
+
+static base::LoopbackHandler* createHandler(const int channel)
+{
+   const auto handler = new base::LoopbackHandler();
+   base::Integer ch(channel);
+   handler->setSlotByName("channel", &ch);
+   return handler;
+}
+
+// Adds a new local player with a unique ID
+static void addPlayer(models::WorldModel* const sim, unsigned short* const nextID)
+{
+   const auto p = new models::AirVehicle();
+   p->setID(*nextID);
+   p->setInitPosition(0.0, 100.0 * (*nextID));
+   p->setInitAltitude(1000.0);
+   char name[16];
+   std::sprintf(name, "p%u", *nextID);
+   sim->addNewPlayer(name, p);
+   p->unref();
+   (*nextID)++;
+}
+
+// Random changes to the local players
+static void changePlayers(models::WorldModel* const sim, const unsigned int nc, std::mt19937& rng)
+{
+   base::PairStream* const list = sim->getPlayers();
+   std::vector<models::Player*> players;
+   for (base::List::Item* item = list->getFirstItem(); item != nullptr; item = item->getNext()) {
+      players.push_back(static_cast<models::Player*>(static_cast<base::Pair*>(item->getValue())->object()));
+   }
+   for (unsigned int i = 0; i < nc && !players.empty(); i++) {
+      models::Player* const p = players[rng() % players.size()];
+      if (p->isMode(models::Player::DELETE_REQUEST)) continue;
+      switch (rng() % 5) {
+         case 0: p->setMode(models::Player::INACTIVE); break;
+         case 1: p->setMode(models::Player::ACTIVE); break;
+         case 2: p->setEnableNetOutput(false); break;
+         case 3: p->setEnableNetOutput(true); break;
+         default: {
+            if (players.size() > NUM_PLAYERS / 2) p->setMode(models::Player::DELETE_REQUEST);
+            break;
+         }
+      }
+   }
+   list->unref();
+}
+
+// Checks the output NIBs; returns the number of errors
+static long checkOutputList(models::WorldModel* const sim, const TestNetIO* const netIO)
+{
+   std::set<const models::Player*> expected;
+   base::PairStream* const list = sim->getPlayers();
+   for (base::List::Item* item = list->getFirstItem(); item != nullptr; item = item->getNext()) {
+      const auto p = static_cast<const models::Player*>(static_cast<base::Pair*>(item->getValue())->object());
+      if (p->isLocalPlayer() && p->isActive() && p->isNetOutputEnabled()) expected.insert(p);
+   }
+   list->unref();
+
+   long errors = 0;
+   std::set<const models::Player*> found;
+   for (unsigned int i = 0; i < netIO->getOutputListSize(); i++) {
+      const interop::Nib* const nib = netIO->getOutputNib(i);
+      if (nib == nullptr || nib->isMode(models::Player::DELETE_REQUEST)) continue;
+      const models::Player* const p = const_cast<interop::Nib*>(nib)->getPlayer();
+      if (!found.insert(p).second || expected.count(p) == 0) errors++;
+   }
+   if (found.size() != expected.size()) errors++;
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int frames = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 500);
+
+   const auto station = new simulation::Station();
+   const auto sim = new models::WorldModel();
+   station->setSlotSimulation(sim);
+
+   const auto netIO = new TestNetIO();
+   const auto netInput = createHandler(41);
+   const auto netOutput = createHandler(42);
+   netIO->setSlotByName("netInput", netInput);
+   netIO->setSlotByName("netOutput", netOutput);
+   netInput->unref();
+   netOutput->unref();
+   const auto networks = new base::PairStream();
+   const auto pair = new base::Pair("dis", netIO);
+   networks->put(pair);
+   pair->unref();
+   station->setSlotByName("networks", networks);
+   networks->unref();
+   station->event(base::Component::RESET_EVENT);
+
+   // The initial players, which the NetIO adds MAX_NEW_OUTGOING at a time
+   unsigned short nextID = 1;
+   for (unsigned int i = 0; i < NUM_PLAYERS; i++) {
+      addPlayer(sim, &nextID);
+      if ((i % 500) == 499) station->updateData(DT);
+   }
+   for (unsigned int f = 0; f <= NUM_PLAYERS / dis::NetIO::MAX_NEW_OUTGOING + 1; f++) {
+      station->updateTC(DT);
+      station->updateData(DT);
+   }
+
+   std::mt19937 rng(23);
+   long errors = checkOutputList(sim, netIO);
+   unsigned long changes = 0;
+   double t = 0.0;
+   for (unsigned int f = 0; f < frames; f++) {
+      base::PairStream* const list = sim->getPlayers();
+      const unsigned int np = list->entries();
+      list->unref();
+
+      const unsigned int nn = (np < MAX_PLAYERS ? static_cast<unsigned int>(rng() % (NEW_PLAYERS + 1)) : 0);
+      for (unsigned int i = 0; i < nn; i++) {
+         addPlayer(sim, &nextID);
+      }
+      const unsigned int nc = ((f % BURST_FRAMES) == (BURST_FRAMES - 1) ? simulation::PlayerEvents::MAX_EVENTS + np : static_cast<unsigned int>(rng() % (CHANGES + 1)));
+      changePlayers(sim, nc, rng);
+      changes += nn + nc;
+
+      station->updateTC(DT);
+      const double t0 = base::getComputerTime();
+      station->updateData(DT);
+      t += (base::getComputerTime() - t0);
+
+      errors += checkOutputList(sim, netIO);
+   }
+   std::printf("frames %u, changes %lu, output NIBs %u: %.3f ms/frame\n", frames, changes, netIO->getOutputListSize(), t * 1.0e3 / frames);
+
+   station->event(base::Component::SHUTDOWN_EVENT);
+   netIO->unref();
+   sim->unref();
+   station->unref();
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld frames' output lists didn't match the active local players\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+// player_index_check -- players-of-interest spatial index test
+//
+//    Places random moving players around the world model's reference point,
+//    builds a models::PlayerSpatialIndex, and checks that query() (geocentric
+//    and gaming area) and queryHorizontal() return, in player list order,
+//    every player within range, as found by checking all of the players.
+//    Prints the average number of candidates and the time per query.
+//
+//    Usage: player_index_check [ players [ queries ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/models/PlayerSpatialIndex.hpp"
+#include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/player/AirVehicle.hpp"
+
+#include "openeaagles/simulation/PlayerRegistry.hpp"
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const double AREA = 400000.0;        // Size of the gaming area (meters)
+static const double CELL_SIZE = 20000.0;    // Index cell size (meters)
+static const unsigned int NEW_PLAYERS = 500;  // New players per player list update
+
+// (updatePlayerList() is run by the background thread, and the reference
+// point is set by slots)
+class TestWorldModel : public models::WorldModel
+{
+public:
+   using models::WorldModel::updatePlayerList;
+   using models::WorldModel::setRefLatitude;
+   using models::WorldModel::setRefLongitude;
+};
+
+// Checks the candidates (in list order, and all players within range)
+static long check(
+      const std::vector<unsigned int>& candidates,
+      const std::vector<models::Player*>& players,
+      const base::Vec3d& p0,
+      const double range,
+      const int mode             // 0: ECEF, 1: NED, 2: NED horizontal
+   )
+{
+   long errors = 0;
+   for (unsigned int i = 1; i < candidates.size(); i++) {
+      if (candidates[i] <= candidates[i - 1]) errors++;
+   }
+   unsigned int j = 0;
+   for (unsigned int i = 0; i < players.size(); i++) {
+      base::Vec3d d = (mode == 0 ? players[i]->getGeocPosition() : players[i]->getPosition()) - p0;
+      if (mode == 2) d[2] = 0.0;
+      while (j < candidates.size() && candidates[j] < i) j++;
+      const bool found = (j < candidates.size() && candidates[j] == i);
+      if (d.length() <= range && !found) errors++;
+   }
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 5000);
+   const unsigned int nq = (argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 2000);
+
+   const auto station = new simulation::Station();
+   const auto sim = new TestWorldModel();
+   station->setSlotSimulation(sim);
+   sim->setRefLatitude(36.0);
+   sim->setRefLongitude(-116.0);
+   sim->reset();
+
+   std::mt19937 rng(7);
+   std::uniform_real_distribution<double> xy(-AREA / 2.0, AREA / 2.0);
+   std::uniform_real_distribution<double> alt(0.0, 12000.0);
+   std::uniform_real_distribution<double> vel(-250.0, 250.0);
+
+   std::vector<models::Player*> players;
+   for (unsigned int i = 0; i < n; i++) {
+      const auto p = new models::AirVehicle();
+      p->setID(static_cast<unsigned short>(i + 1));
+      char name[16];
+      std::sprintf(name, "p%u", i + 1);
+      sim->addNewPlayer(name, p);
+      players.push_back(p);
+      if ((i % NEW_PLAYERS) == (NEW_PLAYERS - 1)) sim->updatePlayerList();
+   }
+   sim->updatePlayerList();
+   for (unsigned int i = 0; i < n; i++) {
+      players[i]->setPosition(xy(rng), xy(rng), -alt(rng));
+      players[i]->setVelocity(vel(rng), vel(rng), 0.0);
+   }
+
+   simulation::PlayerRegistry* const reg = sim->getPlayerRegistry();
+   const auto index = new models::PlayerSpatialIndex(reg, CELL_SIZE, 0.0);
+   reg->unref();
+
+   long errors = 0;
+   unsigned long numCandidates = 0;
+   double t = 0.0;
+   std::vector<unsigned int> candidates;
+   for (unsigned int q = 0; q < nq; q++) {
+      const int mode = static_cast<int>(q % 3);
+      const base::Vec3d ned(xy(rng), xy(rng), -alt(rng));
+      const base::Vec3d p0 = (mode == 0 ? players[rng() % n]->getGeocPosition() : ned);
+      const double range = 1000.0 + 60000.0 * (rng() % 100) / 100.0;
+
+      const double t0 = base::getComputerTime();
+      if (mode == 2) index->queryHorizontal(p0, range, 0.0, &candidates);
+      else index->query(p0, range, (mode == 0), 0.0, &candidates);
+      t += (base::getComputerTime() - t0);
+
+      numCandidates += candidates.size();
+      errors += check(candidates, players, p0, range, mode);
+   }
+   std::printf("players %u, queries %u: %.1f candidates/query, %.2f us/query\n", n, nq,
+               static_cast<double>(numCandidates) / nq, t * 1.0e6 / nq);
+
+   index->unref();
+   for (unsigned int i = 0; i < n; i++) {
+      players[i]->unref();
+   }
+   sim->unref();
+   station->unref();
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld players within range were missing or out of order\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+// player_registry_check -- simulation::PlayerRegistry index test
+//
+//    Adds and removes random players (duplicate IDs and names included) over
+//    many player list updates, and checks that findPlayer() and
+//    findPlayerByName() of each new registry (incrementally updated indexes)
+//    return the same players as a search of the player list and as a
+//    registry built from scratch.  Prints the time per player list update.
+//
+//    Usage: player_registry_check [ updates [ players ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/models/WorldModel.hpp"
+#include "openeaagles/models/player/AirVehicle.hpp"
+
+#include "openeaagles/simulation/PlayerRegistry.hpp"
+#include "openeaagles/simulation/Station.hpp"
+
+#include "openeaagles/base/Identifier.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace oe {
+namespace test {
+
+static const unsigned short MAX_ID = 500;
+static const unsigned int MAX_NAME = 300;
+
+// (updatePlayerList() is run by the background thread)
+class TestWorldModel : public models::WorldModel
+{
+public:
+   using models::WorldModel::updatePlayerList;
+};
+
+// First player on the list with the ID, or the name
+static simulation::AbstractPlayer* search(base::PairStream* const list, const unsigned short id, const char* const name)
+{
+   for (const base::List::Item* item = list->getFirstItem(); item != nullptr; item = item->getNext()) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      const auto ip = const_cast<simulation::AbstractPlayer*>(static_cast<const simulation::AbstractPlayer*>(pair->object()));
+      if (name != nullptr ? (std::strcmp(*ip->getName(), name) == 0) : (ip->getID() == id)) return ip;
+   }
+   return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+   const int updates = (argc > 1 ? std::atoi(argv[1]) : 500);
+   const int target = (argc > 2 ? std::atoi(argv[2]) : 2000);
+
+   const auto station = new simulation::Station();
+   const auto sim = new TestWorldModel();
+   station->setSlotSimulation(sim);
+   sim->reset();
+
+   std::mt19937 rng(5);
+   long mismatches = 0;
+   double tu = 0.0;
+   for (int u = 0; u < updates; u++) {
+      // request the removal of some players, and add new players
+      base::PairStream* list = sim->getPlayers();
+      for (base::List::Item* item = list->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const auto ip = static_cast<simulation::AbstractPlayer*>(static_cast<base::Pair*>(item->getValue())->object());
+         if (rng() % 50 == 0) ip->setMode(simulation::AbstractPlayer::DELETE_REQUEST);
+      }
+      const unsigned int nNew = (list->entries() < static_cast<unsigned int>(target) ? 40 : 20);
+      for (unsigned int i = 0; i < nNew; i++) {
+         const auto p = new models::AirVehicle();
+         p->setID(static_cast<unsigned short>(1 + rng() % MAX_ID));
+         char name[16];
+         std::snprintf(name, sizeof(name), "p%u", static_cast<unsigned int>(rng() % MAX_NAME));
+         sim->addNewPlayer(name, p);
+         p->unref();
+      }
+      list->unref();
+
+      const double t0 = base::getComputerTime();
+      sim->updatePlayerList();
+      tu += (base::getComputerTime() - t0);
+
+      // compare the registry to the list and to a new registry
+      list = sim->getPlayers();
+      simulation::PlayerRegistry* const reg = sim->getPlayerRegistry();
+      const auto full = new simulation::PlayerRegistry(list);
+      for (unsigned short id = 1; id <= MAX_ID; id++) {
+         simulation::AbstractPlayer* const ip = search(list, id, nullptr);
+         if (reg->findPlayer(id) != ip || full->findPlayer(id) != ip) mismatches++;
+      }
+      for (unsigned int i = 0; i < MAX_NAME; i++) {
+         char name[16];
+         std::snprintf(name, sizeof(name), "p%u", i);
+         simulation::AbstractPlayer* const ip = search(list, 0, name);
+         if (reg->findPlayerByName(name) != ip || full->findPlayerByName(name) != ip) mismatches++;
+      }
+      full->unref();
+      reg->unref();
+      list->unref();
+   }
+
+   base::PairStream* const list = sim->getPlayers();
+   std::printf("updates %d, players %u, %.3f ms/update\n", updates, list->entries(), tu * 1000.0 / updates);
+   list->unref();
+   sim->unref();
+   station->unref();
+
+   if (mismatches != 0) {
+      std::printf("FAILED: %ld registry lookups did not find the first player on the list\n", mismatches);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
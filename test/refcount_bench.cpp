@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+// refcount_bench -- Referenced::ref()/unref() micro-benchmark
+//
+//    Times ref()/unref() pairs on a private object per thread (uncontended)
+//    and on one shared object (contended), for 1 to 8 threads, and checks
+//    that each object's reference count is back to one.
+//
+//    Build with -DOE_CONFIG_CHECK_REF_COUNTS=0 to time the unchecked
+//    (fetch_add/fetch_sub) reference counting.
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int LOOPS = 10000000;
+
+static void refLoop(const base::Object* const obj)
+{
+   for (unsigned int i = 0; i < LOOPS; i++) {
+      obj->ref();
+      obj->unref();
+   }
+}
+
+// Returns the ns per ref()/unref() pair (all threads); false in 'ok' if a count is wrong
+static double run(const unsigned int nThreads, const bool shared, bool* const ok)
+{
+   std::vector<base::Integer*> objs;
+   for (unsigned int i = 0; i < (shared ? 1 : nThreads); i++) {
+      objs.push_back(new base::Integer(1));
+   }
+
+   const double t0 = base::getComputerTime();
+   std::vector<std::thread> threads;
+   for (unsigned int i = 0; i < nThreads; i++) {
+      threads.emplace_back(refLoop, objs[shared ? 0 : i]);
+   }
+   for (unsigned int i = 0; i < nThreads; i++) {
+      threads[i].join();
+   }
+   const double dt = base::getComputerTime() - t0;
+
+   for (unsigned int i = 0; i < objs.size(); i++) {
+      if (objs[i]->getRefCount() != 1) *ok = false;
+      objs[i]->unref();
+   }
+   return (dt * 1.0e9 / (static_cast<double>(LOOPS) * nThreads));
+}
+
+int main(int, char*[])
+{
+   std::printf("reference count checks: %s\n", (OE_CONFIG_CHECK_REF_COUNTS ? "on" : "off"));
+   std::printf("%8s %16s %16s\n", "threads", "private (ns)", "shared (ns)");
+
+   bool ok = true;
+   for (unsigned int n = 1; n <= 8; n *= 2) {
+      const double tp = run(n, false, &ok);
+      const double ts = run(n, true, &ok);
+      std::printf("%8u %16.2f %16.2f\n", n, tp, ts);
+   }
+
+   if (!ok) std::printf("FAILED: reference count is not one\n");
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
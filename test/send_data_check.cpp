@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// send_data_check -- Component::send() with SendData test
+//
+//    Sends int, double, bool and string values, and alternating int and
+//    double values, to components with instrument style event tables (one
+//    ON_EVENT_OBJ() per value type), and checks that each changed value is
+//    received with its type and value, that unchanged values aren't sent,
+//    and that there are no allocations after the first send() of each type
+//    and string length (i.e., after the first WARM_UP loops).  Prints the time
+//    per send().
+//
+//    Usage: send_data_check [ loops ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/Component.hpp"
+#include "openeaagles/base/Boolean.hpp"
+#include "openeaagles/base/Float.hpp"
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/Pair.hpp"
+#include "openeaagles/base/PairStream.hpp"
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Counts all allocations
+static std::atomic<long> numAllocs(0);
+
+void* operator new(std::size_t n)
+{
+   numAllocs++;
+   void* p = std::malloc(n);
+   if (p == nullptr) throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   std::free(p);
+}
+
+namespace oe {
+namespace test {
+
+static const char* const STRINGS[] = { "OFF", "STBY", "ON" };
+
+// Component with an instrument style event table
+class Receiver : public base::Component
+{
+   typedef base::Component BaseClass;
+
+public:
+   virtual bool event(const int event, base::Object* const obj = nullptr) override;
+
+   bool onFloat(const base::Float* const msg)       { type = 'f'; value = msg->getDouble(); count++; return true; }
+   bool onInteger(const base::Integer* const msg)   { type = 'i'; value = msg->getInt(); count++; return true; }
+   bool onBoolean(const base::Boolean* const msg)   { type = 'b'; value = msg->getBoolean(); count++; return true; }
+   bool onString(const base::String* const msg)     { type = 's'; std::strcpy(str, *msg); count++; return true; }
+
+   char type {};
+   double value {};
+   char str[16] {};
+   long count {};
+};
+
+BEGIN_EVENT_HANDLER(Receiver)
+   ON_EVENT_OBJ(UPDATE_VALUE, onFloat, base::Float)
+   ON_EVENT_OBJ(UPDATE_VALUE, onInteger, base::Integer)
+   ON_EVENT_OBJ(UPDATE_VALUE, onBoolean, base::Boolean)
+   ON_EVENT_OBJ(UPDATE_VALUE, onString, base::String)
+END_EVENT_HANDLER()
+
+static const unsigned int NUM_RECEIVERS = 5;
+static const int WARM_UP = 12;
+
+int main(int argc, char* argv[])
+{
+   const int loops = (argc > 1 ? std::atoi(argv[1]) : 1000000);
+
+   const auto top = new base::Component();
+   const auto list = new base::PairStream();
+   Receiver* rcv[NUM_RECEIVERS] {};
+   for (unsigned int i = 0; i < NUM_RECEIVERS; i++) {
+      char name[16];
+      std::sprintf(name, "r%u", i);
+      rcv[i] = new Receiver();
+      const auto pair = new base::Pair(name, rcv[i]);
+      list->put(pair);
+      pair->unref();
+   }
+   top->setSlotByName("components", list);
+   list->unref();
+
+   base::Component::SendData sd[NUM_RECEIVERS];
+   long errors = 0;
+   long expected[NUM_RECEIVERS] {};
+   long allocs = 0;
+   double t = 0.0;
+   for (int i = 0; i < loops; i++) {
+      const long a0 = numAllocs;
+      const double t0 = base::getComputerTime();
+      top->send("r0", base::Component::UPDATE_VALUE, i * 0.5, sd[0]);
+      top->send("r1", base::Component::UPDATE_VALUE, i / 3, sd[1]);
+      top->send("r2", base::Component::UPDATE_VALUE, ((i / 2) % 2) != 0, sd[2]);
+      top->send("r3", base::Component::UPDATE_VALUE, STRINGS[(i / 4) % 3], sd[3]);
+      if (i % 2) top->send("r4", base::Component::UPDATE_VALUE, i, sd[4]);
+      else top->send("r4", base::Component::UPDATE_VALUE, i * 0.25, sd[4]);
+      t += (base::getComputerTime() - t0);
+      if (i >= WARM_UP) allocs += (numAllocs - a0);
+
+      // each changed value is received (and only the changed values)
+      expected[0]++;
+      if (i == 0 || (i % 3) == 0) expected[1]++;
+      if (i == 0 || (i % 2) == 0) expected[2]++;
+      if (i == 0 || (i % 4) == 0) expected[3]++;
+      expected[4]++;
+      if (rcv[0]->type != 'f' || rcv[0]->value != i * 0.5) errors++;
+      if (rcv[1]->type != 'i' || rcv[1]->value != i / 3) errors++;
+      if (rcv[2]->type != 'b' || rcv[2]->value != (((i / 2) % 2) != 0)) errors++;
+      if (rcv[3]->type != 's' || std::strcmp(rcv[3]->str, STRINGS[(i / 4) % 3]) != 0) errors++;
+      if ((i % 2) && (rcv[4]->type != 'i' || rcv[4]->value != i)) errors++;
+      if (!(i % 2) && (rcv[4]->type != 'f' || rcv[4]->value != i * 0.25)) errors++;
+   }
+   for (unsigned int i = 0; i < NUM_RECEIVERS; i++) {
+      if (rcv[i]->count != expected[i]) errors++;
+   }
+   std::printf("loops %d, %.1f ns/send, %ld allocations after the warm up\n", loops, t * 1.0e9 / (loops * 5.0), allocs);
+
+   for (unsigned int i = 0; i < NUM_RECEIVERS; i++) {
+      rcv[i]->unref();
+   }
+   top->unref();
+
+   bool ok = true;
+   if (errors != 0) {
+      std::printf("FAILED: %ld values were not received as sent\n", errors);
+      ok = false;
+   }
+   if (allocs != 0) {
+      std::printf("FAILED: send() allocated after the first values of each type\n");
+      ok = false;
+   }
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------------
+// slot_factory_check -- hashed slot name and factory name lookup test
+//
+//    Builds chains of slot tables with random slot names (with duplicate
+//    names, and names that hide base class names), and checks that
+//    SlotTable::index() finds the same slots as comparing the name with each
+//    slot name, derived class table first.  Checks that each slot of some
+//    library classes is found by its name, and that base::factory() and a
+//    FactoryTable construct the named classes.  Prints the time per index()
+//    of each.
+//
+//    Usage: slot_factory_check [ loops ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/FactoryTable.hpp"
+#include "openeaagles/base/SlotTable.hpp"
+#include "openeaagles/base/factory.hpp"
+
+#include "openeaagles/base/Component.hpp"
+#include "openeaagles/base/Float.hpp"
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/Rgba.hpp"
+#include "openeaagles/base/Statistic.hpp"
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/Timers.hpp"
+#include "openeaagles/base/functors/Tables.hpp"
+#include "openeaagles/base/network/UdpMulticastHandler.hpp"
+#include "openeaagles/base/network/UdpUnicastHandler.hpp"
+#include "openeaagles/base/distributions/Uniform.hpp"
+#include "openeaagles/base/ubf/Arbiter.hpp"
+#include "openeaagles/base/units/Distances.hpp"
+#include "openeaagles/base/units/Times.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int NUM_TABLES = 4;      // Tables per chain
+static const unsigned int MAX_SLOTS = 40;      // Max slots per table
+static const unsigned int NUM_CHAINS = 200;
+
+// Slot names of a chain of tables, base class table first
+struct Chain {
+   std::vector<std::string> names[NUM_TABLES];
+   std::vector<const char*> ptrs[NUM_TABLES];
+   base::SlotTable* tables[NUM_TABLES] {};
+};
+
+// Random slot names, from a small set so there are duplicates
+static std::string randomName(std::mt19937& rng)
+{
+   static const char* const words[] = { "altitude", "speed", "heading", "name", "id", "side", "mode", "range", "type", "rate" };
+   std::string name = words[rng() % 10];
+   if (rng() % 2) name += words[rng() % 10];
+   if (rng() % 3 == 0) name += static_cast<char>('0' + rng() % 10);
+   return name;
+}
+
+static void buildChain(Chain* const chain, std::mt19937& rng)
+{
+   for (unsigned int t = 0; t < NUM_TABLES; t++) {
+      const unsigned int ns = static_cast<unsigned int>(rng() % (MAX_SLOTS + 1));
+      for (unsigned int j = 0; j < ns; j++) {
+         chain->names[t].push_back(randomName(rng));
+      }
+      for (unsigned int j = 0; j < ns; j++) {
+         chain->ptrs[t].push_back(chain->names[t][j].c_str());
+      }
+      const char** const s = (ns > 0 ? chain->ptrs[t].data() : nullptr);
+      if (t == 0) chain->tables[t] = new base::SlotTable(s, ns);
+      else chain->tables[t] = new base::SlotTable(s, ns, *chain->tables[t - 1]);
+   }
+}
+
+static void deleteChain(Chain* const chain)
+{
+   for (unsigned int t = NUM_TABLES; t > 0; t--) {
+      delete chain->tables[t - 1];
+   }
+}
+
+// Index of the slot, found by comparing each slot name, our table first
+static unsigned int findSlot(const Chain& chain, const unsigned int t, const char* const name)
+{
+   unsigned int offset = 0;
+   for (unsigned int k = 0; k < t; k++) {
+      offset += static_cast<unsigned int>(chain.names[k].size());
+   }
+   for (unsigned int j = 0; j < chain.names[t].size(); j++) {
+      if (std::strcmp(name, chain.ptrs[t][j]) == 0) return offset + j + 1;
+   }
+   return (t > 0 ? findSlot(chain, t - 1, name) : 0);
+}
+
+// Checks the slots of a library class
+static long checkClassSlots(const base::SlotTable& table)
+{
+   long errors = 0;
+   for (unsigned int k = 1; k <= table.n(); k++) {
+      const unsigned int idx = table.index(table.name(k));
+      if (idx == 0 || std::strcmp(table.name(idx), table.name(k)) != 0) errors++;
+   }
+   if (table.index("noSuchSlot") != 0 || table.index("") != 0) errors++;
+   return errors;
+}
+
+// Checks that base::factory() constructs class T
+template <class T>
+static long checkFactory()
+{
+   long errors = 0;
+   base::Object* const obj = base::factory(T::getFactoryName());
+   if (obj == nullptr || typeid(*obj) != typeid(T)) errors++;
+   if (obj != nullptr) obj->unref();
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int loops = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 200);
+
+   std::mt19937 rng(13);
+   long errors = 0;
+
+   // Random chains: each name on the chain, and names that aren't
+   std::vector<Chain> chains(NUM_CHAINS);
+   for (unsigned int c = 0; c < NUM_CHAINS; c++) {
+      buildChain(&chains[c], rng);
+      const Chain& chain = chains[c];
+      const base::SlotTable* const table = chain.tables[NUM_TABLES - 1];
+      for (unsigned int t = 0; t < NUM_TABLES; t++) {
+         for (unsigned int j = 0; j < chain.names[t].size(); j++) {
+            if (table->index(chain.ptrs[t][j]) != findSlot(chain, NUM_TABLES - 1, chain.ptrs[t][j])) errors++;
+         }
+      }
+      for (unsigned int k = 0; k < 20; k++) {
+         const std::string name = randomName(rng);
+         if (table->index(name.c_str()) != findSlot(chain, NUM_TABLES - 1, name.c_str())) errors++;
+      }
+      if (table->index(nullptr) != 0) errors++;
+   }
+
+   // Library classes' slot tables
+   errors += checkClassSlots(base::Component::getSlotTable());
+   errors += checkClassSlots(base::UdpUnicastHandler::getSlotTable());
+   errors += checkClassSlots(base::UdpMulticastHandler::getSlotTable());
+   errors += checkClassSlots(base::Table3::getSlotTable());
+   errors += checkClassSlots(base::Statistic::getSlotTable());
+   errors += checkClassSlots(base::ubf::Arbiter::getSlotTable());
+
+   // base::factory()
+   errors += checkFactory<base::Integer>();
+   errors += checkFactory<base::Float>();
+   errors += checkFactory<base::Rgba>();
+   errors += checkFactory<base::Statistic>();
+   errors += checkFactory<base::UpTimer>();
+   errors += checkFactory<base::Table3>();
+   errors += checkFactory<base::Meters>();
+   errors += checkFactory<base::NauticalMiles>();
+   errors += checkFactory<base::MilliSeconds>();
+   errors += checkFactory<base::UdpUnicastHandler>();
+   errors += checkFactory<base::Uniform>();
+   errors += checkFactory<base::ubf::Arbiter>();
+   const char* const unknown[] = { "", "integer", "Integer ", "NoSuchClass" };
+   for (unsigned int k = 0; k < 4; k++) {
+      base::Object* const obj = base::factory(unknown[k]);
+      if (obj != nullptr) {
+         obj->unref();
+         errors++;
+      }
+   }
+
+   // FactoryTable: the first of any duplicate names is used
+   {
+      const base::FactoryTable table = {
+         FACTORY_ENTRY(base::Integer),
+         FACTORY_ENTRY(base::Float),
+         { base::Integer::getFactoryName(), &base::FactoryTable::construct<base::Float> }
+      };
+      base::Object* const obj = table.create(base::Integer::getFactoryName());
+      if (table.getNumEntries() != 2 || obj == nullptr || typeid(*obj) != typeid(base::Integer)) errors++;
+      if (obj != nullptr) obj->unref();
+      if (table.create("Rgba") != nullptr) errors++;
+   }
+
+   // Timing: the names in the chains' base class tables (searched last)
+   unsigned long sum = 0;
+   unsigned long n = 0;
+   const double t0 = base::getComputerTime();
+   for (unsigned int k = 0; k < loops; k++) {
+      for (unsigned int c = 0; c < NUM_CHAINS; c++) {
+         const Chain& chain = chains[c];
+         for (unsigned int j = 0; j < chain.names[0].size(); j++) {
+            sum += chain.tables[NUM_TABLES - 1]->index(chain.ptrs[0][j]);
+            n++;
+         }
+      }
+   }
+   const double t1 = base::getComputerTime();
+   for (unsigned int k = 0; k < loops; k++) {
+      for (unsigned int c = 0; c < NUM_CHAINS; c++) {
+         const Chain& chain = chains[c];
+         for (unsigned int j = 0; j < chain.names[0].size(); j++) {
+            sum -= findSlot(chain, NUM_TABLES - 1, chain.ptrs[0][j]);
+         }
+      }
+   }
+   const double t2 = base::getComputerTime();
+   if (sum != 0) errors++;
+   std::printf("lookups %lu: index() %.1f ns/lookup, name compares %.1f ns/lookup\n", n, (t1 - t0) * 1.0e9 / n, (t2 - t1) * 1.0e9 / n);
+
+   for (unsigned int c = 0; c < NUM_CHAINS; c++) {
+      deleteChain(&chains[c]);
+   }
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld slots or classes were not found as expected\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
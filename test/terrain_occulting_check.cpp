@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// terrain_occulting_check -- batched terrain occulting test
+//
+//    Checks random targets around random reference points over a synthetic
+//    (hilly) one degree terrain data file using Terrain::targetOcculting()
+//    and Terrain::targetOccultingMask(), and checks that both give the same
+//    results.  Prints the time per target of each.
+//
+//    Usage: terrain_occulting_check [ reference points [ targets ] ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/terrain/DataFile.hpp"
+
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const unsigned int NUM_POSTS = 1201;       // 3 arc-second posts
+static const double SW_LAT = 36.0;
+static const double SW_LON = -116.0;
+
+// Data file with hills and ridges
+class SyntheticTerrain : public terrain::DataFile
+{
+public:
+   SyntheticTerrain()                         { loadData(); }
+
+private:
+   virtual bool loadData() override {
+      columns = new short*[NUM_POSTS];
+      for (unsigned int i = 0; i < NUM_POSTS; i++) {
+         columns[i] = new short[NUM_POSTS];
+         for (unsigned int j = 0; j < NUM_POSTS; j++) {
+            const double x = static_cast<double>(i) / 40.0;
+            const double y = static_cast<double>(j) / 55.0;
+            const double h = 800.0 + 500.0 * std::sin(x) * std::cos(y) + 250.0 * std::sin(0.37 * x + 1.3 * y);
+            columns[i][j] = static_cast<short>(h);
+         }
+      }
+      nptlat = NUM_POSTS;
+      nptlong = NUM_POSTS;
+      latSpacing = 1.0 / (NUM_POSTS - 1);
+      lonSpacing = 1.0 / (NUM_POSTS - 1);
+      setLatitudeSW(SW_LAT);
+      setLongitudeSW(SW_LON);
+      setLatitudeNE(SW_LAT + 1.0);
+      setLongitudeNE(SW_LON + 1.0);
+      return true;
+   }
+};
+
+int main(int argc, char* argv[])
+{
+   const unsigned int nRefs = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 50);
+   const unsigned int n = (argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 400);
+
+   const auto terrain = new SyntheticTerrain();
+
+   std::mt19937 rng(3);
+   std::uniform_real_distribution<double> pos(0.1, 0.9);
+   std::uniform_real_distribution<double> offset(-0.3, 0.3);
+   std::uniform_real_distribution<double> alt(0.0, 2500.0);
+
+   std::vector<double> lats(n), lons(n), alts(n);
+   std::vector<unsigned int> visible((n + 31) / 32);
+   long mismatches = 0;
+   unsigned long numVisible = 0;
+   double t1 = 0.0, tn = 0.0;
+   for (unsigned int r = 0; r < nRefs; r++) {
+      const double refLat = SW_LAT + pos(rng);
+      const double refLon = SW_LON + pos(rng);
+      const double refAlt = 500.0 + alt(rng);
+      for (unsigned int i = 0; i < n; i++) {
+         lats[i] = refLat + offset(rng);
+         lons[i] = refLon + offset(rng);
+         alts[i] = alt(rng);
+      }
+
+      const double t0 = base::getComputerTime();
+      numVisible += terrain->targetOccultingMask(refLat, refLon, refAlt, lats.data(), lons.data(), alts.data(), n, visible.data());
+      const double ta = base::getComputerTime();
+      for (unsigned int i = 0; i < n; i++) {
+         const bool occulted = terrain->targetOcculting(refLat, refLon, refAlt, lats[i], lons[i], alts[i]);
+         const bool vis = ((visible[i / 32] >> (i % 32)) & 1u) != 0;
+         if (vis == occulted) mismatches++;
+      }
+      const double tb = base::getComputerTime();
+      tn += (ta - t0);
+      t1 += (tb - ta);
+   }
+   terrain->unref();
+
+   const double nt = static_cast<double>(nRefs) * n;
+   std::printf("targets %.0f, visible %lu, targetOccultingMask() %.2f us/target, targetOcculting() %.2f us/target\n",
+               nt, numVisible, tn * 1.0e6 / nt, t1 * 1.0e6 / nt);
+
+   if (mismatches != 0) {
+      std::printf("FAILED: %ld targets were not checked the same by targetOccultingMask() and targetOcculting()\n", mismatches);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
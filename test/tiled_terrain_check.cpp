@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+// tiled_terrain_check -- terrain::TiledTerrain test
+//
+//    Writes a two by two degree set of synthetic SRTM cells to a temporary
+//    directory, and checks that TiledTerrain, with a cache that holds only a
+//    few of its tiles, returns the same elevations (with and without
+//    interpolation) as the cells' SrtmHgtFiles, from getElevation() and
+//    getElevationsAt(), and from two threads at a time.  Prints the cache
+//    statistics and the time per elevation of each.
+//
+//    Usage: tiled_terrain_check [ points ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/terrain/TiledTerrain.hpp"
+#include "openeaagles/terrain/srtm/SrtmHgtFile.hpp"
+
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace oe {
+namespace test {
+
+static const int SW_LAT = 40;
+static const int SW_LON = -117;
+static const int NUM_CELLS = 2;                   // Cells per side
+static const unsigned int NUM_POSTS = 1201;       // 3 arc-second posts
+static const unsigned int TILE_SIZE = 128;
+static const unsigned int CACHE_SIZE = 16;
+static const unsigned int CLUSTER_POINTS = 500;   // Points per cluster
+static const double CLUSTER_SIZE = 0.05;          // Cluster half width (degs)
+
+// Synthetic elevation (meters), which is continuous across the cells.  (It's
+// above sea level: SrtmHgtFile reads sign-magnitude posts, and TiledTerrain
+// reads two's complement posts)
+static short height(const double lat, const double lon)
+{
+   const double h = 800.0 + 700.0 * std::sin(lat * 9.0) * std::cos(lon * 7.0) + 40.0 * std::sin(lat * 230.0 + lon * 170.0);
+   return static_cast<short>(h);
+}
+
+// Cell file name, e.g., "N40W117.hgt"
+static std::string cellName(const int lat, const int lon)
+{
+   char name[16];
+   std::sprintf(name, "N%02dW%03d.hgt", lat, -lon);
+   return name;
+}
+
+// Writes the cells; returns false if a file wasn't written
+static bool writeCells(const std::string& dir)
+{
+   bool ok = true;
+   std::vector<unsigned char> row(NUM_POSTS * 2);
+   for (int i = 0; i < NUM_CELLS && ok; i++) {
+      for (int j = 0; j < NUM_CELLS && ok; j++) {
+         const std::string filename = dir + "/" + cellName(SW_LAT + i, SW_LON + j);
+         FILE* const fp = std::fopen(filename.c_str(), "wb");
+         ok = (fp != nullptr);
+         for (int r = NUM_POSTS - 1; r >= 0 && ok; r--) {
+            for (unsigned int c = 0; c < NUM_POSTS; c++) {
+               const short h = height(SW_LAT + i + r / (NUM_POSTS - 1.0), SW_LON + j + c / (NUM_POSTS - 1.0));
+               row[c * 2] = static_cast<unsigned char>((h >> 8) & 0xff);
+               row[c * 2 + 1] = static_cast<unsigned char>(h & 0xff);
+            }
+            ok = (std::fwrite(row.data(), 1, row.size(), fp) == row.size());
+         }
+         if (fp != nullptr) std::fclose(fp);
+      }
+   }
+   return ok;
+}
+
+static void removeCells(const std::string& dir)
+{
+   for (int i = 0; i < NUM_CELLS; i++) {
+      for (int j = 0; j < NUM_CELLS; j++) {
+         std::remove((dir + "/" + cellName(SW_LAT + i, SW_LON + j)).c_str());
+      }
+   }
+   rmdir(dir.c_str());
+}
+
+// Elevation from the cell files; returns false if not found
+static bool cellElevation(const std::vector<terrain::SrtmHgtFile*>& files, double* const elev, const double lat, const double lon, const bool interp)
+{
+   bool found = false;
+   for (unsigned int k = 0; k < files.size() && !found; k++) {
+      found = files[k]->getElevation(elev, lat, lon, interp);
+   }
+   return found;
+}
+
+// Checks the points using getElevation(); returns the number of errors
+static long checkPoints(const terrain::TiledTerrain* const tt, const std::vector<terrain::SrtmHgtFile*>& files,
+                        const std::vector<double>& lats, const std::vector<double>& lons, const unsigned int first, double* const t)
+{
+   long errors = 0;
+   std::vector<double> elevs(lats.size());
+   std::vector<bool> found(lats.size());
+   const double t0 = base::getComputerTime();
+   for (unsigned int i = first; i < lats.size(); i += 2) {
+      double e = 0.0;
+      found[i] = tt->getElevation(&e, lats[i], lons[i], (i % 4) < 2);
+      elevs[i] = e;
+   }
+   if (t != nullptr) *t = base::getComputerTime() - t0;
+
+   for (unsigned int i = first; i < lats.size(); i += 2) {
+      double e = 0.0;
+      const bool f = cellElevation(files, &e, lats[i], lons[i], (i % 4) < 2);
+      if (f != found[i] || (f && e != elevs[i])) errors++;
+   }
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 40000);
+
+   char tmpl[] = "/tmp/tiled_terrain_check.XXXXXX";
+   if (mkdtemp(tmpl) == nullptr) {
+      std::printf("FAILED: unable to create a temporary directory\n");
+      return 1;
+   }
+   const std::string dir = tmpl;
+   if (!writeCells(dir)) {
+      std::printf("FAILED: unable to write the cells to %s\n", dir.c_str());
+      removeCells(dir);
+      return 1;
+   }
+
+   const auto path = new base::String(dir.c_str());
+   std::vector<terrain::SrtmHgtFile*> files;
+   for (int i = 0; i < NUM_CELLS; i++) {
+      for (int j = 0; j < NUM_CELLS; j++) {
+         const auto file = new terrain::SrtmHgtFile();
+         const auto name = new base::String(cellName(SW_LAT + i, SW_LON + j).c_str());
+         file->setPathname(path);
+         file->setFilename(name);
+         file->reset();
+         name->unref();
+         files.push_back(file);
+      }
+   }
+
+   const auto tt = new terrain::TiledTerrain();
+   tt->setPathname(path);
+   tt->setTileSize(TILE_SIZE);
+   tt->setCacheSize(CACHE_SIZE);
+   tt->reset();
+   path->unref();
+
+   long errors = 0;
+   if (tt->getNumCells() != NUM_CELLS * NUM_CELLS) errors++;
+
+   // Clusters of points over the cells, and a few just outside of them
+   std::mt19937 rng(11);
+   std::uniform_real_distribution<double> u(0.0, NUM_CELLS);
+   std::uniform_real_distribution<double> v(-CLUSTER_SIZE, CLUSTER_SIZE);
+   std::vector<double> lats(n), lons(n);
+   double lat0 = 0.0, lon0 = 0.0;
+   for (unsigned int i = 0; i < n; i++) {
+      if ((i % CLUSTER_POINTS) == 0) {
+         lat0 = SW_LAT + u(rng);
+         lon0 = SW_LON + u(rng);
+      }
+      lats[i] = lat0 + v(rng);
+      lons[i] = lon0 + v(rng);
+   }
+
+   // getElevation(), one thread
+   double t1 = 0.0;
+   errors += checkPoints(tt, files, lats, lons, 0, &t1);
+   errors += checkPoints(tt, files, lats, lons, 1, nullptr);
+
+   // getElevationsAt()
+   std::vector<double> elevs(n);
+   bool* const valid = new bool[n] {};
+   const double t0 = base::getComputerTime();
+   tt->getElevationsAt(elevs.data(), valid, n, lats.data(), lons.data(), true);
+   const double tn = base::getComputerTime() - t0;
+   for (unsigned int i = 0; i < n; i++) {
+      double e = 0.0;
+      const bool f = cellElevation(files, &e, lats[i], lons[i], true);
+      if (f != valid[i] || (f && e != elevs[i])) errors++;
+   }
+   delete[] valid;
+
+   // getElevation(), two threads
+   long threadErrors = 0;
+   std::thread thread([&]() { threadErrors = checkPoints(tt, files, lats, lons, 1, nullptr); });
+   errors += checkPoints(tt, files, lats, lons, 0, nullptr);
+   thread.join();
+   errors += threadErrors;
+
+   if (tt->getNumCachedTiles() > CACHE_SIZE || tt->getCacheEvictions() == 0) errors++;
+
+   std::printf("points %u: cache hits %llu, misses %llu, evictions %llu; getElevation() %.2f us/point, getElevationsAt() %.2f us/point\n",
+               n, tt->getCacheHits(), tt->getCacheMisses(), tt->getCacheEvictions(), t1 * 1.0e6 / ((n + 1) / 2), tn * 1.0e6 / n);
+
+   tt->unref();
+   for (unsigned int k = 0; k < files.size(); k++) {
+      files[k]->unref();
+   }
+   removeCells(dir);
+
+   if (errors != 0) {
+      std::printf("FAILED: %ld elevations (or cache checks) were not the same as the cell files'\n", errors);
+      return 1;
+   }
+   return 0;
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}
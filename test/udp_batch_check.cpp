@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// udp_batch_check -- batched UDP send and receive test
+//
+//    Sends packets of different sizes between two UdpUnicastHandlers on the
+//    loopback interface using sendDataBatch() and recvDataBatch() (batches
+//    larger than PosixHandler::MAX_BATCH included), and one at a time using
+//    sendData() and recvData(), and checks that all of the packets are
+//    received in order with their sizes and contents, and that no others are.  Prints the time per
+//    packet of each.
+//
+//    Usage: udp_batch_check [ packets ]
+//------------------------------------------------------------------------------
+
+#include "openeaagles/base/network/UdpUnicastHandler.hpp"
+#include "openeaagles/base/Integer.hpp"
+#include "openeaagles/base/String.hpp"
+#include "openeaagles/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace oe {
+namespace test {
+
+static const int PORT1 = 47101;
+static const int PORT2 = 47102;
+static const int MAX_SIZE = 256;                // Max packet size (bytes)
+static const unsigned int CHUNK = 200;          // Packets sent before they're received
+
+static base::UdpUnicastHandler* createHandler(const int port, const int localPort)
+{
+   const auto handler = new base::UdpUnicastHandler();
+   base::Integer p(port);
+   base::Integer lp(localPort);
+   base::String ip("127.0.0.1");
+   handler->setSlotByName("ipAddress", &ip);
+   handler->setSlotByName("port", &p);
+   handler->setSlotByName("localPort", &lp);
+   return handler;
+}
+
+// Packet 'i': its size and contents
+static int packetSize(const unsigned int i)
+{
+   return 8 + static_cast<int>((i * 37) % (MAX_SIZE - 8));
+}
+
+static void makePacket(const unsigned int i, char* const buff)
+{
+   const int size = packetSize(i);
+   for (int k = 0; k < size; k++) {
+      buff[k] = static_cast<char>((i + k * 7) & 0xff);
+   }
+}
+
+static bool checkPacket(const unsigned int i, const char* const buff, const unsigned int size)
+{
+   char expected[MAX_SIZE];
+   makePacket(i, expected);
+   return (size == static_cast<unsigned int>(packetSize(i)) && std::memcmp(buff, expected, size) == 0);
+}
+
+// Sends and receives 'n' packets, CHUNK at a time; returns the number of
+// packets not received as sent, and the time in 't'
+static long run(base::UdpUnicastHandler* const tx, base::UdpUnicastHandler* const rx, const unsigned int n, const bool batched, double* const t)
+{
+   std::vector<char> out(CHUNK * MAX_SIZE);
+   std::vector<char> in((CHUNK + 1) * MAX_SIZE);
+   std::vector<const char*> packets(CHUNK);
+   std::vector<int> sizes(CHUNK);
+   std::vector<unsigned int> rsizes(CHUNK + 1);
+
+   long errors = 0;
+   double tt = 0.0;
+   for (unsigned int i0 = 0; i0 < n; i0 += CHUNK) {
+      const unsigned int nc = (n - i0 < CHUNK ? n - i0 : CHUNK);
+      for (unsigned int j = 0; j < nc; j++) {
+         packets[j] = &out[j * MAX_SIZE];
+         sizes[j] = packetSize(i0 + j);
+         makePacket(i0 + j, &out[j * MAX_SIZE]);
+      }
+
+      const double t0 = base::getComputerTime();
+      unsigned int ns = 0;
+      if (batched) ns = tx->sendDataBatch(packets.data(), sizes.data(), nc);
+      else {
+         for (unsigned int j = 0; j < nc; j++) {
+            if (tx->sendData(packets[j], sizes[j])) ns++;
+         }
+      }
+
+      // receive them all (and no more)
+      unsigned int nr = 0;
+      for (int tries = 0; nr < nc && tries < 1000; tries++) {
+         if (batched) nr += rx->recvDataBatch(&in[nr * MAX_SIZE], MAX_SIZE, (CHUNK + 1) - nr, &rsizes[nr]);
+         else {
+            const unsigned int size = rx->recvData(&in[nr * MAX_SIZE], MAX_SIZE);
+            if (size > 0) rsizes[nr++] = size;
+         }
+      }
+      tt += (base::getComputerTime() - t0);
+
+      if (ns != nc || nr != nc) errors += (nc > nr ? nc - nr : nr - nc) + (nc - ns);
+      for (unsigned int j = 0; j < nr && j < nc; j++) {
+         if (!checkPacket(i0 + j, &in[j * MAX_SIZE], rsizes[j])) errors++;
+      }
+   }
+   *t = tt;
+   return errors;
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned int n = (argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 20000);
+
+   base::UdpUnicastHandler* const rx = createHandler(PORT2, PORT1);
+   base::UdpUnicastHandler* const tx = createHandler(PORT1, PORT2);
+   if (!rx->initNetwork(true) || !tx->initNetwork(true)) {
+      std::printf("FAILED: unable to open the loopback UDP sockets\n");
+      return 1;
+   }
+
+   double tb = 0.0, ts = 0.0;
+   const long eb = run(tx, rx, n, true, &tb);
+   const long es = run(tx, rx, n, false, &ts);
+   // nothing left to receive
+   char buff[MAX_SIZE];
+   unsigned int size = 0;
+   const unsigned int extra = rx->recvDataBatch(buff, MAX_SIZE, 1, &size) + rx->recvData(buff, MAX_SIZE);
+
+   std::printf("packets %u: batched %.2f us/packet, one at a time %.2f us/packet\n", n, tb * 1.0e6 / n, ts * 1.0e6 / n);
+
+   tx->unref();
+   rx->unref();
+
+   bool ok = true;
+   if (eb != 0 || es != 0) {
+      std::printf("FAILED: %ld batched and %ld single packets were not received as sent\n", eb, es);
+      ok = false;
+   }
+   if (extra != 0) {
+      std::printf("FAILED: received packets that weren't sent\n");
+      ok = false;
+   }
+   return (ok ? 0 : 1);
+}
+
+}
+}
+
+int main(int argc, char* argv[])
+{
+   return oe::test::main(argc, argv);
+}